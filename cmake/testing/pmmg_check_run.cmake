@@ -0,0 +1,67 @@
+# Run a test command and check its result (cmake -P script):
+#   CMD   : command line, arguments separated by '|'
+#   REGEX : regular expression that must be found in the output (optional)
+#   JSON  : reports that must be valid JSON objects, separated by '|'; a report
+#           given as "file@key" must also have the member "key" (optional)
+# Unlike PASS_REGULAR_EXPRESSION, the test fails if one of the processes
+# returns a non-zero exit code.
+
+string( REPLACE "|" ";" cmd "${CMD}" )
+string( REPLACE "|" ";" reports "${JSON}" )
+
+# Remove the reports of a previous run
+foreach( report ${reports} )
+  string( REGEX REPLACE "@.*$" "" file "${report}" )
+  file( REMOVE ${file} )
+endforeach()
+
+execute_process( COMMAND ${cmd}
+  RESULT_VARIABLE status
+  OUTPUT_VARIABLE out
+  ERROR_VARIABLE  err )
+message( "${out}" )
+message( "${err}" )
+
+if ( NOT "${status}" STREQUAL "0" )
+  message( FATAL_ERROR "Test command failed (exit status: ${status})." )
+endif()
+
+if ( REGEX AND NOT "${out}" MATCHES "${REGEX}" )
+  message( FATAL_ERROR "Expected output \"${REGEX}\" not found." )
+endif()
+
+foreach( report ${reports} )
+  set( key )
+  if ( "${report}" MATCHES "^(.*)@(.*)$" )
+    set( file ${CMAKE_MATCH_1} )
+    set( key  ${CMAKE_MATCH_2} )
+  else()
+    set( file ${report} )
+  endif()
+
+  if ( NOT EXISTS ${file} )
+    message( FATAL_ERROR "Report ${file} not written." )
+  endif()
+  file( READ ${file} content )
+
+  if ( CMAKE_VERSION VERSION_LESS 3.19 )
+    # No JSON parser: only check that the report is a closed object
+    if ( NOT "${content}" MATCHES "^[ \t\r\n]*{.*}[ \t\r\n]*$" )
+      message( FATAL_ERROR "Report ${file} is not a JSON object." )
+    endif()
+    if ( key AND NOT "${content}" MATCHES "\"${key}\"[ \t\r\n]*:" )
+      message( FATAL_ERROR "Report ${file} has no \"${key}\" member." )
+    endif()
+  else()
+    string( JSON type ERROR_VARIABLE jerr TYPE "${content}" )
+    if ( jerr OR NOT "${type}" STREQUAL "OBJECT" )
+      message( FATAL_ERROR "Report ${file} is not a valid JSON object: ${jerr}" )
+    endif()
+    if ( key )
+      string( JSON type ERROR_VARIABLE jerr TYPE "${content}" ${key} )
+      if ( jerr )
+        message( FATAL_ERROR "Report ${file} has no \"${key}\" member." )
+      endif()
+    endif()
+  endif()
+endforeach()
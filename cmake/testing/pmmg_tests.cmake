@@ -1,6 +1,20 @@
 IF( BUILD_TESTING )
   include( CTest )
 
+  # Add a test run by pmmg_check_run.cmake on NP procs: the test fails if a
+  # proc returns a non-zero exit code, if REGEX is not found in the output or
+  # if one of the JSON reports (list of "file" or "file@member") is invalid
+  set( PMMG_CHECK_RUN ${CMAKE_CURRENT_LIST_DIR}/pmmg_check_run.cmake )
+  function( pmmg_add_checked_test NAME NP REGEX JSON )
+    set( cmd ${MPIEXEC} ${MPI_ARGS} ${MPIEXEC_NUMPROC_FLAG} ${NP}
+      $<TARGET_FILE:${PROJECT_NAME}> ${ARGN} )
+    string( REPLACE ";" "|" cmd "${cmd}" )
+    string( REPLACE ";" "|" json "${JSON}" )
+    add_test( NAME ${NAME}
+      COMMAND ${CMAKE_COMMAND} "-DCMD=${cmd}" "-DREGEX=${REGEX}" "-DJSON=${json}"
+      -P ${PMMG_CHECK_RUN} )
+  endfunction()
+
   set( CI_DIR  ${CMAKE_BINARY_DIR}/Tests )
   file( MAKE_DIRECTORY ${CI_DIR} )
   set( CI_DIR_RESULTS  ${CI_DIR}/TEST_OUTPUTS )
@@ -60,6 +74,29 @@ IF( BUILD_TESTING )
       endforeach()
     endforeach()
 
+    # same test case with a log-Euclidean interpolation of the metrics
+    foreach( NP 1 6 8 )
+      add_test( NAME anisotropic-test-torus-with-planar-shock-logEuclidean-${NP}
+        COMMAND ${MPIEXEC} ${MPI_ARGS} ${MPIEXEC_NUMPROC_FLAG} ${NP} $<TARGET_FILE:${PROJECT_NAME}>
+        ${CI_DIR_INPUTS}/Torus/torusholes.mesh
+        -sol ${CI_DIR_INPUTS}/Torus/torusholes.sol
+        -out ${CI_DIR_RESULTS}/anisotropic-test-torus-with-planar-shock-logEuclidean-${NP}-out.mesh
+        -met-interp 1 -mesh-size ${mesh_size} ${myargs} )
+    endforeach()
+
+    # same test case with partitions balanced on the metric-predicted cost (1)
+    # and on the measured cost (2)
+    foreach( WGT 1 2 )
+      foreach( NP 6 8 )
+        add_test( NAME anisotropic-test-torus-with-planar-shock-metisWeights${WGT}-${NP}
+          COMMAND ${MPIEXEC} ${MPI_ARGS} ${MPIEXEC_NUMPROC_FLAG} ${NP} $<TARGET_FILE:${PROJECT_NAME}>
+          ${CI_DIR_INPUTS}/Torus/torusholes.mesh
+          -sol ${CI_DIR_INPUTS}/Torus/torusholes.sol
+          -out ${CI_DIR_RESULTS}/anisotropic-test-torus-with-planar-shock-metisWeights${WGT}-${NP}-out.mesh
+          -metis-weights ${WGT} -mesh-size ${mesh_size} ${myargs} )
+      endforeach()
+    endforeach()
+
     ###############################################################################
     #####
     #####        Tests options (on 1, 6 and 8 procs)
@@ -75,6 +112,110 @@ IF( BUILD_TESTING )
         -mesh-size ${mesh_size} ${myargs} )
     endforeach()
 
+    # Distributed output: one mesh per process, no merge
+    foreach( NP 1 6 8 )
+      add_test( NAME Sphere-distributed-output-${NP}
+        COMMAND ${MPIEXEC} ${MPI_ARGS} ${MPIEXEC_NUMPROC_FLAG} ${NP} $<TARGET_FILE:${PROJECT_NAME}>
+        ${CI_DIR_INPUTS}/Sphere/sphere.mesh
+        -out ${CI_DIR_RESULTS}/sphere-distributed-output-${NP}-out.meshb
+        -distributed-output -mesh-size ${mesh_size} ${myargs} )
+    endforeach()
+
+    # Shared output: one file written by all the processes with MPI-IO
+    foreach( NP 1 6 8 )
+      add_test( NAME Sphere-shared-output-${NP}
+        COMMAND ${MPIEXEC} ${MPI_ARGS} ${MPIEXEC_NUMPROC_FLAG} ${NP} $<TARGET_FILE:${PROJECT_NAME}>
+        ${CI_DIR_INPUTS}/Sphere/sphere.mesh
+        -out ${CI_DIR_RESULTS}/sphere-shared-output-${NP}-out.meshb
+        -shared-output -mesh-size ${mesh_size} ${myargs} )
+    endforeach()
+
+    # The shared output (mesh and metric) is read back by Mmg
+    foreach( NP 6 8 )
+      add_test( NAME Sphere-shared-output-reread-${NP}
+        COMMAND ${MPIEXEC} ${MPI_ARGS} ${MPIEXEC_NUMPROC_FLAG} 1 $<TARGET_FILE:${PROJECT_NAME}>
+        ${CI_DIR_RESULTS}/sphere-shared-output-${NP}-out.meshb
+        -sol ${CI_DIR_RESULTS}/sphere-shared-output-${NP}-out.solb
+        -out ${CI_DIR_RESULTS}/sphere-shared-output-reread-${NP}-out.mesh
+        -niter 0 ${myargs} )
+      set_tests_properties( Sphere-shared-output-reread-${NP}
+        PROPERTIES DEPENDS Sphere-shared-output-${NP}
+        FAIL_REGULAR_EXPRESSION "## Error;## ERROR;[ =]-?nan" )
+    endforeach()
+
+    # Shared input: the output of the shared output test is read by slabs
+    foreach( NP 1 6 8 )
+      add_test( NAME Sphere-shared-input-${NP}
+        COMMAND ${MPIEXEC} ${MPI_ARGS} ${MPIEXEC_NUMPROC_FLAG} ${NP} $<TARGET_FILE:${PROJECT_NAME}>
+        ${CI_DIR_RESULTS}/sphere-shared-output-1-out.meshb
+        -out ${CI_DIR_RESULTS}/sphere-shared-input-${NP}-out.meshb
+        -shared-input -mesh-size ${mesh_size} ${myargs} )
+      set_tests_properties( Sphere-shared-input-${NP}
+        PROPERTIES DEPENDS Sphere-shared-output-1 )
+    endforeach()
+
+    # Communicators build benchmark: time of the node communicators completion
+    # (slowest proc) against the number of procs
+    foreach( NP 2 4 8 16 )
+      pmmg_add_checked_test( Sphere-commBuild-benchmark-${NP} ${NP}
+        "node communicators completion" ""
+        ${CI_DIR_INPUTS}/Sphere/sphere.mesh
+        -out ${CI_DIR_RESULTS}/sphere-commBuild-benchmark-${NP}-out.mesh
+        -mesh-size ${mesh_size} ${myargs} -v 6 )
+    endforeach()
+
+    # Profiling reports (the exit code of every proc and the JSON reports are
+    # checked)
+    foreach( NP 1 4 )
+      set( out ${CI_DIR_RESULTS}/sphere-profiling-${NP}-out )
+
+      # Scratch memory arena for the interpolation and load balancing phases
+      pmmg_add_checked_test( Sphere-arena-${NP} ${NP}
+        "system allocations avoided" ""
+        ${CI_DIR_INPUTS}/Sphere/sphere.mesh -out ${out}-arena.mesh
+        -mesh-size ${mesh_size} ${myargs} -arena-size 4 -v 5 )
+
+      # Memory profile per allocation label
+      pmmg_add_checked_test( Sphere-memprof-${NP} ${NP}
+        "WRITING MEMORY PROFILE" "${out}-memprof.memprof.json@labels"
+        ${CI_DIR_INPUTS}/Sphere/sphere.mesh -out ${out}-memprof.mesh
+        -mesh-size ${mesh_size} ${myargs} -mem-profile )
+
+      # Phases timers reduced over the procs
+      pmmg_add_checked_test( Sphere-timing-${NP} ${NP}
+        "WRITING TIMING REPORT" "${out}-timing.timers.json@timers"
+        ${CI_DIR_INPUTS}/Sphere/sphere.mesh -out ${out}-timing.mesh
+        -mesh-size ${mesh_size} ${myargs} -timing-report )
+    endforeach()
+
+    # Timeline of the events of each proc
+    if ( USE_TRACE )
+      set( out ${CI_DIR_RESULTS}/sphere-profiling-4-out-trace )
+      pmmg_add_checked_test( Sphere-trace-4 4 "WRITING TRACE"
+        "${out}.trace.0.json@traceEvents;${out}.trace.1.json@traceEvents;${out}.trace.2.json@traceEvents;${out}.trace.3.json@traceEvents"
+        ${CI_DIR_INPUTS}/Sphere/sphere.mesh -out ${out}.mesh
+        -mesh-size ${mesh_size} ${myargs} )
+    endif()
+
+    # MPI communication counters (saved with the timers)
+    if ( USE_MPI_COUNTERS )
+      set( out ${CI_DIR_RESULTS}/sphere-profiling-4-out-mpicount )
+      pmmg_add_checked_test( Sphere-mpicount-4 4 "-- MPI"
+        "${out}.timers.json@mpi"
+        ${CI_DIR_INPUTS}/Sphere/sphere.mesh -out ${out}.mesh
+        -mesh-size ${mesh_size} ${myargs} -timing-report -v 5 )
+    endif()
+
+    # Load balancing skipped under a (large) predicted work imbalance
+    if ( USE_PARMETIS )
+      pmmg_add_checked_test( Sphere-lb-threshold-4 4
+        "load balancing skipped" ""
+        ${CI_DIR_INPUTS}/Sphere/sphere.mesh
+        -out ${CI_DIR_RESULTS}/sphere-lb-threshold-4-out.mesh
+        -mesh-size ${mesh_size} ${myargs} -niter 3 -adaptive-repart
+        -lb-threshold 100 -v 5 )
+    endif()
+
     # Option without arguments
     foreach( OPTION "optim" "optimLES" "nosurf" "noinsert" "noswap"  )
       foreach( NP 1 6 8 )
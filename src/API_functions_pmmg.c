@@ -154,6 +154,16 @@ void PMMG_Init_parameters(PMMG_pParMesh parmesh,MPI_Comm comm) {
   parmesh->info.target_mesh_size =  PMMG_REMESHER_TARGET_MESH_SIZE;
   parmesh->info.metis_ratio =  PMMG_RATIO_MMG_METIS;
   parmesh->info.API_mode    =  PMMG_APIDISTRIB_faces;
+  parmesh->info.metinterp_mode = PMMG_METINTERP_mode;
+  parmesh->info.distributed_output = PMMG_OUTPUT_merged;
+  parmesh->info.shared_input = 0;
+  parmesh->info.vwgt_mode = PMMG_VWGT_elements;
+  parmesh->info.repart_adaptive = 0;
+  parmesh->info.repart_itr = PMMG_REPART_ITR;
+  parmesh->info.balance_threshold = 0.;
+  parmesh->info.arena_size = 0;
+  parmesh->info.mem_profile = 0;
+  parmesh->info.timing_report = 0;
 
   for ( k=0; k<parmesh->ngrp; ++k ) {
     mesh = parmesh->listgrp[k].mesh;
@@ -334,6 +344,67 @@ int PMMG_Set_iparameter(PMMG_pParMesh parmesh, int iparam,int val) {
   case PMMG_IPARAM_niter :
     parmesh->niter = val;
     break;
+  case PMMG_IPARAM_metInterp :
+    if ( val != PMMG_METINTERP_linear && val != PMMG_METINTERP_logEuclidean ) {
+      fprintf(stderr,"\n  ## Error: %s: unknown metrics interpolation mode %d.\n",
+              __func__,val);
+      return 0;
+    }
+    parmesh->info.metinterp_mode = val;
+    break;
+  case PMMG_IPARAM_distributedOutput :
+    if ( val != PMMG_OUTPUT_merged && val != PMMG_OUTPUT_perProcess &&
+         val != PMMG_OUTPUT_sharedFile ) {
+      fprintf(stderr,"\n  ## Error: %s: unknown output mode %d.\n",
+              __func__,val);
+      return 0;
+    }
+    parmesh->info.distributed_output = val;
+    break;
+  case PMMG_IPARAM_sharedInput :
+    parmesh->info.shared_input = val;
+    break;
+  case PMMG_IPARAM_metisWeights :
+    if ( val != PMMG_VWGT_elements && val != PMMG_VWGT_metric &&
+         val != PMMG_VWGT_measured ) {
+      fprintf(stderr,"\n  ## Error: %s: unknown metis weights mode %d.\n",
+              __func__,val);
+      return 0;
+    }
+    parmesh->info.vwgt_mode = val;
+    break;
+  case PMMG_IPARAM_adaptiveRepart :
+#ifdef USE_PARMETIS
+    /* The groups are moved by ParMetis instead of by interface displacement;
+     * disabling it keeps the user repartitioning and load balancing modes */
+    parmesh->info.repart_adaptive = val ? 1 : 0;
+    if ( val ) {
+      parmesh->info.repartitioning     = PMMG_REDISTRIBUTION_graph_balancing;
+      parmesh->info.loadbalancing_mode = PMMG_LOADBALANCING_parmetis;
+    }
+#else
+    if ( val ) {
+      fprintf(stderr,"\n  ## Error: %s: adaptive repartitioning needs ParMetis"
+              " (USE_PARMETIS).\n",__func__);
+      return 0;
+    }
+#endif
+    break;
+  case PMMG_IPARAM_arenaSize :
+    if ( val < 0 ) {
+      fprintf(stderr,"\n  ## Error: %s: the arena size must be positive"
+              " (0 to disable the arena).\n",__func__);
+      return 0;
+    }
+    parmesh->info.arena_size = val;
+    break;
+  case PMMG_IPARAM_memProfile :
+    parmesh->info.mem_profile = val ? 1 : 0;
+    PMMG_memprof_on = parmesh->info.mem_profile;
+    break;
+  case PMMG_IPARAM_timingReport :
+    parmesh->info.timing_report = val ? 1 : 0;
+    break;
 
 #ifndef PATTERN
   case PMMG_IPARAM_octree :
@@ -504,6 +575,22 @@ int PMMG_Set_dparameter(PMMG_pParMesh parmesh, int dparam,double val){
   case PMMG_DPARAM_groupsRatio :
     parmesh->info.grps_ratio = val;
     break;
+  case PMMG_DPARAM_repartItr :
+    if ( val <= 0. ) {
+      fprintf(stderr,"\n  ## Error: %s: the repartitioning ratio must be"
+              " strictly positive.\n",__func__);
+      return 0;
+    }
+    parmesh->info.repart_itr = val;
+    break;
+  case PMMG_DPARAM_balanceThreshold :
+    if ( val < 0. ) {
+      fprintf(stderr,"\n  ## Error: %s: the imbalance threshold must be"
+              " positive.\n",__func__);
+      return 0;
+    }
+    parmesh->info.balance_threshold = val;
+    break;
   default :
     fprintf(stderr,"  ## Error: unknown type of parameter\n");
     return 0;
@@ -962,3 +962,142 @@ FORTRAN_NAME(PMMG_SAVEALLSOLS_CENTRALIZED,pmmg_saveallsols_centralized,
 
   return;
 }
+
+/**
+ * See \ref PMMG_saveMesh_distributed function in \ref libparmmg.h file.
+ */
+FORTRAN_NAME(PMMG_SAVEMESH_DISTRIBUTED,pmmg_savemesh_distributed,
+             (PMMG_pParMesh *parmesh,char* filename, int *strlen,int* retval),
+             (parmesh,filename,strlen,retval)){
+  char *tmp = NULL;
+
+  MMG5_SAFE_MALLOC(tmp,(*strlen+1),char,);
+  strncpy(tmp,filename,*strlen);
+  tmp[*strlen] = '\0';
+
+  *retval = PMMG_saveMesh_distributed(*parmesh,tmp);
+
+  MMG5_SAFE_FREE(tmp);
+
+  return;
+}
+
+/**
+ * See \ref PMMG_saveMet_distributed function in \ref libparmmg.h file.
+ */
+FORTRAN_NAME(PMMG_SAVEMET_DISTRIBUTED,pmmg_savemet_distributed,
+             (PMMG_pParMesh *parmesh,char* filename, int *strlen,int* retval),
+             (parmesh,filename,strlen,retval)){
+  char *tmp = NULL;
+
+  MMG5_SAFE_MALLOC(tmp,(*strlen+1),char,);
+  strncpy(tmp,filename,*strlen);
+  tmp[*strlen] = '\0';
+
+  *retval = PMMG_saveMet_distributed(*parmesh,tmp);
+
+  MMG5_SAFE_FREE(tmp);
+
+  return;
+}
+
+/**
+ * See \ref PMMG_saveAllSols_distributed function in \ref libparmmg.h file.
+ */
+FORTRAN_NAME(PMMG_SAVEALLSOLS_DISTRIBUTED,pmmg_saveallsols_distributed,
+             (PMMG_pParMesh *parmesh,char* filename, int *strlen,int* retval),
+             (parmesh,filename,strlen,retval)){
+  char *tmp = NULL;
+
+  MMG5_SAFE_MALLOC(tmp,(*strlen+1),char,);
+  strncpy(tmp,filename,*strlen);
+  tmp[*strlen] = '\0';
+
+  *retval = PMMG_saveAllSols_distributed(*parmesh,tmp);
+
+  MMG5_SAFE_FREE(tmp);
+
+  return;
+}
+
+/**
+ * See \ref PMMG_loadMesh_mpiio function in \ref libparmmg.h file.
+ */
+FORTRAN_NAME(PMMG_LOADMESH_MPIIO,pmmg_loadmesh_mpiio,
+             (PMMG_pParMesh *parmesh,char* meshin,int *strlen0,
+              char* metin,int *strlen1,int* retval),
+             (parmesh,meshin,strlen0,metin,strlen1,retval)){
+  char *tmp0 = NULL, *tmp1 = NULL;
+
+  MMG5_SAFE_MALLOC(tmp0,(*strlen0+1),char,);
+  strncpy(tmp0,meshin,*strlen0);
+  tmp0[*strlen0] = '\0';
+
+  MMG5_SAFE_MALLOC(tmp1,(*strlen1+1),char,MMG5_SAFE_FREE(tmp0));
+  strncpy(tmp1,metin,*strlen1);
+  tmp1[*strlen1] = '\0';
+
+  *retval = PMMG_loadMesh_mpiio(*parmesh,tmp0,*strlen1 ? tmp1 : NULL);
+
+  MMG5_SAFE_FREE(tmp1);
+  MMG5_SAFE_FREE(tmp0);
+
+  return;
+}
+
+/**
+ * See \ref PMMG_saveMesh_mpiio function in \ref libparmmg.h file.
+ */
+FORTRAN_NAME(PMMG_SAVEMESH_MPIIO,pmmg_savemesh_mpiio,
+             (PMMG_pParMesh *parmesh,char* filename, int *strlen,int* retval),
+             (parmesh,filename,strlen,retval)){
+  char *tmp = NULL;
+
+  MMG5_SAFE_MALLOC(tmp,(*strlen+1),char,);
+  strncpy(tmp,filename,*strlen);
+  tmp[*strlen] = '\0';
+
+  *retval = PMMG_saveMesh_mpiio(*parmesh,tmp);
+
+  MMG5_SAFE_FREE(tmp);
+
+  return;
+}
+
+/**
+ * See \ref PMMG_saveMet_mpiio function in \ref libparmmg.h file.
+ */
+FORTRAN_NAME(PMMG_SAVEMET_MPIIO,pmmg_savemet_mpiio,
+             (PMMG_pParMesh *parmesh,char* filename, int *strlen,int* retval),
+             (parmesh,filename,strlen,retval)){
+  char *tmp = NULL;
+
+  MMG5_SAFE_MALLOC(tmp,(*strlen+1),char,);
+  strncpy(tmp,filename,*strlen);
+  tmp[*strlen] = '\0';
+
+  *retval = PMMG_saveMet_mpiio(*parmesh,tmp);
+
+  MMG5_SAFE_FREE(tmp);
+
+  return;
+}
+
+/**
+ * See \ref PMMG_saveAllSols_mpiio function in \ref libparmmg.h file.
+ */
+FORTRAN_NAME(PMMG_SAVEALLSOLS_MPIIO,pmmg_saveallsols_mpiio,
+             (PMMG_pParMesh *parmesh,char* filename, int *strlen,int* retval),
+             (parmesh,filename,strlen,retval)){
+  char *tmp = NULL;
+
+  MMG5_SAFE_MALLOC(tmp,(*strlen+1),char,);
+  strncpy(tmp,filename,*strlen);
+  tmp[*strlen] = '\0';
+
+  *retval = PMMG_saveAllSols_mpiio(*parmesh,tmp);
+
+  MMG5_SAFE_FREE(tmp);
+
+  return;
+}
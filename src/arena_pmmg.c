@@ -0,0 +1,422 @@
+/* =============================================================================
+**  This file is part of the parmmg software package for parallel tetrahedral
+**  mesh modification.
+**  Copyright (c) Bx INP/Inria/UBordeaux, 2017-
+**
+**  parmmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  parmmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with parmmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the parmmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/**
+ * \file arena_pmmg.c
+ * \brief Scratch memory arena behind the PMMG scratch memory macros.
+ * \author Cécile Dobrzynski (Bx INP/Inria)
+ * \author Algiane Froehly (Inria)
+ * \author Luca Cirrottola (Inria)
+ * \version 1
+ * \copyright GNU Lesser General Public License.
+ *
+ * Between PMMG_arena_begin and PMMG_arena_end (a phase), the small scratch
+ * arrays allocated on the parmesh by the PMMG_SCRATCH_MALLOC and
+ * PMMG_SCRATCH_CALLOC macros are bump-allocated in a memory chunk instead of
+ * being allocated by the system. Each array is still charged on
+ * parmesh->memCur, resized by PMMG_REALLOC and freed by PMMG_DEL_MEM (that
+ * only decrements the number of live arrays of its chunk).
+ * At the end of the phase, the chunk is reused in bulk if all its arrays have
+ * been freed, otherwise it is kept until its last array is freed, so arrays
+ * that outlive the phase (communicators...) stay valid.
+ *
+ * The arena is opt-in: the arrays allocated by PMMG_MALLOC and PMMG_CALLOC
+ * always come from the system, because Mmg may free or reallocate them with
+ * its own routines (mesh and metric arrays). The arena is disabled inside
+ * parallel regions and if its size (parmesh->info.arena_size) is 0.
+ *
+ */
+#include "parmmg.h"
+
+/**
+ * \struct PMMG_ArenaChunk
+ * \brief memory chunk of the arena.
+ */
+typedef struct PMMG_ArenaChunk {
+  char                   *base; /*!< first byte of the chunk */
+  size_t                 size;  /*!< size of the chunk */
+  size_t                 used;  /*!< bump pointer (bytes used in the chunk) */
+  int                    live;  /*!< nb of arrays of the chunk not yet freed */
+  struct PMMG_ArenaChunk *nxt;  /*!< next retired chunk */
+} PMMG_ArenaChunk;
+
+/**
+ * \struct PMMG_Arena
+ * \brief state of the arena of the process.
+ */
+typedef struct {
+  void            *owner;   /*!< parmesh whose allocations are served (NULL out of a phase) */
+  const char      *phase;   /*!< name of the current phase */
+  size_t          chunkSize;/*!< size of the chunks */
+  PMMG_ArenaChunk *cur;     /*!< chunk used for the new arrays */
+  PMMG_ArenaChunk *retired; /*!< chunks with live arrays from previous phases */
+  size_t          nserved;  /*!< nb of arrays served by the arena */
+  size_t          nchunks;  /*!< nb of chunks allocated by the system */
+  size_t          nbytes;   /*!< nb of bytes served by the arena */
+} PMMG_Arena;
+
+/**
+ * \struct PMMG_ArenaHead
+ * \brief header stored before each array of the arena (keeps the alignment).
+ */
+typedef struct {
+  size_t size; /*!< size of the array */
+  size_t pad;
+} PMMG_ArenaHead;
+
+static PMMG_Arena PMMG_arena = { NULL,NULL,0,NULL,NULL,0,0,0 };
+
+/**
+ * \param ptr pointer toward an array.
+ *
+ * \return the chunk containing \a ptr, NULL if \a ptr has been allocated by
+ * the system.
+ *
+ */
+static inline
+PMMG_ArenaChunk* PMMG_arena_chunk( void *ptr ) {
+  PMMG_ArenaChunk *chunk;
+  char            *p;
+
+  p     = (char*)ptr;
+  chunk = PMMG_arena.cur;
+  if ( chunk && p > chunk->base && p < chunk->base+chunk->size ) return chunk;
+
+  for ( chunk=PMMG_arena.retired; chunk; chunk=chunk->nxt ) {
+    if ( p > chunk->base && p < chunk->base+chunk->size ) return chunk;
+  }
+  return NULL;
+}
+
+/**
+ * \param chunk pointer toward a chunk
+ *
+ * Unlink the chunk from the retired list and free it.
+ *
+ */
+static
+void PMMG_arena_freeChunk( PMMG_ArenaChunk *chunk ) {
+  PMMG_ArenaChunk **prev;
+
+  for ( prev=&PMMG_arena.retired; *prev; prev=&(*prev)->nxt ) {
+    if ( *prev == chunk ) {
+      *prev = chunk->nxt;
+      break;
+    }
+  }
+  free(chunk->base);
+  free(chunk);
+}
+
+/**
+ * \param owner structure on which the array is charged.
+ * \param size size of the array.
+ *
+ * \return a pointer toward the array of the arena, NULL if the arena can't
+ * serve it.
+ *
+ */
+static
+void* PMMG_arena_alloc( void *owner,size_t size ) {
+  PMMG_ArenaChunk *chunk;
+  PMMG_ArenaHead  *head;
+  size_t          need;
+
+  if ( !PMMG_arena.owner || owner != PMMG_arena.owner ) return NULL;
+#ifdef USE_OPENMP
+  if ( omp_in_parallel() ) return NULL;
+#endif
+
+  need = sizeof(PMMG_ArenaHead) + ( (size+15) & ~(size_t)15 );
+
+  /* Large arrays are allocated by the system */
+  if ( 4*need > PMMG_arena.chunkSize ) return NULL;
+
+  chunk = PMMG_arena.cur;
+  if ( chunk && chunk->used + need > chunk->size ) {
+    if ( !chunk->live ) {
+      chunk->used = 0;
+    }
+    else {
+      /* Keep the chunk until its last array is freed */
+      chunk->nxt         = PMMG_arena.retired;
+      PMMG_arena.retired = chunk;
+      PMMG_arena.cur     = chunk = NULL;
+    }
+  }
+
+  if ( !chunk ) {
+    chunk = (PMMG_ArenaChunk*)malloc(sizeof(PMMG_ArenaChunk));
+    if ( !chunk ) return NULL;
+    chunk->base = (char*)malloc(PMMG_arena.chunkSize);
+    if ( !chunk->base ) {
+      free(chunk);
+      return NULL;
+    }
+    chunk->size = PMMG_arena.chunkSize;
+    chunk->used = 0;
+    chunk->live = 0;
+    chunk->nxt  = NULL;
+    PMMG_arena.cur = chunk;
+    ++PMMG_arena.nchunks;
+  }
+
+  head       = (PMMG_ArenaHead*)(chunk->base + chunk->used);
+  head->size = size;
+  chunk->used += need;
+  ++chunk->live;
+
+  ++PMMG_arena.nserved;
+  PMMG_arena.nbytes += size;
+
+  return (void*)(head+1);
+}
+
+/**
+ * \param owner structure on which the array is charged (mesh or parmesh).
+ * \param size size of the array.
+ *
+ * \return a pointer toward the allocated array, NULL if fail.
+ *
+ * Allocation used by the PMMG_SCRATCH_MALLOC macro.
+ *
+ */
+void* PMMG_scratch_malloc( void *owner,size_t size ) {
+  void *ptr;
+
+  ptr = PMMG_arena_alloc(owner,size);
+  if ( ptr ) return ptr;
+
+  return mymalloc(size);
+}
+
+/**
+ * \param owner structure on which the array is charged (mesh or parmesh).
+ * \param nmemb number of items.
+ * \param size size of an item.
+ *
+ * \return a pointer toward the allocated array (filled with 0), NULL if fail.
+ *
+ * Allocation used by the PMMG_SCRATCH_CALLOC macro.
+ *
+ */
+void* PMMG_scratch_calloc( void *owner,size_t nmemb,size_t size ) {
+  void *ptr;
+
+  ptr = PMMG_arena_alloc(owner,nmemb*size);
+  if ( ptr ) {
+    memset(ptr,0,nmemb*size);
+    return ptr;
+  }
+
+  return mycalloc(nmemb,size);
+}
+
+/**
+ * \param ptr pointer toward the array to free.
+ *
+ * \return the size of the freed array.
+ *
+ * Deallocation used by the PMMG_DEL_MEM macro.
+ *
+ */
+size_t PMMG_myfree( void *ptr ) {
+  PMMG_ArenaChunk *chunk;
+  size_t          size;
+  int             live;
+
+  chunk = PMMG_arena_chunk(ptr);
+  if ( !chunk ) return myfree(ptr);
+
+  size = ((PMMG_ArenaHead*)ptr-1)->size;
+
+#ifdef USE_OPENMP
+#pragma omp atomic capture
+#endif
+  live = --chunk->live;
+
+  if ( !live ) {
+#ifdef USE_OPENMP
+    if ( omp_in_parallel() ) return size;
+#endif
+    if ( chunk != PMMG_arena.cur ) {
+      PMMG_arena_freeChunk(chunk);
+    }
+    else if ( !PMMG_arena.owner ) {
+      /* Out of a phase: the chunk can be reused by the next one */
+      chunk->used = 0;
+    }
+  }
+
+  return size;
+}
+
+/**
+ * \param owner structure on which the array is charged (mesh or parmesh).
+ * \param ptr pointer toward the array to reallocate.
+ * \param size new size of the array.
+ * \param oldsize old size of the array.
+ *
+ * \return a pointer toward the reallocated array, NULL if fail.
+ *
+ * Reallocation used by the PMMG_REALLOC macro. A system array stays a
+ * system array. An array of the arena is shrunk in place and copied in a new
+ * array when it grows.
+ *
+ */
+void* PMMG_myrealloc( void *owner,void *ptr,size_t size,size_t oldsize ) {
+  PMMG_ArenaHead *head;
+  void           *newptr;
+
+  if ( !PMMG_arena_chunk(ptr) ) return myrealloc(ptr,size,oldsize);
+
+  head = (PMMG_ArenaHead*)ptr-1;
+  if ( size <= head->size ) {
+    head->size = size;
+    return ptr;
+  }
+
+  newptr = PMMG_arena_alloc(owner,size);
+  if ( !newptr ) {
+    newptr = mymalloc(size);
+    if ( !newptr ) return NULL;
+  }
+  memcpy(newptr,ptr,MG_MIN(head->size,oldsize));
+  PMMG_myfree(ptr);
+
+  return newptr;
+}
+
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ * \param phase name of the phase.
+ *
+ * Begin a phase: the next small arrays allocated on \a parmesh are served by
+ * the arena (if its size is not 0).
+ *
+ */
+void PMMG_arena_begin( PMMG_pParMesh parmesh,const char *phase ) {
+
+  if ( parmesh->info.arena_size <= 0 ) return;
+
+  assert ( !PMMG_arena.owner && "nested arena phases" );
+
+  if ( PMMG_arena.chunkSize != (size_t)parmesh->info.arena_size*MMG5_MILLION ) {
+    /* New size: the current chunk can't be reused */
+    if ( PMMG_arena.cur ) {
+      if ( PMMG_arena.cur->live ) {
+        PMMG_arena.cur->nxt = PMMG_arena.retired;
+        PMMG_arena.retired  = PMMG_arena.cur;
+      }
+      else {
+        free(PMMG_arena.cur->base);
+        free(PMMG_arena.cur);
+      }
+      PMMG_arena.cur = NULL;
+    }
+    PMMG_arena.chunkSize = (size_t)parmesh->info.arena_size*MMG5_MILLION;
+  }
+
+  PMMG_arena.owner = (void*)parmesh;
+  PMMG_arena.phase = phase;
+}
+
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ *
+ * End a phase: release in bulk the arrays of the current chunk if they have
+ * all been freed, keep the chunk until its last array is freed otherwise.
+ *
+ */
+void PMMG_arena_end( PMMG_pParMesh parmesh ) {
+  PMMG_ArenaChunk *chunk;
+
+  if ( PMMG_arena.owner != (void*)parmesh ) return;
+
+  PMMG_arena.owner = NULL;
+  PMMG_arena.phase = NULL;
+
+  chunk = PMMG_arena.cur;
+  if ( !chunk ) return;
+
+  if ( !chunk->live ) {
+    chunk->used = 0;
+  }
+  else {
+    chunk->nxt         = PMMG_arena.retired;
+    PMMG_arena.retired = chunk;
+    PMMG_arena.cur     = NULL;
+  }
+}
+
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ *
+ * Free the unused chunks of the arena (the chunks that still contain live
+ * arrays are freed with their last array).
+ *
+ */
+void PMMG_arena_free( PMMG_pParMesh parmesh ) {
+  PMMG_ArenaChunk *chunk,*nxt;
+
+  PMMG_arena_end(parmesh);
+
+  if ( PMMG_arena.cur && !PMMG_arena.cur->live ) {
+    free(PMMG_arena.cur->base);
+    free(PMMG_arena.cur);
+    PMMG_arena.cur = NULL;
+  }
+  for ( chunk=PMMG_arena.retired; chunk; chunk=nxt ) {
+    nxt = chunk->nxt;
+    if ( !chunk->live ) PMMG_arena_freeChunk(chunk);
+  }
+}
+
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ *
+ * \return 1 if success, 0 if fail.
+ *
+ * Print the number of arrays served by the arena (system allocations avoided)
+ * summed over the processes.
+ *
+ */
+int PMMG_arena_printStats( PMMG_pParMesh parmesh ) {
+  double loc[3],glob[3];
+
+  if ( parmesh->info.arena_size <= 0 ) return 1;
+
+  loc[0] = (double)PMMG_arena.nserved;
+  loc[1] = (double)PMMG_arena.nchunks;
+  loc[2] = (double)PMMG_arena.nbytes;
+
+  MPI_CHECK( MPI_Reduce(loc,glob,3,MPI_DOUBLE,MPI_SUM,parmesh->info.root,
+                        parmesh->comm),return 0 );
+
+  if ( parmesh->myrank == parmesh->info.root ) {
+    fprintf(stdout,"\n   -- ARENA: %.0f arrays (%.1f MB) served from %.0f chunks:"
+            " %.0f system allocations avoided\n",glob[0],glob[2]/MMG5_MILLION,
+            glob[1],MG_MAX(glob[0]-glob[1],0.));
+  }
+  return 1;
+}
@@ -33,6 +33,7 @@
  */
 #include "linkedlist_pmmg.h"
 #include "coorcell_pmmg.h"
+#include "globalnum_pmmg.h"
 
 /**
  * \param parmesh pointer toward a parmesh structure
@@ -148,20 +149,15 @@ void PMMG_node_comm_free( PMMG_pParMesh parmesh )
  */
 int PMMG_parbdySet( PMMG_pParMesh parmesh ) {
   PMMG_pGrp      grp;
-  PMMG_pExt_comm ext_face_comm;
   PMMG_pInt_comm int_face_comm;
   MMG5_pMesh     mesh;
   MMG5_pTetra    pt;
   MMG5_pxTetra   pxt;
-  MPI_Comm       comm;
-  MPI_Status     status;
   int            *face2int_face_comm_index1,*face2int_face_comm_index2;
-  int            *seenFace,*intvalues,*itosend,*itorecv;
-  int            ngrp,myrank,color,nitem,k,igrp,i,idx,ie,ifac;
+  int            *seenFace,*intvalues;
+  int            ngrp,k,igrp,idx,ie,ifac;
 
-  comm   = parmesh->comm;
   grp    = parmesh->listgrp;
-  myrank = parmesh->myrank;
   ngrp   = parmesh->ngrp;
 
   /* intvalues will be used to store tetra ref */
@@ -200,35 +196,8 @@ int PMMG_parbdySet( PMMG_pParMesh parmesh ) {
   }
 
   /** Send and receive external communicators filled with the tetra ref */
-  for ( k=0; k<parmesh->next_face_comm; ++k ) {
-    ext_face_comm = &parmesh->ext_face_comm[k];
-    nitem         = ext_face_comm->nitem;
-    color         = ext_face_comm->color_out;
-
-    PMMG_CALLOC(parmesh,ext_face_comm->itosend,nitem,int,"itosend array",
-                return 0);
-    itosend = ext_face_comm->itosend;
-
-    PMMG_CALLOC(parmesh,ext_face_comm->itorecv,nitem,int,"itorecv array",
-                return 0);
-    itorecv = ext_face_comm->itorecv;
-
-    for ( i=0; i<nitem; ++i ) {
-      idx            = ext_face_comm->int_comm_index[i];
-      itosend[i]     = intvalues[idx];
-    }
-
-    MPI_CHECK(
-      MPI_Sendrecv(itosend,nitem,MPI_INT,color,MPI_COMMUNICATORS_REF_TAG,
-                   itorecv,nitem,MPI_INT,color,MPI_COMMUNICATORS_REF_TAG,
-                   comm,&status),return 0 );
-
-    /* Store the info in intvalues */
-    for ( i=0; i<nitem; ++i ) {
-      idx            = ext_face_comm->int_comm_index[i];
-      intvalues[idx] = itorecv[i];
-    }
-  }
+  if ( !PMMG_halo_exchange(parmesh,PMMG_HALO_FACE_INT,intvalues,PMMG_HALO_COPY) )
+    return 0;
 
   /* Check the internal communicator */
   for( igrp = 0; igrp < ngrp; igrp++ ) {
@@ -257,11 +226,6 @@ int PMMG_parbdySet( PMMG_pParMesh parmesh ) {
   /* Deallocate and return */
   PMMG_DEL_MEM(parmesh,int_face_comm->intvalues,int,"intvalues");
   PMMG_DEL_MEM(parmesh,seenFace,int,"seenFace");
-  for ( k=0; k<parmesh->next_face_comm; ++k ) {
-    ext_face_comm = &parmesh->ext_face_comm[k];
-    PMMG_DEL_MEM(parmesh,ext_face_comm->itosend,int,"itosend array");
-    PMMG_DEL_MEM(parmesh,ext_face_comm->itorecv,int,"itorecv array");
-  }
 
   return 1;
 }
@@ -510,20 +474,34 @@ int PMMG_build_faceCommIndex( PMMG_pParMesh parmesh ) {
   return 1;
 }
 
+/**
+ * \param parmesh pointer toward a parmesh structure
+ * \return 0 if fail, 1 if success
+ *
+ * Build the face communicators from the node communicators (given with their
+ * global node enumeration). Each proc only sends to its node neighbours the
+ * interface triangles whose three nodes are shared with this neighbour, so the
+ * exchanged memory scales with the interface size and not with the number of
+ * procs.
+ *
+ */
 int PMMG_build_faceCommFromNodes( PMMG_pParMesh parmesh ) {
   PMMG_pExt_comm ext_node_comm;
   PMMG_pGrp      grp;
   MMG5_pMesh     mesh;
   MMG5_pTria     ptt;
   MMG5_Hash      hash;
-  int            **local_index,**global_index;
-  int            *fNodes_loc,*fNodes_par,*fColors;
-  int            nb_fNodes_loc,*nb_fNodes_par,*displs,*counter,*iproc2comm;
-  int            kt,ia,ib,ic,i,icomm,iproc,iloc,iglob,myrank,next_face_comm,ier;
+  MPI_Request    *request;
+  MPI_Status     status;
+  int            **local_index,**global_index,**fNodes_send;
+  int            *fNodes_recv,*fColors,*mark,*parTria;
+  int            nparTria,nb_fNodes_recv,*counter,*iproc2comm;
+  int            offset,nt;
+  int            kt,ia,ib,ic,i,j,icomm,iproc,iloc,iglob,nprocs,next_face_comm,ier;
   MPI_Comm       comm;
 
   comm   = parmesh->comm;
-  myrank = parmesh->myrank;
+  nprocs = parmesh->nprocs;
   grp    = &parmesh->listgrp[0];
   mesh   = grp->mesh;
 
@@ -536,29 +514,23 @@ int PMMG_build_faceCommFromNodes( PMMG_pParMesh parmesh ) {
   /* Loop on ext node communicators to get global node IDs */
   for( icomm=0; icomm<parmesh->next_node_comm; icomm++ ) {
     ext_node_comm = &parmesh->ext_node_comm[icomm];
-    if( !ext_node_comm->nitem_to_share ) continue;
     for( i=0; i<ext_node_comm->nitem_to_share; i++ ) {
       iloc  = ext_node_comm->itosend[i];
       iglob = ext_node_comm->itorecv[i];
       mesh->point[iloc].flag = iglob;
     }
-    /* Deallocate arrays that have been used to store local/global interface
-     * nodes enuleration */
-    PMMG_DEL_MEM(parmesh,ext_node_comm->itosend,int,"ext comm itosend array");
-    PMMG_DEL_MEM(parmesh,ext_node_comm->itorecv,int,"ext comm itorecv array");
-    ext_node_comm->nitem_to_share = 0;
   }
 
   /** 2) Hash triangles with global node index: This avoids the occurrence of
    * non-boundary faces connected to three parallel nodes. */
-  nb_fNodes_loc = 3*mesh->nt;
-  PMMG_CALLOC(parmesh,fNodes_loc,nb_fNodes_loc,int,"fNodes_loc",return 0);
   PMMG_MALLOC(parmesh,fColors,2*mesh->nt,int,"fColors",return 0);
   for( i=0; i<2*mesh->nt; i++ )
     fColors[i] = PMMG_UNSET;
+  PMMG_MALLOC(parmesh,parTria,mesh->nt,int,"parTria",return 0);
 
   if ( ! MMG5_hashNew(mesh,&hash,0.51*mesh->nt,1.51*mesh->nt) ) return 0;
 
+  nparTria = 0;
   for (kt=1; kt<=mesh->nt; kt++) {
     ptt = &mesh->tria[kt];
     ia = mesh->point[ptt->v[0]].flag;
@@ -569,73 +541,127 @@ int PMMG_build_faceCommFromNodes( PMMG_pParMesh parmesh ) {
         MMG5_DEL_MEM(mesh,hash.item);
         return 0;
       }
-      fNodes_loc[3*(kt-1)+0] = ia;
-      fNodes_loc[3*(kt-1)+1] = ib;
-      fNodes_loc[3*(kt-1)+2] = ic;
+      parTria[nparTria++] = kt;
     }
   }
 
+  /* Offset of the local triangles in the (non-surjective) global face
+   * enumeration */
+  offset = 0;
+  nt     = mesh->nt;
+  MPI_CHECK( MPI_Exscan(&nt,&offset,1,MPI_INT,MPI_SUM,comm), return 0 );
+  if ( !parmesh->myrank ) offset = 0;
 
-  /** 3) Communicate face nodes */
-  PMMG_CALLOC(parmesh,nb_fNodes_par,parmesh->nprocs,int,"nb_fNodes_par",return 0);
-  PMMG_CALLOC(parmesh,displs,parmesh->nprocs+1,int,"displs",return 0);
 
-  MPI_CHECK( MPI_Allgather(&nb_fNodes_loc,1,MPI_INT,nb_fNodes_par,1,MPI_INT,comm),
-             return 0 );
-  
-  displs[0] = 0;
-  for( i=0; i<parmesh->nprocs; i++ )
-    displs[i+1] = displs[i]+nb_fNodes_par[i];
+  /** 3) Send to each node neighbour the parallel triangles whose three nodes
+   * are shared with it, together with their global ID */
+  PMMG_CALLOC(parmesh,mark,mesh->np+1,int,"mark",return 0);
+  for( i=1; i<=mesh->np; i++ )
+    mark[i] = PMMG_UNSET;
+
+  PMMG_CALLOC(parmesh,fNodes_send,parmesh->next_node_comm,int*,"fNodes_send pointer",return 0);
+  PMMG_MALLOC(parmesh,request,parmesh->next_node_comm,MPI_Request,"request",return 0);
+  for( icomm=0; icomm<parmesh->next_node_comm; icomm++ ) {
+    ext_node_comm = &parmesh->ext_node_comm[icomm];
+    request[icomm] = MPI_REQUEST_NULL;
+    if( !ext_node_comm->nitem_to_share ) continue;
 
-  PMMG_CALLOC(parmesh,fNodes_par,displs[parmesh->nprocs],int,"fNodes_par",return 0);
+    for( i=0; i<ext_node_comm->nitem_to_share; i++ )
+      mark[ext_node_comm->itosend[i]] = icomm;
+
+    /* Count and store the triangles shared with this neighbour */
+    j = 0;
+    for( i=0; i<nparTria; i++ ) {
+      ptt = &mesh->tria[parTria[i]];
+      if( mark[ptt->v[0]] == icomm && mark[ptt->v[1]] == icomm &&
+          mark[ptt->v[2]] == icomm ) j++;
+    }
+    PMMG_MALLOC(parmesh,fNodes_send[icomm],4*j+1,int,"fNodes_send array",return 0);
+    j = 0;
+    for( i=0; i<nparTria; i++ ) {
+      kt  = parTria[i];
+      ptt = &mesh->tria[kt];
+      if( mark[ptt->v[0]] != icomm || mark[ptt->v[1]] != icomm ||
+          mark[ptt->v[2]] != icomm ) continue;
+      fNodes_send[icomm][4*j+0] = mesh->point[ptt->v[0]].flag;
+      fNodes_send[icomm][4*j+1] = mesh->point[ptt->v[1]].flag;
+      fNodes_send[icomm][4*j+2] = mesh->point[ptt->v[2]].flag;
+      fNodes_send[icomm][4*j+3] = offset+kt;
+      j++;
+    }
 
-  MPI_CHECK( MPI_Allgatherv(fNodes_loc,nb_fNodes_loc,MPI_INT,
-                            fNodes_par,nb_fNodes_par,displs,MPI_INT,comm), return 0);
+    MPI_CHECK( MPI_Isend(fNodes_send[icomm],4*j,MPI_INT,ext_node_comm->color_out,
+                         MPI_COMMUNICATORS_FACE_TAG,comm,&request[icomm]),
+               return 0 );
+  }
 
 
-  /** 4) For each proc pair, get "other" tria in the local hash table,
+  /** 4) For each neighbour, get "other" tria in the local hash table,
    * count and store tria color. */
-  PMMG_CALLOC(parmesh,counter,parmesh->nprocs,int,"counter",return 0);
-  PMMG_CALLOC(parmesh,iproc2comm,parmesh->nprocs,int,"iproc2comm",return 0);
-  for( iproc=0; iproc<parmesh->nprocs; iproc++ )
+  PMMG_CALLOC(parmesh,counter,nprocs,int,"counter",return 0);
+  PMMG_CALLOC(parmesh,iproc2comm,nprocs,int,"iproc2comm",return 0);
+  for( iproc=0; iproc<nprocs; iproc++ )
     iproc2comm[iproc] = PMMG_UNSET;
 
-  /* Get face colors and count faces for each color */
-  icomm = 0;
-  for( iproc=0; iproc<parmesh->nprocs; iproc++ ) {
-    if( iproc == myrank ) continue;
-    for( i=displs[iproc]/3; i<displs[iproc+1]/3; i++ ) {
-      ia = fNodes_par[3*i+0];
-      ib = fNodes_par[3*i+1];
-      ic = fNodes_par[3*i+2];
-      if( ia && ib && ic ) {
-        kt = MMG5_hashGetFace(&hash,ia,ib,ic);
-        if( kt ) { /*it can be zero if (i) is an internal boundary on iproc  */
-          if( iproc2comm[iproc] == PMMG_UNSET ) iproc2comm[iproc] = icomm++;
-          /* Store face color and face global ID (starting from 1) on the other
-           * proc */
-          fColors[2*(kt-1)+0] = iproc;
-          fColors[2*(kt-1)+1] = i+1;
-          counter[iproc]++;
-        }
+  for( icomm=0; icomm<parmesh->next_node_comm; icomm++ ) {
+    ext_node_comm = &parmesh->ext_node_comm[icomm];
+    if( !ext_node_comm->nitem_to_share ) continue;
+    iproc = ext_node_comm->color_out;
+
+    MPI_CHECK( MPI_Probe(iproc,MPI_COMMUNICATORS_FACE_TAG,comm,&status),return 0 );
+    MPI_CHECK( MPI_Get_count(&status,MPI_INT,&nb_fNodes_recv),return 0 );
+    PMMG_MALLOC(parmesh,fNodes_recv,nb_fNodes_recv+1,int,"fNodes_recv",return 0);
+    MPI_CHECK( MPI_Recv(fNodes_recv,nb_fNodes_recv,MPI_INT,iproc,
+                        MPI_COMMUNICATORS_FACE_TAG,comm,&status),return 0 );
+
+    /* Get face colors and count faces for each color */
+    for( i=0; i<nb_fNodes_recv/4; i++ ) {
+      ia = fNodes_recv[4*i+0];
+      ib = fNodes_recv[4*i+1];
+      ic = fNodes_recv[4*i+2];
+      kt = MMG5_hashGetFace(&hash,ia,ib,ic);
+      if( kt ) { /*it can be zero if (i) is an internal boundary on iproc  */
+        /* Store face color and face global ID (starting from 1) on the other
+         * proc */
+        fColors[2*(kt-1)+0] = iproc;
+        fColors[2*(kt-1)+1] = fNodes_recv[4*i+3];
+        counter[iproc]++;
       }
     }
+    PMMG_DEL_MEM(parmesh,fNodes_recv,int,"fNodes_recv");
   }
-  assert( iproc2comm[myrank] == PMMG_UNSET );
+
+  MPI_CHECK( MPI_Waitall(parmesh->next_node_comm,request,MPI_STATUSES_IGNORE),
+             return 0 );
+
+  /* Deallocate arrays that have been used to store local/global interface
+   * nodes enumeration */
+  for( icomm=0; icomm<parmesh->next_node_comm; icomm++ ) {
+    ext_node_comm = &parmesh->ext_node_comm[icomm];
+    if( !ext_node_comm->nitem_to_share ) continue;
+    PMMG_DEL_MEM(parmesh,fNodes_send[icomm],int,"fNodes_send array");
+    PMMG_DEL_MEM(parmesh,ext_node_comm->itosend,int,"ext comm itosend array");
+    PMMG_DEL_MEM(parmesh,ext_node_comm->itorecv,int,"ext comm itorecv array");
+    ext_node_comm->nitem_to_share = 0;
+  }
+
+  /* Face communicators are ordered by increasing remote proc index */
+  icomm = 0;
+  for( iproc=0; iproc<nprocs; iproc++ ) {
+    if( counter[iproc] ) iproc2comm[iproc] = icomm++;
+  }
+  assert( iproc2comm[parmesh->myrank] == PMMG_UNSET );
 
 
   /** 5) Fill face communicators. */
 
   /* Set nb of communicators */
-  next_face_comm = 0;
-  for( iproc=0; iproc<parmesh->nprocs; iproc++ ) {
-    if( iproc2comm[iproc] != PMMG_UNSET ) next_face_comm++;
-  }
+  next_face_comm = icomm;
   ier = PMMG_Set_numberOfFaceCommunicators(parmesh,next_face_comm);
 
   PMMG_CALLOC(parmesh, local_index,next_face_comm,int*, "local_index pointer",return 0);
   PMMG_CALLOC(parmesh,global_index,next_face_comm,int*,"global_index pointer",return 0);
-  for( iproc=0; iproc<parmesh->nprocs; iproc++ ) {
+  for( iproc=0; iproc<nprocs; iproc++ ) {
     if( iproc2comm[iproc] == PMMG_UNSET ) continue;
     /* Set communicator size and reset counter */
     icomm = iproc2comm[iproc];
@@ -653,12 +679,12 @@ int PMMG_build_faceCommFromNodes( PMMG_pParMesh parmesh ) {
     icomm = iproc2comm[iproc];
     i = counter[iproc]++;
     local_index[icomm][i] = kt;
-    global_index[icomm][i] = MG_MIN(displs[myrank]/3+kt,iglob);
+    global_index[icomm][i] = MG_MIN(offset+kt,iglob);
   }
  
  
   /* Fill and sort each communicator */
-  for( iproc=0; iproc<parmesh->nprocs; iproc++ ) {
+  for( iproc=0; iproc<nprocs; iproc++ ) {
     if( iproc2comm[iproc] == PMMG_UNSET ) continue;
     icomm = iproc2comm[iproc];
     ier = PMMG_Set_ithFaceCommunicator_faces( parmesh, icomm, local_index[icomm],
@@ -673,11 +699,10 @@ int PMMG_build_faceCommFromNodes( PMMG_pParMesh parmesh ) {
   /* Free memory */
   MMG5_DEL_MEM(mesh,hash.item);
   PMMG_DEL_MEM(parmesh,fColors,int,"fColors");
-  PMMG_DEL_MEM(parmesh,fNodes_loc,int,"fNodes_loc");
-  PMMG_DEL_MEM(parmesh,fNodes_loc,int,"fNodes_par");
-  PMMG_DEL_MEM(parmesh,nb_fNodes_par,int,"nb_fNodes_par");
-  PMMG_DEL_MEM(parmesh,fNodes_par,int,"fNodes_par");
-  PMMG_DEL_MEM(parmesh,displs,int,"displs");
+  PMMG_DEL_MEM(parmesh,parTria,int,"parTria");
+  PMMG_DEL_MEM(parmesh,mark,int,"mark");
+  PMMG_DEL_MEM(parmesh,fNodes_send,int*,"fNodes_send pointer");
+  PMMG_DEL_MEM(parmesh,request,MPI_Request,"request");
   PMMG_DEL_MEM(parmesh,counter,int,"counter");
   PMMG_DEL_MEM(parmesh,iproc2comm,int,"iproc2comm");
   for( icomm=0; icomm<next_face_comm; icomm++ ) {
@@ -699,13 +724,17 @@ int PMMG_build_faceCommFromNodes( PMMG_pParMesh parmesh ) {
  *
  */
 int PMMG_build_nodeCommFromFaces( PMMG_pParMesh parmesh ) {
-  int ier, ier_glob;
+  double tstart,elapsed,elapsed_max;
+  char   stim[32];
+  int    ier, ier_glob;
 
   assert ( PMMG_check_extFaceComm ( parmesh ) );
   assert ( PMMG_check_intFaceComm ( parmesh ) );
 
   /** Build the internal node communicator from the faces ones */
+  PMMG_TRACE_BEGIN( "internal node comm" );
   ier = PMMG_build_intNodeComm(parmesh);
+  PMMG_TRACE_END( "internal node comm" );
 
   if ( !ier ) {
     fprintf(stderr,"\n  ## Error: %s: unable to build the internal node"
@@ -719,7 +748,9 @@ int PMMG_build_nodeCommFromFaces( PMMG_pParMesh parmesh ) {
      * at the possibility to miss a processor that is not visible from the face
      * communicators: _0_\1/_2_ configuration ( from 0 it is not possible to say
      * that the node at edge intersction belongs to 2 */
+    PMMG_TRACE_BEGIN( "simple external node comm" );
     ier = PMMG_build_simpleExtNodeComm(parmesh);
+    PMMG_TRACE_END( "simple external node comm" );
     if ( !ier ) {
       fprintf(stderr,"\n  ## Error: %s: unable to build the simple externals node"
               " communicators from the external faces communicators.\n",__func__);
@@ -732,7 +763,11 @@ int PMMG_build_nodeCommFromFaces( PMMG_pParMesh parmesh ) {
   if ( !ier_glob ) return 0;
 
   /** Fill the external node communicator */
-  ier = PMMG_build_completeExtNodeComm(parmesh);
+  PMMG_TRACE_BEGIN( "complete external node comm" );
+  tstart  = MPI_Wtime();
+  ier     = PMMG_build_completeExtNodeComm(parmesh);
+  elapsed = MPI_Wtime() - tstart;
+  PMMG_TRACE_END( "complete external node comm" );
   MPI_Allreduce( &ier, &ier_glob, 1, MPI_INT, MPI_MIN, parmesh->comm);
   if ( !ier ) {
     fprintf(stderr,"\n  ## Error: %s: unable to complete the external node"
@@ -740,6 +775,17 @@ int PMMG_build_nodeCommFromFaces( PMMG_pParMesh parmesh ) {
   }
   if ( !ier_glob ) return 0;
 
+  /* Slowest proc time of the communicator completion (imprim is only set on
+   * the root proc) */
+  if ( parmesh->info.imprim0 > PMMG_VERB_DETQUAL ) {
+    MPI_Reduce( &elapsed, &elapsed_max, 1, MPI_DOUBLE, MPI_MAX,
+                parmesh->info.root, parmesh->comm );
+    if ( parmesh->myrank == parmesh->info.root ) {
+      printim(elapsed_max,stim);
+      fprintf(stdout,"       node communicators completion     %s\n",stim);
+    }
+  }
+
   PMMG_MALLOC(parmesh,parmesh->int_node_comm->intvalues,
               parmesh->int_node_comm->nitem,int,"intvalues",return 0);
 
@@ -932,11 +978,15 @@ end:
  *
  * \return 1 if success, 0 if fail.
  *
- * Build the internal node communicators from the faces ones.
+ * Build the internal node communicators from the faces ones. If the groups
+ * track the global indices of their vertices, the copies of a node are
+ * matched by a hash join on the global indices, otherwise they are matched
+ * through the interface faces then by comparison of their coordinates.
  *
  */
 int PMMG_build_intNodeComm( PMMG_pParMesh parmesh ) {
   PMMG_pGrp       grp;
+  PMMG_HGid       hash;
   PMMG_coorCell   *coor_list;
   MMG5_pMesh      mesh;
   MMG5_pTetra     pt;
@@ -952,7 +1002,10 @@ int PMMG_build_intNodeComm( PMMG_pParMesh parmesh ) {
   double dd,dist[3];
 #endif
 
-  ier = 0;
+  ier           = 0;
+  new_pos       = NULL;
+  face_vertices = NULL;
+  coor_list     = NULL;
 
   /** Step 1: give a unique position in the internal communicator for each mesh
    * point but don't care about the unicity of the position for a point shared
@@ -1023,6 +1076,31 @@ int PMMG_build_intNodeComm( PMMG_pParMesh parmesh ) {
     assert ( idx == nitem_node-first_nitem_node && "missing item");
   }
 
+  /** Step 2 bis: if the global indices of the nodes are known, give the same
+   * position to all the copies of a node (hash join) and skip the steps 2
+   * and 3 */
+  if ( PMMG_gid_isTracked(parmesh) ) {
+    if ( !PMMG_hashGid_new(parmesh,&hash,nitem_node) ) goto end;
+
+    pos = 0;
+    for ( grpid=0; grpid<parmesh->ngrp; ++grpid ) {
+      grp  = &parmesh->listgrp[grpid];
+
+      for ( i=0; i<grp->nitem_int_node_comm; ++i ) {
+        ip  = grp->node2int_node_comm_index1[i];
+        assert ( grp->gid[ip] > 0 && "missing global index" );
+
+        idx = PMMG_hashGid_getOrAdd(&hash,grp->gid[ip],pos);
+        if ( idx == pos ) ++pos;
+
+        grp->node2int_node_comm_index2[i] = idx;
+      }
+    }
+    nitem_node = pos;
+
+    PMMG_hashGid_free(parmesh,&hash);
+    goto nitem;
+  }
 
   /** Step 2: remove some of the multiple positions and pack communicators */
   nitem_node_init = nitem_node;
@@ -1286,6 +1364,7 @@ int PMMG_build_intNodeComm( PMMG_pParMesh parmesh ) {
   nitem_node = j;
 
   /** Step 4: Update the number of items in the internal node communicator */
+nitem:
   parmesh->int_node_comm->nitem = nitem_node;
 
   /* Success */
@@ -1312,13 +1391,188 @@ end:
   return ier;
 }
 
+/**
+ * \param parmesh pointer toward a parmesh structure
+ * \param intvalues array of flags (1 for the nodes of the internal communicator
+ * that belong to an external communicator)
+ * \param proclists lists of the (proc,position) couples of each node
+ *
+ * \return 1 if success, 0 if fail.
+ *
+ * Complete the list of procs to which each node of the external communicators
+ * belongs, using the global indices of the nodes: each node is sent to the
+ * rendezvous proc given by a hash of its global index, that assembles the list
+ * of the copies of the node and sends it back to each of them. Unlike the
+ * propagation through the external communicators, the number of exchanges
+ * doesn't depend on the processor graph.
+ *
+ */
+static
+int PMMG_fill_proclists_rendezvous( PMMG_pParMesh parmesh,int *intvalues,
+                                    PMMG_cellLnkdList **proclists ) {
+  PMMG_pGrp      grp;
+  PMMG_HGid      hash;
+  int64_t        *idx2gid,*sbuf,*rbuf;
+  int            *scount,*sdispl,*rcount,*rdispl,*slot,*slotBeg,*slotItem;
+  int            *rep_sbuf,*rep_rbuf,*pos;
+  int            nitem,nprocs,nrecv,nslot,n,k,i,j,idx,ip,ier;
+  uint64_t       h;
+
+  ier    = 0;
+  nprocs = parmesh->nprocs;
+  nitem  = parmesh->int_node_comm->nitem;
+
+  idx2gid  = sbuf     = rbuf   = NULL;
+  scount   = sdispl   = rcount = rdispl = NULL;
+  slot     = slotBeg  = slotItem = NULL;
+  rep_sbuf = rep_rbuf = pos    = NULL;
+  hash.key = NULL;
+  hash.val = NULL;
+
+  /** Global index of each node of the internal communicator */
+  PMMG_CALLOC(parmesh,idx2gid,nitem,int64_t,"node global indices",goto end);
+  for ( k=0; k<parmesh->ngrp; ++k ) {
+    grp = &parmesh->listgrp[k];
+    for ( i=0; i<grp->nitem_int_node_comm; ++i ) {
+      ip  = grp->node2int_node_comm_index1[i];
+      idx = grp->node2int_node_comm_index2[i];
+      idx2gid[idx] = grp->gid[ip];
+    }
+  }
+
+  /** Send the (global index, position) couples to the rendezvous procs */
+  PMMG_CALLOC(parmesh,scount,nprocs,int,"send counts",goto end);
+  PMMG_CALLOC(parmesh,sdispl,nprocs+1,int,"send displs",goto end);
+  PMMG_CALLOC(parmesh,rcount,nprocs,int,"recv counts",goto end);
+  PMMG_CALLOC(parmesh,rdispl,nprocs+1,int,"recv displs",goto end);
+  PMMG_CALLOC(parmesh,pos,nprocs,int,"buffer positions",goto end);
+
+  for ( idx=0; idx<nitem; ++idx ) {
+    if ( !intvalues[idx] ) continue;
+    assert ( idx2gid[idx] > 0 );
+    h = ( (uint64_t)idx2gid[idx] * 0x9E3779B97F4A7C15ULL ) >> 32;
+    scount[h%nprocs] += 2;
+  }
+  for ( k=0; k<nprocs; ++k ) sdispl[k+1] = sdispl[k]+scount[k];
+
+  MPI_CHECK( MPI_Alltoall(scount,1,MPI_INT,rcount,1,MPI_INT,parmesh->comm),
+             goto end );
+  for ( k=0; k<nprocs; ++k ) rdispl[k+1] = rdispl[k]+rcount[k];
+
+  PMMG_MALLOC(parmesh,sbuf,sdispl[nprocs],int64_t,"rendezvous send buffer",goto end);
+  PMMG_MALLOC(parmesh,rbuf,rdispl[nprocs],int64_t,"rendezvous recv buffer",goto end);
+
+  for ( k=0; k<nprocs; ++k ) pos[k] = sdispl[k];
+  for ( idx=0; idx<nitem; ++idx ) {
+    if ( !intvalues[idx] ) continue;
+    h = ( (uint64_t)idx2gid[idx] * 0x9E3779B97F4A7C15ULL ) >> 32;
+    k = h%nprocs;
+    sbuf[pos[k]++] = idx2gid[idx];
+    sbuf[pos[k]++] = idx;
+  }
+
+  MPI_CHECK( MPI_Alltoallv(sbuf,scount,sdispl,MPI_INT64_T,
+                           rbuf,rcount,rdispl,MPI_INT64_T,parmesh->comm),
+             goto end );
+
+  /** Rendezvous: group the received copies by global index */
+  nrecv = rdispl[nprocs]/2;
+  if ( !PMMG_hashGid_new(parmesh,&hash,nrecv) ) goto end;
+  PMMG_MALLOC(parmesh,slot,nrecv,int,"copy slots",goto end);
+  PMMG_CALLOC(parmesh,slotBeg,nrecv+1,int,"slot first copy",goto end);
+  PMMG_MALLOC(parmesh,slotItem,2*nrecv,int,"slot copies",goto end);
+
+  nslot = 0;
+  for ( i=0; i<nrecv; ++i ) {
+    slot[i] = PMMG_hashGid_getOrAdd(&hash,rbuf[2*i],nslot);
+    if ( slot[i] == nslot ) ++nslot;
+    ++slotBeg[slot[i]+1];
+  }
+  for ( j=0; j<nslot; ++j ) slotBeg[j+1] += slotBeg[j];
+
+  for ( k=0; k<nprocs; ++k ) {
+    for ( i=rdispl[k]/2; i<rdispl[k+1]/2; ++i ) {
+      j = slotBeg[slot[i]]++;
+      slotItem[2*j]   = k;
+      slotItem[2*j+1] = (int)rbuf[2*i+1];
+    }
+  }
+  /* Restore the position of the first copy of each slot */
+  for ( j=nslot; j>0; --j ) slotBeg[j] = slotBeg[j-1];
+  slotBeg[0] = 0;
+
+  /** Send back the list of copies of each node, in the order of reception */
+  for ( k=0; k<nprocs; ++k ) {
+    rcount[k] = 0;
+    for ( i=rdispl[k]/2; i<rdispl[k+1]/2; ++i )
+      rcount[k] += 1 + 2*(slotBeg[slot[i]+1]-slotBeg[slot[i]]);
+  }
+  for ( k=0; k<nprocs; ++k ) rdispl[k+1] = rdispl[k]+rcount[k];
+
+  PMMG_MALLOC(parmesh,rep_sbuf,rdispl[nprocs],int,"rendezvous reply",goto end);
+  j = 0;
+  for ( i=0; i<nrecv; ++i ) {
+    rep_sbuf[j++] = slotBeg[slot[i]+1]-slotBeg[slot[i]];
+    for ( idx=slotBeg[slot[i]]; idx<slotBeg[slot[i]+1]; ++idx ) {
+      rep_sbuf[j++] = slotItem[2*idx];
+      rep_sbuf[j++] = slotItem[2*idx+1];
+    }
+  }
+
+  MPI_CHECK( MPI_Alltoall(rcount,1,MPI_INT,scount,1,MPI_INT,parmesh->comm),
+             goto end );
+  for ( k=0; k<nprocs; ++k ) sdispl[k+1] = sdispl[k]+scount[k];
+
+  PMMG_MALLOC(parmesh,rep_rbuf,sdispl[nprocs],int,"rendezvous reply",goto end);
+  MPI_CHECK( MPI_Alltoallv(rep_sbuf,rcount,rdispl,MPI_INT,
+                           rep_rbuf,scount,sdispl,MPI_INT,parmesh->comm),
+             goto end );
+
+  /** Fill the proc lists (the replies of each rendezvous proc come in the
+   * order of the requests) */
+  j = 0;
+  for ( k=0; k<nprocs; ++k ) {
+    for ( i=(k ? pos[k-1] : 0); i<pos[k]; i+=2 ) {
+      idx = (int)sbuf[i+1];
+      n   = rep_rbuf[j++];
+      for ( ; n>0; --n ) {
+        if ( !PMMG_add_cell2lnkdList(parmesh,proclists[idx],rep_rbuf[j],
+                                     rep_rbuf[j+1]) ) goto end;
+        j += 2;
+      }
+    }
+  }
+  assert ( j == sdispl[nprocs] );
+
+  ier = 1;
+
+end:
+  PMMG_hashGid_free(parmesh,&hash);
+  PMMG_DEL_MEM(parmesh,idx2gid,int64_t,"node global indices");
+  PMMG_DEL_MEM(parmesh,sbuf,int64_t,"rendezvous send buffer");
+  PMMG_DEL_MEM(parmesh,rbuf,int64_t,"rendezvous recv buffer");
+  PMMG_DEL_MEM(parmesh,rep_sbuf,int,"rendezvous reply");
+  PMMG_DEL_MEM(parmesh,rep_rbuf,int,"rendezvous reply");
+  PMMG_DEL_MEM(parmesh,slot,int,"copy slots");
+  PMMG_DEL_MEM(parmesh,slotBeg,int,"slot first copy");
+  PMMG_DEL_MEM(parmesh,slotItem,int,"slot copies");
+  PMMG_DEL_MEM(parmesh,scount,int,"send counts");
+  PMMG_DEL_MEM(parmesh,sdispl,int,"send displs");
+  PMMG_DEL_MEM(parmesh,rcount,int,"recv counts");
+  PMMG_DEL_MEM(parmesh,rdispl,int,"recv displs");
+  PMMG_DEL_MEM(parmesh,pos,int,"buffer positions");
+
+  return ier;
+}
+
 /**
  * \param parmesh pointer toward a parmesh structure
  *
  * \return 1 if success, 0 if fail.
  *
- * Complete the external communicators by travelling through the processors and
- * faces to detect all the processors to which each node belongs.
+ * Complete the external communicators by detecting all the processors to which
+ * each node belongs: in one rendezvous exchange if the global indices of the
+ * nodes are tracked, by travelling through the processors and faces otherwise.
  *
  */
 int PMMG_build_completeExtNodeComm( PMMG_pParMesh parmesh ) {
@@ -1328,7 +1582,7 @@ int PMMG_build_completeExtNodeComm( PMMG_pParMesh parmesh ) {
   int               *intvalues,nitem,nproclists,ier,ier2,k,i,j,idx,pos,rank,color;
   int               *itosend,*itorecv,*i2send_size,*i2recv_size,nitem2comm;
   int               *nitem_ext_comm,next_comm,val1_i,val2_i,val1_j,val2_j;
-  int               alloc_size;
+  int               alloc_size,rendezvous,grpid;
   int8_t            glob_update,loc_update;
   MPI_Request       *request;
   MPI_Status        *status;
@@ -1348,6 +1602,21 @@ int PMMG_build_completeExtNodeComm( PMMG_pParMesh parmesh ) {
   nitem_ext_comm  = NULL;
   list.item       = NULL;
 
+  /** The rendezvous algorithm needs the global indices of all the nodes of the
+   * communicators on all the procs */
+  rendezvous = parmesh->ngrp ? PMMG_gid_isTracked(parmesh) : 1;
+  for ( grpid=0; grpid<parmesh->ngrp && rendezvous; ++grpid ) {
+    for ( i=0; i<parmesh->listgrp[grpid].nitem_int_node_comm; ++i ) {
+      idx = parmesh->listgrp[grpid].node2int_node_comm_index1[i];
+      if ( parmesh->listgrp[grpid].gid[idx] <= 0 ) {
+        rendezvous = 0;
+        break;
+      }
+    }
+  }
+  MPI_CHECK( MPI_Allreduce(MPI_IN_PLACE,&rendezvous,1,MPI_INT,MPI_MIN,
+                           parmesh->comm),return 0 );
+
   PMMG_CALLOC(parmesh,int_node_comm->intvalues,nitem,int,"node communicator",
     return 0);
   intvalues     = int_node_comm->intvalues;
@@ -1419,10 +1688,16 @@ int PMMG_build_completeExtNodeComm( PMMG_pParMesh parmesh ) {
     }
   }
 
-  /** Step 2: While at least the proc list of 1 node is modified, send and
-   * recieve the proc list of all the nodes to/from the other processors. At the
-   * end of this loop, each node has the entire list of the proc to which it
-   * belongs */
+  /** Step 2: Get the entire list of the procs to which each node belongs */
+  if ( rendezvous ) {
+    if ( !PMMG_fill_proclists_rendezvous(parmesh,intvalues,proclists) ) goto end;
+    goto complete;
+  }
+
+  /* Without global indices: while at least the proc list of 1 node is
+   * modified, send and recieve the proc list of all the nodes to/from the other
+   * processors. At the end of this loop, each node has the entire list of the
+   * proc to which it belongs */
   alloc_size = parmesh->next_node_comm;
   PMMG_MALLOC(parmesh,request,    alloc_size,MPI_Request,"mpi request array",goto end);
   PMMG_MALLOC(parmesh,status,     alloc_size,MPI_Status,"mpi status array",goto end);
@@ -1522,6 +1797,7 @@ int PMMG_build_completeExtNodeComm( PMMG_pParMesh parmesh ) {
 
   } while ( glob_update );
 
+complete:
   /** Step 3: Cancel the old external communicator and build it again from the
    * list of proc of each node */
   PMMG_CALLOC(parmesh,nitem_ext_comm,parmesh->nprocs,int,
@@ -1665,3 +1941,112 @@ end:
 
   return ier;
 }
+
+/**
+ * \param parmesh pointer toward a parmesh structure
+ * \param glonum global indices of the mesh vertices (allocated to np+1 and
+ * filled, 0 for unused vertices).
+ * \param nowned number of vertices owned by the process (filled).
+ * \param offset number of vertices owned by the lower ranks (filled).
+ * \param nglob total number of vertices of the parallel mesh (filled).
+ *
+ * \return 1 if success, 0 if fail.
+ *
+ * Compute a global numbering of the vertices (only one group per process is
+ * allowed). An interface node is owned by the lowest rank that shares it. Each
+ * process numbers its owned vertices from \a offset+1 to \a offset+nowned,
+ * \a offset being computed by an exclusive prefix sum of the number of owned
+ * vertices, then the owners send the global indices of the interface nodes
+ * through the node communicators.
+ *
+ */
+int PMMG_compute_verticesGloNum( PMMG_pParMesh parmesh,int *glonum,int *nowned,
+                                 int *offset,int *nglob ) {
+  PMMG_pGrp      grp;
+  PMMG_pInt_comm int_node_comm;
+  PMMG_pExt_comm ext_node_comm;
+  MMG5_pMesh     mesh;
+  int            *intvalues;
+  int            myrank,color,icomm,i,k,idx,ip,ier;
+
+  assert ( parmesh->ngrp == 1 );
+  grp    = &parmesh->listgrp[0];
+  mesh   = grp->mesh;
+  myrank = parmesh->myrank;
+
+  int_node_comm = parmesh->int_node_comm;
+  PMMG_MALLOC(parmesh,int_node_comm->intvalues,int_node_comm->nitem,int,
+              "intvalues",return 0);
+  intvalues = int_node_comm->intvalues;
+
+  /** Owner of the interface nodes: lowest rank that shares the node */
+  for ( i=0; i<int_node_comm->nitem; ++i ) {
+    intvalues[i] = myrank;
+  }
+  for ( icomm=0; icomm<parmesh->next_node_comm; ++icomm ) {
+    ext_node_comm = &parmesh->ext_node_comm[icomm];
+    color         = ext_node_comm->color_out;
+    for ( i=0; i<ext_node_comm->nitem; ++i ) {
+      idx            = ext_node_comm->int_comm_index[i];
+      intvalues[idx] = MG_MIN(intvalues[idx],color);
+    }
+  }
+
+  /** Count the owned vertices (non owned ones are marked by -1) */
+  for ( ip=1; ip<=mesh->np; ++ip ) {
+    glonum[ip] = MG_VOK(&mesh->point[ip]) ? 0 : -1;
+  }
+  for ( k=0; k<grp->nitem_int_node_comm; ++k ) {
+    ip  = grp->node2int_node_comm_index1[k];
+    idx = grp->node2int_node_comm_index2[k];
+    if ( intvalues[idx] != myrank ) glonum[ip] = -1;
+  }
+
+  *nowned = 0;
+  for ( ip=1; ip<=mesh->np; ++ip ) {
+    if ( !glonum[ip] ) ++(*nowned);
+  }
+
+  /** Number the owned vertices after the ones of the lower ranks */
+  *offset = 0;
+  MPI_CHECK( MPI_Exscan(nowned,offset,1,MPI_INT,MPI_SUM,parmesh->comm),return 0 );
+  if ( !myrank ) *offset = 0;
+  MPI_CHECK( MPI_Allreduce(nowned,nglob,1,MPI_INT,MPI_SUM,parmesh->comm),return 0 );
+
+  k = *offset;
+  for ( ip=1; ip<=mesh->np; ++ip ) {
+    if ( !glonum[ip] ) glonum[ip] = ++k;
+  }
+
+  /** Send the global indices of the interface nodes from their owners */
+  for ( k=0; k<grp->nitem_int_node_comm; ++k ) {
+    ip             = grp->node2int_node_comm_index1[k];
+    idx            = grp->node2int_node_comm_index2[k];
+    intvalues[idx] = MG_MAX(glonum[ip],0);
+  }
+
+  /* Only the owner sends a non zero index */
+  if ( !PMMG_halo_exchange(parmesh,PMMG_HALO_NODE_INT,intvalues,PMMG_HALO_MAX) )
+    return 0;
+
+  ier = 1;
+  for ( k=0; k<grp->nitem_int_node_comm; ++k ) {
+    ip  = grp->node2int_node_comm_index1[k];
+    idx = grp->node2int_node_comm_index2[k];
+    if ( !MG_VOK(&mesh->point[ip]) ) continue;
+
+    glonum[ip] = intvalues[idx];
+    if ( glonum[ip] <= 0 ) {
+      fprintf(stderr,"\n  ## Error: %s: no global index received for the"
+              " interface node %d.\n",__func__,ip);
+      ier = 0;
+    }
+  }
+  for ( ip=1; ip<=mesh->np; ++ip ) {
+    if ( glonum[ip] < 0 ) glonum[ip] = 0;
+  }
+
+  PMMG_DEL_MEM(parmesh,int_node_comm->intvalues,int,"intvalues");
+
+  return ier;
+}
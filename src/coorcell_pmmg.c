@@ -159,3 +159,130 @@ int PMMG_unscale_coorCellList (PMMG_coorCell *list,int nitem,double min[3],
 
   return 1;
 }
+
+/**
+ * \param c point coordinates scaled in the unit cube
+ *
+ * \return the index of the point along the Hilbert curve.
+ *
+ * Compute the index of a point along a 3D Hilbert curve with \ref
+ * PMMG_HILBERT_NBITS levels of refinement (J. Skilling, "Programming the
+ * Hilbert curve", AIP Conf. Proc. 707, 2004): coordinates are converted into
+ * the "transposed" Hilbert index whose bits are then interleaved.
+ *
+ */
+uint64_t PMMG_hilbertKey(double c[3]) {
+  uint64_t key;
+  uint32_t X[3],M,P,Q,t,nmax;
+  int      i,j;
+
+  nmax = (1u << PMMG_HILBERT_NBITS) - 1;
+
+  for ( i=0; i<3; ++i ) {
+    if ( c[i] <= 0. )       X[i] = 0;
+    else if ( c[i] >= 1. )  X[i] = nmax;
+    else                    X[i] = (uint32_t)(c[i]*nmax);
+  }
+
+  M = 1u << (PMMG_HILBERT_NBITS-1);
+
+  /* Inverse undo */
+  for ( Q=M; Q>1; Q>>=1 ) {
+    P = Q-1;
+    for ( i=0; i<3; ++i ) {
+      if ( X[i] & Q ) {
+        X[0] ^= P;
+      }
+      else {
+        t     = (X[0] ^ X[i]) & P;
+        X[0] ^= t;
+        X[i] ^= t;
+      }
+    }
+  }
+
+  /* Gray encode */
+  for ( i=1; i<3; ++i ) X[i] ^= X[i-1];
+  t = 0;
+  for ( Q=M; Q>1; Q>>=1 ) {
+    if ( X[2] & Q ) t ^= Q-1;
+  }
+  for ( i=0; i<3; ++i ) X[i] ^= t;
+
+  /* Interleave the bits of the transposed index */
+  key = 0;
+  for ( j=PMMG_HILBERT_NBITS-1; j>=0; --j ) {
+    for ( i=0; i<3; ++i ) {
+      key = (key << 1) | ((X[i] >> j) & 1u);
+    }
+  }
+
+  return key;
+}
+
+/**
+ * \param a  pointer toward a PMMG_hilbertCell structure.
+ * \param b  pointer toward a PMMG_hilbertCell structure.
+ *
+ * \return 1 if a is greater than b, -1 if b is greater than 1, 0 if they are
+ * equals.
+ *
+ * Compare 2 hilbert cells (can be used inside the qsort C fnuction) on their
+ * Hilbert index.
+ *
+ */
+int PMMG_compare_hilbertCell (const void * a, const void * b) {
+  PMMG_hilbertCell *cell1,*cell2;
+
+  cell1 = (PMMG_hilbertCell*)a;
+  cell2 = (PMMG_hilbertCell*)b;
+
+  if ( cell1->key > cell2->key ) return 1;
+  if ( cell1->key < cell2->key ) return -1;
+
+  return 0;
+}
+
+/**
+ * \param list   array of PMMG_coorCell
+ * \param nitem  number of items in the list
+ * \param sorted array of PMMG_hilbertCell (of size nitem) to fill
+ *
+ * \return 1 if success, 0 if fail;
+ *
+ * Scale the coordinates listed in the \a list array (the list is modified) and
+ * fill the \a sorted array with the indices of the items of \a list, sorted
+ * along the Hilbert curve.
+ *
+ */
+int PMMG_hilbertSort_coorCellList (PMMG_coorCell *list,int nitem,
+                                   PMMG_hilbertCell *sorted) {
+  double min[3],max[3],delta;
+  int    i;
+
+  if ( !nitem ) return 1;
+
+  if ( !PMMG_find_coorCellListBoundingBox(list,nitem,min,max,&delta) )
+    return 0;
+
+  if ( delta < MMG5_EPSD ) {
+    /* All the points are at the same location: keep the list order */
+    for ( i=0; i<nitem; ++i ) {
+      sorted[i].key = i;
+      sorted[i].idx = list[i].idx;
+    }
+    return 1;
+  }
+
+  if ( !PMMG_scale_coorCellList(list,nitem,min,max,&delta) )
+    return 0;
+
+  for ( i=0; i<nitem; ++i ) {
+    sorted[i].key = PMMG_hilbertKey(list[i].c);
+    sorted[i].idx = list[i].idx;
+  }
+
+  qsort(sorted,nitem,sizeof(PMMG_hilbertCell),PMMG_compare_hilbertCell);
+
+  return 1;
+}
@@ -48,10 +48,34 @@ typedef struct {
   int     grp;  /*!< a group to which belong the point */
 } PMMG_coorCell;
 
+/**
+ * \def PMMG_HILBERT_NBITS
+ *
+ * Number of bits per space direction used to compute the Hilbert index of a
+ * point (3*PMMG_HILBERT_NBITS must fit in a 64 bits integer)
+ *
+ */
+#define PMMG_HILBERT_NBITS 21
+
+/**
+ * \struct PMMG_hilbertCell
+ *
+ * \brief Cell containing the index of a point on the Hilbert curve and the
+ * point index
+ *
+ */
+typedef struct {
+  uint64_t key; /*!< index of the point along the Hilbert curve */
+  int      idx; /*!< index associated to the point */
+} PMMG_hilbertCell;
+
 
 int PMMG_compare_coorCell (const void * a, const void * b);
 int PMMG_find_coorCellListBoundingBox(PMMG_coorCell*,int,double*,double*,double*);
 int PMMG_scale_coorCellList (PMMG_coorCell*,int,double*,double*,double*);
 int PMMG_unscale_coorCellList (PMMG_coorCell*,int,double*,double*,double);
+uint64_t PMMG_hilbertKey(double c[3]);
+int PMMG_compare_hilbertCell (const void * a, const void * b);
+int PMMG_hilbertSort_coorCellList (PMMG_coorCell*,int,PMMG_hilbertCell*);
 
 #endif
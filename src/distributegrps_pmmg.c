@@ -70,6 +70,9 @@ PMMG_Grp PMMG_assign_grp(PMMG_pGrp group) {
 
   out.flag = group->flag;
 
+  out.gid    = group->gid;
+  out.gidmax = group->gidmax;
+
   return out;
 }
 
@@ -103,6 +106,9 @@ PMMG_Grp PMMG_move_grp(PMMG_pGrp group) {
   group->face2int_face_comm_index1 = NULL;
   group->face2int_face_comm_index2 = NULL;
 
+  group->gid    = NULL;
+  group->gidmax = 0;
+
   return out;
 }
 
@@ -981,7 +987,7 @@ int PMMG_mpisizeof_grp ( PMMG_pGrp grp ) {
   const MMG5_pMesh mesh = grp->mesh;
   const MMG5_pSol  met  = grp->met;
 
-  int k,i,idx;
+  int k,i,j,idx;
 
   idx = 0;
   if ( !grp->mesh ) {
@@ -1073,6 +1079,13 @@ int PMMG_mpisizeof_grp ( PMMG_pGrp grp ) {
   idx += sizeof(int); // met->size;
   idx += sizeof(int); // met->type;
 
+  /** Solution fields info */
+  idx += sizeof(int); // nsols
+  for ( j=0; grp->sol && j<mesh->nsols; ++j ) {
+    idx += sizeof(int); // grp->sol[j].type
+    idx += sizeof(int); // grp->sol[j].size
+  }
+
   /** Communicator sizes */
   idx += sizeof(int); // grp->nitem_int_node_comm;
   idx += sizeof(int); // grp->nitem_int_face_comm;
@@ -1163,6 +1176,15 @@ int PMMG_mpisizeof_grp ( PMMG_pGrp grp ) {
     }
   }
 
+  /** Pack solution fields */
+  idx += mesh->np * PMMG_fields_size(mesh,grp->sol) * sizeof(double);
+
+  /** Pack global indices of vertices */
+  idx += sizeof(int); // (grp->gid ? 1 : 0)
+  if ( grp->gid ) {
+    idx += mesh->np * sizeof(int64_t); // grp->gid[k]
+  }
+
   /** Pack communicators */
   /* Node communicator */
   for ( k=0; k<grp->nitem_int_node_comm; ++k ) {
@@ -1204,7 +1226,7 @@ int PMMG_mpipack_grp ( PMMG_pGrp grp,char **buffer ) {
   const MMG5_pMesh mesh = grp->mesh;
   const MMG5_pSol  met  = grp->met;
 
-  int   k,i,ier,meshin_s,meshout_s,metin_s,metout_s;
+  int   k,i,j,ier,meshin_s,meshout_s,metin_s,metout_s;
   char  *tmp;
 
   ier = 1;
@@ -1319,6 +1341,14 @@ int PMMG_mpipack_grp ( PMMG_pGrp grp,char **buffer ) {
   *( (int *) tmp) = met->size;          tmp += sizeof(int);
   *( (int *) tmp) = met->type;          tmp += sizeof(int);
 
+  /** Solution fields info */
+  *( (int *) tmp) = grp->sol ? mesh->nsols : 0; tmp += sizeof(int);
+  for ( j=0; grp->sol && j<mesh->nsols; ++j ) {
+    assert ( mesh->np == grp->sol[j].np );
+    *( (int *) tmp) = grp->sol[j].type; tmp += sizeof(int);
+    *( (int *) tmp) = grp->sol[j].size; tmp += sizeof(int);
+  }
+
   /** Communicator sizes */
   *( (int *) tmp) = grp->nitem_int_node_comm; tmp += sizeof(int);
   *( (int *) tmp) = grp->nitem_int_face_comm; tmp += sizeof(int);
@@ -1409,6 +1439,24 @@ int PMMG_mpipack_grp ( PMMG_pGrp grp,char **buffer ) {
     }
   }
 
+  /** Pack solution fields */
+  for ( j=0; grp->sol && j<mesh->nsols; ++j ) {
+    for ( k=1; k<=mesh->np; ++k ) {
+      for ( i=0; i<grp->sol[j].size; ++i ) {
+        *( (double *) tmp) = grp->sol[j].m[grp->sol[j].size*k + i];
+        tmp += sizeof(double);
+      }
+    }
+  }
+
+  /** Pack global indices of vertices */
+  *( (int *) tmp) = (grp->gid ? 1 : 0 ); tmp += sizeof(int);
+  if ( grp->gid ) {
+    for ( k=1; k<=mesh->np; ++k ) {
+      *( (int64_t *) tmp) = grp->gid[k]; tmp += sizeof(int64_t);
+    }
+  }
+
   /** Pack communicators */
   /* Node communicator */
   for ( k=0; k<grp->nitem_int_node_comm; ++k ) {
@@ -1456,8 +1504,10 @@ int PMMG_mpiunpack_grp ( PMMG_pParMesh parmesh,PMMG_pGrp grp,char **buffer,
   MMG5_pMesh mesh;
   MMG5_pSol  met;
   double     ddummy;
-  int        k,i,ier,ier_grp,ier_mesh,ier_sol,ier_comm,np,xp,ne,xt;
+  int        k,i,j,ier,ier_grp,ier_mesh,ier_sol,ier_fields,ier_comm,np,xp,ne,xt;
   int        size,ismet,used,idummy,meshin_s,metin_s,meshout_s,metout_s;
+  int        nsols,type,fieldsSize,npfields,isgid;
+  size_t     meshMem;
   int16_t    i16dummy;
   char       cdummy,chaine[256];
 
@@ -1485,6 +1535,8 @@ int PMMG_mpiunpack_grp ( PMMG_pParMesh parmesh,PMMG_pGrp grp,char **buffer,
   ne = *( (int *) *buffer); *buffer += sizeof(int);
   xt = *( (int *) *buffer); *buffer += sizeof(int);
 
+  npfields = np;
+
   if ( ier_grp ) {
     /* Give all the available memory to the mesh */
     mesh->memMax = *memAv;
@@ -1658,6 +1710,19 @@ int PMMG_mpiunpack_grp ( PMMG_pParMesh parmesh,PMMG_pGrp grp,char **buffer,
     /** Set the metric size */
     ier_sol = MMG3D_Set_solSize(mesh,met,MMG5_Vertex,np,met->type);
 
+    /** Solution fields */
+    nsols      = *( (int *) *buffer); *buffer += sizeof(int);
+    fieldsSize = 0;
+    ier_fields = PMMG_fields_init(mesh,&grp->sol,nsols);
+    for ( j=0; j<nsols; ++j ) {
+      type        = *( (int *) *buffer); *buffer += sizeof(int);
+      fieldsSize += *( (int *) *buffer); *buffer += sizeof(int);
+      if ( ier_fields ) {
+        ier_fields = MMG3D_Set_solSize(mesh,&grp->sol[j],MMG5_Vertex,
+                                       mesh->np,type);
+      }
+    }
+
     /* Use exactly the amount of needed memory for this mesh and metric */
     mesh->memMax = mesh->memCur;
 
@@ -1665,11 +1730,20 @@ int PMMG_mpiunpack_grp ( PMMG_pParMesh parmesh,PMMG_pGrp grp,char **buffer,
     *memAv -= mesh->memMax;
 
     ier = MG_MIN ( ier, ier_sol );
+    ier = MG_MIN ( ier, ier_fields );
   }
   else {
-    ier = ier_sol = 0;
+    ier = ier_sol = ier_fields = 0;
     /** Metric type */
     idummy = *( (int *) *buffer); *buffer += sizeof(int);
+
+    /** Solution fields */
+    nsols      = *( (int *) *buffer); *buffer += sizeof(int);
+    fieldsSize = 0;
+    for ( j=0; j<nsols; ++j ) {
+      idummy      = *( (int *) *buffer); *buffer += sizeof(int);
+      fieldsSize += *( (int *) *buffer); *buffer += sizeof(int);
+    }
   }
 
   /** Communicator sizes */
@@ -1851,6 +1925,48 @@ int PMMG_mpiunpack_grp ( PMMG_pParMesh parmesh,PMMG_pGrp grp,char **buffer,
     }
   }
 
+  /** Pack solution fields */
+  if ( ier_fields ) {
+    for ( j=0; j<nsols; ++j ) {
+      size = grp->sol[j].size;
+      for ( k=1; k<=mesh->np; ++k ) {
+        for ( i=0; i<size; ++i ) {
+          grp->sol[j].m[size*k + i] = *( (double *) *buffer);
+          *buffer += sizeof(double);
+        }
+      }
+    }
+  }
+  else {
+    /* The fields can't be allocated */
+    *buffer += npfields * fieldsSize * sizeof(double);
+  }
+
+  /** Pack global indices of vertices */
+  grp->gid    = NULL;
+  grp->gidmax = 0;
+  isgid = *( (int *) *buffer); *buffer += sizeof(int);
+  if ( isgid ) {
+    if ( ier_mesh ) {
+      /* Give the available memory to the mesh for the allocation */
+      meshMem       = mesh->memMax;
+      mesh->memMax += *memAv;
+      PMMG_CALLOC(mesh,grp->gid,mesh->npmax+1,int64_t,"global indices",
+                  ier = 0);
+      mesh->memMax  = mesh->memCur;
+      *memAv       -= ( mesh->memMax - meshMem );
+      grp->gidmax   = grp->gid ? mesh->npmax : 0;
+    }
+    if ( grp->gid ) {
+      for ( k=1; k<=mesh->np; ++k ) {
+        grp->gid[k] = *( (int64_t *) *buffer); *buffer += sizeof(int64_t);
+      }
+    }
+    else {
+      *buffer += npfields * sizeof(int64_t);
+    }
+  }
+
   /** Pack communicators */
   ier_comm = 1;
 
@@ -1915,7 +2031,6 @@ int PMMG_mpiunpack_grp ( PMMG_pParMesh parmesh,PMMG_pGrp grp,char **buffer,
 /**
  * \param parmesh pointer toward the mesh structure.
  * \param recv index of the proc that receive the groups
- * \param interaction_map map of interactions with the other processors
  * \param intcomm_flag flag of the boundary faces of the sended group
  * \param nitem_intcomm_flag size of the incomm_flag array
  * \param recv_ext_idx buffer to receive data
@@ -1933,7 +2048,7 @@ int PMMG_mpiunpack_grp ( PMMG_pParMesh parmesh,PMMG_pGrp grp,char **buffer,
  */
 static inline
 int PMMG_transfer_grps_fromMetoJ(PMMG_pParMesh parmesh,const int recv,
-                                 int *interaction_map,int **intcomm_flag,
+                                 int **intcomm_flag,
                                  int *nitem_intcomm_flag,int **recv_ext_idx,
                                  int *nitem_recv_ext_idx,
                                  PMMG_pExt_comm ext_recv_comm,char **grps2send,
@@ -1973,7 +2088,7 @@ int PMMG_transfer_grps_fromMetoJ(PMMG_pParMesh parmesh,const int recv,
    *  - 6 if it is at the interface of 2 groups that are transfered.
    */
   *nitem_intcomm_flag = int_comm->nitem;
-  PMMG_CALLOC(parmesh,*intcomm_flag,*nitem_intcomm_flag,int,"intcomm_flag",ier=0);
+  PMMG_SCRATCH_CALLOC(parmesh,*intcomm_flag,*nitem_intcomm_flag,int,"intcomm_flag",ier=0);
   count = 0;
 
   if ( *intcomm_flag ) {
@@ -2001,7 +2116,7 @@ int PMMG_transfer_grps_fromMetoJ(PMMG_pParMesh parmesh,const int recv,
   nitem = ext_recv_comm ? ext_recv_comm->nitem : 0;
 
   *nitem_recv_ext_idx = nitem + 1;
-  PMMG_MALLOC(parmesh,*recv_ext_idx,*nitem_recv_ext_idx,int,"recv_ext_idx",ier=0);
+  PMMG_SCRATCH_MALLOC(parmesh,*recv_ext_idx,*nitem_recv_ext_idx,int,"recv_ext_idx",ier=0);
   /* MPI_Recv will fail if recv_ext_idx is not allocated */
   MPI_CHECK( MPI_Recv(*recv_ext_idx,*nitem_recv_ext_idx,MPI_INT,recv,
                       MPI_TRANSFER_GRP_TAG+1,comm,&status), ier=0 );
@@ -2010,8 +2125,8 @@ int PMMG_transfer_grps_fromMetoJ(PMMG_pParMesh parmesh,const int recv,
   offset = 0;
   nitem_recv_intcomm = (*recv_ext_idx)[offset++];
 
-  PMMG_MALLOC(parmesh,send2recv_int_comm,int_comm->nitem,int,"send2recv_int_comm",
-              ier = MG_MIN (ier,0) );
+  PMMG_SCRATCH_MALLOC(parmesh,send2recv_int_comm,int_comm->nitem,int,"send2recv_int_comm",
+                      ier = MG_MIN (ier,0) );
 
   if ( send2recv_int_comm ) {
     for ( k=0; k<int_comm->nitem; ++k ) {
@@ -2179,8 +2294,8 @@ int PMMG_transfer_grps_fromMetoJ(PMMG_pParMesh parmesh,const int recv,
    *   external communicator, the number of faces to add and the list of faces.
    */
   ier0 = 1;
-  PMMG_MALLOC ( parmesh,*trequest,nprocs,MPI_Request,"request_tab",
-                ier0 = 0; ier = MG_MIN(ier,ier0); );
+  PMMG_SCRATCH_MALLOC ( parmesh,*trequest,nprocs,MPI_Request,"request_tab",
+                        ier0 = 0; ier = MG_MIN(ier,ier0); );
   if ( ier0 )
     for ( k=0; k<nprocs; ++k ) {
       (*trequest)[k] = MPI_REQUEST_NULL;
@@ -2197,8 +2312,8 @@ int PMMG_transfer_grps_fromMetoJ(PMMG_pParMesh parmesh,const int recv,
 
     ext_face_comm->nitem_to_share = ext_face_comm->nitem;
 
-    PMMG_MALLOC ( parmesh,ext_face_comm->itosend,ext_face_comm->nitem_to_share,
-                  int,"itosend",ier = MG_MIN(ier,0); );
+    PMMG_SCRATCH_MALLOC ( parmesh,ext_face_comm->itosend,ext_face_comm->nitem_to_share,
+                          int,"itosend",ier = MG_MIN(ier,0); );
 
     if ( *intcomm_flag && ext_face_comm->itosend ) {
       for ( i=0; i<ext_face_comm->nitem; ++i ) {
@@ -2215,11 +2330,10 @@ int PMMG_transfer_grps_fromMetoJ(PMMG_pParMesh parmesh,const int recv,
       }
     }
 
-    if ( interaction_map[ext_face_comm->color_out] ) {
-      MPI_CHECK ( MPI_Isend(ext_face_comm->itosend,ext_face_comm->nitem_to_share,
-                            MPI_INT,ext_face_comm->color_out,MPI_TRANSFER_GRP_TAG+30,
-                            comm,&((*trequest)[ext_face_comm->color_out])), ier=0 );
-    }
+    /* The procs that share faces with myrank update their communicators */
+    MPI_CHECK ( MPI_Isend(ext_face_comm->itosend,ext_face_comm->nitem_to_share,
+                          MPI_INT,ext_face_comm->color_out,MPI_TRANSFER_GRP_TAG+30,
+                          comm,&((*trequest)[ext_face_comm->color_out])), ier=0 );
   }
 
   PMMG_REALLOC ( parmesh,*recv_ext_idx,*nitem_recv_ext_idx+1+2*nextcomm+count,
@@ -2287,8 +2401,8 @@ int PMMG_transfer_grps_fromMetoJ(PMMG_pParMesh parmesh,const int recv,
   }
 
   /* Pack the groups */
-  PMMG_MALLOC ( parmesh,*grps2send,*pack_size,char,"grps2send",
-                ier = MG_MIN(ier,0) );
+  PMMG_SCRATCH_MALLOC ( parmesh,*grps2send,*pack_size,char,"grps2send",
+                        ier = MG_MIN(ier,0) );
 
   ptr = *grps2send;
   for ( k=0; k<ngrp; ++k ) {
@@ -2319,7 +2433,6 @@ int PMMG_transfer_grps_fromMetoJ(PMMG_pParMesh parmesh,const int recv,
 /**
  * \param parmesh pointer toward the mesh structure.
  * \param sndr index of the proc that send the groups
- * \param interaction_map map of interactions with the other processors
  * \param intcomm_flag position in the internal comm of the faces of the
  * external comm sndr-recv
  * \param nitem_intcomm_flag size of the incomm_flag array
@@ -2335,7 +2448,7 @@ int PMMG_transfer_grps_fromMetoJ(PMMG_pParMesh parmesh,const int recv,
  */
 static inline
 int PMMG_transfer_grps_fromItoMe(PMMG_pParMesh parmesh,const int sndr,
-                                 int *interaction_map,int **intcomm_flag,
+                                 int **intcomm_flag,
                                  int *nitem_intcomm_flag,int **recv_ext_idx,
                                  int *nitem_recv_ext_idx,
                                  PMMG_pExt_comm ext_send_comm,
@@ -2365,8 +2478,8 @@ int PMMG_transfer_grps_fromItoMe(PMMG_pParMesh parmesh,const int sndr,
   /** Step 1: build the send2recv_int_comm array that gives the new
       face2int_face_comm_index pointer for the received group */
   *nitem_intcomm_flag = ext_send_comm ? ext_send_comm->nitem + 1 : 1;
-  PMMG_MALLOC ( parmesh,(*intcomm_flag),*nitem_intcomm_flag,int,"intcomm_flag",
-                *nitem_intcomm_flag = 1;ier = 0 );
+  PMMG_SCRATCH_MALLOC ( parmesh,(*intcomm_flag),*nitem_intcomm_flag,int,"intcomm_flag",
+                        *nitem_intcomm_flag = 1;ier = 0 );
 
   if ( *intcomm_flag ) {
     (*intcomm_flag)[0] = parmesh->int_face_comm->nitem;
@@ -2388,8 +2501,8 @@ int PMMG_transfer_grps_fromItoMe(PMMG_pParMesh parmesh,const int sndr,
   MPI_CHECK ( MPI_Probe(sndr,MPI_TRANSFER_GRP_TAG+3,comm,&status), ier = 0 );
   MPI_CHECK ( MPI_Get_count(&status,MPI_INT,nitem_recv_ext_idx), ier = 0 );
 
-  PMMG_MALLOC ( parmesh,*recv_ext_idx,*nitem_recv_ext_idx,int,"recv_ext_idx",
-                ier = 0 );
+  PMMG_SCRATCH_MALLOC ( parmesh,*recv_ext_idx,*nitem_recv_ext_idx,int,"recv_ext_idx",
+                        ier = 0 );
 
   MPI_CHECK ( MPI_Recv(*recv_ext_idx,*nitem_recv_ext_idx,MPI_INT,sndr,MPI_TRANSFER_GRP_TAG+3,comm,&status),
               ier = 0 );
@@ -2536,7 +2649,7 @@ int PMMG_transfer_grps_fromItoMe(PMMG_pParMesh parmesh,const int sndr,
   MPI_CHECK ( MPI_Probe(sndr,MPI_SENDGRP_TAG,comm,&status), ier = 0 );
   MPI_CHECK ( MPI_Get_count(&status,MPI_CHAR,&pack_size), ier = 0 );
 
-  PMMG_MALLOC ( parmesh,buffer,pack_size,char,"buffer", ier = 0 );
+  PMMG_SCRATCH_MALLOC ( parmesh,buffer,pack_size,char,"buffer", ier = 0 );
 
   MPI_CHECK ( MPI_Recv(buffer,pack_size,MPI_CHAR,sndr,MPI_SENDGRP_TAG,comm,&status),
               ier = 0 );
@@ -2591,17 +2704,18 @@ int PMMG_transfer_grps_fromItoMe(PMMG_pParMesh parmesh,const int sndr,
  * \param parmesh pointer toward the mesh structure.
  * \param sndr index of the proc that send the groups
  * \param recv index of the proc that receive the groups
- * \param interaction_map map of interactions with the other processors
  *
  * \return 0 if fail, 1 if we success
  *
  * Transfer and update the data that are modified due to the transfer of the
- * groups from the proc \a sndr toward the proc \a recv.
+ * groups from the proc \a sndr toward the proc \a recv. Only \a sndr, \a recv
+ * and the procs that share faces with \a sndr take part to the transfer, the
+ * other procs return immediately.
  *
  */
 static inline
 int PMMG_transfer_grps_fromItoJ(PMMG_pParMesh parmesh,const int sndr,
-                                const int recv,int *interaction_map) {
+                                const int recv) {
 
   PMMG_pExt_comm ext_face_comm,ext_send_comm,ext_recv_comm;
   MPI_Status     status;
@@ -2617,16 +2731,6 @@ int PMMG_transfer_grps_fromItoJ(PMMG_pParMesh parmesh,const int sndr,
 
   assert ( sndr != recv );
 
-  /* I am the receiver and I don't have any interactions with the sender */
-  if ( ( recv == myrank ) && !interaction_map[sndr] ) return 1;
-
-  /* I am the sender and I don't have any interactions with the receiver */
-  if ( ( sndr == myrank ) && !interaction_map[sndr] ) return 1;
-
-  /* I am neither the sender nor the receiver and I don't have any interactions
-   * with the sender */
-  if ( ( sndr != myrank ) && ( recv != myrank )  && !interaction_map[sndr] ) return 1;
-
   ier = 1;
 
   /** Step 1: find the myrank-sndr and myrank-recv external communicators */
@@ -2642,6 +2746,11 @@ int PMMG_transfer_grps_fromItoJ(PMMG_pParMesh parmesh,const int sndr,
       ext_recv_comm = ext_face_comm;
   }
 
+  /* I am neither the sender nor the receiver and I don't share any face with
+   * the sender: my communicators are not modified by the transfer */
+  if ( ( sndr != myrank ) && ( recv != myrank ) &&
+       !( ext_send_comm && ext_send_comm->nitem > 0 ) ) return 1;
+
 
   /** Step 2: transfer and update the data */
   nitem_intcomm_flag = 0;
@@ -2652,7 +2761,7 @@ int PMMG_transfer_grps_fromItoJ(PMMG_pParMesh parmesh,const int sndr,
 
   if ( myrank == sndr ) {
     /* j = recv */
-    ier = PMMG_transfer_grps_fromMetoJ(parmesh,recv,interaction_map,
+    ier = PMMG_transfer_grps_fromMetoJ(parmesh,recv,
                                        &intcomm_flag,&nitem_intcomm_flag,
                                        &recv_ext_idx,&nitem_recv_ext_idx,
                                        ext_recv_comm,&grps2send,&pack_size,
@@ -2660,7 +2769,7 @@ int PMMG_transfer_grps_fromItoJ(PMMG_pParMesh parmesh,const int sndr,
   }
   else if ( myrank == recv ) {
     /* i = sndr */
-    ier = PMMG_transfer_grps_fromItoMe(parmesh,sndr,interaction_map,
+    ier = PMMG_transfer_grps_fromItoMe(parmesh,sndr,
                                        &intcomm_flag,&nitem_intcomm_flag,
                                        &recv_ext_idx,&nitem_recv_ext_idx,
                                        ext_send_comm,&irequest);
@@ -2674,8 +2783,8 @@ int PMMG_transfer_grps_fromItoJ(PMMG_pParMesh parmesh,const int sndr,
     nitem_recv_ext_idx = 0;
     if ( ext_send_comm && ext_send_comm->nitem > 0 ) {
       nitem_recv_ext_idx = ext_send_comm->nitem;
-      PMMG_MALLOC(parmesh,recv_ext_idx,nitem_recv_ext_idx,int,"recv_ext_idx",
-                  ier=0);
+      PMMG_SCRATCH_MALLOC(parmesh,recv_ext_idx,nitem_recv_ext_idx,int,"recv_ext_idx",
+                          ier=0);
       MPI_CHECK( MPI_Recv( recv_ext_idx,nitem_recv_ext_idx,MPI_INT,sndr,
                            MPI_TRANSFER_GRP_TAG+30,parmesh->comm,&status ),
                  ier = MG_MIN(ier,0) );
@@ -2811,13 +2920,14 @@ int PMMG_transfer_grps_fromItoJ(PMMG_pParMesh parmesh,const int sndr,
 int PMMG_transfer_all_grps(PMMG_pParMesh parmesh,idx_t *part) {
   MPI_Comm       comm;
   int            myrank,nprocs;
-  int            *interaction_map;
+  int            *ndest,*dest_displs,*dest,*mydest,nmydest;
+  int8_t         *isdest;
   int            *send_grps,*recv_grps,*nfaces2send,*nfaces2recv;
   int            *next_comm2send,*ext_comms_next_idx,*nitems2send;
   int            *extComm_next_idx,*items_next_idx,*recv_array;
   int            *extComm_grpFaces2extComm,*extComm_grpFaces2face2int;
   int            max_ngrp;
-  int            ier,ier_glob,k,j,err;
+  int            ier,ier_glob,k,j,i,err,intrace;
 
   myrank    = parmesh->myrank;
   nprocs    = parmesh->nprocs;
@@ -2836,7 +2946,11 @@ int PMMG_transfer_all_grps(PMMG_pParMesh parmesh,idx_t *part) {
   extComm_grpFaces2extComm  = NULL;
   extComm_grpFaces2face2int = NULL;
   recv_array                = NULL;
-  interaction_map           = NULL;
+  ndest                     = NULL;
+  dest_displs               = NULL;
+  dest                      = NULL;
+  mydest                    = NULL;
+  isdest                    = NULL;
 
   /** Step 1: Merge all the groups that must be sended to a given proc into 1
    * group */
@@ -2883,24 +2997,69 @@ int PMMG_transfer_all_grps(PMMG_pParMesh parmesh,idx_t *part) {
 
   /** Step 3:
    *
-   * Compute the map of interactions: each proc interacts with all the other
-   * procs (worst case)
+   * Compute the sparse graph of the group transfers: the procs toward which
+   * the proc k sends groups are stored (by increasing rank) in
+   * dest[dest_displs[k]:dest_displs[k+1]-1].
    *
    */
-//#warning add interaction map
-  ier = 0;
-  PMMG_CALLOC(parmesh,interaction_map,nprocs,int,"interaction_map",goto end);
+  ier = 1;
+  PMMG_SCRATCH_CALLOC(parmesh,ndest,nprocs,int,"ndest",ier = 0);
+  PMMG_SCRATCH_CALLOC(parmesh,dest_displs,nprocs+1,int,"dest_displs",ier = 0);
+  PMMG_SCRATCH_CALLOC(parmesh,isdest,nprocs,int8_t,"isdest",ier = 0);
+  PMMG_SCRATCH_MALLOC(parmesh,mydest,parmesh->ngrp+1,int,"mydest",ier = 0);
+
+  nmydest = 0;
+  if ( ier ) {
+    for ( k=0; k<parmesh->ngrp; ++k ) {
+      j = parmesh->listgrp[k].flag;
+      if ( j != myrank ) isdest[j] = 1;
+    }
+    for ( j=0; j<nprocs; ++j ) {
+      if ( isdest[j] ) mydest[nmydest++] = j;
+    }
+  }
+
+  MPI_Allreduce( &ier, &ier_glob, 1, MPI_INT, MPI_MIN, comm);
+  if ( !ier_glob ) {
+    fprintf(stderr,"\n  ## Error: %s: unable to allocate the graph of the"
+            " group transfers.\n",__func__);
+    ier = -1;
+    goto end;
+  }
+
+  MPI_CHECK( MPI_Allgather(&nmydest,1,MPI_INT,ndest,1,MPI_INT,comm),
+             ier = -1; goto end );
+
   for ( k=0; k<nprocs; ++k ) {
-    interaction_map[k] = 1;
+    dest_displs[k+1] = dest_displs[k] + ndest[k];
   }
 
-  /** Step 4: proc k send its data (group and/or communicators), proc j receive
-   * data */
+  PMMG_SCRATCH_MALLOC(parmesh,dest,dest_displs[nprocs]+1,int,"dest",ier = 0);
+  MPI_Allreduce( &ier, &ier_glob, 1, MPI_INT, MPI_MIN, comm);
+  if ( !ier_glob ) {
+    fprintf(stderr,"\n  ## Error: %s: unable to allocate the graph of the"
+            " group transfers.\n",__func__);
+    ier = -1;
+    goto end;
+  }
+
+  MPI_CHECK( MPI_Allgatherv(mydest,nmydest,MPI_INT,
+                            dest,ndest,dest_displs,MPI_INT,comm),
+             ier = -1; goto end );
+
+  /** Step 4: for each edge k->j of the graph, proc k send its data (group
+   * and/or communicators), proc j receive data and the procs that share faces
+   * with proc k update their communicators. All the procs process the edges
+   * in the same order but only wait for the transfers in which they take
+   * part: the transfers between distinct procs are performed concurrently. */
   ier = 1;
   for ( k=0; k<nprocs; ++k ) {
-    for ( j=0; j<nprocs; ++j ) {
-      if ( j==k ) continue;
-      err =  PMMG_transfer_grps_fromItoJ(parmesh,k,j,interaction_map);
+    for ( i=dest_displs[k]; i<dest_displs[k+1]; ++i ) {
+      /* Only the sender and the receiver trace the transfer */
+      intrace = ( myrank == k || myrank == dest[i] );
+      if ( intrace ) PMMG_TRACE_BEGIN_ARGS( "transfer groups","from",k,"to",dest[i] );
+      err =  PMMG_transfer_grps_fromItoJ(parmesh,k,dest[i]);
+      if ( intrace ) PMMG_TRACE_END( "transfer groups" );
       ier = MG_MIN ( ier,err );
     }
   }
@@ -2914,7 +3073,10 @@ int PMMG_transfer_all_grps(PMMG_pParMesh parmesh,idx_t *part) {
   }
 
   /** Step 6: Node communicators reconstruction from the face ones */
-  if ( !PMMG_build_nodeCommFromFaces(parmesh) ) {
+  PMMG_TRACE_BEGIN( "build node comms" );
+  ier = PMMG_build_nodeCommFromFaces(parmesh);
+  PMMG_TRACE_END( "build node comms" );
+  if ( !ier ) {
     fprintf(stderr,"\n  ## Unable to build the new node communicators from"
             " the face ones.\n");
     ier = -1;
@@ -2933,8 +3095,11 @@ int PMMG_transfer_all_grps(PMMG_pParMesh parmesh,idx_t *part) {
   if ( !err )  ier = 1;
 
 end:
-  if ( interaction_map )
-    PMMG_DEL_MEM(parmesh,interaction_map,int,"interaction_map");
+  PMMG_DEL_MEM(parmesh,ndest,int,"ndest");
+  PMMG_DEL_MEM(parmesh,dest_displs,int,"dest_displs");
+  PMMG_DEL_MEM(parmesh,dest,int,"dest");
+  PMMG_DEL_MEM(parmesh,mydest,int,"mydest");
+  PMMG_DEL_MEM(parmesh,isdest,int8_t,"isdest");
   if ( send_grps )
     PMMG_DEL_MEM(parmesh,send_grps,int,"send_grps");
   if ( recv_grps )
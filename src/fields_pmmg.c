@@ -0,0 +1,257 @@
+/* =============================================================================
+**  This file is part of the parmmg software package for parallel tetrahedral
+**  mesh modification.
+**  Copyright (c) Bx INP/Inria/UBordeaux, 2017-
+**
+**  parmmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  parmmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with parmmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the parmmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/**
+ * \file fields_pmmg.c
+ * \brief Functions to carry the user solution fields with the mesh vertices.
+ * \author Cécile Dobrzynski (Bx INP/Inria)
+ * \author Algiane Froehly (Inria)
+ * \author Luca Cirrottola (Inria)
+ * \version 1
+ * \copyright GNU Lesser General Public License.
+ *
+ * The solution fields of a group are stored in the \a grp->sol array of
+ * \a mesh->nsols solution structures (the array is NULL if the mesh has no
+ * fields). All the fields are defined at the mesh vertices.
+ *
+ */
+#include "parmmg.h"
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param field pointer toward the array of solution fields.
+ *
+ * \return the number of double values stored at each vertex by all the fields.
+ *
+ */
+int PMMG_fields_size( MMG5_pMesh mesh,MMG5_pSol field ) {
+  int j,size;
+
+  size = 0;
+  if ( !field ) return size;
+
+  for ( j=0; j<mesh->nsols; ++j ) {
+    size += field[j].size;
+  }
+  return size;
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param field pointer toward the array of solution fields (allocated).
+ * \param nsols number of solution fields.
+ *
+ * \return 0 if fail, 1 if success
+ *
+ * Allocate an array of \a nsols empty solution fields for the mesh.
+ *
+ */
+int PMMG_fields_init( MMG5_pMesh mesh,MMG5_pSol *field,int nsols ) {
+  int j;
+
+  *field      = NULL;
+  mesh->nsols = 0;
+
+  if ( !nsols ) return 1;
+
+  PMMG_CALLOC(mesh,*field,nsols,MMG5_Sol,"solution fields",return 0);
+  mesh->nsols = nsols;
+
+  for ( j=0; j<nsols; ++j ) {
+    (*field)[j].ver = 2;
+    (*field)[j].dim = 3;
+  }
+
+  return 1;
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param field pointer toward the array of solution fields (allocated).
+ * \param meshRef pointer toward the reference mesh.
+ * \param fieldRef pointer toward the reference array of solution fields.
+ * \param np number of vertices of the fields (at least 1 to force the
+ * allocation).
+ *
+ * \return 0 if fail, 1 if success
+ *
+ * Allocate the solution fields of the mesh with the same number, types and
+ * file names as the fields of the reference mesh. The fields are allocated at
+ * the size of the point array of \a mesh.
+ *
+ */
+int PMMG_fields_copyStructure( MMG5_pMesh mesh,MMG5_pSol *field,
+                               MMG5_pMesh meshRef,MMG5_pSol fieldRef,int np ) {
+  MMG5_pSol psl,pslRef;
+  int       j;
+
+  if ( !fieldRef ) {
+    *field      = NULL;
+    mesh->nsols = 0;
+    return 1;
+  }
+
+  if ( !PMMG_fields_init( mesh,field,meshRef->nsols ) ) return 0;
+
+  for ( j=0; j<mesh->nsols; ++j ) {
+    psl    = *field + j;
+    pslRef = fieldRef + j;
+
+    if ( pslRef->namein && !MMG5_Set_inputSolName( mesh,psl,pslRef->namein ) )
+      return 0;
+    if ( pslRef->nameout && !MMG5_Set_outputSolName( mesh,psl,pslRef->nameout ) )
+      return 0;
+
+    if ( !MMG3D_Set_solSize( mesh,psl,MMG5_Vertex,np,pslRef->type ) )
+      return 0;
+  }
+
+  return 1;
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param field pointer toward the array of solution fields.
+ * \param npmax new maximal number of vertices of the fields.
+ *
+ * \return 0 if fail, 1 if success
+ *
+ * Reallocate the solution fields to store \a npmax vertices (fields that
+ * have been deallocated are allocated again).
+ *
+ */
+int PMMG_fields_resize( MMG5_pMesh mesh,MMG5_pSol field,int npmax ) {
+  MMG5_pSol psl;
+  int       j;
+
+  if ( !field ) return 1;
+
+  for ( j=0; j<mesh->nsols; ++j ) {
+    psl = field + j;
+    if ( psl->m && psl->npmax == npmax ) continue;
+
+    if ( psl->m ) {
+      PMMG_REALLOC(mesh,psl->m,psl->size*(npmax+1),psl->size*(psl->npmax+1),
+                   double,"solution field",return 0);
+    }
+    else {
+      PMMG_CALLOC(mesh,psl->m,psl->size*(npmax+1),double,"solution field",
+                  return 0);
+    }
+    psl->npmax = npmax;
+    psl->np    = MG_MIN(psl->np,npmax);
+    psl->npi   = psl->np;
+  }
+
+  return 1;
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param field pointer toward the array of solution fields.
+ * \param np number of vertices.
+ *
+ * Set the number of vertices of the solution fields.
+ *
+ */
+void PMMG_fields_setNp( MMG5_pMesh mesh,MMG5_pSol field,int np ) {
+  int j;
+
+  if ( !field ) return;
+
+  for ( j=0; j<mesh->nsols; ++j ) {
+    assert ( np <= field[j].npmax );
+    field[j].np  = np;
+    field[j].npi = np;
+  }
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param field pointer toward the array of solution fields to fill.
+ * \param ip index of the vertex to fill.
+ * \param fieldRef pointer toward the array of solution fields to copy.
+ * \param ipRef index of the vertex to copy.
+ *
+ * Copy the values of all the solution fields at the vertex \a ipRef of
+ * \a fieldRef into the vertex \a ip of \a field (both arrays have the same
+ * number and types of fields).
+ *
+ */
+void PMMG_fields_copyPoint( MMG5_pMesh mesh,MMG5_pSol field,int ip,
+                            MMG5_pSol fieldRef,int ipRef ) {
+  int j,size;
+
+  if ( !field ) return;
+
+  for ( j=0; j<mesh->nsols; ++j ) {
+    size = field[j].size;
+    assert ( size == fieldRef[j].size );
+    memcpy(&field[j].m[size*ip],&fieldRef[j].m[size*ipRef],size*sizeof(double));
+  }
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param field pointer toward the array of solution fields.
+ * \param ip index of the vertex.
+ * \param buf buffer of size \ref PMMG_fields_size (filled).
+ *
+ * Store contiguously the values of all the solution fields at the vertex \a ip.
+ *
+ */
+void PMMG_fields_packPoint( MMG5_pMesh mesh,MMG5_pSol field,int ip,
+                            double *buf ) {
+  int j,size;
+
+  if ( !field ) return;
+
+  for ( j=0; j<mesh->nsols; ++j ) {
+    size = field[j].size;
+    memcpy(buf,&field[j].m[size*ip],size*sizeof(double));
+    buf += size;
+  }
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param field pointer toward the array of solution fields (filled).
+ * \param ip index of the vertex.
+ * \param buf buffer filled by \ref PMMG_fields_packPoint.
+ *
+ * Set the values of all the solution fields at the vertex \a ip from a
+ * contiguous buffer.
+ *
+ */
+void PMMG_fields_unpackPoint( MMG5_pMesh mesh,MMG5_pSol field,int ip,
+                              const double *buf ) {
+  int j,size;
+
+  if ( !field ) return;
+
+  for ( j=0; j<mesh->nsols; ++j ) {
+    size = field[j].size;
+    memcpy(&field[j].m[size*ip],buf,size*sizeof(double));
+    buf += size;
+  }
+}
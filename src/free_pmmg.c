@@ -85,6 +85,16 @@ void PMMG_grp_free( PMMG_pParMesh parmesh, PMMG_pGrp grp )
                               &grp->face2int_face_comm_index1,
                               &grp->face2int_face_comm_index2,
                               &grp->nitem_int_face_comm);
+  PMMG_gid_free(grp->mesh,grp);
+
+  if ( grp->disp ) {
+    PMMG_DEL_MEM(grp->mesh,grp->disp->m,double,"displacement");
+    PMMG_DEL_MEM(grp->mesh,grp->disp,MMG5_Sol,"displacement");
+  }
+
+  /* The mesh arrays are freed by Mmg */
+  PMMG_memprof_releaseMesh(grp->mesh,grp->met,grp->mesh->nsols ? grp->sol : NULL);
+
   if (grp->mesh->nsols)
     MMG3D_Free_all( MMG5_ARG_start,
                     MMG5_ARG_ppMesh, &grp->mesh,
@@ -105,6 +115,8 @@ void PMMG_grp_free( PMMG_pParMesh parmesh, PMMG_pGrp grp )
  */
 void PMMG_parmesh_Free_Comm( PMMG_pParMesh parmesh )
 {
+  PMMG_halo_free( parmesh );
+
   PMMG_parmesh_int_comm_free( parmesh, parmesh->int_node_comm );
   PMMG_DEL_MEM(parmesh, parmesh->int_node_comm, PMMG_Int_comm, "int node comm");
   PMMG_parmesh_int_comm_free( parmesh, parmesh->int_edge_comm );
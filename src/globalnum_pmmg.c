@@ -0,0 +1,357 @@
+/* =============================================================================
+**  This file is part of the parmmg software package for parallel tetrahedral
+**  mesh modification.
+**  Copyright (c) Bx INP/Inria/UBordeaux, 2017-
+**
+**  parmmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  parmmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with parmmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the parmmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/**
+ * \file globalnum_pmmg.c
+ * \brief Persistent global indices of the mesh vertices.
+ * \author Cécile Dobrzynski (Bx INP/Inria)
+ * \author Algiane Froehly (Inria)
+ * \author Luca Cirrottola (Inria)
+ * \version 1
+ * \copyright GNU Lesser General Public License.
+ *
+ * Each vertex of a group carries a 64 bits global index stored in the
+ * \a grp->gid array (\a grp->gidmax+1 items, NULL if the indices are not
+ * tracked). The copies of a vertex shared by several groups or processes have
+ * the same index. The indices are computed once before the first remeshing
+ * iteration, then they follow the vertices through the group splits, merges
+ * and transfers. After a remeshing, the parallel vertices (frozen by Mmg)
+ * keep their indices and the other vertices receive new indices from a
+ * per-process range (\a parmesh->gid_next, incremented by the number of
+ * processes) so no communication is needed.
+ *
+ */
+#include "globalnum_pmmg.h"
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param grp pointer toward the group.
+ * \param grpRef pointer toward the reference group.
+ *
+ * \return 0 if fail, 1 if success
+ *
+ * Allocate the global indices of the group at the size of its point array if
+ * the reference group tracks them.
+ *
+ */
+int PMMG_gid_copyStructure( MMG5_pMesh mesh,PMMG_pGrp grp,PMMG_pGrp grpRef ) {
+
+  grp->gid    = NULL;
+  grp->gidmax = 0;
+
+  if ( !grpRef->gid ) return 1;
+
+  PMMG_CALLOC(mesh,grp->gid,mesh->npmax+1,int64_t,"global indices",return 0);
+  grp->gidmax = mesh->npmax;
+
+  return 1;
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param grp pointer toward the group.
+ * \param npmax new maximal number of vertices.
+ *
+ * \return 0 if fail, 1 if success
+ *
+ * Reallocate the global indices of the group to store \a npmax vertices (new
+ * items are set to 0).
+ *
+ */
+int PMMG_gid_resize( MMG5_pMesh mesh,PMMG_pGrp grp,int npmax ) {
+
+  if ( !grp->gid || grp->gidmax == npmax ) return 1;
+
+  PMMG_RECALLOC(mesh,grp->gid,npmax+1,grp->gidmax+1,int64_t,"global indices",
+                return 0);
+  grp->gidmax = npmax;
+
+  return 1;
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param grp pointer toward the group.
+ *
+ * Deallocate the global indices of the group.
+ *
+ */
+void PMMG_gid_free( MMG5_pMesh mesh,PMMG_pGrp grp ) {
+
+  if ( grp->gid ) {
+    PMMG_DEL_MEM(mesh,grp->gid,int64_t,"global indices");
+  }
+  grp->gidmax = 0;
+}
+
+/**
+ * \param grp pointer toward the group to fill.
+ * \param ip index of the vertex to fill.
+ * \param grpRef pointer toward the group to copy.
+ * \param ipRef index of the vertex to copy.
+ *
+ * Copy the global index of the vertex \a ipRef of \a grpRef into the vertex
+ * \a ip of \a grp.
+ *
+ */
+void PMMG_gid_copyPoint( PMMG_pGrp grp,int ip,PMMG_pGrp grpRef,int ipRef ) {
+
+  if ( !grp->gid || !grpRef->gid ) return;
+
+  assert ( ip <= grp->gidmax && ipRef <= grpRef->gidmax );
+  grp->gid[ip] = grpRef->gid[ipRef];
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param grp pointer toward the group.
+ * \param permNodGlob node permutation (new index of the old vertex k).
+ * \param np number of vertices before the renumbering.
+ *
+ * \return 0 if fail, 1 if success
+ *
+ * Permute the global indices after the renumbering of the mesh vertices.
+ *
+ */
+int PMMG_gid_permute( MMG5_pMesh mesh,PMMG_pGrp grp,int *permNodGlob,int np ) {
+  int64_t *gid;
+  int     k;
+
+  if ( !grp->gid || !permNodGlob ) return 1;
+
+  PMMG_CALLOC(mesh,gid,grp->gidmax+1,int64_t,"permuted global indices",
+              return 0);
+  for ( k=1; k<=np; ++k ) {
+    assert ( permNodGlob[k] <= grp->gidmax );
+    gid[permNodGlob[k]] = grp->gid[k];
+  }
+  PMMG_DEL_MEM(mesh,grp->gid,int64_t,"global indices");
+  grp->gid = gid;
+
+  return 1;
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param grp pointer toward the group.
+ *
+ * Move the global indices at the pack index of the vertices, stored in the tmp
+ * field of the points (see \ref MMG3D_mark_packedPoints).
+ *
+ */
+void PMMG_gid_pack( MMG5_pMesh mesh,PMMG_pGrp grp ) {
+  MMG5_pPoint ppt;
+  int         k;
+
+  if ( !grp->gid ) return;
+
+  /* The pack index is never larger than the current one */
+  for ( k=1; k<=mesh->np; ++k ) {
+    ppt = &mesh->point[k];
+    if ( !MG_VOK(ppt) ) continue;
+
+    assert ( ppt->tmp && ppt->tmp <= k );
+    grp->gid[ppt->tmp] = grp->gid[k];
+  }
+}
+
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ *
+ * \return 0 if fail, 1 if success
+ *
+ * Compute the initial global indices of the vertices from the global numbering
+ * of the parallel mesh (only one group per process) and initialize the range
+ * of the indices given to the new vertices.
+ *
+ */
+int PMMG_gid_init( PMMG_pParMesh parmesh ) {
+  PMMG_pGrp  grp;
+  MMG5_pMesh mesh;
+  size_t     available,oldMemMax;
+  int        *glonum,nowned,offset,nglob,ip,ier;
+
+  assert ( parmesh->ngrp == 1 );
+  grp  = &parmesh->listgrp[0];
+  mesh = grp->mesh;
+
+  PMMG_gid_free( mesh,grp );
+
+  glonum = NULL;
+  PMMG_MALLOC(parmesh,glonum,mesh->np+1,int,"glonum",ier = 0);
+  if ( glonum ) {
+    ier = PMMG_compute_verticesGloNum(parmesh,glonum,&nowned,&offset,&nglob);
+  }
+  MPI_CHECK( MPI_Allreduce(MPI_IN_PLACE,&ier,1,MPI_INT,MPI_MIN,parmesh->comm),
+             ier = 0 );
+  if ( !ier ) {
+    PMMG_DEL_MEM(parmesh,glonum,int,"glonum");
+    return 0;
+  }
+
+  /* The indices are counted on the mesh memory as the other point arrays */
+  PMMG_TRANSFER_AVMEM_TO_PARMESH(parmesh,available,oldMemMax);
+  PMMG_TRANSFER_AVMEM_FROM_PMESH_TO_MESH(parmesh,mesh,available,oldMemMax);
+
+  PMMG_CALLOC(mesh,grp->gid,mesh->npmax+1,int64_t,"global indices",ier = 0);
+  if ( ier ) {
+    grp->gidmax = mesh->npmax;
+    for ( ip=1; ip<=mesh->np; ++ip ) {
+      grp->gid[ip] = (int64_t)glonum[ip];
+    }
+  }
+
+  PMMG_TRANSFER_AVMEM_FROM_MESH_TO_PMESH(parmesh,mesh,available,oldMemMax);
+  PMMG_DEL_MEM(parmesh,glonum,int,"glonum");
+
+  /* New vertices are numbered after the initial ones, in a strided range */
+  parmesh->gid_next = (int64_t)nglob + 1 + parmesh->myrank;
+
+  return ier;
+}
+
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ *
+ * \return 0 if fail, 1 if success
+ *
+ * Update the global indices after the remeshing of the groups: the parallel
+ * vertices keep their index and the other vertices (that may have been
+ * created, or inserted in the slot of a deleted vertex) receive a new index
+ * from the range of the process. Must be called sequentially.
+ *
+ */
+int PMMG_gid_update( PMMG_pParMesh parmesh ) {
+  PMMG_pGrp   grp;
+  MMG5_pMesh  mesh;
+  MMG5_pPoint ppt;
+  int         igrp,ip;
+
+  for ( igrp=0; igrp<parmesh->ngrp; ++igrp ) {
+    grp  = &parmesh->listgrp[igrp];
+    mesh = grp->mesh;
+
+    if ( !mesh || !grp->gid ) continue;
+
+    assert ( grp->gidmax == mesh->npmax );
+
+    for ( ip=1; ip<=mesh->np; ++ip ) {
+      ppt = &mesh->point[ip];
+      if ( !MG_VOK(ppt) ) {
+        grp->gid[ip] = 0;
+        continue;
+      }
+      if ( (ppt->tag & MG_PARBDY) && grp->gid[ip] > 0 ) continue;
+
+      grp->gid[ip]       = parmesh->gid_next;
+      parmesh->gid_next += parmesh->nprocs;
+    }
+  }
+
+  return 1;
+}
+
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ *
+ * \return 1 if all the groups track the global indices of their vertices,
+ * 0 otherwise.
+ *
+ */
+int PMMG_gid_isTracked( PMMG_pParMesh parmesh ) {
+  int igrp;
+
+  if ( !parmesh->ngrp ) return 0;
+
+  for ( igrp=0; igrp<parmesh->ngrp; ++igrp ) {
+    if ( parmesh->listgrp[igrp].mesh && !parmesh->listgrp[igrp].gid ) return 0;
+  }
+  return 1;
+}
+
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ * \param hash pointer toward the hash table.
+ * \param nitem maximal number of keys stored in the table.
+ *
+ * \return 0 if fail, 1 if success
+ *
+ * Allocate a hash table for \a nitem global indices (with a load factor lower
+ * than 1/2).
+ *
+ */
+int PMMG_hashGid_new( PMMG_pParMesh parmesh,PMMG_HGid *hash,int nitem ) {
+
+  hash->siz = 16;
+  while ( hash->siz < 2*nitem ) hash->siz *= 2;
+
+  hash->val = NULL;
+  PMMG_CALLOC(parmesh,hash->key,hash->siz,int64_t,"gid hash keys",return 0);
+  PMMG_MALLOC(parmesh,hash->val,hash->siz,int,"gid hash values",
+              PMMG_DEL_MEM(parmesh,hash->key,int64_t,"gid hash keys");
+              return 0);
+
+  return 1;
+}
+
+/**
+ * \param hash pointer toward the hash table.
+ * \param key global index (strictly positive).
+ * \param val value to associate to the key if it is not yet stored.
+ *
+ * \return the value associated to \a key (\a val if the key is new).
+ *
+ * Search the global index \a key in the table and add it if it is missing
+ * (linear probing).
+ *
+ */
+int PMMG_hashGid_getOrAdd( PMMG_HGid *hash,int64_t key,int val ) {
+  uint64_t h;
+
+  assert ( key > 0 );
+
+  h = ( (uint64_t)key * 0x9E3779B97F4A7C15ULL ) >> 32;
+  h &= (uint64_t)(hash->siz-1);
+
+  while ( hash->key[h] ) {
+    if ( hash->key[h] == key ) return hash->val[h];
+    h = ( h+1 ) & (uint64_t)(hash->siz-1);
+  }
+  hash->key[h] = key;
+  hash->val[h] = val;
+
+  return val;
+}
+
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ * \param hash pointer toward the hash table.
+ *
+ * Deallocate the hash table.
+ *
+ */
+void PMMG_hashGid_free( PMMG_pParMesh parmesh,PMMG_HGid *hash ) {
+  PMMG_DEL_MEM(parmesh,hash->key,int64_t,"gid hash keys");
+  PMMG_DEL_MEM(parmesh,hash->val,int,"gid hash values");
+  hash->siz = 0;
+}
@@ -0,0 +1,55 @@
+/* =============================================================================
+**  This file is part of the parmmg software package for parallel tetrahedral
+**  mesh modification.
+**  Copyright (c) Bx INP/Inria/UBordeaux, 2017-
+**
+**  parmmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  parmmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with parmmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the parmmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/**
+ * \file globalnum_pmmg.h
+ * \brief globalnum_pmmg.c header file
+ * \author Cécile Dobrzynski (Bx INP/Inria)
+ * \author Algiane Froehly (Inria)
+ * \version 5
+ * \copyright GNU Lesser General Public License.
+ */
+
+#ifndef GLOBALNUM_PMMG_H
+
+#define GLOBALNUM_PMMG_H
+
+#include "parmmg.h"
+
+/**
+ * \struct PMMG_HGid
+ *
+ * \brief Open addressing hash table whose keys are vertex global indices
+ *
+ */
+typedef struct {
+  int64_t *key; /*!< global index stored in each slot (0 if the slot is empty) */
+  int     *val; /*!< value associated to the global index of each slot */
+  int     siz;  /*!< number of slots (power of 2) */
+} PMMG_HGid;
+
+int  PMMG_hashGid_new( PMMG_pParMesh parmesh,PMMG_HGid *hash,int nitem );
+int  PMMG_hashGid_getOrAdd( PMMG_HGid *hash,int64_t key,int val );
+void PMMG_hashGid_free( PMMG_pParMesh parmesh,PMMG_HGid *hash );
+
+#endif
@@ -222,6 +222,9 @@ int PMMG_grpSplit_setMeshSize_initData(MMG5_pMesh mesh, int np, int ne,
     fprintf(stderr,"     Your mesh don't contains tetrahedra.\n");
   }
 
+  /* The arrays are freed by Mmg */
+  PMMG_memprof_releaseMesh(mesh,NULL,NULL);
+
   if ( mesh->point )
     MMG5_DEL_MEM(mesh,mesh->point);
   if ( mesh->tetra )
@@ -336,6 +339,8 @@ int PMMG_oldGrps_newGroup( PMMG_pParMesh parmesh,int igrp ) {
   grp = &parmesh->old_listgrp[igrp];
   grp->mesh = NULL;
   grp->met  = NULL;
+  grp->sol  = NULL;
+  grp->disp = NULL;
 
   MMG3D_Init_mesh( MMG5_ARG_start,
                    MMG5_ARG_ppMesh, &grp->mesh,
@@ -367,6 +372,17 @@ int PMMG_oldGrps_newGroup( PMMG_pParMesh parmesh,int igrp ) {
     if ( !MMG3D_Set_solSize(mesh,met,MMG5_Vertex,meshOld->np,metOld->type) )
       return 0;
 
+  /* Set solution fields and displacement sizes */
+  if ( !PMMG_fields_copyStructure(mesh,&grp->sol,meshOld,
+                                  parmesh->listgrp[igrp].sol,meshOld->np) )
+    return 0;
+
+  if ( parmesh->listgrp[igrp].disp && parmesh->listgrp[igrp].disp->m ) {
+    PMMG_CALLOC(mesh,grp->disp,1,MMG5_Sol,"background displacement",return 0);
+    if ( !MMG3D_Set_solSize(mesh,grp->disp,MMG5_Vertex,meshOld->np,MMG5_Vector) )
+      return 0;
+  }
+
   /* Copy the info structure of the initial mesh: it contains the remeshing
    * options */
   memcpy(&(mesh->info),&(meshOld->info),sizeof(MMG5_Info) );
@@ -405,6 +421,7 @@ PMMG_splitGrps_newGroup( PMMG_pParMesh parmesh,PMMG_pGrp grp,int igrp,
 
   grp->mesh = NULL;
   grp->met  = NULL;
+  grp->sol  = NULL;
   grp->disp = NULL;
 
   MMG3D_Init_mesh( MMG5_ARG_start, MMG5_ARG_ppMesh, &grp->mesh,
@@ -443,6 +460,13 @@ PMMG_splitGrps_newGroup( PMMG_pParMesh parmesh,PMMG_pGrp grp,int igrp,
       return 0;
   }
 
+  /* Same for the solution fields */
+  if ( !PMMG_fields_copyStructure(grp->mesh,&grp->sol,meshOld,grpOld->sol,1) )
+    return 0;
+
+  /* And for the global indices of the vertices */
+  if ( !PMMG_gid_copyStructure(grp->mesh,grp,grpOld) ) return 0;
+
   /* Copy the info structure of the initial mesh: it contains the remeshing
    * options */
   if ( !PMMG_copy_mmgInfo ( &meshOld->info,&grp->mesh->info ) ) return 0;
@@ -487,26 +511,148 @@ PMMG_splitGrps_newGroup( PMMG_pParMesh parmesh,PMMG_pGrp grp,int igrp,
   return 1;
 }
 
+/**
+ * \param parmesh pointer toward the parmesh structure
+ * \param igrp index of the group to check
+ *
+ * \return 1 if the background group \a igrp can be recycled to store the
+ * current group \a igrp, 0 otherwise.
+ *
+ * A background group can be recycled if it stores the same fields as the
+ * current group (metrics, solution fields and displacement).
+ *
+ */
+static inline
+int PMMG_oldGrps_isRecyclable( PMMG_pParMesh parmesh,int igrp ) {
+  PMMG_pGrp  const grpCur = &parmesh->listgrp[igrp];
+  PMMG_pGrp  const grp    = &parmesh->old_listgrp[igrp];
+  int              isMet,isDisp;
+
+  if ( !grp->mesh ) return 0;
+
+  isMet = ( grpCur->mesh->info.inputMet == 1 );
+  if ( isMet != ( grp->met->m != NULL ) ) return 0;
+
+  if ( (grp->sol != NULL) != (grpCur->sol != NULL) ) return 0;
+  if ( grp->sol && grp->mesh->nsols != grpCur->mesh->nsols ) return 0;
+
+  isDisp = ( grpCur->disp && grpCur->disp->m );
+  if ( isDisp != ( grp->disp != NULL ) ) return 0;
+
+  return 1;
+}
+
+/**
+ * \param parmesh pointer toward the parmesh structure
+ * \param igrp index of the group to resize
+ *
+ * \return 0 if fail, 1 if success
+ *
+ * Resize the background group \a igrp (allocated at a previous iteration) to
+ * store the current group \a igrp. The arrays are reallocated only if they
+ * are too small or if more than half of them is unused.
+ *
+ * \remark The background mesh keeps whole MMG5_Point and MMG5_Tetra arrays
+ * because the localization and interpolation functions work on a MMG5_Mesh:
+ * the recycling saves the allocations between iterations, not memory.
+ *
+ */
+static
+int PMMG_oldGrps_resizeGroup( PMMG_pParMesh parmesh,int igrp ) {
+  MMG5_pMesh const meshOld= parmesh->listgrp[igrp].mesh;
+  PMMG_pGrp        grp;
+  MMG5_pMesh       mesh;
+  MMG5_pSol        met;
+  size_t           oldMemMax,memAv;
+  int              np,ne;
+
+  grp  = &parmesh->old_listgrp[igrp];
+  mesh = grp->mesh;
+  met  = grp->met;
+
+  np = meshOld->np;
+  ne = meshOld->ne;
+
+  /* Give all the available memory to the mesh */
+  oldMemMax = parmesh->memCur;
+  memAv     = parmesh->memMax-oldMemMax;
+  PMMG_TRANSFER_AVMEM_FROM_PMESH_TO_MESH(parmesh,mesh,memAv,oldMemMax);
+
+  /* Points and point data */
+  if ( np > mesh->npmax || 2*np < mesh->npmax ) {
+    PMMG_REALLOC(mesh,mesh->point,np+1,mesh->npmax+1,MMG5_Point,
+                 "background vertices",return 0);
+
+    if ( met->m ) {
+      PMMG_REALLOC(mesh,met->m,met->size*(np+1),met->size*(met->npmax+1),
+                   double,"background metric",return 0);
+      met->npmax = np;
+    }
+
+    if ( grp->disp ) {
+      PMMG_REALLOC(mesh,grp->disp->m,grp->disp->size*(np+1),
+                   grp->disp->size*(grp->disp->npmax+1),double,
+                   "background displacement",return 0);
+      grp->disp->npmax = np;
+    }
+
+    if ( !PMMG_fields_resize(mesh,grp->sol,np) ) return 0;
+
+    mesh->npmax = np;
+  }
+  mesh->np = mesh->npi = np;
+  met->np  = met->npi  = met->m ? np : 0;
+  if ( grp->disp ) {
+    grp->disp->np = grp->disp->npi = np;
+  }
+  PMMG_fields_setNp(mesh,grp->sol,np);
+
+  /* Tetrahedra and adjacency */
+  if ( ne > mesh->nemax || 2*ne < mesh->nemax ) {
+    PMMG_REALLOC(mesh,mesh->tetra,ne+1,mesh->nemax+1,MMG5_Tetra,
+                 "background tetra",return 0);
+    PMMG_REALLOC(mesh,mesh->adja,4*ne+5,4*mesh->nemax+5,int,
+                 "background adjacency table",return 0);
+    mesh->nemax = ne;
+  }
+  mesh->ne = mesh->nei = ne;
+
+  /* Copy the info structure of the initial mesh: it contains the remeshing
+   * options */
+  memcpy(&(mesh->info),&(meshOld->info),sizeof(MMG5_Info) );
+
+  /* Give the available memory to the parmesh */
+  PMMG_TRANSFER_AVMEM_FROM_MESH_TO_PMESH(parmesh,mesh,memAv,oldMemMax);
+
+  return 1;
+}
+
 /**
  * \param parmesh pointer toward the parmesh structure
  * \param igrp index of the group to fill
  *
  * Fill the background mesh with the current mesh on group igrp
- * (info.inputMet == 1 if a  metrics is provided by the user).
+ * (info.inputMet == 1 if a  metrics is provided by the user). Only the data
+ * used by the interpolation are copied: vertices and adjacency of the
+ * tetrahedra, coordinates and tags of the points, metrics and solution fields
+ * (the other fields of the points and tetra are allocated but not filled).
  *
  */
 int PMMG_oldGrps_fillGroup( PMMG_pParMesh parmesh,int igrp ) {
 
   MMG5_pMesh const meshOld= parmesh->listgrp[igrp].mesh;
   MMG5_pSol  const metOld = parmesh->listgrp[igrp].met;
+  PMMG_pGrp  const grpOld = &parmesh->listgrp[igrp];
+  PMMG_pGrp        grp;
   MMG5_pMesh       mesh;
   MMG5_pSol        met;
   MMG5_pTetra      pt,ptCur;
   MMG5_pPoint      ppt,pptCur;
   int              *adja,*oldAdja,ie,ip;
 
-  mesh = parmesh->old_listgrp[igrp].mesh;
-  met  = parmesh->old_listgrp[igrp].met;
+  grp  = &parmesh->old_listgrp[igrp];
+  mesh = grp->mesh;
+  met  = grp->met;
 
   assert( mesh->ne == meshOld->ne );
   assert( mesh->np == meshOld->np );
@@ -515,11 +661,15 @@ int PMMG_oldGrps_fillGroup( PMMG_pParMesh parmesh,int igrp ) {
   for ( ie = 1; ie < meshOld->ne+1; ++ie ) {
     pt = &meshOld->tetra[ie];
     ptCur = &mesh->tetra[ie];
- 
-    if ( !MG_EOK(pt) ) continue;
 
-    /* Copy tetra */
-    memcpy( ptCur, pt, sizeof(MMG5_Tetra) );
+    if ( !MG_EOK(pt) ) {
+      /* The background mesh may be recycled: mark the unused tetra */
+      ptCur->v[0] = 0;
+      continue;
+    }
+
+    /* Copy tetra vertices */
+    memcpy( ptCur->v, pt->v, 4*sizeof(int) );
 
     /* Copy element's adjacency */
     assert( meshOld->adja );
@@ -539,20 +689,25 @@ int PMMG_oldGrps_fillGroup( PMMG_pParMesh parmesh,int igrp ) {
     ppt = &meshOld->point[ip];
     pptCur = &mesh->point[ip];
 
-    if ( !MG_VOK(ppt) ) {
-
-      /* Only copy the tag (to detect the not VOK point) */
-      pptCur->tag = ppt->tag;
+    /* Copy the tag (to detect the not VOK and the required points) */
+    pptCur->tag = ppt->tag;
 
-    } else {
+    if ( MG_VOK(ppt) ) {
 
-      /* Copy point */
-      memcpy( pptCur, ppt, sizeof(MMG5_Point) );
+      /* Copy coordinates */
+      memcpy( pptCur->c, ppt->c, 3*sizeof(double) );
 
       /* Copy metrics */
       if ( mesh->info.inputMet == 1 )
         memcpy( &met->m[ ip*met->size ], &metOld->m[ip*met->size], met->size*sizeof(double) );
 
+      /* Copy solution fields and displacement */
+      PMMG_fields_copyPoint( mesh,grp->sol,ip,grpOld->sol,ip );
+      if ( grp->disp )
+        memcpy( &grp->disp->m[ ip*grp->disp->size ],
+                &grpOld->disp->m[ ip*grp->disp->size ],
+                grp->disp->size*sizeof(double) );
+
       /* Skip xpoint */
       pptCur->xp = 0;
 
@@ -902,6 +1057,8 @@ PMMG_splitGrps_fillGroup( PMMG_pParMesh parmesh,PMMG_pGrp grp,int grpIdOld,int g
                          "metric array",return 0);
           }
           met->npmax = mesh->npmax;
+          if ( !PMMG_fields_resize(mesh,grp->sol,mesh->npmax) ) return 0;
+          if ( !PMMG_gid_resize(mesh,grp,mesh->npmax) ) return 0;
           assert ( *np<=mesh->npmax );
         }
         memcpy( mesh->point+(*np),&meshOld->point[pt->v[poi]],
@@ -911,6 +1068,8 @@ PMMG_splitGrps_fillGroup( PMMG_pParMesh parmesh,PMMG_pGrp grp,int grpIdOld,int g
                   &grpOld->met->m[pt->v[poi] * met->size],
                   met->size * sizeof( double ) );
         }
+        PMMG_fields_copyPoint( mesh,grp->sol,*np,grpOld->sol,pt->v[poi] );
+        PMMG_gid_copyPoint( grp,*np,grpOld,pt->v[poi] );
 
         /* Update tetra vertex index */
         tetraCur->v[poi] = (*np);
@@ -1063,6 +1222,7 @@ PMMG_splitGrps_countTetPerGrp( PMMG_pParMesh parmesh,MMG5_pMesh meshOld,
 /**
  * \param mesh pointer toward an MMG5 mesh structure
  * \param met pointer toward an MMG5 metric structure
+ * \param field pointer toward the array of solution fields
  * \param np number of points in the mesh
  *
  * \return 0 if fail, 1 if success
@@ -1075,7 +1235,8 @@ PMMG_splitGrps_countTetPerGrp( PMMG_pParMesh parmesh,MMG5_pMesh meshOld,
  *
  */
 static inline
-int PMMG_splitGrps_cleanMesh( MMG5_pMesh mesh,MMG5_pSol met,int np )
+int PMMG_splitGrps_cleanMesh( MMG5_pMesh mesh,MMG5_pSol met,MMG5_pSol field,
+                              int np )
 {
   MMG5_pTetra  pt;
   MMG5_pxTetra pxt;
@@ -1101,6 +1262,7 @@ int PMMG_splitGrps_cleanMesh( MMG5_pMesh mesh,MMG5_pSol met,int np )
     PMMG_REALLOC(mesh,met->m,met->size*(np+1),met->size*(met->npmax+1),
                  double,"fitted metric table",return 0);
   met->npmax = mesh->npmax;
+  if ( !PMMG_fields_resize(mesh,field,mesh->npmax) ) return 0;
 
   /* Set memMax to the smallest possible value */
   mesh->memMax = mesh->memCur;
@@ -1113,6 +1275,7 @@ int PMMG_splitGrps_cleanMesh( MMG5_pMesh mesh,MMG5_pSol met,int np )
     met->np  = np;
     met->npi = np;
   }
+  PMMG_fields_setNp(mesh,field,np);
 
   /* Udate tags and refs of tetra edges (if we have 2 boundary tetra in the
    * shell of an edge, it is possible that one of the xtetra has set the edge
@@ -1142,27 +1305,45 @@ int PMMG_splitGrps_cleanMesh( MMG5_pMesh mesh,MMG5_pSol met,int np )
  *
  * \return 0 if fail, 1 if success
  *
- * Copy all groups from the current to the background list.
+ * Copy all groups from the current to the background list. The background
+ * groups of the previous iteration are recycled: their arrays are resized
+ * (if needed) instead of being freed and allocated again.
  *
  */
 int PMMG_update_oldGrps( PMMG_pParMesh parmesh ) {
   int grpId;
 
-  PMMG_listgrp_free(parmesh, &parmesh->old_listgrp, parmesh->nold_grp);
+  /** Resize the list of background groups */
+  if ( parmesh->nold_grp != parmesh->ngrp ) {
+    for ( grpId = parmesh->ngrp; grpId < parmesh->nold_grp; ++grpId )
+      PMMG_grp_free( parmesh, &parmesh->old_listgrp[grpId] );
 
-  /* Allocate list of subgroups struct and allocate memory */
-  parmesh->nold_grp = parmesh->ngrp;
-  PMMG_CALLOC(parmesh,parmesh->old_listgrp,parmesh->nold_grp,PMMG_Grp,
-              "old group list ",return 0);
+    PMMG_RECALLOC(parmesh,parmesh->old_listgrp,parmesh->ngrp,parmesh->nold_grp,
+                  PMMG_Grp,"old group list ",return 0);
+    parmesh->nold_grp = parmesh->ngrp;
+  }
 
   /** Copy every group */
   for ( grpId = 0; grpId < parmesh->ngrp; ++grpId ) {
 
-    /* New group initialisation */
-    if ( !PMMG_oldGrps_newGroup( parmesh, grpId ) ) {
-      fprintf(stderr,"\n  ## Error: %s: unable to initialize new background"
-              " group (%d).\n",__func__,grpId);
-      return 0;
+    if ( PMMG_oldGrps_isRecyclable( parmesh, grpId ) ) {
+      /* Recycle the background group of the previous iteration */
+      if ( !PMMG_oldGrps_resizeGroup( parmesh, grpId ) ) {
+        fprintf(stderr,"\n  ## Error: %s: unable to resize background"
+                " group (%d).\n",__func__,grpId);
+        return 0;
+      }
+    }
+    else {
+      if ( parmesh->old_listgrp[grpId].mesh )
+        PMMG_grp_free( parmesh, &parmesh->old_listgrp[grpId] );
+
+      /* New group initialisation */
+      if ( !PMMG_oldGrps_newGroup( parmesh, grpId ) ) {
+        fprintf(stderr,"\n  ## Error: %s: unable to initialize new background"
+                " group (%d).\n",__func__,grpId);
+        return 0;
+      }
     }
 
     /* Fill group */
@@ -1282,7 +1463,14 @@ int PMMG_split_eachGrp( PMMG_pParMesh parmesh,int grpIdOld,PMMG_pGrp grpsNew,idx
     }
 
     /* Mesh cleaning in the new group */
-    if ( !PMMG_splitGrps_cleanMesh(meshCur,grpCur->met,poiPerGrp[grpId]) ) {
+    if ( !PMMG_gid_resize(meshCur,grpCur,poiPerGrp[grpId]) ) {
+      fprintf(stderr,"\n  ## Error: %s: unable to fit the global indices of"
+              " new group (%d).\n",__func__,grpId);
+      ret_val = -1;
+      goto fail_sgrp;
+    }
+    if ( !PMMG_splitGrps_cleanMesh(meshCur,grpCur->met,grpCur->sol,
+                                   poiPerGrp[grpId]) ) {
       fprintf(stderr,"\n  ## Error: %s: unable to clean the mesh of"
               " new group (%d).\n",__func__,grpId);
       ret_val = -1;
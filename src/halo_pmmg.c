@@ -0,0 +1,314 @@
+/* =============================================================================
+**  This file is part of the parmmg software package for parallel tetrahedral
+**  mesh modification.
+**  Copyright (c) Bx INP/Inria/UBordeaux, 2017-
+**
+**  parmmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  parmmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with parmmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the parmmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/**
+ * \file halo_pmmg.c
+ * \brief Persistent exchanges of the interface values through the external
+ * communicators.
+ * \author Cécile Dobrzynski (Bx INP/Inria)
+ * \author Algiane Froehly (Inria)
+ * \author Luca Cirrottola (Inria)
+ * \version 1
+ * \copyright GNU Lesser General Public License.
+ *
+ * A halo (\a parmesh->halo[ihalo], see PMMG_HALO) exchanges the values of an
+ * internal communicator (node or face, int or double values) with the remote
+ * procs of the matching external communicators. The MPI requests are created
+ * once with MPI_Send_init/MPI_Recv_init and the send/receive buffers are kept
+ * between the exchanges: they are rebuilt only if the external communicators
+ * (remote procs or sizes) have changed.
+ *
+ */
+#include "parmmg.h"
+
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ * \param ihalo index of the halo.
+ * \param next_comm pointer toward the number of external communicators.
+ *
+ * \return the external communicators used by the halo \a ihalo.
+ *
+ */
+static inline
+PMMG_pExt_comm PMMG_halo_extComm( PMMG_pParMesh parmesh,int ihalo,int *next_comm ) {
+
+  if ( ihalo == PMMG_HALO_NODE_INT || ihalo == PMMG_HALO_NODE_DBL ) {
+    *next_comm = parmesh->next_node_comm;
+    return parmesh->ext_node_comm;
+  }
+  *next_comm = parmesh->next_face_comm;
+  return parmesh->ext_face_comm;
+}
+
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ * \param halo pointer toward the halo.
+ * \param ihalo index of the halo.
+ *
+ * Free the persistent requests and the buffers of a halo.
+ *
+ */
+static
+void PMMG_halo_reset( PMMG_pParMesh parmesh,PMMG_pHalo halo,int ihalo ) {
+  int k;
+
+  for ( k=0; k<2*halo->nreq; ++k ) {
+    if ( halo->request[k] != MPI_REQUEST_NULL )
+      MPI_Request_free(&halo->request[k]);
+  }
+  PMMG_DEL_MEM(parmesh,halo->request,MPI_Request,"halo requests");
+  PMMG_DEL_MEM(parmesh,halo->color,int,"halo colors");
+  PMMG_DEL_MEM(parmesh,halo->displs,int,"halo displs");
+  PMMG_DEL_MEM(parmesh,halo->ireq2comm,int,"halo requests comms");
+  if ( ihalo == PMMG_HALO_NODE_DBL || ihalo == PMMG_HALO_FACE_DBL ) {
+    PMMG_DEL_MEM(parmesh,halo->sbuf,double,"halo send buffer");
+    PMMG_DEL_MEM(parmesh,halo->rbuf,double,"halo recv buffer");
+  }
+  else {
+    PMMG_DEL_MEM(parmesh,halo->sbuf,int,"halo send buffer");
+    PMMG_DEL_MEM(parmesh,halo->rbuf,int,"halo recv buffer");
+  }
+  halo->ncomm = -1;
+  halo->nreq  = 0;
+}
+
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ *
+ * Free all the halos of the parmesh.
+ *
+ */
+void PMMG_halo_free( PMMG_pParMesh parmesh ) {
+  int ihalo;
+
+  if ( !parmesh->halo ) return;
+
+  for ( ihalo=0; ihalo<PMMG_NHALO; ++ihalo )
+    PMMG_halo_reset(parmesh,&parmesh->halo[ihalo],ihalo);
+
+  PMMG_DEL_MEM(parmesh,parmesh->halo,PMMG_Halo,"halos");
+}
+
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ * \param ihalo index of the halo.
+ *
+ * \return 1 if the halo matches the current external communicators, 0
+ * otherwise.
+ *
+ */
+static
+int PMMG_halo_isValid( PMMG_pParMesh parmesh,int ihalo ) {
+  PMMG_pHalo     halo;
+  PMMG_pExt_comm ext_comm;
+  int            next_comm,k;
+
+  halo     = &parmesh->halo[ihalo];
+  ext_comm = PMMG_halo_extComm(parmesh,ihalo,&next_comm);
+
+  if ( halo->ncomm != next_comm ) return 0;
+
+  for ( k=0; k<next_comm; ++k ) {
+    if ( halo->color[k] != ext_comm[k].color_out ) return 0;
+    if ( halo->displs[k+1]-halo->displs[k] != ext_comm[k].nitem ) return 0;
+  }
+  return 1;
+}
+
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ * \param ihalo index of the halo.
+ *
+ * \return 1 if success, 0 if fail.
+ *
+ * Allocate the buffers of the halo \a ihalo and create its persistent
+ * requests (one receive and one send per non empty external communicator).
+ *
+ */
+static
+int PMMG_halo_build( PMMG_pParMesh parmesh,int ihalo ) {
+  PMMG_pHalo     halo;
+  PMMG_pExt_comm ext_comm;
+  MPI_Datatype   type;
+  int            next_comm,nitem,k,ireq,tag;
+
+  halo     = &parmesh->halo[ihalo];
+  ext_comm = PMMG_halo_extComm(parmesh,ihalo,&next_comm);
+  tag      = MPI_HALO_TAG+ihalo;
+
+  PMMG_halo_reset(parmesh,halo,ihalo);
+
+  PMMG_MALLOC(parmesh,halo->color,next_comm+1,int,"halo colors",return 0);
+  PMMG_CALLOC(parmesh,halo->displs,next_comm+1,int,"halo displs",return 0);
+  PMMG_MALLOC(parmesh,halo->ireq2comm,next_comm+1,int,"halo requests comms",
+              return 0);
+
+  halo->nreq = 0;
+  for ( k=0; k<next_comm; ++k ) {
+    halo->color[k]    = ext_comm[k].color_out;
+    halo->displs[k+1] = halo->displs[k] + ext_comm[k].nitem;
+    if ( ext_comm[k].nitem ) halo->ireq2comm[halo->nreq++] = k;
+  }
+  nitem = halo->displs[next_comm];
+
+  if ( ihalo == PMMG_HALO_NODE_DBL || ihalo == PMMG_HALO_FACE_DBL ) {
+    type = MPI_DOUBLE;
+    PMMG_MALLOC(parmesh,halo->sbuf,nitem,double,"halo send buffer",return 0);
+    PMMG_MALLOC(parmesh,halo->rbuf,nitem,double,"halo recv buffer",return 0);
+  }
+  else {
+    type = MPI_INT;
+    PMMG_MALLOC(parmesh,halo->sbuf,nitem,int,"halo send buffer",return 0);
+    PMMG_MALLOC(parmesh,halo->rbuf,nitem,int,"halo recv buffer",return 0);
+  }
+
+  /* Receives first, then sends */
+  PMMG_MALLOC(parmesh,halo->request,2*halo->nreq+1,MPI_Request,"halo requests",
+              return 0);
+  for ( ireq=0; ireq<2*halo->nreq; ++ireq )
+    halo->request[ireq] = MPI_REQUEST_NULL;
+
+  for ( ireq=0; ireq<halo->nreq; ++ireq ) {
+    k     = halo->ireq2comm[ireq];
+    nitem = ext_comm[k].nitem;
+    if ( type == MPI_DOUBLE ) {
+      MPI_CHECK( MPI_Recv_init((double*)halo->rbuf+halo->displs[k],nitem,type,
+                               halo->color[k],tag,parmesh->comm,
+                               &halo->request[ireq]),return 0 );
+      MPI_CHECK( MPI_Send_init((double*)halo->sbuf+halo->displs[k],nitem,type,
+                               halo->color[k],tag,parmesh->comm,
+                               &halo->request[halo->nreq+ireq]),return 0 );
+    }
+    else {
+      MPI_CHECK( MPI_Recv_init((int*)halo->rbuf+halo->displs[k],nitem,type,
+                               halo->color[k],tag,parmesh->comm,
+                               &halo->request[ireq]),return 0 );
+      MPI_CHECK( MPI_Send_init((int*)halo->sbuf+halo->displs[k],nitem,type,
+                               halo->color[k],tag,parmesh->comm,
+                               &halo->request[halo->nreq+ireq]),return 0 );
+    }
+  }
+  halo->ncomm = next_comm;
+
+  return 1;
+}
+
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ * \param ihalo index of the halo (see PMMG_HALO).
+ * \param values values of the internal communicator (int or double array
+ * depending on the halo).
+ * \param mode way to store the received values in \a values (see PMMG_HALO).
+ *
+ * \return 1 if success, 0 if fail.
+ *
+ * Send the internal communicator values of the items of each external
+ * communicator to its remote proc and receive the remote values. All the
+ * receives are posted first, then the send buffer of each external
+ * communicator is packed and sent while the other ones are being packed. The
+ * received values stay in the halo receive buffer (\a rbuf, at position
+ * \a displs[k] for the k^th external communicator) until the next exchange,
+ * and are stored in \a values following \a mode, in the order of the
+ * external communicators.
+ *
+ */
+int PMMG_halo_exchange( PMMG_pParMesh parmesh,int ihalo,void *values,int mode ) {
+  PMMG_pHalo     halo;
+  PMMG_pExt_comm ext_comm;
+  int            *ival,*isbuf,*irbuf;
+  double         *rval,*rsbuf,*rrbuf;
+  int            next_comm,k,i,ireq,idx,isdbl;
+
+  assert ( 0 <= ihalo && ihalo < PMMG_NHALO );
+
+  if ( !parmesh->halo ) {
+    PMMG_MALLOC(parmesh,parmesh->halo,PMMG_NHALO,PMMG_Halo,"halos",return 0);
+    for ( k=0; k<PMMG_NHALO; ++k ) {
+      memset(&parmesh->halo[k],0,sizeof(PMMG_Halo));
+      parmesh->halo[k].ncomm = -1;
+    }
+  }
+  halo = &parmesh->halo[ihalo];
+
+  /** Create the requests if the topology of the communicators has changed */
+  if ( !PMMG_halo_isValid(parmesh,ihalo) ) {
+    if ( !PMMG_halo_build(parmesh,ihalo) ) {
+      fprintf(stderr,"\n  ## Error: %s: unable to build the halo %d.\n",
+              __func__,ihalo);
+      return 0;
+    }
+  }
+  ext_comm = PMMG_halo_extComm(parmesh,ihalo,&next_comm);
+
+  isdbl = ( ihalo == PMMG_HALO_NODE_DBL || ihalo == PMMG_HALO_FACE_DBL );
+  assert ( !isdbl || mode != PMMG_HALO_MAX );
+
+  ival  = (int*)values;
+  isbuf = (int*)halo->sbuf;
+  irbuf = (int*)halo->rbuf;
+  rval  = (double*)values;
+  rsbuf = (double*)halo->sbuf;
+  rrbuf = (double*)halo->rbuf;
+
+  /** Post the receives */
+  if ( halo->nreq ) {
+    MPI_CHECK( MPI_Startall(halo->nreq,halo->request),return 0 );
+  }
+
+  /** Pack and send the values of each communicator */
+  for ( ireq=0; ireq<halo->nreq; ++ireq ) {
+    k = halo->ireq2comm[ireq];
+    if ( isdbl ) {
+      for ( i=0; i<ext_comm[k].nitem; ++i )
+        rsbuf[halo->displs[k]+i] = rval[ext_comm[k].int_comm_index[i]];
+    }
+    else {
+      for ( i=0; i<ext_comm[k].nitem; ++i )
+        isbuf[halo->displs[k]+i] = ival[ext_comm[k].int_comm_index[i]];
+    }
+    MPI_CHECK( MPI_Start(&halo->request[halo->nreq+ireq]),return 0 );
+  }
+
+  MPI_CHECK( MPI_Waitall(halo->nreq,halo->request,MPI_STATUSES_IGNORE),
+             return 0 );
+
+  /** Store the received values (in the order of the communicators) */
+  if ( mode != PMMG_HALO_KEEP ) {
+    for ( k=0; k<next_comm; ++k ) {
+      for ( i=0; i<ext_comm[k].nitem; ++i ) {
+        idx = ext_comm[k].int_comm_index[i];
+        if ( isdbl )
+          rval[idx] = rrbuf[halo->displs[k]+i];
+        else if ( mode == PMMG_HALO_MAX )
+          ival[idx] = MG_MAX(ival[idx],irbuf[halo->displs[k]+i]);
+        else
+          ival[idx] = irbuf[halo->displs[k]+i];
+      }
+    }
+  }
+
+  MPI_CHECK( MPI_Waitall(halo->nreq,&halo->request[halo->nreq],
+                         MPI_STATUSES_IGNORE),return 0 );
+
+  return 1;
+}
@@ -642,3 +642,298 @@ int PMMG_saveAllSols_centralized(PMMG_pParMesh parmesh,const char *filename) {
 
   return ier;
 }
+
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ * \param filename name of the file.
+ * \param defext extension to use if \a filename has no extension.
+ * \param data pointer toward the file name of the current process (allocated).
+ *
+ * \return 0 if fail, 1 otherwise
+ *
+ * Insert the rank of the process before the extension of the file name
+ * ("name.ext" becomes "name.<rank>.ext").
+ *
+ */
+static
+int PMMG_rankFilename( PMMG_pParMesh parmesh,const char *filename,
+                       const char *defext,char **data ) {
+  const char *ext;
+  char       *ptr;
+
+  PMMG_CALLOC(parmesh,*data,strlen(filename)+strlen(defext)+16,char,"data",
+              return 0);
+
+  strcpy(*data,filename);
+  ptr = MMG5_Get_filenameExt(*data);
+  ext = ( *ptr ) ? filename + (ptr - *data) : defext;
+  *ptr = '\0';
+
+  sprintf(ptr,".%d%s",parmesh->myrank,ext);
+
+  return 1;
+}
+
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ * \param filename name of the output mesh (may be NULL).
+ * \param ext extension of the report.
+ * \param data pointer toward the file name of the report (allocated).
+ *
+ * \return 0 if fail, 1 otherwise
+ *
+ * Replace the extension of the output mesh name by the report extension
+ * ("name.mesh" becomes "name<ext>", "parmmg<ext>" without output name).
+ *
+ */
+int PMMG_reportFilename( PMMG_pParMesh parmesh,const char *filename,
+                         const char *ext,char **data ) {
+  char *ptr;
+
+  if ( !filename || !*filename ) filename = "parmmg";
+
+  PMMG_CALLOC(parmesh,*data,strlen(filename)+strlen(ext)+1,char,"data",
+              return 0);
+
+  strcpy(*data,filename);
+  ptr = MMG5_Get_filenameExt(*data);
+  strcpy(ptr,ext);
+
+  return 1;
+}
+
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ * \param filename name of the mesh file (already saved by Mmg).
+ *
+ * \return 0 if fail, 1 otherwise
+ *
+ * Append the parallel face communicators to a mesh file in Medit format (the
+ * final "End" keyword is overwritten and written again after the
+ * communicators). The global index of a face is its position in the external
+ * communicator, which is the same on the two sides of each pair of procs.
+ * The communicators are written as read by \ref PMMG_loadCommunicators.
+ *
+ */
+static
+int PMMG_saveCommunicators( PMMG_pParMesh parmesh,const char *filename ) {
+  FILE       *inm;
+  long       pos,size;
+  int        ncomm,*nitem_comm,*color,**idx_loc;
+  int        bin,binch,bpos,ntot,icomm,i,k,ier;
+  char       tail[32],*ptr;
+
+  /** Get the face communicators */
+  if ( !PMMG_Get_numberOfFaceCommunicators(parmesh,&ncomm) ) return 0;
+
+  ier        = 1;
+  inm        = NULL;
+  nitem_comm = color = NULL;
+  idx_loc    = NULL;
+  PMMG_CALLOC(parmesh,nitem_comm,ncomm,int,"nitem_comm",ier = 0;goto end);
+  PMMG_CALLOC(parmesh,color,ncomm,int,"color",ier = 0;goto end);
+  PMMG_CALLOC(parmesh,idx_loc,ncomm,int*,"idx_loc pointer",ier = 0;goto end);
+
+  ntot = 0;
+  for( icomm = 0; icomm < ncomm; icomm++ ) {
+    if ( !PMMG_Get_ithFaceCommunicatorSize(parmesh,icomm,&color[icomm],
+                                           &nitem_comm[icomm]) ) {
+      ier = 0;
+      goto end;
+    }
+    PMMG_CALLOC(parmesh,idx_loc[icomm],nitem_comm[icomm],int,"idx_loc",
+                ier = 0;goto end);
+    ntot += nitem_comm[icomm];
+  }
+  if ( !PMMG_Get_FaceCommunicator_faces(parmesh,idx_loc) ) {
+    ier = 0;
+    goto end;
+  }
+
+  /** Overwrite the End keyword of the mesh file */
+  bin = strstr(filename,".meshb") ? 1 : 0;
+
+  if ( !(inm = fopen(filename,"r+b")) ) {
+    fprintf(stderr,"\n  ## Error: %s: unable to open %s.\n",__func__,filename);
+    ier = 0;
+  }
+
+  if ( ier ) {
+    fseek(inm,0,SEEK_END);
+    size = ftell(inm);
+
+    if ( bin ) {
+      pos   = size - MMG5_SW;
+      binch = 0;
+      fseek(inm,pos,SEEK_SET);
+      if ( pos < 0 || fread(&binch,MMG5_SW,1,inm) != 1 || binch != 54 ) {
+        ier = 0;
+      }
+    }
+    else {
+      pos = MG_MAX(0,size-(long)sizeof(tail)+1);
+      fseek(inm,pos,SEEK_SET);
+      k = fread(tail,1,size-pos,inm);
+      tail[k] = '\0';
+      ptr = NULL;
+      for ( i=k-3; i>=0; --i ) {
+        if ( !strncmp(&tail[i],"End",3) ) {
+          ptr = &tail[i];
+          break;
+        }
+      }
+      if ( ptr ) pos += ptr-tail;
+      else ier = 0;
+    }
+    if ( !ier ) {
+      fprintf(stderr,"\n  ## Error: %s: End keyword not found in %s.\n",
+              __func__,filename);
+    }
+  }
+
+  /** Write the communicators then the End keyword */
+  if ( ier ) {
+    fseek(inm,pos,SEEK_SET);
+
+    if ( !bin ) {
+      fprintf(inm,"ParallelTriangles\n%d\n",ncomm);
+      for( icomm = 0; icomm < ncomm; icomm++ ) {
+        fprintf(inm,"%d %d\n",color[icomm],nitem_comm[icomm]);
+      }
+      for( icomm = 0; icomm < ncomm; icomm++ ) {
+        for( i = 0; i < nitem_comm[icomm]; i++ ) {
+          fprintf(inm,"%d %d %d\n",idx_loc[icomm][i],i+1,icomm);
+        }
+      }
+      fprintf(inm,"\nEnd\n");
+    }
+    else {
+      binch = 70; // ParallelTriangles
+      fwrite(&binch,MMG5_SW,1,inm);
+      bpos = pos + (3 + 2*ncomm + 3*ntot)*MMG5_SW; // NulPos
+      fwrite(&bpos,MMG5_SW,1,inm);
+      fwrite(&ncomm,MMG5_SW,1,inm);
+      for( icomm = 0; icomm < ncomm; icomm++ ) {
+        fwrite(&color[icomm],MMG5_SW,1,inm);
+        fwrite(&nitem_comm[icomm],MMG5_SW,1,inm);
+      }
+      for( icomm = 0; icomm < ncomm; icomm++ ) {
+        for( i = 0; i < nitem_comm[icomm]; i++ ) {
+          fwrite(&idx_loc[icomm][i],MMG5_SW,1,inm);
+          k = i+1;
+          fwrite(&k,MMG5_SW,1,inm);
+          fwrite(&icomm,MMG5_SW,1,inm);
+        }
+      }
+      binch = 54; // End
+      fwrite(&binch,MMG5_SW,1,inm);
+    }
+  }
+end:
+  if ( inm ) fclose(inm);
+
+  /* Release memory and return */
+  PMMG_DEL_MEM(parmesh,nitem_comm,int,"nitem_comm");
+  PMMG_DEL_MEM(parmesh,color,int,"color");
+  if ( idx_loc ) {
+    for( icomm = 0; icomm < ncomm; icomm++ ) {
+      PMMG_DEL_MEM(parmesh,idx_loc[icomm],int,"idx_loc");
+    }
+  }
+  PMMG_DEL_MEM(parmesh,idx_loc,int*,"idx_loc pointer");
+
+  return ier;
+}
+
+int PMMG_saveMesh_distributed(PMMG_pParMesh parmesh,const char *filename) {
+  MMG5_pMesh mesh;
+  int        ier;
+  char       *data;
+
+  if ( parmesh->ngrp != 1 ) {
+    fprintf(stderr,"  ## Error: %s: you must have exactly 1 group in you parmesh.",
+            __func__);
+    return 0;
+  }
+  mesh = parmesh->listgrp[0].mesh;
+
+  if ( !PMMG_rankFilename(parmesh,filename,".mesh",&data) ) return 0;
+
+  /* Set mmg verbosity to the max between the Parmmg verbosity and the mmg verbosity */
+  assert ( mesh->info.imprim == parmesh->info.mmg_imprim );
+  mesh->info.imprim = MG_MAX ( parmesh->info.imprim, mesh->info.imprim );
+
+  ier = MMG3D_saveMesh(mesh,data);
+
+  /* Restore the mmg verbosity to its initial value */
+  mesh->info.imprim = parmesh->info.mmg_imprim;
+
+  /* Save parallel communicators */
+  if ( 1 == ier ) {
+    ier = PMMG_saveCommunicators(parmesh,data);
+  }
+
+  PMMG_DEL_MEM(parmesh,data,char,"data");
+
+  return ier;
+}
+
+int PMMG_saveMet_distributed(PMMG_pParMesh parmesh,const char *filename) {
+  MMG5_pMesh mesh;
+  MMG5_pSol  met;
+  int        ier;
+  char       *data;
+
+  if ( parmesh->ngrp != 1 ) {
+    fprintf(stderr,"  ## Error: %s: you must have exactly 1 group in you parmesh.",
+            __func__);
+    return 0;
+  }
+  mesh = parmesh->listgrp[0].mesh;
+  met  = parmesh->listgrp[0].met;
+
+  if ( !PMMG_rankFilename(parmesh,filename,".sol",&data) ) return 0;
+
+  /* Set mmg verbosity to the max between the Parmmg verbosity and the mmg verbosity */
+  assert ( mesh->info.imprim == parmesh->info.mmg_imprim );
+  mesh->info.imprim = MG_MAX ( parmesh->info.imprim, mesh->info.imprim );
+
+  ier =  MMG3D_saveSol(mesh,met,data);
+
+  /* Restore the mmg verbosity to its initial value */
+  mesh->info.imprim = parmesh->info.mmg_imprim;
+
+  PMMG_DEL_MEM(parmesh,data,char,"data");
+
+  return ier;
+}
+
+int PMMG_saveAllSols_distributed(PMMG_pParMesh parmesh,const char *filename) {
+  MMG5_pMesh mesh;
+  MMG5_pSol  sol;
+  int        ier;
+  char       *data;
+
+  if ( parmesh->ngrp != 1 ) {
+    fprintf(stderr,"  ## Error: %s: you must have exactly 1 group in you parmesh.",
+            __func__);
+    return 0;
+  }
+  mesh = parmesh->listgrp[0].mesh;
+  sol  = parmesh->listgrp[0].sol;
+
+  if ( !PMMG_rankFilename(parmesh,filename,".sol",&data) ) return 0;
+
+  /* Set mmg verbosity to the max between the Parmmg verbosity and the mmg verbosity */
+  assert ( mesh->info.imprim == parmesh->info.mmg_imprim );
+  mesh->info.imprim = MG_MAX ( parmesh->info.imprim, mesh->info.imprim );
+
+  ier = MMG3D_saveAllSols(mesh,&sol,data);
+
+  /* Restore the mmg verbosity to its initial value */
+  mesh->info.imprim = parmesh->info.mmg_imprim;
+
+  PMMG_DEL_MEM(parmesh,data,char,"data");
+
+  return ier;
+}
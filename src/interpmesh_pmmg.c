@@ -33,6 +33,7 @@
  */
 #include "parmmg.h"
 #include "locate_pmmg.h"
+#include "coorcell_pmmg.h"
 
 /**
  * \param minNew lower bounds of the new box in each space direction
@@ -59,86 +60,33 @@ int PMMG_intersect_boundingBox( double *minNew, double *maxNew,
   return 1;
 }
 
-/**
- * \param mesh pointer to the mesh structure
- * \param pt pointer to the current tetra
- * \param coord pointer to the point coordinates
- * \param faceAreas oriented face areas of the current tetrahedron
- * \param barycoord pointer to the point barycentric coordinates in the current
- * tetra
- *
- * \return 0 if fail, 1 if success
- *
- *  Compute the barycentric coordinates of a given point in a given tetrahedron.
- *
- */
-int PMMG_compute_baryCoord( MMG5_pMesh mesh, MMG5_pTetra pt,
-                    double *coord, double *faceAreas, PMMG_baryCoord *barycoord ) {
-  double *c0,*normal,vol;
-  int    ifac;
-
-  /* Retrieve tetra volume */
-  vol = pt->qual;
-
-  /* Retrieve face areas and compute barycentric coordinates */
-  for( ifac = 0; ifac < 4; ifac++ ) {
-    normal = &faceAreas[3*ifac];
-    c0 = mesh->point[pt->v[MMG5_idir[ifac][0]]].c;
-    barycoord[ifac].val = -( (coord[0]-c0[0])*normal[0] +
-                             (coord[1]-c0[1])*normal[1] +
-                             (coord[2]-c0[2])*normal[2] )/vol;
-    barycoord[ifac].idx = ifac;
-  }
-
-  return 1;
-}
-
-/**
- * \param a pointer to point barycentric coordinates
- * \param b pointer to point barycentric coordinates
- *
- * \return -1 if (a < b), +1 if (a > b), 0 if equal
- *
- *  Compare the barycentric coordinates of a given point in a given tetrahedron.
- *
- */
-int PMMG_compare_baryCoord( const void *a,const void *b ) {
-  PMMG_baryCoord *coord_a;
-  PMMG_baryCoord *coord_b;
-
-  coord_a = (PMMG_baryCoord *)a;
-  coord_b = (PMMG_baryCoord *)b;
-
-  if( coord_a->val > coord_b-> val ) return 1;
-  if( coord_a->val < coord_b-> val ) return -1;
-
-  return 0;
-}
-
 /**
  * \param mesh pointer to the background mesh structure
  * \param ppt pointer to the point to locate
  * \param init index of the starting element
- * \param faceAreas oriented face areas of the all tetrahedra in the mesh
+ * \param faceAreas scaled face areas of the all tetrahedra in the mesh (see
+ * \ref PMMG_LOCATE_FACEAREAS_SIZE)
+ * \param grid localization grid of the background mesh
  * \param barycoord barycentric coordinates of the point to be located
+ * \param nstep number of elements visited by the adjacency walk (incremented)
  *
  * \return ie if positive, index of the target element; if negative, index of
  * the closest element; 0 if not found
  *
- *  Locate a point in a background mesh by traveling the elements adjacency.
+ *  Locate a point in a background mesh by traveling the elements adjacency,
+ *  starting from an element provided by the localization grid. If the walk
+ *  fails, search the point in the cells of the localization grid.
  *
  */
 int PMMG_locatePoint( MMG5_pMesh mesh, MMG5_pPoint ppt, int init,
-                      double *faceAreas, PMMG_baryCoord *barycoord ) {
+                      double *faceAreas, PMMG_locateGrid *grid,
+                      PMMG_baryCoord *barycoord, int *nstep ) {
   MMG5_pTetra    ptr,pt1;
-  int            *adja,iel,ip,idxTet,step,closestTet;
-  double         vol,eps,closestDist;
+  int            *adja,iel,ip,imin,idxTet,step,closestTet;
+  double         eps,closestDist;
   static int     mmgWarn0=0,mmgWarn1=0;
 
-  if(!init)
-    idxTet = 1;
-  else
-    idxTet = init;
+  idxTet = PMMG_locate_gridSeed( grid,mesh,ppt->c,init );
 
   step = 0;
   ++mesh->base;
@@ -150,20 +98,27 @@ int PMMG_locatePoint( MMG5_pMesh mesh, MMG5_pPoint ppt, int init,
     if ( !MG_EOK(ptr) ) continue;
 
     adja = &mesh->adja[4*(idxTet-1)+1];
-    vol = ptr->qual;
     eps = MMG5_EPS;
 
     /** Mark tetra */
     ptr->flag = mesh->base;
 
-    /** Get barycentric coordinates and sort them in ascending order */
-    PMMG_compute_baryCoord(mesh, ptr, ppt->c, &faceAreas[12*idxTet], barycoord);
-    qsort(barycoord,4,sizeof(PMMG_baryCoord),PMMG_compare_baryCoord);
+    /** Get barycentric coordinates and the smallest one */
+    imin = PMMG_compute_baryCoord(&faceAreas[PMMG_LOCATE_FACEAREAS_SIZE*idxTet],
+                                  ppt->c, barycoord);
 
     /** Exit if inside the element */
-    if( barycoord[0].val > -eps ) break;
+    if( barycoord[imin].val > -eps ) break;
 
-    /** Compute new direction */
+    /** Compute new direction: cross the face of smallest coordinate */
+    iel = adja[imin]/4;
+    if ( iel && mesh->tetra[iel].flag != mesh->base ) {
+      idxTet = iel;
+      continue;
+    }
+
+    /* Otherwise, try the other faces by ascending coordinates */
+    PMMG_sort_baryCoord( barycoord );
     for( ip=0; ip<4; ip++ ) {
       iel = adja[barycoord[ip].idx]/4;
 
@@ -179,64 +134,33 @@ int PMMG_locatePoint( MMG5_pMesh mesh, MMG5_pPoint ppt, int init,
       break;
     }
 
-    /** Stuck: Start exhaustive research */
+    /** Stuck: Start research in the localization grid */
     if (ip == 4) step = mesh->ne+1;
 
   }
+  *nstep += MG_MIN(step,mesh->ne);
 
-  /** Boundary hit or cyclic path: Perform exhaustive research */
+  /** Boundary hit or cyclic path: Perform research in the localization grid */
   if( step == (mesh->ne+1) ) {
-    if ( !mmgWarn0 ) {
-      mmgWarn0 = 1;
+    if ( PMMG_raise_warnFlag(&mmgWarn0) ) {
       if ( mesh->info.imprim > PMMG_VERB_DETQUAL ) {
         fprintf(stderr,"\n  ## Warning %s: Cannot locate point,"
-                " performing exhaustive research.\n",__func__);
+                " performing research in the localization grid.\n",__func__);
       }
     }
 
-    closestTet = 0;
-    closestDist = 1.0e10;
-    for( idxTet=1; idxTet<mesh->ne+1; idxTet++ ) {
-
-      /** Get tetra */
-      ptr = &mesh->tetra[idxTet];
-      if ( !MG_EOK(ptr) ) continue;
-
-      /*¨Skip already analized tetras */
-      if( ptr->flag == mesh->base ) continue;
-
-      adja = &mesh->adja[4*(idxTet-1)+1];
-      vol = ptr->qual;
-      eps = MMG5_EPS;
-
-      /** Mark tetra */
-      ptr->flag = mesh->base;
-
-      /** Get barycentric coordinates and sort them in ascending order */
-      PMMG_compute_baryCoord(mesh, ptr, ppt->c, &faceAreas[12*idxTet], barycoord);
-      qsort(barycoord,4,sizeof(PMMG_baryCoord),PMMG_compare_baryCoord);
-
-      /** Exit if inside the element */
-      if( barycoord[0].val > -eps ) break;
-
-      /** Save element index (with negative sign) if it is the closest one */
-      if( fabs(barycoord[0].val)*vol < closestDist ) {
-        closestDist = fabs(barycoord[0].val)*vol;
-        closestTet = -idxTet;
-      }
-
-    }
+    idxTet = PMMG_locate_searchGrid( mesh,ppt,grid,faceAreas,barycoord,
+                                     &closestTet,&closestDist );
 
     /** Element not found: Return the closest one with negative sign (if found) */
-    if ( idxTet == mesh->ne+1 ) {
-      if ( !mmgWarn1 ) {
-        mmgWarn1 = 1;
+    if ( !idxTet ) {
+      if ( PMMG_raise_warnFlag(&mmgWarn1) ) {
         if ( mesh->info.imprim > PMMG_VERB_VERSION ) {
           fprintf(stderr,"\n  ## Warning %s: Point not located, smallest external volume %e.",
                   __func__,closestDist);
         }
       }
-      return closestTet;
+      return -closestTet;
     }
 
   }
@@ -244,41 +168,38 @@ int PMMG_locatePoint( MMG5_pMesh mesh, MMG5_pPoint ppt, int init,
 }
 
 /**
- * \param grp pointer to the current group structure
- * \param oldGrp pointer to the bqckground group structure
- * \param pt pointer to the target background tetrahedron
- * \param ip index of the current point
- * \param phi barycentric coordinates of the point to be interpolated
- *
- * \return 0 if fail, 1 if success
+ * \param nitem number of points to interpolate.
+ * \param sorted indices of the points to interpolate.
+ * \param vert indices of the 4 background vertices of each point.
+ * \param phi barycentric coordinates of each point w.r.t. its 4 background
+ * vertices.
+ * \param nsize number of components of the field.
+ * \param oldm values of the field on the background mesh.
+ * \param m values of the field on the current mesh (filled at the listed
+ * points).
  *
- *  Linearly interpolate point metrics on a target background tetrahedron..
+ *  Linearly interpolate one field at a list of already located points: the
+ *  location stencil (vertices and weights) is shared by all the fields.
  *
  */
-int PMMG_interpMetrics_point( PMMG_pGrp grp,PMMG_pGrp oldGrp,MMG5_pTetra pt,
-                              int ip,PMMG_baryCoord *phi ) {
-  MMG5_pMesh     mesh;
-  MMG5_pSol      met,oldMet;
-  MMG5_pPoint    ppt;
-  int            iloc,i,isize,nsize,ier;
-
-  met    = grp->met;
-  oldMet = oldGrp->met;
-  mesh   = grp->mesh;
-  ppt    = &mesh->point[ip];
-  nsize  = met->size;
-
-  /** Linear interpolation of the metrics */
-  for( isize = 0; isize<nsize; isize++ ) {
-    met->m[nsize*ip+isize] = 0.0;
-    /* Barycentric coordinates could be permuted */
-    for( i=0; i<4; i++ ) {
-      iloc = phi[i].idx;
-      met->m[nsize*ip+isize] += phi[i].val*oldMet->m[nsize*pt->v[iloc]+isize];
+static inline
+void PMMG_interpField_batch( int nitem,PMMG_hilbertCell *sorted,int *vert,
+                             double *phi,int nsize,const double *oldm,
+                             double *m ) {
+  const int    *v;
+  const double *w;
+  double       *dst;
+  int          k,isize;
+
+  for( k = 0; k < nitem; k++ ) {
+    v   = &vert[4*k];
+    w   = &phi[4*k];
+    dst = &m[nsize*sorted[k].idx];
+    for( isize = 0; isize<nsize; isize++ ) {
+      dst[isize] = w[0]*oldm[nsize*v[0]+isize] + w[1]*oldm[nsize*v[1]+isize]
+        + w[2]*oldm[nsize*v[2]+isize] + w[3]*oldm[nsize*v[3]+isize];
     }
   }
-
-  return 1;
 }
 
 /**
@@ -288,54 +209,55 @@ int PMMG_interpMetrics_point( PMMG_pGrp grp,PMMG_pGrp oldGrp,MMG5_pTetra pt,
  *
  * \return 0 if fail, 1 if success
  *
- * Copy the metric of a freezed interface point.
+ * Copy the metric and the solution fields (and the displacement if any) of a
+ * freezed interface point.
  *
  */
-int PMMG_copyMetrics_point( PMMG_pGrp grp,PMMG_pGrp oldGrp, int* permNodGlob) {
+int PMMG_copyMetricsAndFields_point( PMMG_pGrp grp,PMMG_pGrp oldGrp,
+                                     int* permNodGlob) {
   MMG5_pMesh     mesh,oldMesh;
-  MMG5_pSol      met,oldMet;
+  MMG5_pSol      met,oldMet,disp,oldDisp;
   MMG5_pPoint    ppt;
-  int            isize,nsize,ip;
+  int            isize,nsize,ip,ipNew,ismet,isdisp;
 
   mesh    = grp->mesh;
-  if ( !mesh->info.inputMet || mesh->info.hsiz > 0.0 ) return 1;
-
   met     = grp->met;
+  disp    = grp->disp;
   oldMesh = oldGrp->mesh;
   oldMet  = oldGrp->met;
+  oldDisp = oldGrp->disp;
   nsize   = met->size;
 
+  ismet   = ( mesh->info.inputMet && mesh->info.hsiz <= 0.0 );
+  isdisp  = ( disp && disp->m && oldDisp && oldDisp->m );
+  if ( !ismet && !grp->sol && !isdisp ) return 1;
+
+  assert ( !grp->sol || (oldGrp->sol && oldMesh->nsols == mesh->nsols) );
+
 //#warning Luca: when surface adapt will be ready, distinguish BDY from PARBDY
 
-  /** Freezed points: Copy the  metrics  */
-  if ( (!oldGrp->mesh->info.renum) || !permNodGlob ) {
-    /* No permutation array: simple copy */
-    for( ip = 1; ip <= oldMesh->np; ++ip ) {
-      ppt = &oldMesh->point[ip];
-      if( !MG_VOK(ppt) ) continue;
+  /** Freezed points: Copy the metrics and the fields. Without permutation
+   * array, the points keep their indices, otherwise (scotch renumbering) we
+   * must copy from the old mesh to the new one. */
+  for( ip = 1; ip <= oldMesh->np; ++ip ) {
+    ppt = &oldMesh->point[ip];
+    if( !MG_VOK(ppt) ) continue;
 
-      ppt->flag = mesh->base;
-      if( ppt->tag & MG_REQ ) {
-        for( isize = 0; isize<nsize; isize++ ) {
-          met->m[nsize*ip+isize] = oldMet->m[nsize*ip+isize];
-        }
-      }
-    }
-  }
-  else {
-    /* Due to the scotch renumbering we must copy from the old mesh to the
-     * new one */
-    for( ip = 1; ip <= oldMesh->np; ++ip ) {
-      ppt = &oldMesh->point[ip];
-      if( !MG_VOK(ppt) ) continue;
+    ppt->flag = mesh->base;
+    if( !(ppt->tag & MG_REQ) ) continue;
 
-      ppt->flag = mesh->base;
-      if( ppt->tag & MG_REQ ) {
-        for( isize = 0; isize<nsize; isize++ ) {
-          met->m[nsize*permNodGlob[ip]+isize] = oldMet->m[nsize*ip+isize];
-        }
+    ipNew = ( (!oldGrp->mesh->info.renum) || !permNodGlob ) ? ip : permNodGlob[ip];
+
+    if ( ismet ) {
+      for( isize = 0; isize<nsize; isize++ ) {
+        met->m[nsize*ipNew+isize] = oldMet->m[nsize*ip+isize];
       }
     }
+    PMMG_fields_copyPoint( mesh,grp->sol,ipNew,oldGrp->sol,ip );
+    if ( isdisp ) {
+      memcpy(&disp->m[disp->size*ipNew],&oldDisp->m[disp->size*ip],
+             disp->size*sizeof(double));
+    }
   }
 
   return 1;
@@ -344,145 +266,325 @@ int PMMG_copyMetrics_point( PMMG_pGrp grp,PMMG_pGrp oldGrp, int* permNodGlob) {
 
 /**
  * \param parmesh pointer to the parmesh structure.
- * \param permNodGlob permutation array of nodes.
+ * \param igrp index of the group to interpolate.
+ * \param faceAreas oriented face areas of the background mesh of the group.
+ * \param grid localization grid of the background mesh of the group.
+ * \param logMet logarithms of the background metrics of the group, NULL for a
+ * linear interpolation of the metrics.
  *
  * \return 0 if fail, 1 if success
  *
- *  Interpolate metrics for all groups from background to current meshes.
- *  Do nothing if no metrics is provided (info.inputMet == 0), otherwise:
- *  - if the metrics is constant, recompute it;
- *  - else, interpolate the non-constant metrics.
+ *  Interpolate the metrics, the solution fields and the displacement of the
+ *  group \a igrp from its background mesh. The points to interpolate are
+ *  sorted along a Hilbert curve before being located so successive points are
+ *  close to each other: the localization of a point starts from the element
+ *  of the previous one and the adjacency walks are short.
+ *
+ *  Each point is located only once: its background vertices and barycentric
+ *  coordinates are stored and reused to interpolate every field. The working
+ *  arrays are allocated on the group mesh.
+ *
+ *  In log-Euclidean mode, the logarithms of the metrics are interpolated, then
+ *  the interpolated values are passed to the exponential by batches.
  *
  */
-int PMMG_interpMetrics_grps( PMMG_pParMesh parmesh,int *permNodGlob ) {
+static
+int PMMG_interpMetricsAndFields_grp( PMMG_pParMesh parmesh,int igrp,
+                                     double *faceAreas,PMMG_locateGrid *grid,
+                                     double *logMet ) {
   PMMG_pGrp   grp,oldGrp;
   MMG5_pMesh  mesh,oldMesh;
   MMG5_pTetra pt;
   MMG5_pPoint ppt;
+  PMMG_coorCell    *list;
+  PMMG_hilbertCell *sorted;
   PMMG_baryCoord barycoord[4];
-  double      **faceAreas,*normal;
-  int         igrp,ip,istart,ie,ifac,ia,ib,ic,iloc;
-  int         ier;
+  mytime      ctim;
+  double      buf[6*PMMG_LOGMET_BATCH],*phi;
+  int         ip,istart,ie,iloc,i,j,k,l,nb,nsize,nitem,nstep,ier;
+  int         *vert,ismet,isdisp,nsols;
   static int  mmgWarn=0;
 
-  /** Pre-compute oriented face areas */
-  PMMG_MALLOC( parmesh,faceAreas,parmesh->nold_grp,double*,"faceAreas pointer",return 0);
+  grp = &parmesh->listgrp[igrp];
+  mesh = grp->mesh;
+  oldGrp = &parmesh->old_listgrp[igrp];
+  oldMesh = oldGrp->mesh;
 
-  for( igrp = 0; igrp < parmesh->nold_grp; igrp++ ) {
-    grp = &parmesh->old_listgrp[igrp];
-    mesh = grp->mesh;
+  ismet = ( mesh->info.inputMet == 1 );
+
+  if( ismet && mesh->info.hsiz > 0.0 ) {
+
+    /* Compute constant metrics */
+    if ( !MMG3D_Set_constantSize(mesh,grp->met) ) return 0;
+
+    ismet = 0;
+  }
+
+  nsols  = grp->sol ? mesh->nsols : 0;
+  isdisp = ( grp->disp && grp->disp->m && oldGrp->disp && oldGrp->disp->m );
+
+  if ( !ismet && !nsols && !isdisp ) {
 
-    ier = 1;
-    PMMG_MALLOC( parmesh,faceAreas[igrp],12*(mesh->ne+1),double,"faceAreas",ier=0 );
-    if( !ier ) {
-      int igrp1;
-      for( igrp1 = 0; igrp1 < igrp; igrp1++ )
-        PMMG_DEL_MEM(parmesh,faceAreas[igrp1],double,"faceAreas");
-      PMMG_DEL_MEM(parmesh,faceAreas,double*,"faceAreas pointer");
+    /* Nothing to do */
+    return 1;
+
+  }
+
+  assert ( !nsols || (oldGrp->sol && oldMesh->nsols == nsols) );
+
+  /* Interpolate metrics and fields */
+  oldMesh->base = 0;
+  for ( ie = 1; ie < oldMesh->ne+1; ie++ ) {
+    pt = &oldMesh->tetra[ie];
+    if ( !MG_EOK(pt) ) continue;
+    pt->flag = oldMesh->base;
+  }
+
+  /** List the points to interpolate */
+  PMMG_MALLOC( mesh,list,mesh->np,PMMG_coorCell,"points to interpolate",return 0 );
+  PMMG_MALLOC( mesh,sorted,mesh->np,PMMG_hilbertCell,"sorted points",
+               PMMG_DEL_MEM(mesh,list,PMMG_coorCell,"points to interpolate");
+               return 0 );
+
+  mesh->base++;
+  nitem = 0;
+
+  for( ie = 1; ie <= mesh->ne; ie++ ) {
+    pt = &mesh->tetra[ie];
+    if( !MG_EOK(pt) ) continue;
+    for( iloc = 0; iloc < 4; iloc++ ) {
+      ip = pt->v[iloc];
+      ppt = &mesh->point[ip];
+      if( !MG_VOK(ppt) ) continue;
+
+      /* Skip already listed points */
+      if( ppt->flag == mesh->base ) continue;
+
+      /* Flag point as interpolated */
+      ppt->flag = mesh->base;
+
+      /* Required points are treated by copyMetricsAndFields_point */
+      if( ppt->tag & MG_REQ ) continue;
+
+      assert ( nitem < mesh->np );
+      list[nitem].c[0] = ppt->c[0];
+      list[nitem].c[1] = ppt->c[1];
+      list[nitem].c[2] = ppt->c[2];
+      list[nitem].idx  = ip;
+      ++nitem;
+    }
+  }
+
+  /** Sort the points along the Hilbert curve */
+  ier = PMMG_hilbertSort_coorCellList( list,nitem,sorted );
+  PMMG_DEL_MEM(mesh,list,PMMG_coorCell,"points to interpolate");
+  if ( !ier ) {
+    PMMG_DEL_MEM(mesh,sorted,PMMG_hilbertCell,"sorted points");
+    return 0;
+  }
+
+  /** Interpolation stencils: background vertices and barycentric coordinates
+   * of each point */
+  vert = NULL;
+  phi  = NULL;
+  PMMG_MALLOC( mesh,vert,4*nitem,int,"interpolation vertices",ier = 0 );
+  if ( ier ) {
+    PMMG_MALLOC( mesh,phi,4*nitem,double,"interpolation weights",ier = 0 );
+  }
+  if ( !ier ) {
+    PMMG_DEL_MEM(mesh,vert,int,"interpolation vertices");
+    PMMG_DEL_MEM(mesh,sorted,PMMG_hilbertCell,"sorted points");
+    return 0;
+  }
+
+  /** Locate the points in the old mesh */
+  if ( parmesh->info.imprim > PMMG_VERB_DETQUAL ) {
+    tminit(&ctim,1);
+    chrono(ON,&ctim);
+  }
+
+  istart = 0;
+  nstep  = 0;
+  for( k = 0; k < nitem; k++ ) {
+    ip  = sorted[k].idx;
+    ppt = &mesh->point[ip];
+
+    /** Locate point in the old mesh */
+    istart = PMMG_locatePoint( oldMesh, ppt, istart,
+                               faceAreas, grid, barycoord, &nstep );
+    if( !istart ) {
+      fprintf(stderr,"\n  ## Error: %s: proc %d (grp %d),"
+              " point %d not found, coords %e %e %e\n",__func__,
+              parmesh->myrank,igrp,ip, mesh->point[ip].c[0],
+              mesh->point[ip].c[1],mesh->point[ip].c[2]);
+      PMMG_DEL_MEM(mesh,phi,double,"interpolation weights");
+      PMMG_DEL_MEM(mesh,vert,int,"interpolation vertices");
+      PMMG_DEL_MEM(mesh,sorted,PMMG_hilbertCell,"sorted points");
       return 0;
+    } else if( istart < 0 ) {
+      if ( PMMG_raise_warnFlag(&mmgWarn) ) {
+        if ( mesh->info.imprim > PMMG_VERB_VERSION ) {
+          fprintf(stderr,"\n  ## Warning: %s: proc %d (grp %d), point %d not"
+                  " found, coords %e %e %e\n",__func__,parmesh->myrank,
+                  igrp,ip, mesh->point[ip].c[0],mesh->point[ip].c[1],
+                  mesh->point[ip].c[2]);
+        }
+      }
+      istart = -istart;
     }
 
-    for( ie = 1; ie <= mesh->ne; ie++ ) {
-      pt = &mesh->tetra[ie];
-      /* Store tetra volume in the qual field */
-      pt->qual = MMG5_orvol( mesh->point, pt->v );
-      /* Store oriented face normals */
-      for( ifac = 0; ifac < 4; ifac++ ) {
-        normal = &faceAreas[igrp][12*ie+3*ifac];
-        ia = pt->v[MMG5_idir[ifac][0]];
-        ib = pt->v[MMG5_idir[ifac][1]];
-        ic = pt->v[MMG5_idir[ifac][2]];
-        ier = MMG5_nonUnitNorPts( mesh,ia,ib,ic,normal );
+    /** Store the stencil (barycentric coordinates could be permuted) */
+    pt = &oldMesh->tetra[istart];
+    for( i = 0; i < 4; i++ ) {
+      vert[4*k+i] = pt->v[barycoord[i].idx];
+      phi[4*k+i]  = barycoord[i].val;
+    }
+  }
+
+  if ( parmesh->info.imprim > PMMG_VERB_DETQUAL && nitem ) {
+    chrono(OFF,&ctim);
+    fprintf(stdout,"         proc %d (grp %d): %d located points,"
+            " mean walk length %.2f, %.3e locates/s\n",parmesh->myrank,igrp,
+            nitem,(double)nstep/nitem,
+            ctim.gdif > 0. ? nitem/ctim.gdif : 0.);
+  }
+
+  /** Interpolate the metrics */
+  if ( ismet ) {
+    nsize = grp->met->size;
+    PMMG_interpField_batch( nitem,sorted,vert,phi,nsize,
+                            logMet ? logMet : oldGrp->met->m,grp->met->m );
+
+    /* Log-Euclidean interpolation: come back from the logarithms */
+    if ( logMet ) {
+      for( k = 0; k < nitem; k += PMMG_LOGMET_BATCH ) {
+        nb = MG_MIN( PMMG_LOGMET_BATCH,nitem-k );
+        for( l = 0; l < nb; l++ ) {
+          memcpy(&buf[nsize*l],&grp->met->m[nsize*sorted[k+l].idx],
+                 nsize*sizeof(double));
+        }
+        PMMG_expMetrics_batch( nsize,buf,buf,nb );
+        for( l = 0; l < nb; l++ ) {
+          memcpy(&grp->met->m[nsize*sorted[k+l].idx],&buf[nsize*l],
+                 nsize*sizeof(double));
+        }
       }
     }
   }
 
+  /** Interpolate the solution fields and the displacement */
+  for ( j = 0; j < nsols; ++j ) {
+    assert ( grp->sol[j].size == oldGrp->sol[j].size );
+    PMMG_interpField_batch( nitem,sorted,vert,phi,grp->sol[j].size,
+                            oldGrp->sol[j].m,grp->sol[j].m );
+  }
 
-  /** Loop on current groups */
-  for( igrp = 0; igrp < parmesh->ngrp; igrp++ ) {
-    grp = &parmesh->listgrp[igrp];
-    mesh = grp->mesh;
+  if ( isdisp ) {
+    PMMG_interpField_batch( nitem,sorted,vert,phi,grp->disp->size,
+                            oldGrp->disp->m,grp->disp->m );
+  }
 
-    if( mesh->info.inputMet != 1 ) {
+  PMMG_DEL_MEM(mesh,phi,double,"interpolation weights");
+  PMMG_DEL_MEM(mesh,vert,int,"interpolation vertices");
+  PMMG_DEL_MEM(mesh,sorted,PMMG_hilbertCell,"sorted points");
 
-      /* Nothing to do */
-      continue;
+  return 1;
+}
 
-    } else {
+/**
+ * \param parmesh pointer to the parmesh structure.
+ *
+ * \return 0 if fail, 1 if success
+ *
+ *  Interpolate metrics, solution fields and displacement for all groups from
+ *  background to current meshes. For the metrics:
+ *  - nothing is done if no metrics is provided (info.inputMet == 0);
+ *  - if the metrics is constant, it is recomputed;
+ *  - else, the non-constant metrics is interpolated (linearly or, in
+ *  log-Euclidean mode, through their logarithms that are computed once for
+ *  each background group).
+ *  The solution fields and the displacement (if allocated) are linearly
+ *  interpolated with the same point localization as the metrics.
+ *
+ */
+int PMMG_interpMetricsAndFields_grps( PMMG_pParMesh parmesh ) {
+  PMMG_pGrp   grp;
+  MMG5_pMesh  mesh;
+  PMMG_locateGrid *grids;
+  double      **faceAreas,**logMet;
+  size_t      available,oldMemMax;
+  int         igrp,ie,logInterp;
+  int         ier;
 
-      if( mesh->info.hsiz > 0.0 ) {
+  /** Pre-compute oriented face areas and localization grids */
+  PMMG_SCRATCH_CALLOC( parmesh,faceAreas,parmesh->nold_grp,double*,"faceAreas pointer",return 0);
+  PMMG_SCRATCH_CALLOC( parmesh,grids,parmesh->nold_grp,PMMG_locateGrid,"locate grids",
+                       PMMG_DEL_MEM(parmesh,faceAreas,double*,"faceAreas pointer");
+                       return 0 );
+  PMMG_SCRATCH_CALLOC( parmesh,logMet,parmesh->nold_grp,double*,"logMet pointer",
+                       PMMG_DEL_MEM(parmesh,grids,PMMG_locateGrid,"locate grids");
+                       PMMG_DEL_MEM(parmesh,faceAreas,double*,"faceAreas pointer");
+                       return 0 );
+
+  ier = 1;
+  for( igrp = 0; igrp < parmesh->nold_grp; igrp++ ) {
+    grp = &parmesh->old_listgrp[igrp];
+    mesh = grp->mesh;
 
-        /* Compute constant metrics */
-        if ( !MMG3D_Set_constantSize(mesh,grp->met) ) return 0;
+    PMMG_MALLOC( parmesh,faceAreas[igrp],PMMG_LOCATE_FACEAREAS_SIZE*(mesh->ne+1),
+                 double,"faceAreas",ier=0 );
+    if( !ier ) goto end;
 
-      } else {
+    for( ie = 1; ie <= mesh->ne; ie++ ) {
+      PMMG_compute_faceAreas( mesh,ie,
+                              &faceAreas[igrp][PMMG_LOCATE_FACEAREAS_SIZE*ie] );
+    }
 
-        /* Interpolate metrics */
-        oldGrp = &parmesh->old_listgrp[igrp];
-        oldMesh = oldGrp->mesh;
+    if ( !PMMG_locate_buildGrid( parmesh,mesh,&grids[igrp] ) ) {
+      ier = 0;
+      goto end;
+    }
 
-        oldMesh->base = 0;
-        for ( ie = 1; ie < oldMesh->ne+1; ie++ ) {
-          pt = &oldMesh->tetra[ie];
-          if ( !MG_EOK(pt) ) continue;
-          pt->flag = oldMesh->base;
-        }
+    /** Log-Euclidean mode: compute the logarithms of the background metrics */
+    logInterp = ( parmesh->info.metinterp_mode == PMMG_METINTERP_logEuclidean &&
+                  mesh->info.inputMet == 1 && mesh->info.hsiz <= 0.0 &&
+                  grp->met && grp->met->m );
+    if ( logInterp ) {
+      PMMG_MALLOC( parmesh,logMet[igrp],grp->met->size*(mesh->np+1),
+                   double,"logMet",ier=0 );
+      if( !ier ) goto end;
 
-        mesh->base++;
-        istart = 1;
-
-        for( ie = 1; ie <= mesh->ne; ie++ ) {
-          pt = &mesh->tetra[ie];
-          if( !MG_EOK(pt) ) continue;
-          for( iloc = 0; iloc < 4; iloc++ ) {
-            ip = pt->v[iloc];
-            ppt = &mesh->point[ip];
-            if( !MG_VOK(ppt) ) continue;
-
-            /* Skip already interpolated points */
-            if( ppt->flag == mesh->base ) continue;
-
-            if( ppt->tag & MG_REQ ) {
-              continue; // treated by copyMetric_points
-            } else {
-
-              /** Locate point in the old mesh */
-              istart = PMMG_locatePoint( oldMesh, ppt, istart,
-                                         faceAreas[igrp], barycoord );
-              if( !istart ) {
-                fprintf(stderr,"\n  ## Error: %s: proc %d (grp %d),"
-                        " point %d not found, coords %e %e %e\n",__func__,
-                        parmesh->myrank,igrp,ip, mesh->point[ip].c[0],
-                        mesh->point[ip].c[1],mesh->point[ip].c[2]);
-                return 0;
-              } else if( istart < 0 ) {
-                if ( !mmgWarn ) {
-                  mmgWarn = 1;
-                  if ( mesh->info.imprim > PMMG_VERB_VERSION ) {
-                    fprintf(stderr,"\n  ## Warning: %s: proc %d (grp %d), point %d not"
-                            " found, coords %e %e %e\n",__func__,parmesh->myrank,
-                            igrp,ip, mesh->point[ip].c[0],mesh->point[ip].c[1],
-                            mesh->point[ip].c[2]);
-                  }
-                }
-                istart = -istart;
-              }
-  
-              /** Interpolate point metrics */
-              ier = PMMG_interpMetrics_point(grp,oldGrp,&oldMesh->tetra[istart],
-                                             ip,barycoord);
-            }
-
-            /* Flag point as interpolated */
-            ppt->flag = mesh->base;
-          }
-        }
-      }
+      PMMG_logMetrics_mesh( mesh,grp->met,logMet[igrp] );
     }
+  }
+
 
+  /** Loop on current groups (groups are independent and may be treated
+   * concurrently): give the available memory to the group meshes */
+  PMMG_TRANSFER_AVMEM_TO_MESHES(parmesh);
+
+#ifdef USE_OPENMP
+#pragma omp parallel for schedule(dynamic,1) reduction(min:ier)
+#endif
+  for( igrp = 0; igrp < parmesh->ngrp; igrp++ ) {
+    if ( !PMMG_interpMetricsAndFields_grp( parmesh,igrp,faceAreas[igrp],
+                                           &grids[igrp],logMet[igrp] ) ) {
+      ier = 0;
+    }
   }
-  for( igrp = 0; igrp < parmesh->nold_grp; igrp++)
+
+end:
+  for( igrp = 0; igrp < parmesh->nold_grp; igrp++) {
+    PMMG_locate_freeGrid( parmesh,&grids[igrp] );
     PMMG_DEL_MEM( parmesh,faceAreas[igrp],double,"faceAreas");
+    PMMG_DEL_MEM( parmesh,logMet[igrp],double,"logMet");
+  }
+  PMMG_DEL_MEM( parmesh,logMet,double*,"logMet pointer");
+  PMMG_DEL_MEM( parmesh,grids,PMMG_locateGrid,"locate grids");
   PMMG_DEL_MEM( parmesh,faceAreas,double*,"faceAreas pointer");
-  return 1;
+
+  /* Give the available memory back to the parmesh */
+  PMMG_TRANSFER_AVMEM_TO_PARMESH(parmesh,available,oldMemMax);
+
+  return ier;
 }
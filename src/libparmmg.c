@@ -122,6 +122,7 @@ int PMMG_check_inputData(PMMG_pParMesh parmesh)
  */
 int PMMG_analys_buildComm(PMMG_pParMesh parmesh,MMG5_pMesh mesh) {
   MMG5_Hash      hash;
+  int            ier;
 
   /**--- stage 1: data structures for surface */
   if ( abs(mesh->info.imprim) > 3 )
@@ -232,7 +233,10 @@ int PMMG_analys_buildComm(PMMG_pParMesh parmesh,MMG5_pMesh mesh) {
       PMMG_DEL_MEM(parmesh, parmesh->ext_face_comm,PMMG_Ext_comm,"ext face comm");
       parmesh->next_face_comm = 0;
       PMMG_DEL_MEM(parmesh, parmesh->int_face_comm,PMMG_Int_comm,"int face comm");
-      if ( !PMMG_build_faceCommFromNodes(parmesh) ) return PMMG_STRONGFAILURE;
+      PMMG_TRACE_BEGIN( "build face comms" );
+      ier = PMMG_build_faceCommFromNodes(parmesh);
+      PMMG_TRACE_END( "build face comms" );
+      if ( !ier ) return PMMG_STRONGFAILURE;
       break;
   }
 
@@ -367,6 +371,7 @@ int PMMG_preprocessMesh_distributed( PMMG_pParMesh parmesh )
 {
   MMG5_pMesh mesh;
   MMG5_pSol  met;
+  int        ier;
 
   mesh = parmesh->listgrp[0].mesh;
   met  = parmesh->listgrp[0].met;
@@ -441,7 +446,10 @@ int PMMG_preprocessMesh_distributed( PMMG_pParMesh parmesh )
     parmesh->next_node_comm = 0;
     PMMG_DEL_MEM(parmesh, parmesh->int_node_comm,PMMG_Int_comm,"int node comm");
     PMMG_CALLOC(parmesh,parmesh->int_node_comm,1,PMMG_Int_comm,"int node comm",return 0);
-    if ( !PMMG_build_nodeCommFromFaces(parmesh) ) {
+    PMMG_TRACE_BEGIN( "build node comms" );
+    ier = PMMG_build_nodeCommFromFaces(parmesh);
+    PMMG_TRACE_END( "build node comms" );
+    if ( !ier ) {
       return PMMG_STRONGFAILURE;
     }
   }
@@ -550,13 +558,55 @@ int PMMG_distributeMesh_centralized_timers( PMMG_pParMesh parmesh,mytime *ctim )
   return iresult;
 }
 
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ *
+ * \return 0 if fail, 1 if success.
+ *
+ * Give all the available memory to the mesh of the first group, shrink its
+ * arrays to their used size and rebuild its boundary triangles.
+ *
+ */
+static
+int PMMG_packUpMesh( PMMG_pParMesh parmesh ) {
+  MMG5_pMesh mesh;
+  int        npmax,xpmax,nemax,xtmax;
+  long int   tmpmem;
+
+  /** All the memory is devoted to the mesh **/
+  tmpmem = parmesh->memMax - parmesh->memCur;
+  parmesh->memMax = parmesh->memCur;
+  parmesh->listgrp[0].mesh->memMax += tmpmem;
+
+  mesh  = parmesh->listgrp[0].mesh;
+  npmax = mesh->npmax;
+  nemax = mesh->nemax;
+  xpmax = mesh->xpmax;
+  xtmax = mesh->xtmax;
+  mesh->npmax = mesh->np;
+  mesh->nemax = mesh->ne;
+  mesh->xpmax = mesh->xp;
+  mesh->xtmax = mesh->xt;
+
+  if ( !PMMG_setMemMax_realloc( mesh, npmax, xpmax, nemax, xtmax ) ) {
+    fprintf(stdout,"\n\n\n  -- LACK OF MEMORY\n\n\n");
+    return 0;
+  }
+
+  if ( (!MMG3D_hashTetra( mesh, 0 )) || (-1 == MMG3D_bdryBuild( mesh )) ) {
+    /** Impossible to rebuild the triangle */
+    fprintf(stdout,"\n\n\n  -- IMPOSSIBLE TO BUILD THE BOUNDARY MESH\n\n\n");
+    return 0;
+  }
+
+  return 1;
+}
+
 int PMMG_parmmglib_centralized(PMMG_pParMesh parmesh) {
   PMMG_pGrp     grp;
-  MMG5_pMesh    mesh;
   MMG5_pSol     met;
   int           ier;
-  int           iresult,ierlib,npmax,xpmax,nemax,xtmax;
-  long int      tmpmem;
+  int           iresult,ierlib;
   mytime        ctim[TIMEMAX];
   int8_t        tim;
   char          stim[32];
@@ -572,12 +622,13 @@ int PMMG_parmmglib_centralized(PMMG_pParMesh parmesh) {
   tminit(ctim,TIMEMAX);
   chrono(ON,&(ctim[0]));
 
+  PMMG_timer_start( parmesh,PMMG_PHASE_INIT );
+
   /* Distribute the mesh */
   ier = PMMG_distributeMesh_centralized_timers( parmesh, ctim );
   if( ier != PMMG_SUCCESS ) return ier;
 
   grp    = &parmesh->listgrp[0];
-  mesh   = grp->mesh;
   met    = grp->met;
 
   /** Remeshing */
@@ -588,6 +639,7 @@ int PMMG_parmmglib_centralized(PMMG_pParMesh parmesh) {
              met->size < 6 ? "ISOTROPIC" : "ANISOTROPIC" );
   }
 
+  PMMG_timer_stop( parmesh,PMMG_PHASE_INIT );
   ier = PMMG_parmmglib1(parmesh);
   MPI_Allreduce( &ier, &ierlib, 1, MPI_INT, MPI_MAX, parmesh->comm );
 
@@ -601,7 +653,27 @@ int PMMG_parmmglib_centralized(PMMG_pParMesh parmesh) {
   }
 
 //#warning remove the lib_centralized and lib_distributed library to have modular centralized input + annalysis or parallel input + analysis , libparmmg1 call, then centralized or distributed output
-  switch ( parmesh->info.fmtout ) {
+  if ( parmesh->info.distributed_output ) {
+    // Distributed Output: each process packs up its own mesh
+    tim = 4;
+    chrono(ON,&(ctim[tim]));
+    if ( parmesh->info.imprim > PMMG_VERB_VERSION ) {
+      fprintf(stdout,"\n   -- PHASE 3 : MESH PACKED UP\n");
+    }
+
+    ier = ( parmesh->ngrp ) ? PMMG_packUpMesh( parmesh ) : 1;
+    MPI_Allreduce( &ier, &iresult, 1, MPI_INT, MPI_MIN, parmesh->comm );
+    if ( !iresult ) {
+      PMMG_CLEAN_AND_RETURN(parmesh,PMMG_LOWFAILURE);
+    }
+
+    chrono(OFF,&(ctim[tim]));
+    if ( parmesh->info.imprim > PMMG_VERB_VERSION ) {
+      printim(ctim[tim].gdif,stim);
+      fprintf(stdout,"   -- PHASE 3 COMPLETED.     %s\n",stim);
+    }
+  }
+  else switch ( parmesh->info.fmtout ) {
   case ( MMG5_FMT_VtkPvtu ):
     // Distributed Output
 //#warning boundaries arent rebuilded
@@ -635,29 +707,7 @@ int PMMG_parmmglib_centralized(PMMG_pParMesh parmesh) {
         fprintf( stdout,"\n   -- PHASE 4 : MESH PACKED UP\n" );
       }
 
-      tmpmem = parmesh->memMax - parmesh->memCur;
-      parmesh->memMax = parmesh->memCur;
-      parmesh->listgrp[0].mesh->memMax += tmpmem;
-
-      mesh = parmesh->listgrp[0].mesh;
-      mesh  = parmesh->listgrp[0].mesh;
-      npmax = mesh->npmax;
-      nemax = mesh->nemax;
-      xpmax = mesh->xpmax;
-      xtmax = mesh->xtmax;
-      mesh->npmax = mesh->np;
-      mesh->nemax = mesh->ne;
-      mesh->xpmax = mesh->xp;
-      mesh->xtmax = mesh->xt;
-
-      if ( !PMMG_setMemMax_realloc( mesh, npmax, xpmax, nemax, xtmax ) ) {
-        fprintf(stdout,"\n\n\n  -- LACK OF MEMORY\n\n\n");
-        PMMG_CLEAN_AND_RETURN(parmesh,PMMG_LOWFAILURE);
-      }
-
-      if ( (!MMG3D_hashTetra( mesh, 0 )) || (-1 == MMG3D_bdryBuild( mesh )) ) {
-        /** Impossible to rebuild the triangle */
-        fprintf(stdout,"\n\n\n  -- IMPOSSIBLE TO BUILD THE BOUNDARY MESH\n\n\n");
+      if ( !PMMG_packUpMesh( parmesh ) ) {
         PMMG_CLEAN_AND_RETURN(parmesh,PMMG_LOWFAILURE);
       }
 
@@ -683,8 +733,7 @@ int PMMG_parmmglib_centralized(PMMG_pParMesh parmesh) {
 int PMMG_parmmglib_distributed(PMMG_pParMesh parmesh) {
   MMG5_pMesh       mesh;
   MMG5_pSol        met;
-  int              ier,iresult,ierlib,nepax,npmax,nemax,xpmax,xtmax;
-  long int         tmpmem;
+  int              ier,iresult,ierlib,nepax;
   mytime           ctim[TIMEMAX];
   int8_t           tim;
   char             stim[32];
@@ -701,6 +750,8 @@ int PMMG_parmmglib_distributed(PMMG_pParMesh parmesh) {
   tminit(ctim,TIMEMAX);
   chrono(ON,&(ctim[0]));
 
+  PMMG_timer_start( parmesh,PMMG_PHASE_INIT );
+
   /** Check input data */
   tim = 1;
   chrono(ON,&(ctim[tim]));
@@ -754,6 +805,7 @@ int PMMG_parmmglib_distributed(PMMG_pParMesh parmesh) {
              met->size < 6 ? "ISOTROPIC" : "ANISOTROPIC" );
   }
 
+  PMMG_timer_stop( parmesh,PMMG_PHASE_INIT );
   ier = PMMG_parmmglib1(parmesh);
   MPI_Allreduce( &ier, &ierlib, 1, MPI_INT, MPI_MAX, parmesh->comm );
 
@@ -772,28 +824,7 @@ int PMMG_parmmglib_distributed(PMMG_pParMesh parmesh) {
   if ( parmesh->info.imprim > PMMG_VERB_VERSION )
     fprintf(stdout,"\n   -- PHASE 3 : MESH PACKED UP\n");
 
-  /** All the memory is devoted to the mesh **/
-  tmpmem = parmesh->memMax - parmesh->memCur;
-  parmesh->memMax = parmesh->memCur;
-  parmesh->listgrp[0].mesh->memMax += tmpmem;
-
-  mesh  = parmesh->listgrp[0].mesh;
-  npmax = mesh->npmax;
-  nemax = mesh->nemax;
-  xpmax = mesh->xpmax;
-  xtmax = mesh->xtmax;
-  mesh->npmax = mesh->np;
-  mesh->nemax = mesh->ne;
-  mesh->xpmax = mesh->xp;
-  mesh->xtmax = mesh->xt;
-  if ( !PMMG_setMemMax_realloc( mesh, npmax, xpmax, nemax, xtmax ) ) {
-    fprintf(stdout,"\n\n\n  -- LACK OF MEMORY\n\n\n");
-    PMMG_CLEAN_AND_RETURN(parmesh,PMMG_LOWFAILURE);
-  }
-
-  if ( (!MMG3D_hashTetra( mesh, 0 )) || ( -1 == MMG3D_bdryBuild(parmesh->listgrp[0].mesh) ) ) {
-    /** Impossible to rebuild the triangle **/
-    fprintf(stdout,"\n\n\n  -- IMPOSSIBLE TO BUILD THE BOUNDARY MESH\n\n\n");
+  if ( !PMMG_packUpMesh( parmesh ) ) {
     PMMG_CLEAN_AND_RETURN(parmesh,PMMG_LOWFAILURE);
   }
 
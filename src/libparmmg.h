@@ -76,8 +76,18 @@ enum PMMG_Param {
   PMMG_IPARAM_metisRatio,        /*!< [n], wanted ratio # mesh / # metis super nodes (advanced use) */
   PMMG_IPARAM_ifcLayers,         /*!< [n], Number of layers of interface displacement */
   PMMG_DPARAM_groupsRatio,       /*!< [val], Allowed imbalance between current and desired groups size */
+  PMMG_DPARAM_repartItr,         /*!< [val], Ratio between edge cut and migration cost for the adaptive repartitioning */
+  PMMG_DPARAM_balanceThreshold,  /*!< [val], Predicted work imbalance under which the graph load balancing is skipped (0: never skip) */
   PMMG_IPARAM_APImode,           /*!< [0/1], Initialize parallel library through interface faces or nodes */
   PMMG_IPARAM_niter,             /*!< [n], Set the number of remeshing iterations */
+  PMMG_IPARAM_metInterp,         /*!< [0/1], Metrics interpolation: linear or log-Euclidean */
+  PMMG_IPARAM_distributedOutput, /*!< [0/1/2], Merge the meshes, save one mesh per process or one shared file */
+  PMMG_IPARAM_sharedInput,       /*!< [0/1], Read the input mesh by slabs on all the processes (MPI-IO) */
+  PMMG_IPARAM_metisWeights,      /*!< [0/1/2], Balance partitions on element count, on the metric-predicted or on the measured remeshing cost */
+  PMMG_IPARAM_adaptiveRepart,    /*!< [0/1], Repartition the groups from their current distribution (ParMetis adaptive repartitioning) */
+  PMMG_IPARAM_arenaSize,         /*!< [n], Size in Mbytes of the chunks of the scratch memory arena (0: no arena) */
+  PMMG_IPARAM_memProfile,        /*!< [0/1], Profile the memory per allocation label (report in name.memprof.json) */
+  PMMG_IPARAM_timingReport,      /*!< [0/1], Save the phases timers reduced over the processes (report in name.timers.json) */
   PMMG_DPARAM_angleDetection,    /*!< [val], Value for angle detection */
   PMMG_DPARAM_hmin,              /*!< [val], Minimal mesh size */
   PMMG_DPARAM_hmax,              /*!< [val], Maximal mesh size */
@@ -1866,6 +1876,148 @@ int PMMG_usage( PMMG_pParMesh parmesh, char * const prog);
  *
  */
   int PMMG_saveAllSols_centralized(PMMG_pParMesh parmesh, const char *filename);
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ * \param filename pointer toward the name of file.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Save the mesh of each process in its own file at Medit format, without
+ * merging the meshes. The rank of the process is inserted before the file
+ * extension ("name.mesh" is saved as "name.<rank>.mesh"). The parallel face
+ * communicators are appended to each file as a "ParallelTriangles" section
+ * so the files can be read again by \ref PMMG_loadMesh_distributed (only one
+ * group per process is allowed).
+ *
+ * \remark Fortran interface:
+ * >   SUBROUTINE PMMG_SAVEMESH_DISTRIBUTED(parmesh,filename,strlen,retval)\n
+ * >     MMG5_DATA_PTR_T, INTENT(INOUT) :: parmesh\n
+ * >     CHARACTER(LEN=*), INTENT(IN)   :: filename\n
+ * >     INTEGER, INTENT(IN)            :: strlen\n
+ * >     INTEGER, INTENT(OUT)           :: retval\n
+ * >   END SUBROUTINE\n
+ *
+ */
+  int PMMG_saveMesh_distributed(PMMG_pParMesh parmesh, const char *filename);
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ * \param filename name of file.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Write the metrics of each process in its own file at medit format (the rank
+ * of the process is inserted before the file extension).
+ *
+ * \remark Fortran interface:
+ * >   SUBROUTINE PMMG_SAVEMET_DISTRIBUTED(parmesh,filename,strlen,retval)\n
+ * >     MMG5_DATA_PTR_T, INTENT(INOUT) :: parmesh\n
+ * >     CHARACTER(LEN=*), INTENT(IN)   :: filename\n
+ * >     INTEGER, INTENT(IN)            :: strlen\n
+ * >     INTEGER, INTENT(OUT)           :: retval\n
+ * >   END SUBROUTINE\n
+ *
+ */
+  int PMMG_saveMet_distributed(PMMG_pParMesh parmesh, const char *filename);
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ * \param filename name of file.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Write the solution fields of each process in its own file at medit format
+ * (the rank of the process is inserted before the file extension).
+ *
+ * \remark Fortran interface:
+ * >   SUBROUTINE PMMG_SAVEALLSOLS_DISTRIBUTED(parmesh,filename,strlen,retval)\n
+ * >     MMG5_DATA_PTR_T, INTENT(INOUT) :: parmesh\n
+ * >     CHARACTER(LEN=*), INTENT(IN)   :: filename\n
+ * >     INTEGER, INTENT(IN)            :: strlen\n
+ * >     INTEGER, INTENT(OUT)           :: retval\n
+ * >   END SUBROUTINE\n
+ *
+ */
+  int PMMG_saveAllSols_distributed(PMMG_pParMesh parmesh, const char *filename);
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ * \param meshin name of the mesh file.
+ * \param metin name of the metric file (its extension is replaced by ".solb"),
+ * NULL if no metric.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Load a mesh (and its facultative metric) at Medit binary format without
+ * reading it on one process: the processes read disjoint slabs of the files
+ * with collective MPI-IO calls, the tetrahedra are partitioned (with ParMetis
+ * if available) and sent to their owner, then each process receives its
+ * vertices, metrics and boundary triangles. The node communicators are built,
+ * so the mesh can be remeshed by \ref PMMG_parmmglib_distributed (only one
+ * group per process is allowed).
+ *
+ * \remark Fortran interface:
+ * >   SUBROUTINE PMMG_LOADMESH_MPIIO(parmesh,meshin,strlen0,metin,strlen1,retval)\n
+ * >     MMG5_DATA_PTR_T, INTENT(INOUT) :: parmesh\n
+ * >     CHARACTER(LEN=*), INTENT(IN)   :: meshin,metin\n
+ * >     INTEGER, INTENT(IN)            :: strlen0,strlen1\n
+ * >     INTEGER, INTENT(OUT)           :: retval\n
+ * >   END SUBROUTINE\n
+ *
+ */
+  int PMMG_loadMesh_mpiio(PMMG_pParMesh parmesh, const char *meshin,
+                          const char *metin);
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ * \param filename pointer toward the name of file.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Save the parallel mesh in one shared file at Medit binary format, without
+ * merging the meshes: all the processes write their own vertices, triangles
+ * and tetrahedra in the file with collective MPI-IO calls (only one group per
+ * process is allowed). The vertices are numbered globally and the triangles
+ * of the parallel interfaces are not saved. Only the vertices, triangles and
+ * tetrahedra are saved.
+ *
+ * \remark Fortran interface:
+ * >   SUBROUTINE PMMG_SAVEMESH_MPIIO(parmesh,filename,strlen,retval)\n
+ * >     MMG5_DATA_PTR_T, INTENT(INOUT) :: parmesh\n
+ * >     CHARACTER(LEN=*), INTENT(IN)   :: filename\n
+ * >     INTEGER, INTENT(IN)            :: strlen\n
+ * >     INTEGER, INTENT(OUT)           :: retval\n
+ * >   END SUBROUTINE\n
+ *
+ */
+  int PMMG_saveMesh_mpiio(PMMG_pParMesh parmesh, const char *filename);
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ * \param filename name of file (its extension is replaced by ".solb").
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Save the metrics in one shared file at Medit binary format with collective
+ * MPI-IO calls (see \ref PMMG_saveMesh_mpiio).
+ *
+ * \remark Fortran interface:
+ * >   SUBROUTINE PMMG_SAVEMET_MPIIO(parmesh,filename,strlen,retval)\n
+ * >     MMG5_DATA_PTR_T, INTENT(INOUT) :: parmesh\n
+ * >     CHARACTER(LEN=*), INTENT(IN)   :: filename\n
+ * >     INTEGER, INTENT(IN)            :: strlen\n
+ * >     INTEGER, INTENT(OUT)           :: retval\n
+ * >   END SUBROUTINE\n
+ *
+ */
+  int PMMG_saveMet_mpiio(PMMG_pParMesh parmesh, const char *filename);
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ * \param filename name of file (its extension is replaced by ".solb").
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Save the solution fields in one shared file at Medit binary format with
+ * collective MPI-IO calls (see \ref PMMG_saveMesh_mpiio).
+ *
+ * \remark Fortran interface:
+ * >   SUBROUTINE PMMG_SAVEALLSOLS_MPIIO(parmesh,filename,strlen,retval)\n
+ * >     MMG5_DATA_PTR_T, INTENT(INOUT) :: parmesh\n
+ * >     CHARACTER(LEN=*), INTENT(IN)   :: filename\n
+ * >     INTEGER, INTENT(IN)            :: strlen\n
+ * >     INTEGER, INTENT(OUT)           :: retval\n
+ * >   END SUBROUTINE\n
+ *
+ */
+  int PMMG_saveAllSols_mpiio(PMMG_pParMesh parmesh, const char *filename);
 
 int PMMG_savePvtuMesh(PMMG_pParMesh parmesh, const char * filename);
 
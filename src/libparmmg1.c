@@ -198,7 +198,7 @@ int PMMG_packParMesh( PMMG_pParMesh parmesh )
   MMG5_pMesh  mesh;
   MMG5_pSol   met;
   MMG5_pSol   disp;
-  int         np,nc,igrp;
+  int         np,nc,igrp,k;
 
   for ( igrp=0; igrp<parmesh->ngrp; ++igrp ) {
     grp                       = &parmesh->listgrp[igrp];
@@ -227,12 +227,21 @@ int PMMG_packParMesh( PMMG_pParMesh parmesh )
     if ( disp && disp->m )
       if ( !MMG3D_pack_sol(mesh,disp) ) return 0;
 
+    /* compact solution fields */
+    for ( k=0; grp->sol && k<mesh->nsols; ++k ) {
+      if ( grp->sol[k].m )
+        if ( !MMG3D_pack_sol(mesh,&grp->sol[k]) ) return 0;
+    }
+
     /** Store in tmp the pack index of each point and count the corner*/
     if ( !MMG3D_mark_packedPoints(mesh,&np,&nc) ) return 0;
 
     /* node index update in internal communicator */
     if ( !PMMG_update_node2intPackedVertices( grp ) ) return 0;
 
+    /* global indices update */
+    PMMG_gid_pack( mesh,grp );
+
     /** Update the element vertices indices */
     if ( !MMG3D_update_eltsVertices(mesh) ) return 0;
 
@@ -297,11 +306,13 @@ int PMMG_store_faceVerticesInIntComm( PMMG_pParMesh parmesh, int igrp,
 
   grp                 = &parmesh->listgrp[igrp];
   nitem_int_face_comm = grp->nitem_int_face_comm;
+  mesh                = grp->mesh;
 
-  PMMG_MALLOC(parmesh,*facesData,3*nitem_int_face_comm,int,"facesData",return 0);
+  /* The array is attached to the group mesh so the remeshing of distinct groups
+   * can be done concurrently */
+  PMMG_MALLOC(mesh,*facesData,3*nitem_int_face_comm,int,"facesData",return 0);
 
   face2int_face_comm_index1 = grp->face2int_face_comm_index1;
-  mesh                      = parmesh->listgrp[igrp].mesh;
   for ( k=0; k<nitem_int_face_comm; ++k ) {
     /** Get the vertices indices of the interface triangles */
     iel   =  face2int_face_comm_index1[k]/12;
@@ -427,7 +438,7 @@ hash:
   MMG5_DEL_MEM(mesh,hash.item);
 
 facesData:
-  PMMG_DEL_MEM(parmesh,facesData,int,"facesData");
+  PMMG_DEL_MEM(mesh,facesData,int,"facesData");
 
   return ier;
 }
@@ -441,6 +452,262 @@ static inline void PMMG_scotch_message( int8_t *warnScotch ) {
   return;
 }
 
+/**
+ * \param parmesh pointer toward a parmesh structure
+ * \param i index of the group to remesh
+ * \param warnScotch pointer toward the scotch warning flag
+ *
+ * \return 1 if success, 0 if the remeshing fails but the mesh is still
+ * conform (we can save it), -1 if the mesh is not conform.
+ *
+ * Remesh the group \a i of the parmesh: renumbering, Mmg call and update of
+ * the group communicators. The memory available for the remeshing must have
+ * been given to the group mesh before the call: all the allocations of this
+ * function are counted on the group mesh so groups can be remeshed
+ * concurrently.
+ *
+ */
+static
+int PMMG_remesh_grp( PMMG_pParMesh parmesh,int i,int8_t *warnScotch ) {
+  PMMG_pGrp  grp;
+  MMG5_pMesh mesh;
+  MMG5_pSol  met;
+  double     tstart;
+  int        ier,k,*facesData,*permNodGlob;
+#ifdef USE_SCOTCH
+  int        npPerm;
+#endif
+
+  mesh = parmesh->listgrp[i].mesh;
+  met  = parmesh->listgrp[i].met;
+
+  /** Store the vertices of interface faces in the internal communicator */
+  if ( !(ier = PMMG_store_faceVerticesInIntComm(parmesh,i,&facesData) ) ) {
+    /* We are not able to remesh */
+    fprintf(stderr,"\n  ## Interface faces storage problem."
+            " Exit program.\n");
+    return 0;
+  }
+
+  /* Mmg may free or reallocate the mesh arrays from now on */
+  PMMG_memprof_releaseMesh(mesh,met,parmesh->listgrp[i].sol);
+
+  permNodGlob = NULL;
+
+#ifndef USE_SCOTCH
+  (void)warnScotch;
+#else
+  /* Allocation of the array that will store the node permutation */
+  npPerm = mesh->np;
+  PMMG_MALLOC(mesh,permNodGlob,mesh->np+1,int,"node permutation",
+              PMMG_scotch_message(warnScotch) );
+  if ( permNodGlob ) {
+    for ( k=1; k<=mesh->np; ++k ) {
+      permNodGlob[k] = k;
+    }
+  }
+
+  /* renumerotation if available */
+  if ( !MMG5_scotchCall(mesh,met,permNodGlob) )
+  {
+    PMMG_scotch_message(warnScotch);
+  }
+#endif
+
+  /* Mark reinitialisation in order to be able to remesh all the mesh */
+  mesh->mark = 0;
+  mesh->base = 0;
+  for ( k=1 ; k<=mesh->nemax ; k++ ) {
+    mesh->tetra[k].mark = mesh->mark;
+    mesh->tetra[k].flag = mesh->base;
+  }
+
+  /** Call the remesher */
+  /* Here we need to scale the mesh */
+  if ( !MMG5_scaleMesh(mesh,met,NULL) ) { ier = -1; goto end; }
+
+  if ( !mesh->adja ) {
+    if ( !MMG3D_hashTetra(mesh,0) ) {
+      fprintf(stderr,"\n  ## Hashing problem. Exit program.\n");
+      ier = -1;
+      goto end;
+    }
+  }
+
+  /* Measure the remeshing cost of the group (load balancing feedback) */
+  grp            = &parmesh->listgrp[i];
+  grp->mmg_ne_in = mesh->ne;
+  tstart         = MPI_Wtime();
+
+  PMMG_TRACE_BEGIN_ARGS( "mmg3d1",
+                         "grp",i,"ne",mesh->ne );
+#ifdef PATTERN
+  ier = MMG5_mmg3d1_pattern( mesh, met, permNodGlob );
+#else
+  ier = MMG5_mmg3d1_delone( mesh, met, permNodGlob );
+#endif
+  PMMG_TRACE_END( "mmg3d1" );
+
+  grp->mmg_time = MPI_Wtime() - tstart;
+
+  if ( !ier ) {
+    fprintf(stderr,"\n  ## MMG remeshing problem. Exit program.\n");
+  }
+
+  /** Pack the tetra */
+  if ( mesh->adja )
+    PMMG_DEL_MEM(mesh,mesh->adja,int,"adja table");
+
+  if ( !MMG5_paktet(mesh) ) {
+    fprintf(stderr,"\n  ## Tetra packing problem. Exit program.\n");
+    ier = -1;
+    goto end;
+  }
+  grp->mmg_ne_new = MG_MAX(mesh->ne - grp->mmg_ne_in,0);
+
+  /** Update interface tetra indices in the face communicator */
+  if ( ! PMMG_update_face2intInterfaceTetra(parmesh,i,facesData,permNodGlob) ) {
+    fprintf(stderr,"\n  ## Interface tetra updating problem. Exit program.\n");
+    ier = -1;
+    goto perm;
+  }
+
+#ifdef USE_SCOTCH
+  /** Update nodal communicators if node renumbering is enabled */
+  if ( mesh->info.renum &&
+       !PMMG_update_node2intRnbg(&parmesh->listgrp[i],permNodGlob) ) {
+    fprintf(stderr,"\n  ## Interface tetra updating problem. Exit program.\n");
+    ier = -1;
+    goto perm;
+  }
+
+  /** Update the global indices of the vertices (only the parallel ones are
+   * kept, see PMMG_gid_update) */
+  if ( mesh->info.renum && !PMMG_gid_permute(mesh,grp,permNodGlob,npPerm) ) {
+    fprintf(stderr,"\n  ## Global indices permutation problem. Exit program.\n");
+    ier = -1;
+    goto perm;
+  }
+#endif
+
+  if ( !MMG5_unscaleMesh(mesh,met,NULL) ) { ier = -1; goto perm; }
+
+  /** Mmg may have reallocated the points: fit the fields to the point array */
+  if ( !PMMG_fields_resize(mesh,grp->sol,mesh->npmax) ) { ier = -1; goto perm; }
+  PMMG_fields_setNp(mesh,grp->sol,mesh->np);
+  if ( !PMMG_gid_resize(mesh,grp,mesh->npmax) ) { ier = -1; goto perm; }
+
+  if ( grp->disp && grp->disp->m ) {
+    PMMG_REALLOC(mesh,grp->disp->m,grp->disp->size*(mesh->npmax+1),
+                 grp->disp->size*(grp->disp->npmax+1),double,
+                 "displacement array",ier = -1; goto perm);
+    grp->disp->npmax = mesh->npmax;
+    grp->disp->np    = mesh->np;
+  }
+
+  if ( !PMMG_copyMetricsAndFields_point( grp,&parmesh->old_listgrp[i],
+                                         permNodGlob) ) {
+    ier = -1;
+    goto perm;
+  }
+
+  /* Reset the mesh->gap field in case Mmg have modified it */
+  mesh->gap = MMG5_GAP;
+
+  goto perm;
+
+end:
+  PMMG_DEL_MEM(mesh,facesData,int,"facesData");
+
+perm:
+  if ( permNodGlob ) {
+    PMMG_DEL_MEM(mesh,permNodGlob,int,"node permutation");
+  }
+
+  return ier;
+}
+
+#ifdef USE_OPENMP
+/**
+ * \param parmesh pointer toward a parmesh structure
+ * \param warnScotch pointer toward the scotch warning flag
+ *
+ * \return 1 if success, 0 if the remeshing of at least one group fails but the
+ * meshes are still conform, -1 if a mesh is not conform.
+ *
+ * Remesh concurrently the groups of the parmesh (one group per thread). The
+ * memory available on the proc is splitted between the threads: each thread
+ * owns a fixed part of the available memory, gives it to the group that it
+ * remeshes and takes it back (minus the memory consumed by the group) once the
+ * group is remeshed. Thus the sum of the memory used by the groups that are
+ * remeshed together never exceeds the available memory.
+ *
+ */
+static
+int PMMG_remesh_grps_omp( PMMG_pParMesh parmesh,int8_t *warnScotch ) {
+  size_t     oldMemMax,available,thrAvailable,memCur;
+  int        ier,ierGrp,nthreads,i;
+  int8_t     warn;
+
+  nthreads = omp_get_max_threads();
+  if ( nthreads > parmesh->ngrp ) nthreads = parmesh->ngrp;
+  if ( nthreads < 1 ) nthreads = 1;
+
+  PMMG_TRANSFER_AVMEM_TO_PARMESH(parmesh,available,oldMemMax);
+
+  /* The parmesh must not allocate memory during the parallel section */
+  parmesh->memMax = parmesh->memCur;
+  thrAvailable    = available/nthreads;
+
+  ier  = 1;
+  warn = *warnScotch;
+
+  /* Each thread raises its own copy of the scotch warning flag */
+#pragma omp parallel num_threads(nthreads) default(none)                \
+  shared(parmesh,ier) firstprivate(thrAvailable)                        \
+  private(i,ierGrp,memCur) reduction(max:warn)
+  {
+#pragma omp for schedule(dynamic,1)
+    for ( i=0; i<parmesh->ngrp; ++i ) {
+      MMG5_pMesh mesh = parmesh->listgrp[i].mesh;
+
+      /* Reset the value of the fem mode */
+      mesh->info.fem = parmesh->info.fem;
+
+      if ( (!mesh->np) && (!mesh->ne) ) {
+        /* Empty mesh */
+        continue;
+      }
+
+      /* Give the thread memory to the group */
+      memCur       = mesh->memCur;
+      mesh->memMax = memCur + thrAvailable;
+
+      ierGrp = PMMG_remesh_grp( parmesh,i,&warn );
+
+      /* Take the remaining memory back */
+      assert ( mesh->memCur <= memCur + thrAvailable );
+      thrAvailable = memCur + thrAvailable - mesh->memCur;
+      mesh->memMax = mesh->memCur;
+
+      if ( ierGrp < 1 ) {
+#pragma omp critical (PMMG_remesh_grps_ier)
+        {
+          if ( ierGrp < ier ) ier = ierGrp;
+        }
+      }
+    }
+  }
+
+  *warnScotch = warn;
+
+  /* Give back the available memory to the parmesh */
+  PMMG_TRANSFER_AVMEM_TO_PARMESH(parmesh,available,oldMemMax);
+
+  return ier;
+}
+#endif
+
 /**
  * \param parmesh pointer toward a parmesh structure where the boundary entities
  * are stored into xtetra and xpoint strucutres
@@ -457,10 +724,11 @@ static inline void PMMG_scotch_message( int8_t *warnScotch ) {
 int PMMG_parmmglib1( PMMG_pParMesh parmesh )
 {
   MMG5_pMesh mesh;
-  MMG5_pSol  met;
+#ifndef USE_OPENMP
   size_t     oldMemMax,available;
+#endif
   mytime     ctim[TIMEMAX];
-  int        it,ier,ier_end,ieresult,i,k,*facesData,*permNodGlob;
+  int        it,ier,ier_end,ieresult,i;
   int8_t     tim,warnScotch;
   char       stim[32];
 
@@ -469,14 +737,25 @@ int PMMG_parmmglib1( PMMG_pParMesh parmesh )
 
   ier_end = PMMG_SUCCESS;
 
+  /** Global indices of the vertices (followed through the iterations) */
+  ier = PMMG_gid_init( parmesh );
+
+  MPI_CHECK ( MPI_Allreduce( &ier,&ieresult,1,MPI_INT,MPI_MIN,parmesh->comm ),
+              PMMG_CLEAN_AND_RETURN(parmesh,PMMG_LOWFAILURE) );
+  if ( !ieresult ) {
+    PMMG_CLEAN_AND_RETURN(parmesh,PMMG_LOWFAILURE);
+  }
+
   /** Groups creation */
   if ( parmesh->info.imprim > PMMG_VERB_QUAL ) {
     tim = 0;
     chrono(ON,&(ctim[tim]));
   }
 
+  PMMG_timer_start( parmesh,PMMG_PHASE_GRPSPLIT );
   ier = PMMG_splitPart_grps( parmesh,PMMG_GRPSPL_MMG_TARGET,0,
                          PMMG_REDISTRIBUTION_graph_balancing );
+  PMMG_timer_stop( parmesh,PMMG_PHASE_GRPSPLIT );
 
   MPI_CHECK ( MPI_Allreduce( &ier,&ieresult,1,MPI_INT,MPI_MIN,parmesh->comm ),
               PMMG_CLEAN_AND_RETURN(parmesh,PMMG_LOWFAILURE) );
@@ -528,6 +807,9 @@ int PMMG_parmmglib1( PMMG_pParMesh parmesh )
       fprintf(stdout,"\r       adaptation: iter %d   cumul. timer %s",it+1,stim);fflush(stdout);
     }
 
+    PMMG_timer_setIteration( parmesh,it );
+    PMMG_timer_start( parmesh,PMMG_PHASE_MMG );
+
     /** Update old groups for metrics interpolation */
     PMMG_update_oldGrps( parmesh );
 
@@ -537,9 +819,12 @@ int PMMG_parmmglib1( PMMG_pParMesh parmesh )
       chrono(ON,&(ctim[tim]));
     }
 
+#ifdef USE_OPENMP
+    ier = PMMG_remesh_grps_omp( parmesh,&warnScotch );
+#else
+    ier = 1;
     for ( i=0; i<parmesh->ngrp; ++i ) {
       mesh         = parmesh->listgrp[i].mesh;
-      met          = parmesh->listgrp[i].met;
 
       /* Reset the value of the fem mode */
       mesh->info.fem = parmesh->info.fem;
@@ -551,112 +836,27 @@ int PMMG_parmmglib1( PMMG_pParMesh parmesh )
 
       PMMG_TRANSFER_AVMEM_TO_PARMESH(parmesh,available,oldMemMax);
 
-      /** Store the vertices of interface faces in the internal communicator */
-      if ( !(ier = PMMG_store_faceVerticesInIntComm(parmesh,i,&facesData) ) ) {
-        /* We are not able to remesh */
-        fprintf(stderr,"\n  ## Interface faces storage problem."
-                " Exit program.\n");
-        break;
-      }
-      else {
-        /* We can remesh */
+      PMMG_TRANSFER_AVMEM_FROM_PMESH_TO_MESH(parmesh,parmesh->listgrp[i].mesh,
+                                             available,oldMemMax);
 
-        permNodGlob = NULL;
+      ier = PMMG_remesh_grp( parmesh,i,&warnScotch );
 
-#ifdef USE_SCOTCH
-        /* Allocation of the array that will store the node permutation */
-        PMMG_MALLOC(parmesh,permNodGlob,mesh->np+1,int,"node permutation",
-                    PMMG_scotch_message(&warnScotch) );
-        if ( permNodGlob ) {
-          for ( k=1; k<=mesh->np; ++k ) {
-            permNodGlob[k] = k;
-          }
-        }
-
-        PMMG_TRANSFER_AVMEM_FROM_PMESH_TO_MESH(parmesh,parmesh->listgrp[i].mesh,
-                                               available,oldMemMax);
-
-        /* renumerotation if available */
-        if ( !MMG5_scotchCall(mesh,met,permNodGlob) )
-        {
-          PMMG_scotch_message(&warnScotch);
-        }
-#else
-        PMMG_TRANSFER_AVMEM_FROM_PMESH_TO_MESH(parmesh,parmesh->listgrp[i].mesh,
-                                               available,oldMemMax);
-#endif
-
-        /* Mark reinitialisation in order to be able to remesh all the mesh */
-        mesh->mark = 0;
-        mesh->base = 0;
-        for ( k=1 ; k<=mesh->nemax ; k++ ) {
-          mesh->tetra[k].mark = mesh->mark;
-          mesh->tetra[k].flag = mesh->base;
-        }
-
-        /** Call the remesher */
-        /* Here we need to scale the mesh */
-        if ( !MMG5_scaleMesh(mesh,met,NULL) ) { goto strong_failed; }
+      PMMG_TRANSFER_AVMEM_FROM_MESH_TO_PMESH(parmesh,parmesh->listgrp[i].mesh,
+                                             available,oldMemMax);
 
-        if ( !mesh->adja ) {
-          if ( !MMG3D_hashTetra(mesh,0) ) {
-            fprintf(stderr,"\n  ## Hashing problem. Exit program.\n");
-            goto strong_failed;
-          }
-        }
-
-#ifdef PATTERN
-        ier = MMG5_mmg3d1_pattern( mesh, met, permNodGlob );
-#else
-        ier = MMG5_mmg3d1_delone( mesh, met, permNodGlob );
-#endif
-
-        if ( !ier ) {
-          fprintf(stderr,"\n  ## MMG remeshing problem. Exit program.\n");
-        }
-
-        /** Pack the tetra */
-        if ( mesh->adja )
-          PMMG_DEL_MEM(mesh,mesh->adja,int,"adja table");
-
-        if ( !MMG5_paktet(mesh) ) {
-          fprintf(stderr,"\n  ## Tetra packing problem. Exit program.\n");
-          goto strong_failed;
-        }
-
-        /** Update interface tetra indices in the face communicator */
-        if ( ! PMMG_update_face2intInterfaceTetra(parmesh,i,facesData,permNodGlob) ) {
-          fprintf(stderr,"\n  ## Interface tetra updating problem. Exit program.\n");
-          goto strong_failed;
-        }
-
-
-#ifdef USE_SCOTCH
-        /** Update nodal communicators if node renumbering is enabled */
-        if ( mesh->info.renum &&
-             !PMMG_update_node2intRnbg(&parmesh->listgrp[i],permNodGlob) ) {
-          fprintf(stderr,"\n  ## Interface tetra updating problem. Exit program.\n");
-          goto strong_failed;
-        }
+      if ( ier < 1 ) { break; }
+    }
 #endif
+    PMMG_timer_stop( parmesh,PMMG_PHASE_MMG );
 
-        if ( !MMG5_unscaleMesh(mesh,met,NULL) ) { goto strong_failed; }
-
-        PMMG_TRANSFER_AVMEM_FROM_MESH_TO_PMESH(parmesh,parmesh->listgrp[i].mesh,
-                                               available,oldMemMax);
-
-        if ( !PMMG_copyMetrics_point( &parmesh->listgrp[i],&parmesh->old_listgrp[i],
-                                      permNodGlob) ) {
-          goto strong_failed;
-        }
+    if ( ier < 0 ) { goto strong_failed; }
 
-        if ( !ier ) { break; }
-      }
-      /* Reset the mesh->gap field in case Mmg have modified it */
-      mesh->gap = MMG5_GAP;
-    }
+    /** Give new global indices to the vertices created by the remeshing */
+    if ( ier > 0 && !PMMG_gid_update( parmesh ) ) ier = 0;
 
+    PMMG_TRACE_BEGIN( "error check" );
     MPI_Allreduce( &ier, &ieresult, 1, MPI_INT, MPI_MIN, parmesh->comm );
+    PMMG_TRACE_END( "error check" );
     if ( parmesh->info.imprim > PMMG_VERB_ITWAVES ) {
       chrono(OFF,&(ctim[tim]));
       printim(ctim[tim].gdif,stim);
@@ -666,20 +866,26 @@ int PMMG_parmmglib1( PMMG_pParMesh parmesh )
     if ( !ieresult )
       goto failed_handling;
 
-    /** Interpolate metrics */
+    /** Interpolate metrics and fields */
     if ( parmesh->info.imprim > PMMG_VERB_ITWAVES ) {
       tim = 2;
       chrono(RESET,&(ctim[tim]));
       chrono(ON,&(ctim[tim]));
     }
 
-    ier = PMMG_interpMetrics_grps( parmesh, permNodGlob );
+    PMMG_timer_start( parmesh,PMMG_PHASE_INTERP );
+    PMMG_arena_begin( parmesh,"interpolation" );
+    ier = PMMG_interpMetricsAndFields_grps( parmesh );
+    PMMG_arena_end( parmesh );
+    PMMG_timer_stop( parmesh,PMMG_PHASE_INTERP );
 
+    PMMG_TRACE_BEGIN( "error check" );
     MPI_Allreduce( &ier, &ieresult, 1, MPI_INT, MPI_MIN, parmesh->comm );
+    PMMG_TRACE_END( "error check" );
     if ( parmesh->info.imprim > PMMG_VERB_ITWAVES ) {
       chrono(OFF,&(ctim[tim]));
       printim(ctim[tim].gdif,stim);
-      fprintf(stdout,"       metric interpolation              %s\n",stim);
+      fprintf(stdout,"       metric and fields interpolation   %s\n",stim);
     }
 
     if ( !ieresult ) {
@@ -689,7 +895,9 @@ int PMMG_parmmglib1( PMMG_pParMesh parmesh )
     }
 
     /* Compute quality in the interpolated metrics */
+    PMMG_timer_start( parmesh,PMMG_PHASE_QUALITY );
     ier = PMMG_tetraQual( parmesh,0 );
+    PMMG_timer_stop( parmesh,PMMG_PHASE_QUALITY );
 
     /** load Balancing at group scale and communicators reconstruction */
     tim = 3;
@@ -698,9 +906,15 @@ int PMMG_parmmglib1( PMMG_pParMesh parmesh )
       chrono(ON,&(ctim[tim]));
     }
 
+    PMMG_timer_start( parmesh,PMMG_PHASE_LOADBAL );
+    PMMG_arena_begin( parmesh,"load balancing" );
     ier = PMMG_loadBalancing(parmesh);
+    PMMG_arena_end( parmesh );
+    PMMG_timer_stop( parmesh,PMMG_PHASE_LOADBAL );
 
+    PMMG_TRACE_BEGIN( "error check" );
     MPI_Allreduce( &ier, &ieresult, 1, MPI_INT, MPI_MIN, parmesh->comm );
+    PMMG_TRACE_END( "error check" );
    if ( parmesh->info.imprim > PMMG_VERB_ITWAVES ) {
       chrono(OFF,&(ctim[tim]));
       printim(ctim[tim].gdif,stim);
@@ -718,6 +932,10 @@ int PMMG_parmmglib1( PMMG_pParMesh parmesh )
     }
   }
 
+  if ( parmesh->info.imprim0 > PMMG_VERB_ITWAVES ) {
+    PMMG_arena_printStats( parmesh );
+  }
+
   if ( parmesh->info.imprim > PMMG_VERB_STEPS ) {
     printf("\n");
   }
@@ -734,7 +952,10 @@ int PMMG_parmmglib1( PMMG_pParMesh parmesh )
     chrono(ON,&(ctim[tim]));
   }
 
+  PMMG_timer_setIteration( parmesh,-1 );
+  PMMG_timer_start( parmesh,PMMG_PHASE_PACKING );
   ier = PMMG_packParMesh(parmesh);
+  PMMG_timer_stop( parmesh,PMMG_PHASE_PACKING );
   MPI_Allreduce( &ier, &ieresult, 1, MPI_INT, MPI_MIN, parmesh->comm );
   if ( parmesh->info.imprim > PMMG_VERB_STEPS ) {
     chrono(OFF,&(ctim[tim]));
@@ -754,7 +975,9 @@ int PMMG_parmmglib1( PMMG_pParMesh parmesh )
     chrono(ON,&(ctim[tim]));
   }
 
+  PMMG_timer_start( parmesh,PMMG_PHASE_MERGING );
   ier = PMMG_merge_grps(parmesh,0);
+  PMMG_timer_stop( parmesh,PMMG_PHASE_MERGING );
   MPI_Allreduce( &ier, &ieresult, 1, MPI_INT, MPI_MIN, parmesh->comm );
 
   if ( parmesh->info.imprim > PMMG_VERB_STEPS ) {
@@ -787,10 +1010,13 @@ failed_handling:
     tim = 4;
     chrono(ON,&(ctim[tim]));
   }
+  PMMG_timer_setIteration( parmesh,-1 );
+  PMMG_timer_start( parmesh,PMMG_PHASE_PACKING );
   if ( !PMMG_packParMesh(parmesh) ) {
     fprintf(stderr,"\n  ## Parmesh packing problem. Exit program.\n");
     PMMG_CLEAN_AND_RETURN(parmesh,PMMG_STRONGFAILURE);
   }
+  PMMG_timer_stop( parmesh,PMMG_PHASE_PACKING );
   if ( parmesh->info.imprim > PMMG_VERB_STEPS ) {
     chrono(OFF,&(ctim[tim]));
     printim(ctim[tim].gdif,stim);
@@ -800,10 +1026,12 @@ failed_handling:
   if ( parmesh->info.imprim > PMMG_VERB_STEPS ) {
     chrono(ON,&(ctim[5]));
   }
+  PMMG_timer_start( parmesh,PMMG_PHASE_MERGING );
   if ( !PMMG_merge_grps(parmesh,0) ) {
     fprintf(stderr,"\n  ## Groups merging problem. Exit program.\n");
     PMMG_CLEAN_AND_RETURN(parmesh,PMMG_STRONGFAILURE);
   }
+  PMMG_timer_stop( parmesh,PMMG_PHASE_MERGING );
   if ( parmesh->info.imprim > PMMG_VERB_STEPS ) {
     chrono(OFF,&(ctim[5]));
     printim(ctim[5].gdif,stim);
@@ -81,6 +81,15 @@ int PMMG_defaultValues( PMMG_pParMesh parmesh )
 //    fprintf( stdout,"ratio: # meshes / # metis super nodes (-metis-ratio) : %d\n",abs(PMMG_RATIO_MMG_METIS) );
     fprintf( stdout,"# of layers for interface displacement (-nlayers) : %d\n",PMMG_MVIFCS_NLAYERS);
     fprintf( stdout,"allowed imbalance between current and desired groups size (-groups-ratio) : %f\n",PMMG_GRPS_RATIO);
+    fprintf( stdout,"metrics interpolation mode (-met-interp) : %d (0: linear, 1: log-Euclidean)\n",PMMG_METINTERP_mode);
+    fprintf( stdout,"output mode (-distributed-output, -shared-output) : %d (0: merged, 1: per process, 2: shared file)\n",parmesh->info.distributed_output);
+    fprintf( stdout,"input read by slabs on all the processes (-shared-input) : %d\n",parmesh->info.shared_input);
+    fprintf( stdout,"metis weights (-metis-weights) : %d (0: elements count, 1: predicted remeshing cost, 2: measured remeshing cost)\n",parmesh->info.vwgt_mode);
+    fprintf( stdout,"adaptive repartitioning (-adaptive-repart [itr]) : %d (itr: %g)\n",parmesh->info.repart_adaptive,parmesh->info.repart_itr);
+    fprintf( stdout,"imbalance under which the load balancing is skipped (-lb-threshold) : %g\n",parmesh->info.balance_threshold);
+    fprintf( stdout,"size of the scratch memory arena chunks in Mb (-arena-size) : %d (0: no arena)\n",parmesh->info.arena_size);
+    fprintf( stdout,"memory profile per allocation label (-mem-profile) : %d\n",parmesh->info.mem_profile);
+    fprintf( stdout,"phases timers reduced over the procs (-timing-report) : %d\n",parmesh->info.timing_report);
 
 #ifdef USE_SCOTCH
     fprintf(stdout,"SCOTCH renumbering                  : enabled\n");
@@ -119,14 +128,36 @@ int PMMG_usage( PMMG_pParMesh parmesh, char * const prog )
     fprintf(stdout,"\n**  File specifications\n");
     fprintf(stdout,"-in  file  input triangulation\n");
     fprintf(stdout,"-out file  output triangulation\n");
+    fprintf(stdout,"-distributed-output  save one mesh per process with its"
+            " communicators\n");
+    fprintf(stdout,"-shared-output       save one .meshb file written by all"
+            " the processes (MPI-IO)\n");
+    fprintf(stdout,"-shared-input        read the .meshb file by slabs on all"
+            " the processes (MPI-IO)\n");
     fprintf(stdout,"-sol file  load solution or metric file\n");
 
     fprintf(stdout,"\n**  Parameters\n");
     fprintf(stdout,"-niter        val  number of remeshing iterations\n");
     fprintf(stdout,"-mesh-size    val  target mesh size for the remesher\n");
     fprintf(stdout,"-metis-ratio  val  number of metis super nodes per mesh\n");
+    fprintf(stdout,"-metis-weights val metis weights: 0 elements count, 1 predicted remeshing cost,\n"
+            "                   2 measured remeshing cost\n");
     fprintf(stdout,"-nlayers      val  number of layers for interface displacement\n");
     fprintf(stdout,"-groups-ratio val  allowed imbalance between current and desired groups size\n");
+    fprintf(stdout,"-met-interp   val  metrics interpolation: 0 linear, 1 log-Euclidean\n");
+#ifdef USE_PARMETIS
+    fprintf(stdout,"-adaptive-repart [itr] move the groups with ParMetis adaptive"
+            " repartitioning\n"
+            "                   (itr: edge cut / migration cost ratio)\n");
+    fprintf(stdout,"-lb-threshold val  skip the graph load balancing under this"
+            " predicted work imbalance\n");
+#endif
+    fprintf(stdout,"-arena-size   val  size in Mb of the scratch memory arena chunks (0: disabled)\n");
+    fprintf(stdout,"-mem-profile       save the memory peaks per allocation label in"
+            " name.memprof.json\n");
+    fprintf(stdout,"-timing-report     save the phases timers (min/max/mean/imbalance"
+            " over the procs)\n"
+            "                   in name.timers.json\n");
 
     //fprintf(stdout,"-ar     val  angle detection\n");
     //fprintf(stdout,"-nr          no angle detection\n");
@@ -207,6 +238,50 @@ int PMMG_parsar( int argc, char *argv[], PMMG_pParMesh parmesh )
   while ( i < argc ) {
     if ( *argv[i] == '-' ) {
       switch( argv[i][1] ) {
+      case 'a':
+        if ( !strcmp(argv[i],"-adaptive-repart") ) {
+
+          if ( !PMMG_Set_iparameter(parmesh,PMMG_IPARAM_adaptiveRepart,1) ) {
+            ret_val = 0;
+            goto fail_proc;
+          }
+          /* Optional ratio between edge cut and migration cost */
+          if ( ++i < argc ) {
+            if ( isdigit(argv[i][0]) ) {
+              if ( !PMMG_Set_dparameter(parmesh,PMMG_DPARAM_repartItr,atof(argv[i])) ) {
+                ret_val = 0;
+                goto fail_proc;
+              }
+            }
+            else {
+              i--;
+            }
+          }
+          else {
+            i--;
+          }
+        }
+        else if ( !strcmp(argv[i],"-arena-size") ) {
+          /* Size of the chunks of the scratch memory arena */
+          if ( ++i < argc && isdigit(argv[i][0]) ) {
+            if ( !PMMG_Set_iparameter(parmesh,PMMG_IPARAM_arenaSize,atoi(argv[i])) ) {
+              ret_val = 0;
+              goto fail_proc;
+            }
+          }
+          else {
+            fprintf(stderr,"\nMissing argument option %s\n",argv[i-1]);
+            ret_val = 0;
+            goto fail_proc;
+          }
+        }
+        else {
+          ARGV_APPEND(parmesh, argv, mmgArgv, i, mmgArgc,
+                      " adding to mmgArgv for mmg: ",
+                      ret_val = 0; goto fail_proc );
+        }
+        break;
+
       case 'g':
         if ( !strcmp(argv[i],"-groups-ratio") ) {
 
@@ -230,6 +305,30 @@ int PMMG_parsar( int argc, char *argv[], PMMG_pParMesh parmesh )
         }
         break;
 
+      case 'l':
+        if ( !strcmp(argv[i],"-lb-threshold") ) {
+
+          /* Imbalance under which the graph load balancing is skipped */
+          if ( ++i < argc && ( isdigit(argv[i][0]) || argv[i][0]=='.' ) ) {
+            if ( !PMMG_Set_dparameter(parmesh,PMMG_DPARAM_balanceThreshold,
+                                      atof(argv[i])) ) {
+              ret_val = 0;
+              goto fail_proc;
+            }
+          }
+          else {
+            fprintf( stderr, "\nMissing argument option %c\n", argv[i-1][1] );
+            ret_val = 0;
+            goto fail_proc;
+          }
+        }
+        else {
+          ARGV_APPEND(parmesh, argv, mmgArgv, i, mmgArgc,
+                      " adding to mmgArgv for mmg: ",
+                      ret_val = 0; goto fail_proc );
+        }
+        break;
+
       case 'm':
         if ( !strcmp(argv[i],"-mmg-v") ) {
 
@@ -278,6 +377,54 @@ int PMMG_parsar( int argc, char *argv[], PMMG_pParMesh parmesh )
             goto fail_proc;
           }
         }
+        else if ( !strcmp(argv[i],"-met-interp") ) {
+
+          /* Metrics interpolation mode */
+          if ( ++i < argc ) {
+            if ( isdigit(argv[i][0]) ) {
+              val = atoi(argv[i]);
+
+              if ( !PMMG_Set_iparameter(parmesh,PMMG_IPARAM_metInterp,val) ) {
+                ret_val = 0;
+                goto fail_proc;
+              }
+            }
+            else {
+              fprintf( stderr, "\nMissing argument option %c\n", argv[i-1][1] );
+              ret_val = 0;
+              goto fail_proc;
+            }
+          }
+          else {
+            fprintf( stderr, "\nMissing argument option %c\n", argv[i-1][1] );
+            ret_val = 0;
+            goto fail_proc;
+          }
+        }
+        else if ( !strcmp(argv[i],"-metis-weights") ) {
+
+          /* Metis node weights */
+          if ( ++i < argc ) {
+            if ( isdigit(argv[i][0]) ) {
+              val = atoi(argv[i]);
+
+              if ( !PMMG_Set_iparameter(parmesh,PMMG_IPARAM_metisWeights,val) ) {
+                ret_val = 0;
+                goto fail_proc;
+              }
+            }
+            else {
+              fprintf( stderr, "\nMissing argument option %c\n", argv[i-1][1] );
+              ret_val = 0;
+              goto fail_proc;
+            }
+          }
+          else {
+            fprintf( stderr, "\nMissing argument option %c\n", argv[i-1][1] );
+            ret_val = 0;
+            goto fail_proc;
+          }
+        }
         else if ( !strcmp(argv[i],"-metis-ratio") ) {
 
           /* Number of metis super nodes per mesh */
@@ -302,6 +449,13 @@ int PMMG_parsar( int argc, char *argv[], PMMG_pParMesh parmesh )
             goto fail_proc;
           }
         }
+        else if ( !strcmp(argv[i],"-mem-profile") ) {
+          /* Memory profile per allocation label */
+          if ( !PMMG_Set_iparameter(parmesh,PMMG_IPARAM_memProfile,1) ) {
+            ret_val = 0;
+            goto fail_proc;
+          }
+        }
         else if ( !strcmp(argv[i],"-mmg-d") ) {
           if ( !PMMG_Set_iparameter(parmesh,PMMG_IPARAM_mmgDebug,val) ) {
             ret_val = 0;
@@ -362,10 +516,21 @@ int PMMG_parsar( int argc, char *argv[], PMMG_pParMesh parmesh )
         }
         break;
 
-      case 'd':  /* debug */
-        if ( !PMMG_Set_iparameter(parmesh,PMMG_IPARAM_debug,1) )  {
-          ret_val = 0;
-          goto fail_proc;
+      case 'd':
+        if ( !strcmp(argv[i],"-distributed-output") ) {
+          /* Save one mesh per process */
+          if ( !PMMG_Set_iparameter(parmesh,PMMG_IPARAM_distributedOutput,
+                                    PMMG_OUTPUT_perProcess) ) {
+            ret_val = 0;
+            goto fail_proc;
+          }
+        }
+        else {
+          /* debug */
+          if ( !PMMG_Set_iparameter(parmesh,PMMG_IPARAM_debug,1) )  {
+            ret_val = 0;
+            goto fail_proc;
+          }
         }
         break;
 #ifdef USE_SCOTCH
@@ -378,6 +543,44 @@ int PMMG_parsar( int argc, char *argv[], PMMG_pParMesh parmesh )
         break;
 #endif
 
+      case 's':
+        if ( !strcmp(argv[i],"-shared-output") ) {
+          /* Save one file written by all the processes */
+          if ( !PMMG_Set_iparameter(parmesh,PMMG_IPARAM_distributedOutput,
+                                    PMMG_OUTPUT_sharedFile) ) {
+            ret_val = 0;
+            goto fail_proc;
+          }
+        }
+        else if ( !strcmp(argv[i],"-shared-input") ) {
+          /* Read the input file by slabs on all the processes */
+          if ( !PMMG_Set_iparameter(parmesh,PMMG_IPARAM_sharedInput,1) ) {
+            ret_val = 0;
+            goto fail_proc;
+          }
+        }
+        else {
+          ARGV_APPEND(parmesh, argv, mmgArgv, i, mmgArgc,
+                      " adding to mmgArgv for mmg: ",
+                      ret_val = 0; goto fail_proc );
+        }
+        break;
+
+      case 't':
+        if ( !strcmp(argv[i],"-timing-report") ) {
+          /* Phases timers reduced over the procs */
+          if ( !PMMG_Set_iparameter(parmesh,PMMG_IPARAM_timingReport,1) ) {
+            ret_val = 0;
+            goto fail_proc;
+          }
+        }
+        else {
+          ARGV_APPEND(parmesh, argv, mmgArgv, i, mmgArgc,
+                      " adding to mmgArgv for mmg: ",
+                      ret_val = 0; goto fail_proc );
+        }
+        break;
+
       case 'v':  /* verbosity */
         if ( ++i < argc ) {
           if ( isdigit(argv[i][0]) ||
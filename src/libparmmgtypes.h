@@ -34,6 +34,7 @@
 
 #include "mmg/mmg3d/libmmgtypes.h"
 #include <mpi.h>
+#include <stdint.h>
 
 
 /**
@@ -208,6 +209,82 @@
  */
 #define PMMG_LOADBALANCING_parmetis 2
 
+/**
+ * \def PMMG_METINTERP_linear
+ *
+ * Linearly interpolate the metrics components
+ *
+ */
+#define PMMG_METINTERP_linear 0
+
+/**
+ * \def PMMG_METINTERP_logEuclidean
+ *
+ * Linearly interpolate the logarithms of the metrics (log-Euclidean
+ * interpolation)
+ *
+ */
+#define PMMG_METINTERP_logEuclidean 1
+
+/**
+ * \def PMMG_METINTERP_mode
+ *
+ * Choose how to interpolate the metrics
+ *
+ */
+#define PMMG_METINTERP_mode PMMG_METINTERP_linear
+
+/**
+ * \def PMMG_OUTPUT_merged
+ *
+ * Merge the meshes on the root process before saving them
+ *
+ */
+#define PMMG_OUTPUT_merged 0
+
+/**
+ * \def PMMG_OUTPUT_perProcess
+ *
+ * Save one mesh file per process
+ *
+ */
+#define PMMG_OUTPUT_perProcess 1
+
+/**
+ * \def PMMG_OUTPUT_sharedFile
+ *
+ * Save the meshes of all the processes in one shared file (MPI-IO)
+ *
+ */
+#define PMMG_OUTPUT_sharedFile 2
+
+/**
+ * \def PMMG_VWGT_elements
+ *
+ * Balance the partitions on their number of elements
+ *
+ */
+#define PMMG_VWGT_elements 0
+
+/**
+ * \def PMMG_VWGT_metric
+ *
+ * Balance the partitions on the number of elements predicted by the metric
+ * (integral of sqrt(det(M)) over each element)
+ *
+ */
+#define PMMG_VWGT_metric 1
+
+/**
+ * \def PMMG_VWGT_measured
+ *
+ * Balance the partitions on the number of elements predicted by the metric,
+ * weighted by the Mmg time per element measured on each process at the
+ * previous iteration
+ *
+ */
+#define PMMG_VWGT_measured 2
+
 /**
  * \def PMMG_APIDISTRIB_faces
  *
@@ -278,6 +355,37 @@ typedef struct {
 } PMMG_Ext_comm;
 typedef PMMG_Ext_comm  * PMMG_pExt_comm;
 
+/**
+ * \struct PMMG_Halo
+ * \brief persistent exchange of the values of an internal communicator through
+ * the external communicators (see halo_pmmg.c).
+ */
+typedef struct {
+  int          ncomm;     /*!< Nb of external communicators when the requests have been created (-1 if not created) */
+  int          nreq;      /*!< Nb of non empty external communicators (nb of recv and of send requests) */
+  int*         color;     /*!< Remote processor of each external communicator */
+  int*         displs;    /*!< Position of the items of each external communicator in the buffers */
+  int*         ireq2comm; /*!< External communicator of each request */
+  void*        sbuf;      /*!< Send buffer (int or double) */
+  void*        rbuf;      /*!< Receive buffer (int or double) */
+  MPI_Request* request;   /*!< Persistent requests (nreq receives then nreq sends) */
+} PMMG_Halo;
+typedef PMMG_Halo  * PMMG_pHalo;
+
+/**
+ * \struct PMMG_Timers
+ * \brief wall time of the phases of the pipeline per adaptation iteration
+ * (see timers_pmmg.c).
+ */
+typedef struct {
+  int          ntimer;  /*!< Nb of timers */
+  int          niter;   /*!< Nb of iterations allocated (the first row is out of the adaptation loop) */
+  int          it;      /*!< Current iteration (-1 out of the adaptation loop) */
+  double*      tstart;  /*!< Start time of each running timer */
+  double*      time;    /*!< Cumulated time of each timer per iteration (niter+1 rows of ntimer values) */
+} PMMG_Timers;
+typedef PMMG_Timers  * PMMG_pTimers;
+
 /**
  * \struct PMMG_Grp
  * \brief Grp mesh structure.
@@ -301,6 +409,13 @@ typedef struct {
   int*         face2int_face_comm_index1; /*!< List of interface faces (local index)*/
   int*         face2int_face_comm_index2; /*!< List of index in internal communicator (where put the interface faces)*/
   int          flag;
+
+  double       mmg_time;   /*!< Wall time of the last remeshing of the grp */
+  int          mmg_ne_in;  /*!< Nb elements of the grp before the last remeshing */
+  int          mmg_ne_new; /*!< Nb elements created by the last remeshing */
+
+  int64_t*     gid;    /*!< Global index of each vertex (NULL if not tracked) */
+  int          gidmax; /*!< Nb vertices allocated in the gid array */
 } PMMG_Grp;
 typedef PMMG_Grp  * PMMG_pGrp;
 
@@ -326,6 +441,16 @@ typedef struct {
   int target_mesh_size; /*!< target mesh size for Mmg */
   int API_mode; /*!< use faces or nodes information to build communicators */
   int fmtout; /*!< store the output format asked */
+  int metinterp_mode; /*!< way to interpolate the metrics (see METINTERP) */
+  int distributed_output; /*!< way to save the meshes (see OUTPUT) */
+  int shared_input; /*!< read the input mesh by slabs on all the processes */
+  int vwgt_mode; /*!< metis node weights for the partitioning (see VWGT) */
+  int repart_adaptive; /*!< repartition the groups from the current distribution (ParMetis adaptive repartitioning) */
+  double repart_itr; /*!< ratio between the edge cut and the migration cost for the adaptive repartitioning */
+  double balance_threshold; /*!< predicted work imbalance under which the graph load balancing is skipped */
+  int arena_size; /*!< size (in Mb) of the chunks of the scratch memory arena (0: no arena) */
+  int mem_profile; /*!< profile the memory per allocation label */
+  int timing_report; /*!< save the phases timers reduced over the procs */
 } PMMG_Info;
 
 
@@ -366,9 +491,19 @@ typedef struct {
   int            next_face_comm; /*!< Number of external face communicator */
   PMMG_pExt_comm ext_face_comm;  /*!< External communicators (in increasing order w.r. to the remote proc index) */
 
+  /* persistent exchanges through the external communicators */
+  PMMG_pHalo     halo; /*!< Halos (PMMG_NHALO items, NULL if not used) */
+
+  /* profiling */
+  PMMG_pTimers   timers; /*!< Wall time of the pipeline phases (NULL if not used) */
+
   /* global variables */
   int            ddebug; //! Debug level
   int            niter;  //! Number of adaptation iterations
+  double         cost_ratio; //! Measured Mmg cost per element of the proc relative to the mean one
+  double         lb_time;    //! Wall time of the last load balancing with graph repartitioning
+  int            lb_skipped; //! 1 if the last load balancing has been skipped
+  int64_t        gid_next;   //! Next global vertex index given by this proc (strided by nprocs)
 
   /* parameters of the run */
   PMMG_Info      info; /*!< \ref PMMG_Info structure */
@@ -80,15 +80,154 @@ int PMMG_resetOldTag(PMMG_pParMesh parmesh) {
   return 1;
 }
 
+/**
+ * \param parmesh pointer toward a parmesh structure
+ *
+ * \return 1 if success, 0 if fail.
+ *
+ * Fit the cost model of the proc from the last remeshing of its groups: the
+ * Mmg time per processed element (initial plus created elements) of the proc,
+ * divided by the mean time per element over all the procs. The ratio is stored
+ * in \a parmesh->cost_ratio and used by the graph partitioners to weight the
+ * groups of the proc. Procs without remeshed elements get a ratio of 1.
+ *
+ */
+int PMMG_fit_costModel( PMMG_pParMesh parmesh ) {
+  PMMG_pGrp grp;
+  double    loc[2],glo[2],rate,mean;
+  int       igrp;
+
+  loc[0] = loc[1] = 0.;
+  for ( igrp=0; igrp<parmesh->ngrp; ++igrp ) {
+    grp     = &parmesh->listgrp[igrp];
+    loc[0] += grp->mmg_time;
+    loc[1] += (double)grp->mmg_ne_in + (double)grp->mmg_ne_new;
+  }
+
+  MPI_CHECK( MPI_Allreduce(loc,glo,2,MPI_DOUBLE,MPI_SUM,parmesh->comm),
+             return 0 );
+
+  parmesh->cost_ratio = 1.;
+  if ( loc[1] > 0. && glo[0] > 0. && glo[1] > 0. ) {
+    rate = loc[0]/loc[1];
+    mean = glo[0]/glo[1];
+    parmesh->cost_ratio = MG_MAX(MG_MIN(rate/mean,PMMG_COSTRATIO_MAX),
+                                 1./PMMG_COSTRATIO_MAX);
+  }
+
+  /* imprim is only set on the root proc: imprim0 guards the collectives */
+  if ( parmesh->info.imprim0 > PMMG_VERB_DETQUAL ) {
+    MPI_CHECK( MPI_Allreduce(&parmesh->cost_ratio,glo,1,MPI_DOUBLE,MPI_MIN,
+                             parmesh->comm), return 0 );
+    MPI_CHECK( MPI_Allreduce(&parmesh->cost_ratio,&glo[1],1,MPI_DOUBLE,MPI_MAX,
+                             parmesh->comm), return 0 );
+    if ( parmesh->myrank == parmesh->info.root ) {
+      fprintf(stdout,"               measured cost ratio       min %.2f max %.2f\n",
+              glo[0],glo[1]);
+    }
+  }
+
+  return 1;
+}
+
+/**
+ * \param in1 pointer toward the input array
+ * \param out1 pointer toward the in/out array
+ * \param len pointer toward the number of elements
+ * \param dptr pointer toward the MPI datatype
+ *
+ * Reduction of a pair of works: maximum of the first value, sum of the second.
+ *
+ */
+static void PMMG_maxsum_work(void *in1, void* out1, int *len, MPI_Datatype *dptr )
+{
+  double *in, *out;
+  int    i;
+
+  in  = (double *)in1;
+  out = (double *)out1;
+
+  for ( i=0; i<*len; i++) {
+    out[ 2*i ]    = MG_MAX(out[ 2*i ],in[ 2*i ]);
+    out[ 2*i+1 ] += in[ 2*i+1 ];
+  }
+}
+
+/**
+ * \param parmesh pointer toward a parmesh structure
+ * \param imbalance pointer toward the imbalance (filled)
+ *
+ * \return 1 if success, 0 if fail.
+ *
+ * Compute the imbalance of the work predicted for the next remeshing (maximal
+ * work of a proc over the mean work, minus 1). The work of a proc is its
+ * number of elements, or the number of elements predicted by the metric (times
+ * the measured cost ratio) depending on the metis weights mode. The maximal
+ * and total works are reduced in a single collective communication.
+ *
+ */
+static inline
+int PMMG_get_imbalance( PMMG_pParMesh parmesh,double *imbalance ) {
+  MMG5_pMesh   mesh;
+  MMG5_pSol    met;
+  MMG5_pTetra  pt;
+  MPI_Datatype mpi_work_t;
+  MPI_Op       mpi_maxsum_op;
+  double       work[2],wmean;
+  int          igrp,k,ier;
+
+  work[0] = 0.;
+  for ( igrp=0; igrp<parmesh->ngrp; ++igrp ) {
+    mesh = parmesh->listgrp[igrp].mesh;
+    met  = parmesh->listgrp[igrp].met;
+    if ( !mesh ) continue;
+
+    if ( parmesh->info.vwgt_mode == PMMG_VWGT_elements ) {
+      work[0] += (double)mesh->ne;
+      continue;
+    }
+    for ( k=1; k<=mesh->ne; ++k ) {
+      pt = &mesh->tetra[k];
+      if ( !MG_EOK(pt) ) continue;
+      work[0] += PMMG_computeVwgt(mesh,met,pt);
+    }
+  }
+  if ( parmesh->info.vwgt_mode == PMMG_VWGT_measured &&
+       parmesh->cost_ratio > 0. ) {
+    work[0] *= parmesh->cost_ratio;
+  }
+  work[1] = work[0];
+
+  /* work[0]: maximal work, work[1]: total work */
+  MPI_Type_contiguous( 2, MPI_DOUBLE, &mpi_work_t );
+  MPI_Type_commit( &mpi_work_t );
+  MPI_Op_create( PMMG_maxsum_work, 1, &mpi_maxsum_op );
+
+  ier = ( MPI_SUCCESS == MPI_Allreduce( MPI_IN_PLACE,work,1,mpi_work_t,
+                                        mpi_maxsum_op,parmesh->comm) );
+
+  MPI_Op_free( &mpi_maxsum_op );
+  MPI_Type_free( &mpi_work_t );
+
+  if ( !ier ) return 0;
+
+  wmean = work[1]/(double)parmesh->nprocs;
+  *imbalance = ( wmean > 0. ) ? work[0]/wmean - 1. : 0.;
+
+  return 1;
+}
+
 /**
  * \param parmesh pointer toward a parmesh structure
  *
  * \return 1 if success, 0 if fail but we can save the meshes, -1 if we cannot.
  *
- * Load balancing of the mesh groups over the processors.
+ * Split the groups, distribute them over the processors and split them again
+ * for the remesher (in the current redistribution mode).
  *
  */
-int PMMG_loadBalancing(PMMG_pParMesh parmesh) {
+static
+int PMMG_balance_grps(PMMG_pParMesh parmesh) {
   MMG5_pMesh mesh;
   int        ier,ier_glob,igrp,ne;
   mytime     ctim[5];
@@ -106,7 +245,9 @@ int PMMG_loadBalancing(PMMG_pParMesh parmesh) {
     chrono(ON,&(ctim[tim]));
   }
 
+  PMMG_timer_start( parmesh,PMMG_TIMER_LB_IFC );
   ier = PMMG_resetOldTag(parmesh);
+  PMMG_timer_stop( parmesh,PMMG_TIMER_LB_IFC );
   if ( !ier ) {
     fprintf(stderr,"\n  ## Problem when counting the number of interface faces.\n");
   }
@@ -133,7 +274,9 @@ int PMMG_loadBalancing(PMMG_pParMesh parmesh) {
 
   if ( ier ) {
     /** Split the ngrp groups of listgrp into a higher number of groups */
+    PMMG_timer_start( parmesh,PMMG_TIMER_LB_SPLITMET );
     ier = PMMG_split_n2mGrps(parmesh,PMMG_GRPSPL_DISTR_TARGET,1);
+    PMMG_timer_stop( parmesh,PMMG_TIMER_LB_SPLITMET );
   }
 
   /* There is mpi comms in distribute_grps thus we don't want that one proc
@@ -156,7 +299,9 @@ int PMMG_loadBalancing(PMMG_pParMesh parmesh) {
     chrono(ON,&(ctim[tim]));
   }
 
+  PMMG_timer_start( parmesh,PMMG_TIMER_LB_DISTRIB );
   ier = PMMG_distribute_grps(parmesh);
+  PMMG_timer_stop( parmesh,PMMG_TIMER_LB_DISTRIB );
   if ( ier <= 0 ) {
     fprintf(stderr,"\n  ## Group distribution problem.\n");
   }
@@ -178,6 +323,7 @@ int PMMG_loadBalancing(PMMG_pParMesh parmesh) {
     chrono(ON,&(ctim[tim]));
   }
 
+  PMMG_timer_start( parmesh,PMMG_TIMER_LB_SPLITMMG );
   if ( ier ) {
     /** Redistribute the ngrp groups of listgrp into a higher number of groups */
     ier = PMMG_split_n2mGrps(parmesh,PMMG_GRPSPL_MMG_TARGET,0);
@@ -200,6 +346,7 @@ int PMMG_loadBalancing(PMMG_pParMesh parmesh) {
     }
   }
   PMMG_TRANSFER_AVMEM_TO_PARMESH(parmesh,memAv,oldMemMax);
+  PMMG_timer_stop( parmesh,PMMG_TIMER_LB_SPLITMMG );
 
   if ( parmesh->info.imprim > PMMG_VERB_DETQUAL ) {
     chrono(OFF,&(ctim[tim]));
@@ -209,3 +356,65 @@ int PMMG_loadBalancing(PMMG_pParMesh parmesh) {
 
   return ier_glob;
 }
+
+/**
+ * \param parmesh pointer toward a parmesh structure
+ *
+ * \return 1 if success, 0 if fail but we can save the meshes, -1 if we cannot.
+ *
+ * Load balancing of the mesh groups over the processors. With graph
+ * repartitioning, if the imbalance of the predicted work is under the user
+ * threshold, the load balancing is skipped for this iteration: the groups, their
+ * interfaces and communicators are kept as is (no group split, distribution or
+ * adjacency rebuild, the remesher hashes the groups itself). As the interfaces
+ * are frozen during the remeshing, the load balancing is never skipped twice in
+ * a row so the interfaces are moved at least every other iteration.
+ *
+ */
+int PMMG_loadBalancing(PMMG_pParMesh parmesh) {
+  double     imbalance,tstart,elapsed;
+  int        ier;
+  char       stim[32];
+
+  /** Feedback of the measured remeshing cost into the partitioning weights */
+  if ( parmesh->info.vwgt_mode == PMMG_VWGT_measured ) {
+    ier = PMMG_fit_costModel(parmesh);
+    if ( !ier ) {
+      fprintf(stderr,"\n  ## Problem when fitting the remeshing cost model.\n");
+      return 0;
+    }
+  }
+
+  /** Check if the load balancing is needed */
+  tstart = MPI_Wtime();
+
+  if ( parmesh->info.balance_threshold > 0. && !parmesh->lb_skipped &&
+       parmesh->info.repartitioning == PMMG_REDISTRIBUTION_graph_balancing ) {
+    if ( !PMMG_get_imbalance(parmesh,&imbalance) ) {
+      fprintf(stderr,"\n  ## Problem when computing the load imbalance.\n");
+      return 0;
+    }
+    if ( parmesh->info.imprim > PMMG_VERB_DETQUAL ) {
+      fprintf(stdout,"               predicted work imbalance  %.3f\n",imbalance);
+    }
+
+    if ( imbalance < parmesh->info.balance_threshold ) {
+      parmesh->lb_skipped = 1;
+
+      /** Report the time saved by the skipped load balancing */
+      if ( parmesh->info.imprim > PMMG_VERB_ITWAVES ) {
+        elapsed = MPI_Wtime() - tstart;
+        printim(MG_MAX(parmesh->lb_time-elapsed,0.),stim);
+        fprintf(stdout,"       load balancing skipped, time saved %s\n",stim);
+      }
+      return 1;
+    }
+  }
+  parmesh->lb_skipped = 0;
+
+  ier = PMMG_balance_grps(parmesh);
+
+  parmesh->lb_time = MPI_Wtime() - tstart;
+
+  return ier;
+}
@@ -0,0 +1,397 @@
+/* =============================================================================
+**  This file is part of the parmmg software package for parallel tetrahedral
+**  mesh modification.
+**  Copyright (c) Bx INP/Inria/UBordeaux, 2017-
+**
+**  parmmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  parmmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with parmmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the parmmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/**
+ * \file locate_pmmg.c
+ * \brief Localization grid of a background mesh.
+ * \author Cécile Dobrzynski (Bx INP/Inria)
+ * \author Algiane Froehly (Inria)
+ * \author Luca Cirrottola (Inria)
+ * \version 1
+ * \copyright GNU Lesser General Public License.
+ *
+ * Uniform grid over the bounding box of a background mesh, used to seed the
+ * point localization and to replace the exhaustive research over the
+ * background elements when the adjacency walk fails.
+ *
+ */
+#include "parmmg.h"
+#include "locate_pmmg.h"
+
+/**
+ * \param mesh pointer toward the background mesh
+ * \param ie index of the tetra
+ * \param faceAreas scaled face areas of the tetra (filled, see \ref
+ * PMMG_LOCATE_FACEAREAS_SIZE)
+ *
+ * Store the tetra volume in its qual field and compute the data needed to
+ * evaluate the barycentric coordinates of a point in the tetra: the oriented
+ * face areas \f$n_i\f$ and their dot product \f$d_i\f$ with the first
+ * vertex of each face, both divided by the volume. The coordinates are taken
+ * relative to the first vertex \f$o\f$ of the tetra, so the barycentric
+ * coordinate relative to face \f$i\f$ of a point \f$x\f$ is
+ * \f$d_i - n_i \cdot (x-o)\f$ and stays accurate far from the origin.
+ *
+ */
+void PMMG_compute_faceAreas( MMG5_pMesh mesh,int ie,double *faceAreas ) {
+  MMG5_pTetra pt;
+  double      normal[3],*c0,*o,vol;
+  int         ifac,ia,ib,ic;
+
+  pt = &mesh->tetra[ie];
+
+  /* Store tetra volume in the qual field */
+  vol = pt->qual = MMG5_orvol( mesh->point, pt->v );
+
+  /* Origin of the tetra frame */
+  o = mesh->point[pt->v[0]].c;
+  faceAreas[16] = o[0];
+  faceAreas[17] = o[1];
+  faceAreas[18] = o[2];
+  faceAreas[19] = 0.;
+
+  /* Store oriented face normals */
+  for( ifac = 0; ifac < 4; ifac++ ) {
+    ia = pt->v[MMG5_idir[ifac][0]];
+    ib = pt->v[MMG5_idir[ifac][1]];
+    ic = pt->v[MMG5_idir[ifac][2]];
+    MMG5_nonUnitNorPts( mesh,ia,ib,ic,normal );
+
+    c0 = mesh->point[ia].c;
+    faceAreas[   ifac] = normal[0]/vol;
+    faceAreas[ 4+ifac] = normal[1]/vol;
+    faceAreas[ 8+ifac] = normal[2]/vol;
+    faceAreas[12+ifac] = ( (c0[0]-o[0])*normal[0] + (c0[1]-o[1])*normal[1] +
+                           (c0[2]-o[2])*normal[2] )/vol;
+  }
+}
+
+/**
+ * \param grid pointer toward the localization grid
+ * \param c point coordinates
+ * \param idx cell indices of the point in each space direction (filled)
+ *
+ * Compute the indices of the cell containing the point of coordinates \a c
+ * (points outside the grid are projected on the closest boundary cell).
+ *
+ */
+static inline
+void PMMG_locate_cellIdx( PMMG_locateGrid *grid,double *c,int idx[3] ) {
+  int d;
+
+  for ( d=0; d<3; ++d ) {
+    idx[d] = (int)( (c[d]-grid->min[d])*grid->dinv[d] );
+    if ( idx[d] < 0 ) idx[d] = 0;
+    else if ( idx[d] >= grid->n[d] ) idx[d] = grid->n[d]-1;
+  }
+}
+
+/**
+ * \param grid pointer toward the localization grid
+ * \param i cell index along the x direction
+ * \param j cell index along the y direction
+ * \param k cell index along the z direction
+ *
+ * \return the global index of the cell
+ *
+ */
+static inline
+int PMMG_locate_cell( PMMG_locateGrid *grid,int i,int j,int k ) {
+  return ( k*grid->n[1] + j )*grid->n[0] + i;
+}
+
+/**
+ * \param grid pointer toward the localization grid
+ * \param mesh pointer toward the background mesh
+ * \param pt pointer toward a tetra of the background mesh
+ * \param imin lowest cell indices of the tetra bounding box (filled)
+ * \param imax highest cell indices of the tetra bounding box (filled)
+ *
+ * Compute the range of cells intersected by the bounding box of a tetra.
+ *
+ */
+static inline
+void PMMG_locate_tetraCells( PMMG_locateGrid *grid,MMG5_pMesh mesh,
+                             MMG5_pTetra pt,int imin[3],int imax[3] ) {
+  int idx[3],i,d;
+
+  PMMG_locate_cellIdx( grid,mesh->point[pt->v[0]].c,imin );
+  imax[0] = imin[0];
+  imax[1] = imin[1];
+  imax[2] = imin[2];
+
+  for ( i=1; i<4; ++i ) {
+    PMMG_locate_cellIdx( grid,mesh->point[pt->v[i]].c,idx );
+    for ( d=0; d<3; ++d ) {
+      imin[d] = MG_MIN(imin[d],idx[d]);
+      imax[d] = MG_MAX(imax[d],idx[d]);
+    }
+  }
+}
+
+/**
+ * \param parmesh pointer toward the parmesh structure
+ * \param mesh pointer toward the background mesh
+ * \param grid pointer toward the localization grid to build
+ *
+ * \return 1 if success, 0 if fail
+ *
+ * Build a uniform grid over the bounding box of the background mesh and store
+ * in each cell the list of elements whose bounding box intersects the cell.
+ * The number of cells is chosen to have about \ref PMMG_LOCATE_NELTS_PER_CELL
+ * elements per cell.
+ *
+ */
+int PMMG_locate_buildGrid( PMMG_pParMesh parmesh,MMG5_pMesh mesh,
+                           PMMG_locateGrid *grid ) {
+  MMG5_pTetra pt;
+  MMG5_pPoint ppt;
+  double      max[3],ext[3],h,vol;
+  int         imin[3],imax[3],ncell,ncellTarget,ie,ip,i,j,k,d;
+
+  grid->cell = NULL;
+  grid->item = NULL;
+
+  /** Step 1: Bounding box of the background mesh */
+  for ( d=0; d<3; ++d ) {
+    grid->min[d] =  DBL_MAX;
+    max[d]       = -DBL_MAX;
+  }
+  for ( ip=1; ip<=mesh->np; ++ip ) {
+    ppt = &mesh->point[ip];
+    if ( !MG_VOK(ppt) ) continue;
+    for ( d=0; d<3; ++d ) {
+      grid->min[d] = MG_MIN(grid->min[d],ppt->c[d]);
+      max[d]       = MG_MAX(max[d],ppt->c[d]);
+    }
+  }
+
+  /** Step 2: Grid size */
+  vol = 1.;
+  for ( d=0; d<3; ++d ) {
+    if ( max[d] < grid->min[d] ) {
+      /* Empty mesh */
+      grid->min[d] = max[d] = 0.;
+    }
+    ext[d] = max[d]-grid->min[d];
+    if ( ext[d] < MMG5_EPSD ) ext[d] = MMG5_EPSD;
+    vol *= ext[d];
+  }
+
+  ncellTarget = MG_MAX( 1, mesh->ne/PMMG_LOCATE_NELTS_PER_CELL );
+  h = cbrt( vol/ncellTarget );
+
+  for ( d=0; d<3; ++d ) {
+    grid->n[d]    = (int)MG_MIN( ext[d]/h+1., PMMG_LOCATE_NCELLS_DIR_MAX );
+    grid->dinv[d] = grid->n[d]/ext[d];
+  }
+  ncell = grid->n[0]*grid->n[1]*grid->n[2];
+
+  PMMG_CALLOC(parmesh,grid->cell,ncell+1,int,"locate grid cells",return 0);
+
+  /** Step 3: Count the elements of each cell (in cell[icell+1]) */
+  for ( ie=1; ie<=mesh->ne; ++ie ) {
+    pt = &mesh->tetra[ie];
+    if ( !MG_EOK(pt) ) continue;
+
+    PMMG_locate_tetraCells( grid,mesh,pt,imin,imax );
+    for ( k=imin[2]; k<=imax[2]; ++k )
+      for ( j=imin[1]; j<=imax[1]; ++j )
+        for ( i=imin[0]; i<=imax[0]; ++i )
+          ++grid->cell[PMMG_locate_cell(grid,i,j,k)+1];
+  }
+
+  for ( i=0; i<ncell; ++i ) {
+    grid->cell[i+1] += grid->cell[i];
+  }
+
+  PMMG_MALLOC(parmesh,grid->item,MG_MAX(1,grid->cell[ncell]),int,
+              "locate grid items",
+              PMMG_DEL_MEM(parmesh,grid->cell,int,"locate grid cells");
+              return 0);
+
+  /** Step 4: Fill the cells (cell[icell] is used as insertion position and
+   * shifted back at the end) */
+  for ( ie=1; ie<=mesh->ne; ++ie ) {
+    pt = &mesh->tetra[ie];
+    if ( !MG_EOK(pt) ) continue;
+
+    PMMG_locate_tetraCells( grid,mesh,pt,imin,imax );
+    for ( k=imin[2]; k<=imax[2]; ++k )
+      for ( j=imin[1]; j<=imax[1]; ++j )
+        for ( i=imin[0]; i<=imax[0]; ++i )
+          grid->item[grid->cell[PMMG_locate_cell(grid,i,j,k)]++] = ie;
+  }
+
+  for ( i=ncell; i>0; --i ) {
+    grid->cell[i] = grid->cell[i-1];
+  }
+  grid->cell[0] = 0;
+
+  return 1;
+}
+
+/**
+ * \param parmesh pointer toward the parmesh structure
+ * \param grid pointer toward the localization grid
+ *
+ * Free the localization grid.
+ *
+ */
+void PMMG_locate_freeGrid( PMMG_pParMesh parmesh,PMMG_locateGrid *grid ) {
+
+  if ( grid->item )
+    PMMG_DEL_MEM(parmesh,grid->item,int,"locate grid items");
+  if ( grid->cell )
+    PMMG_DEL_MEM(parmesh,grid->cell,int,"locate grid cells");
+}
+
+/**
+ * \param grid pointer toward the localization grid
+ * \param mesh pointer toward the background mesh
+ * \param c coordinates of the point to locate
+ * \param init index of the previously found element (0 if none)
+ *
+ * \return the index of the element from which to start the adjacency walk
+ *
+ * Keep \a init as starting element if it lies in the cell of the point or in a
+ * neighbouring cell (close points are located in close elements), otherwise
+ * start from an element of the cell of the point.
+ *
+ */
+int PMMG_locate_gridSeed( PMMG_locateGrid *grid,MMG5_pMesh mesh,double *c,
+                          int init ) {
+  MMG5_pTetra pt;
+  int         idx[3],idxInit[3],icell;
+
+  PMMG_locate_cellIdx( grid,c,idx );
+
+  if ( init ) {
+    pt = &mesh->tetra[init];
+    if ( MG_EOK(pt) ) {
+      PMMG_locate_cellIdx( grid,mesh->point[pt->v[0]].c,idxInit );
+      if ( abs(idx[0]-idxInit[0]) <= 1 && abs(idx[1]-idxInit[1]) <= 1 &&
+           abs(idx[2]-idxInit[2]) <= 1 ) {
+        return init;
+      }
+    }
+  }
+
+  icell = PMMG_locate_cell( grid,idx[0],idx[1],idx[2] );
+  if ( grid->cell[icell+1] > grid->cell[icell] ) {
+    return grid->item[grid->cell[icell]];
+  }
+
+  return init ? init : 1;
+}
+
+/**
+ * \param mesh pointer toward the background mesh
+ * \param ppt pointer toward the point to locate
+ * \param grid pointer toward the localization grid
+ * \param faceAreas scaled face areas of the all tetrahedra in the mesh (see
+ * \ref PMMG_LOCATE_FACEAREAS_SIZE)
+ * \param barycoord barycentric coordinates of the point to be located
+ * \param closestTet index of the closest element found (0 if none)
+ * \param closestDist smallest external volume found
+ *
+ * \return index of the element containing the point, 0 if not found.
+ *
+ * Search the element containing the point among the elements of the grid
+ * cells, traveling the cells by layers of increasing distance to the cell of
+ * the point. Elements already visited by the adjacency walk (flagged with
+ * mesh->base) are skipped. If the point is not found, the research stops one
+ * layer after the first layer providing a candidate, and \a closestTet is the
+ * element with the smallest external volume among the visited ones.
+ *
+ */
+int PMMG_locate_searchGrid( MMG5_pMesh mesh,MMG5_pPoint ppt,
+                            PMMG_locateGrid *grid,double *faceAreas,
+                            PMMG_baryCoord *barycoord,int *closestTet,
+                            double *closestDist ) {
+  MMG5_pTetra pt;
+  double      eps;
+  int         idx[3],rmax,r,i,j,k,l,icell,ie,imin,foundLayer;
+
+  eps = MMG5_EPS;
+
+  *closestTet  = 0;
+  *closestDist = 1.0e10;
+  foundLayer   = -1;
+
+  PMMG_locate_cellIdx( grid,ppt->c,idx );
+
+  rmax = MG_MAX( grid->n[0],MG_MAX(grid->n[1],grid->n[2]) );
+
+  for ( r=0; r<rmax; ++r ) {
+    for ( k=MG_MAX(0,idx[2]-r); k<=MG_MIN(grid->n[2]-1,idx[2]+r); ++k ) {
+      for ( j=MG_MAX(0,idx[1]-r); j<=MG_MIN(grid->n[1]-1,idx[1]+r); ++j ) {
+        for ( i=MG_MAX(0,idx[0]-r); i<=MG_MIN(grid->n[0]-1,idx[0]+r); ++i ) {
+
+          /* Only the cells of the current layer */
+          if ( abs(i-idx[0])!=r && abs(j-idx[1])!=r && abs(k-idx[2])!=r )
+            continue;
+
+          icell = PMMG_locate_cell( grid,i,j,k );
+          for ( l=grid->cell[icell]; l<grid->cell[icell+1]; ++l ) {
+            ie = grid->item[l];
+            pt = &mesh->tetra[ie];
+
+            /* Skip already analized tetras */
+            if ( pt->flag == mesh->base ) continue;
+            pt->flag = mesh->base;
+
+            imin = PMMG_compute_baryCoord(&faceAreas[PMMG_LOCATE_FACEAREAS_SIZE*ie],
+                                          ppt->c,barycoord);
+
+            /** Exit if inside the element */
+            if ( barycoord[imin].val > -eps ) return ie;
+
+            /** Save element index if it is the closest one */
+            if ( fabs(barycoord[imin].val)*pt->qual < *closestDist ) {
+              *closestDist = fabs(barycoord[imin].val)*pt->qual;
+              *closestTet  = ie;
+            }
+          }
+        }
+      }
+    }
+
+    if ( *closestTet ) {
+      if ( foundLayer < 0 ) {
+        foundLayer = r;
+      }
+      else if ( r > foundLayer ) {
+        break;
+      }
+    }
+  }
+
+  /* Barycentric coordinates in the closest element */
+  if ( *closestTet ) {
+    PMMG_compute_baryCoord(&faceAreas[PMMG_LOCATE_FACEAREAS_SIZE*(*closestTet)],
+                           ppt->c,barycoord);
+  }
+
+  return 0;
+}
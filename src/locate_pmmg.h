@@ -37,6 +37,10 @@
 
 #include "parmmg.h"
 
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
 /** \struct PMMG_baryCoord
  *
  * \brief Struct containing the index and value of a barycentric coordinate
@@ -47,4 +51,168 @@ typedef struct {
   double val; /*!< coordinate value */
 } PMMG_baryCoord;
 
+/**
+ * \def PMMG_LOCATE_FACEAREAS_SIZE
+ *
+ * Number of doubles stored per element in the faceAreas array: for each
+ * direction x, y, z the component of the 4 oriented face areas divided by the
+ * element volume, then the 4 values of the dot product between these vectors
+ * and the first vertex of the face, relative to the first vertex of the element
+ * (struct-of-arrays layout), then the coordinates of this vertex and a padding
+ * value.
+ *
+ */
+#define PMMG_LOCATE_FACEAREAS_SIZE 20
+
+/**
+ * \def PMMG_LOCATE_NELTS_PER_CELL
+ *
+ * Target mean number of elements per cell of the localization grid
+ *
+ */
+#define PMMG_LOCATE_NELTS_PER_CELL 8
+
+/**
+ * \def PMMG_LOCATE_NCELLS_DIR_MAX
+ *
+ * Maximal number of cells of the localization grid in each space direction
+ *
+ */
+#define PMMG_LOCATE_NCELLS_DIR_MAX 512
+
+/** \struct PMMG_locateGrid
+ *
+ * \brief Uniform grid storing, for each cell, the list of the elements of a
+ * background mesh whose bounding box intersects the cell.
+ *
+ */
+typedef struct {
+  double min[3];  /*!< lower corner of the grid bounding box */
+  double dinv[3]; /*!< inverse of the cell sizes */
+  int    n[3];    /*!< number of cells in each space direction */
+  int    *cell;   /*!< position of the first element of each cell in item */
+  int    *item;   /*!< list of the elements of the cells */
+} PMMG_locateGrid;
+
+int  PMMG_locate_buildGrid( PMMG_pParMesh parmesh,MMG5_pMesh mesh,
+                            PMMG_locateGrid *grid );
+void PMMG_locate_freeGrid( PMMG_pParMesh parmesh,PMMG_locateGrid *grid );
+int  PMMG_locate_gridSeed( PMMG_locateGrid *grid,MMG5_pMesh mesh,double *c,
+                           int init );
+int  PMMG_locate_searchGrid( MMG5_pMesh mesh,MMG5_pPoint ppt,
+                             PMMG_locateGrid *grid,double *faceAreas,
+                             PMMG_baryCoord *barycoord,int *closestTet,
+                             double *closestDist );
+
+void PMMG_compute_faceAreas( MMG5_pMesh mesh,int ie,double *faceAreas );
+
+/**
+ * \param faceAreas scaled face areas of the tetra (see \ref
+ * PMMG_LOCATE_FACEAREAS_SIZE)
+ * \param coord point coordinates
+ * \param val barycentric coordinates of the point (filled)
+ *
+ * Compute the 4 barycentric coordinates of a point in a tetra (AVX or SSE2
+ * kernel if available, scalar loop otherwise). The point is first moved to the
+ * frame of the first vertex of the tetra so that the coordinates don't suffer
+ * from cancellation on meshes far from the origin.
+ *
+ */
+static inline
+void PMMG_baryCoord_kernel( const double *faceAreas,const double *coord,
+                            double *val ) {
+  double c[3];
+
+  c[0] = coord[0] - faceAreas[16];
+  c[1] = coord[1] - faceAreas[17];
+  c[2] = coord[2] - faceAreas[18];
+
+#if defined(__AVX__)
+  __m256d r;
+
+  r = _mm256_mul_pd( _mm256_loadu_pd(faceAreas  ),_mm256_set1_pd(c[0]) );
+  r = _mm256_add_pd( r,_mm256_mul_pd(_mm256_loadu_pd(faceAreas+4),
+                                     _mm256_set1_pd(c[1])) );
+  r = _mm256_add_pd( r,_mm256_mul_pd(_mm256_loadu_pd(faceAreas+8),
+                                     _mm256_set1_pd(c[2])) );
+  r = _mm256_sub_pd( _mm256_loadu_pd(faceAreas+12),r );
+  _mm256_storeu_pd( val,r );
+#elif defined(__SSE2__)
+  __m128d x,y,z,r0,r1;
+
+  x  = _mm_set1_pd(c[0]);
+  y  = _mm_set1_pd(c[1]);
+  z  = _mm_set1_pd(c[2]);
+
+  r0 = _mm_mul_pd( _mm_loadu_pd(faceAreas  ),x );
+  r1 = _mm_mul_pd( _mm_loadu_pd(faceAreas+2),x );
+  r0 = _mm_add_pd( r0,_mm_mul_pd(_mm_loadu_pd(faceAreas+4),y) );
+  r1 = _mm_add_pd( r1,_mm_mul_pd(_mm_loadu_pd(faceAreas+6),y) );
+  r0 = _mm_add_pd( r0,_mm_mul_pd(_mm_loadu_pd(faceAreas+8),z) );
+  r1 = _mm_add_pd( r1,_mm_mul_pd(_mm_loadu_pd(faceAreas+10),z) );
+  _mm_storeu_pd( val  ,_mm_sub_pd(_mm_loadu_pd(faceAreas+12),r0) );
+  _mm_storeu_pd( val+2,_mm_sub_pd(_mm_loadu_pd(faceAreas+14),r1) );
+#else
+  int ifac;
+
+  for ( ifac=0; ifac<4; ++ifac ) {
+    val[ifac] = faceAreas[12+ifac] - ( faceAreas[ifac  ]*c[0] +
+                                       faceAreas[4+ifac]*c[1] +
+                                       faceAreas[8+ifac]*c[2] );
+  }
+#endif
+}
+
+/**
+ * \param faceAreas scaled face areas of the tetra
+ * \param coord point coordinates
+ * \param barycoord barycentric coordinates of the point (filled)
+ *
+ * \return the index of the smallest barycentric coordinate
+ *
+ * Compute the barycentric coordinates of a point in a tetra and find the
+ * smallest one without branches.
+ *
+ */
+static inline
+int PMMG_compute_baryCoord( const double *faceAreas,const double *coord,
+                            PMMG_baryCoord *barycoord ) {
+  double val[4],m01,m23;
+  int    i01,i23,ifac;
+
+  PMMG_baryCoord_kernel( faceAreas,coord,val );
+
+  for ( ifac=0; ifac<4; ++ifac ) {
+    barycoord[ifac].idx = ifac;
+    barycoord[ifac].val = val[ifac];
+  }
+
+  i01 = ( val[1] < val[0] );
+  m01 = i01 ? val[1] : val[0];
+  i23 = 2 + ( val[3] < val[2] );
+  m23 = ( val[3] < val[2] ) ? val[3] : val[2];
+
+  return ( m23 < m01 ) ? i23 : i01;
+}
+
+/**
+ * \param barycoord barycentric coordinates of a point
+ *
+ * Sort the 4 barycentric coordinates in ascending order (insertion sort).
+ *
+ */
+static inline
+void PMMG_sort_baryCoord( PMMG_baryCoord *barycoord ) {
+  PMMG_baryCoord tmp;
+  int            i,j;
+
+  for ( i=1; i<4; ++i ) {
+    tmp = barycoord[i];
+    for ( j=i; j>0 && barycoord[j-1].val > tmp.val; --j ) {
+      barycoord[j] = barycoord[j-1];
+    }
+    barycoord[j] = tmp;
+  }
+}
+
 #endif
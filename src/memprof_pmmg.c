@@ -0,0 +1,734 @@
+/* =============================================================================
+**  This file is part of the parmmg software package for parallel tetrahedral
+**  mesh modification.
+**  Copyright (c) Bx INP/Inria/UBordeaux, 2017-
+**
+**  parmmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  parmmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with parmmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the parmmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/**
+ * \file memprof_pmmg.c
+ * \brief Memory profiler: current and peak memory per allocation label.
+ * \author Cécile Dobrzynski (Bx INP/Inria)
+ * \author Algiane Froehly (Inria)
+ * \author Luca Cirrottola (Inria)
+ * \version 1
+ * \copyright GNU Lesser General Public License.
+ *
+ * When the profiler is enabled (-mem-profile), each array allocated by the
+ * PMMG memory macros is charged on the label (\a msg argument) of its
+ * allocation until it is freed. For each label, we store the peak of memory,
+ * the peak reached during each phase of the pipeline and the memory used when
+ * the process reaches its own peak (the arrays that drive the peak). The
+ * arrays allocated by Mmg are not seen by the profiler, and the arrays of a
+ * group mesh are uncharged when the mesh is handed to Mmg, which may free or
+ * reallocate them (see \ref PMMG_memprof_releaseMesh).
+ *
+ */
+#include "parmmg.h"
+
+/**
+ * \struct PMMG_MemprofLabel
+ * \brief memory charged on an allocation label.
+ */
+typedef struct {
+  const char *name;                 /*!< label */
+  size_t     cur;                   /*!< current memory */
+  size_t     peak;                  /*!< peak of memory */
+  size_t     atPeak;                /*!< memory when the process reaches its peak */
+  size_t     phasePeak[PMMG_NPHASE];/*!< peak of memory during each phase */
+} PMMG_MemprofLabel;
+
+/**
+ * \struct PMMG_MemprofSlot
+ * \brief array tracked by the profiler (slot of the pointer hash table).
+ */
+typedef struct {
+  void   *ptr;   /*!< address of the array (NULL if empty slot) */
+  size_t size;   /*!< size of the array */
+  int    label;  /*!< label of the array */
+} PMMG_MemprofSlot;
+
+/**
+ * \struct PMMG_Memprof
+ * \brief state of the memory profiler of the process.
+ */
+typedef struct {
+  PMMG_MemprofSlot  *slot;     /*!< pointer hash table (linear probing) */
+  size_t            nslot;     /*!< size of the pointer hash table (power of 2) */
+  size_t            nused;     /*!< nb of arrays tracked */
+  PMMG_MemprofLabel *label;    /*!< labels */
+  int               nlabel;    /*!< nb of labels */
+  int               nlabelmax; /*!< nb of labels allocated */
+  int               *lhash;    /*!< label hash table (index+1, 0 if empty) */
+  int               nlhash;    /*!< size of the label hash table (power of 2) */
+  int               phase;     /*!< current phase */
+  size_t            cur;       /*!< current memory of the tracked arrays */
+  size_t            peak;      /*!< peak of memory of the tracked arrays */
+  size_t            snap;      /*!< memory at the last snapshot of the labels */
+  size_t            phasePeak[PMMG_NPHASE];/*!< peak of memory during each phase */
+} PMMG_Memprof;
+
+int                 PMMG_memprof_on = 0;
+static PMMG_Memprof PMMG_memprof = { NULL,0,0,NULL,0,0,NULL,0,0,0,0,0,{0} };
+
+static const char *PMMG_phaseName[PMMG_NPHASE] = {
+  "init","group splitting","mmg","interpolation","quality",
+  "load balancing","packing","merging","output" };
+
+/**
+ * \param phase index of the phase.
+ *
+ * \return the name of the phase.
+ *
+ */
+const char* PMMG_Get_phaseName( int phase ) {
+  assert ( phase >= 0 && phase < PMMG_NPHASE );
+  return PMMG_phaseName[phase];
+}
+
+/**
+ * \param ptr address of an array.
+ * \param mask size of the pointer hash table minus 1.
+ *
+ * \return the first slot of the pointer hash table to probe for \a ptr.
+ *
+ */
+static inline
+size_t PMMG_memprof_hashPtr( void *ptr,size_t mask ) {
+  return (size_t)( ((uint64_t)(uintptr_t)ptr >> 4) * 0x9E3779B97F4A7C15ULL >> 20 )
+    & mask;
+}
+
+/**
+ * \param name label.
+ *
+ * \return the hash key of the label.
+ *
+ */
+static inline
+unsigned PMMG_memprof_hashName( const char *name ) {
+  unsigned h = 2166136261u;
+
+  for ( ; *name; ++name ) h = ( h ^ (unsigned char)*name ) * 16777619u;
+  return h;
+}
+
+/**
+ * \param nslot new size of the pointer hash table.
+ *
+ * \return 1 if success, 0 if fail.
+ *
+ * Resize the pointer hash table and insert again the tracked arrays.
+ *
+ */
+static
+int PMMG_memprof_resizeSlots( size_t nslot ) {
+  PMMG_MemprofSlot *old;
+  size_t           k,j,nold;
+
+  old  = PMMG_memprof.slot;
+  nold = PMMG_memprof.nslot;
+
+  PMMG_memprof.slot = (PMMG_MemprofSlot*)calloc(nslot,sizeof(PMMG_MemprofSlot));
+  if ( !PMMG_memprof.slot ) {
+    PMMG_memprof.slot = old;
+    return 0;
+  }
+  PMMG_memprof.nslot = nslot;
+
+  for ( k=0; k<nold; ++k ) {
+    if ( !old[k].ptr ) continue;
+    j = PMMG_memprof_hashPtr(old[k].ptr,nslot-1);
+    while ( PMMG_memprof.slot[j].ptr ) j = (j+1) & (nslot-1);
+    PMMG_memprof.slot[j] = old[k];
+  }
+  free(old);
+
+  return 1;
+}
+
+/**
+ * \param name label.
+ *
+ * \return the index of the label, -1 if fail.
+ *
+ * Find the label \a name (the same literal may have different addresses in
+ * different files) or create it.
+ *
+ */
+static
+int PMMG_memprof_label( const char *name ) {
+  PMMG_MemprofLabel *label;
+  int               *lhash,nlhash,k,j,idx;
+
+  if ( PMMG_memprof.nlhash ) {
+    j = PMMG_memprof_hashName(name) & (PMMG_memprof.nlhash-1);
+    while ( (idx = PMMG_memprof.lhash[j]) ) {
+      if ( PMMG_memprof.label[idx-1].name == name ||
+           !strcmp(PMMG_memprof.label[idx-1].name,name) ) return idx-1;
+      j = (j+1) & (PMMG_memprof.nlhash-1);
+    }
+  }
+
+  /* New label */
+  if ( PMMG_memprof.nlabel == PMMG_memprof.nlabelmax ) {
+    k = PMMG_memprof.nlabelmax ? 2*PMMG_memprof.nlabelmax : 64;
+    label = (PMMG_MemprofLabel*)realloc(PMMG_memprof.label,
+                                        k*sizeof(PMMG_MemprofLabel));
+    if ( !label ) return -1;
+    PMMG_memprof.label     = label;
+    PMMG_memprof.nlabelmax = k;
+  }
+  if ( 2*(PMMG_memprof.nlabel+1) > PMMG_memprof.nlhash ) {
+    nlhash = PMMG_memprof.nlhash ? 2*PMMG_memprof.nlhash : 128;
+    lhash  = (int*)calloc(nlhash,sizeof(int));
+    if ( !lhash ) return -1;
+    for ( k=0; k<PMMG_memprof.nlabel; ++k ) {
+      j = PMMG_memprof_hashName(PMMG_memprof.label[k].name) & (nlhash-1);
+      while ( lhash[j] ) j = (j+1) & (nlhash-1);
+      lhash[j] = k+1;
+    }
+    free(PMMG_memprof.lhash);
+    PMMG_memprof.lhash  = lhash;
+    PMMG_memprof.nlhash = nlhash;
+  }
+
+  idx   = PMMG_memprof.nlabel++;
+  label = &PMMG_memprof.label[idx];
+  memset(label,0,sizeof(PMMG_MemprofLabel));
+  label->name = name;
+
+  j = PMMG_memprof_hashName(name) & (PMMG_memprof.nlhash-1);
+  while ( PMMG_memprof.lhash[j] ) j = (j+1) & (PMMG_memprof.nlhash-1);
+  PMMG_memprof.lhash[j] = idx+1;
+
+  return idx;
+}
+
+/**
+ * \param ptr address of the array.
+ *
+ * \return the slot of \a ptr in the pointer hash table, -1 if not tracked.
+ *
+ */
+static
+long PMMG_memprof_find( void *ptr ) {
+  size_t j,mask;
+
+  if ( !PMMG_memprof.nslot ) return -1;
+
+  mask = PMMG_memprof.nslot-1;
+  j    = PMMG_memprof_hashPtr(ptr,mask);
+  while ( PMMG_memprof.slot[j].ptr ) {
+    if ( PMMG_memprof.slot[j].ptr == ptr ) return (long)j;
+    j = (j+1) & mask;
+  }
+  return -1;
+}
+
+/**
+ * \param j slot to empty.
+ *
+ * Uncharge the array of slot \a j from its label and remove it from the
+ * pointer hash table (backward shift deletion).
+ *
+ */
+static
+void PMMG_memprof_remove( size_t j ) {
+  size_t mask,i,k;
+
+  PMMG_memprof.label[PMMG_memprof.slot[j].label].cur -= PMMG_memprof.slot[j].size;
+  PMMG_memprof.cur -= PMMG_memprof.slot[j].size;
+  --PMMG_memprof.nused;
+
+  mask = PMMG_memprof.nslot-1;
+  i    = j;
+  PMMG_memprof.slot[i].ptr = NULL;
+  for ( j=(i+1)&mask; PMMG_memprof.slot[j].ptr; j=(j+1)&mask ) {
+    k = PMMG_memprof_hashPtr(PMMG_memprof.slot[j].ptr,mask);
+    /* Move slot j in the hole if its first probe isn't in ]i,j] */
+    if ( ( i <= j ) ? ( k <= i || k > j ) : ( k <= i && k > j ) ) {
+      PMMG_memprof.slot[i]     = PMMG_memprof.slot[j];
+      PMMG_memprof.slot[j].ptr = NULL;
+      i = j;
+    }
+  }
+}
+
+/**
+ * \param ptr address of the array.
+ * \param size size of the array.
+ * \param msg allocation label.
+ *
+ * Charge the array on its label and update the peaks.
+ *
+ */
+static
+void PMMG_memprof_insert( void *ptr,size_t size,const char *msg ) {
+  PMMG_MemprofLabel *label;
+  long              j;
+  int               idx,k,phase;
+
+  /* Address reused after a free that has not been seen (Mmg free) */
+  j = PMMG_memprof_find(ptr);
+  if ( j >= 0 ) PMMG_memprof_remove(j);
+
+  if ( 2*(PMMG_memprof.nused+1) > PMMG_memprof.nslot ) {
+    if ( !PMMG_memprof_resizeSlots(PMMG_memprof.nslot ? 2*PMMG_memprof.nslot : 4096) )
+      return;
+  }
+
+  idx = PMMG_memprof_label(msg);
+  if ( idx < 0 ) return;
+
+  j = PMMG_memprof_hashPtr(ptr,PMMG_memprof.nslot-1);
+  while ( PMMG_memprof.slot[j].ptr ) j = (j+1) & (PMMG_memprof.nslot-1);
+  PMMG_memprof.slot[j].ptr   = ptr;
+  PMMG_memprof.slot[j].size  = size;
+  PMMG_memprof.slot[j].label = idx;
+  ++PMMG_memprof.nused;
+
+  phase = PMMG_memprof.phase;
+  label = &PMMG_memprof.label[idx];
+  label->cur += size;
+  label->peak = MG_MAX(label->peak,label->cur);
+  label->phasePeak[phase] = MG_MAX(label->phasePeak[phase],label->cur);
+
+  PMMG_memprof.cur += size;
+  PMMG_memprof.phasePeak[phase] = MG_MAX(PMMG_memprof.phasePeak[phase],
+                                         PMMG_memprof.cur);
+  if ( PMMG_memprof.cur > PMMG_memprof.peak ) {
+    PMMG_memprof.peak = PMMG_memprof.cur;
+
+    /* Snapshot of the labels at the process peak (within 1%) */
+    if ( PMMG_memprof.cur > PMMG_memprof.snap + PMMG_memprof.snap/100 ) {
+      PMMG_memprof.snap = PMMG_memprof.cur;
+      for ( k=0; k<PMMG_memprof.nlabel; ++k ) {
+        PMMG_memprof.label[k].atPeak = PMMG_memprof.label[k].cur;
+      }
+    }
+  }
+}
+
+/**
+ * \param ptr address of the allocated array.
+ * \param size size of the array.
+ * \param msg allocation label.
+ *
+ * Track an array allocated by PMMG_MALLOC or PMMG_CALLOC.
+ *
+ */
+void PMMG_memprof_alloc( void *ptr,size_t size,const char *msg ) {
+  if ( !ptr ) return;
+
+#ifdef USE_OPENMP
+#pragma omp critical (PMMG_memprof)
+#endif
+  PMMG_memprof_insert(ptr,size,msg);
+}
+
+/**
+ * \param ptr address of the array to free.
+ *
+ * Stop to track an array freed by PMMG_DEL_MEM (untracked arrays are
+ * ignored).
+ *
+ */
+void PMMG_memprof_release( void *ptr ) {
+  long j;
+
+#ifdef USE_OPENMP
+#pragma omp critical (PMMG_memprof)
+#endif
+  {
+    j = PMMG_memprof_find(ptr);
+    if ( j >= 0 ) PMMG_memprof_remove(j);
+  }
+}
+
+/**
+ * \param ptr old address of the array.
+ * \param newptr new address of the array.
+ * \param size new size of the array.
+ * \param msg allocation label.
+ *
+ * Track an array reallocated by PMMG_REALLOC (the array is charged on the
+ * label of the reallocation).
+ *
+ */
+void PMMG_memprof_realloc( void *ptr,void *newptr,size_t size,const char *msg ) {
+  long j;
+
+#ifdef USE_OPENMP
+#pragma omp critical (PMMG_memprof)
+#endif
+  {
+    j = PMMG_memprof_find(ptr);
+    if ( j >= 0 ) PMMG_memprof_remove(j);
+    PMMG_memprof_insert(newptr,size,msg);
+  }
+}
+
+/**
+ * \param mesh pointer toward a mesh.
+ * \param met pointer toward the metric (may be NULL).
+ * \param sol pointer toward the solution fields (may be NULL).
+ *
+ * Stop to track the entity arrays of a mesh, its metric and its solution
+ * fields before Mmg frees or reallocates them (Mmg remeshing, MMG3D_Free_all,
+ * MMG5_DEL_MEM): otherwise they stay charged until their address is reused.
+ *
+ */
+void PMMG_memprof_releaseMesh( MMG5_pMesh mesh,MMG5_pSol met,MMG5_pSol sol ) {
+  int k;
+
+  if ( !PMMG_memprof_on || !mesh ) return;
+
+  PMMG_memprof_release(mesh->point);
+  PMMG_memprof_release(mesh->xpoint);
+  PMMG_memprof_release(mesh->tetra);
+  PMMG_memprof_release(mesh->xtetra);
+  PMMG_memprof_release(mesh->adja);
+  PMMG_memprof_release(mesh->prism);
+  PMMG_memprof_release(mesh->xprism);
+  PMMG_memprof_release(mesh->tria);
+  PMMG_memprof_release(mesh->quadra);
+  PMMG_memprof_release(mesh->edge);
+
+  if ( met ) PMMG_memprof_release(met->m);
+  if ( sol ) {
+    for ( k=0; k<mesh->nsols; ++k ) {
+      PMMG_memprof_release(sol[k].m);
+    }
+  }
+}
+
+/**
+ * \param phase index of the new phase.
+ *
+ * Set the phase on which the next allocations are charged (the memory already
+ * allocated counts in the peaks of the new phase).
+ *
+ */
+void PMMG_memprof_setPhase( int phase ) {
+  int k;
+
+  assert ( phase >= 0 && phase < PMMG_NPHASE );
+
+  if ( !PMMG_memprof_on ) return;
+
+  PMMG_memprof.phase = phase;
+  for ( k=0; k<PMMG_memprof.nlabel; ++k ) {
+    PMMG_memprof.label[k].phasePeak[phase] =
+      MG_MAX(PMMG_memprof.label[k].phasePeak[phase],PMMG_memprof.label[k].cur);
+  }
+  PMMG_memprof.phasePeak[phase] = MG_MAX(PMMG_memprof.phasePeak[phase],
+                                         PMMG_memprof.cur);
+}
+
+/**
+ * Free the profiler data and disable it.
+ */
+void PMMG_memprof_destroy( void ) {
+  free(PMMG_memprof.slot);
+  free(PMMG_memprof.label);
+  free(PMMG_memprof.lhash);
+  memset(&PMMG_memprof,0,sizeof(PMMG_Memprof));
+  PMMG_memprof_on = 0;
+}
+
+/**
+ * \param a pointer toward a label name.
+ * \param b pointer toward a label name.
+ *
+ * \return the comparison of the label names.
+ *
+ */
+static
+int PMMG_memprof_cmpName( const void *a,const void *b ) {
+  return strcmp(*(const char**)a,*(const char**)b);
+}
+
+/**
+ * \param a pointer toward a (peak,label) pair.
+ * \param b pointer toward a (peak,label) pair.
+ *
+ * \return the comparison of the pairs by decreasing peak.
+ *
+ */
+static
+int PMMG_memprof_cmpPeak( const void *a,const void *b ) {
+  const double *pa = (const double*)a;
+  const double *pb = (const double*)b;
+
+  if ( pa[0] > pb[0] ) return -1;
+  if ( pa[0] < pb[0] ) return  1;
+  return ( pa[1] > pb[1] ) - ( pa[1] < pb[1] );
+}
+
+/**
+ * \param fp file.
+ * \param key key of the entry.
+ * \param vmin min of the values over the processes.
+ * \param vmax max of the values over the processes.
+ * \param vsum sum of the values over the processes.
+ * \param i index of the value.
+ * \param nprocs number of processes.
+ * \param last 1 if last entry of the object.
+ *
+ * Write the min/max/avg entry of a value in the JSON report.
+ *
+ */
+static
+void PMMG_memprof_writeStat( FILE *fp,const char *key,double *vmin,double *vmax,
+                             double *vsum,int i,int nprocs,int last ) {
+  fprintf(fp,"\"%s\": {\"min\": %.0f, \"max\": %.0f, \"avg\": %.1f}%s",
+          key,vmin[i],vmax[i],vsum[i]/nprocs,last ? "" : ", ");
+}
+
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ * \param filename name of the output mesh (the report is saved in
+ * "name.memprof.json").
+ *
+ * \return 1 if success, 0 if fail.
+ *
+ * Reduce the memory profile over the processes (union of the labels) and
+ * write the min, max and average over the processes of the peaks of each
+ * label in a JSON file. The labels are sorted by decreasing max peak.
+ * Collective; the profiler is disabled after the report.
+ *
+ */
+int PMMG_memprof_report( PMMG_pParMesh parmesh,const char *filename ) {
+  PMMG_MemprofLabel *label;
+  FILE              *fp;
+  const char        **names;
+  char              *buf,*gbuf,*ptr,*data,*fname;
+  double            *loc,*vmin,*vmax,*vsum,*order;
+  int               *lens,*displs,*lidx,len,glen,nu,nval,k,j,i,ier,ieresult;
+
+  if ( !PMMG_memprof_on ) return 1;
+
+  /* Stop the profiling: the report arrays are not tracked */
+  PMMG_memprof_on = 0;
+
+  ier  = 1;
+  nval = 3 + PMMG_NPHASE;
+  buf  = gbuf = data = fname = NULL;
+  lens = displs = lidx = NULL;
+  loc  = vmin = vmax = vsum = order = NULL;
+  names = NULL;
+
+  /** Step 1: gather the label names on the root and make their union */
+  len = 0;
+  for ( k=0; k<PMMG_memprof.nlabel; ++k ) {
+    len += strlen(PMMG_memprof.label[k].name)+1;
+  }
+  PMMG_MALLOC(parmesh,buf,len+1,char,"memprof buf",ier = 0);
+  if ( ier ) {
+    ptr = buf;
+    for ( k=0; k<PMMG_memprof.nlabel; ++k ) {
+      strcpy(ptr,PMMG_memprof.label[k].name);
+      ptr += strlen(ptr)+1;
+    }
+  }
+  if ( parmesh->myrank == parmesh->info.root ) {
+    PMMG_MALLOC(parmesh,lens,parmesh->nprocs,int,"memprof lens",ier = 0);
+    PMMG_MALLOC(parmesh,displs,parmesh->nprocs,int,"memprof displs",ier = 0);
+  }
+  MPI_Allreduce( &ier,&ieresult,1,MPI_INT,MPI_MIN,parmesh->comm );
+  if ( !ieresult ) goto end;
+
+  MPI_CHECK( MPI_Gather(&len,1,MPI_INT,lens,1,MPI_INT,parmesh->info.root,
+                        parmesh->comm),ier = 0 );
+
+  glen = 0;
+  nu   = 0;
+  if ( parmesh->myrank == parmesh->info.root ) {
+    for ( k=0; k<parmesh->nprocs; ++k ) {
+      displs[k] = glen;
+      glen     += lens[k];
+    }
+    PMMG_MALLOC(parmesh,gbuf,glen+1,char,"memprof gbuf",ier = 0);
+  }
+  MPI_Allreduce( &ier,&ieresult,1,MPI_INT,MPI_MIN,parmesh->comm );
+  if ( !ieresult ) goto end;
+
+  MPI_CHECK( MPI_Gatherv(buf,len,MPI_CHAR,gbuf,lens,displs,MPI_CHAR,
+                         parmesh->info.root,parmesh->comm),ier = 0 );
+
+  if ( parmesh->myrank == parmesh->info.root ) {
+    /* Count, sort and unique the names */
+    for ( ptr=gbuf; ptr<gbuf+glen; ptr+=strlen(ptr)+1 ) ++nu;
+    PMMG_MALLOC(parmesh,names,nu,const char*,"memprof names",ier = 0);
+    if ( ier ) {
+      k = 0;
+      for ( ptr=gbuf; ptr<gbuf+glen; ptr+=strlen(ptr)+1 ) names[k++] = ptr;
+      qsort(names,nu,sizeof(char*),PMMG_memprof_cmpName);
+      j = 0;
+      for ( k=0; k<nu; ++k ) {
+        if ( j && !strcmp(names[j-1],names[k]) ) continue;
+        names[j++] = names[k];
+      }
+      nu = j;
+
+      /* Pack the union in the root buffer */
+      PMMG_MALLOC(parmesh,data,glen+1,char,"memprof data",ier = 0);
+      if ( ier ) {
+        glen = 0;
+        for ( k=0; k<nu; ++k ) {
+          strcpy(data+glen,names[k]);
+          glen += strlen(names[k])+1;
+        }
+      }
+    }
+  }
+  MPI_Allreduce( &ier,&ieresult,1,MPI_INT,MPI_MIN,parmesh->comm );
+  if ( !ieresult ) goto end;
+
+  /** Step 2: broadcast the union of the labels */
+  MPI_CHECK( MPI_Bcast(&glen,1,MPI_INT,parmesh->info.root,parmesh->comm),ier = 0 );
+  MPI_CHECK( MPI_Bcast(&nu,1,MPI_INT,parmesh->info.root,parmesh->comm),ier = 0 );
+  if ( parmesh->myrank != parmesh->info.root ) {
+    PMMG_MALLOC(parmesh,data,glen+1,char,"memprof data",ier = 0);
+  }
+  PMMG_CALLOC(parmesh,loc,(nu+1)*nval,double,"memprof loc",ier = 0);
+  PMMG_MALLOC(parmesh,lidx,PMMG_memprof.nlabel+1,int,"memprof lidx",ier = 0);
+  if ( parmesh->myrank == parmesh->info.root ) {
+    PMMG_MALLOC(parmesh,vmin,(nu+1)*nval,double,"memprof vmin",ier = 0);
+    PMMG_MALLOC(parmesh,vmax,(nu+1)*nval,double,"memprof vmax",ier = 0);
+    PMMG_MALLOC(parmesh,vsum,(nu+1)*nval,double,"memprof vsum",ier = 0);
+  }
+  MPI_Allreduce( &ier,&ieresult,1,MPI_INT,MPI_MIN,parmesh->comm );
+  if ( !ieresult ) goto end;
+
+  MPI_CHECK( MPI_Bcast(data,glen,MPI_CHAR,parmesh->info.root,parmesh->comm),
+             ier = 0 );
+
+  /** Step 3: local values in the union order (last row: all the labels) */
+  for ( k=0; k<PMMG_memprof.nlabel; ++k ) lidx[k] = k;
+  ptr = data;
+  for ( i=0; i<nu; ++i ) {
+    for ( k=0; k<PMMG_memprof.nlabel; ++k ) {
+      if ( lidx[k] < 0 ) continue;
+      label = &PMMG_memprof.label[lidx[k]];
+      if ( strcmp(label->name,ptr) ) continue;
+
+      loc[i*nval]   = (double)label->peak;
+      loc[i*nval+1] = (double)label->atPeak;
+      loc[i*nval+2] = (double)label->cur;
+      for ( j=0; j<PMMG_NPHASE; ++j ) {
+        loc[i*nval+3+j] = (double)label->phasePeak[j];
+      }
+      lidx[k] = -1;
+      break;
+    }
+    ptr += strlen(ptr)+1;
+  }
+  loc[nu*nval]   = (double)PMMG_memprof.peak;
+  loc[nu*nval+1] = (double)PMMG_memprof.snap;
+  loc[nu*nval+2] = (double)PMMG_memprof.cur;
+  for ( j=0; j<PMMG_NPHASE; ++j ) {
+    loc[nu*nval+3+j] = (double)PMMG_memprof.phasePeak[j];
+  }
+
+  MPI_CHECK( MPI_Reduce(loc,vmin,(nu+1)*nval,MPI_DOUBLE,MPI_MIN,
+                        parmesh->info.root,parmesh->comm),ier = 0 );
+  MPI_CHECK( MPI_Reduce(loc,vmax,(nu+1)*nval,MPI_DOUBLE,MPI_MAX,
+                        parmesh->info.root,parmesh->comm),ier = 0 );
+  MPI_CHECK( MPI_Reduce(loc,vsum,(nu+1)*nval,MPI_DOUBLE,MPI_SUM,
+                        parmesh->info.root,parmesh->comm),ier = 0 );
+
+  /** Step 4: write the report on the root */
+  if ( parmesh->myrank == parmesh->info.root && ier ) {
+    /* Sort the labels by decreasing max peak */
+    PMMG_MALLOC(parmesh,order,2*nu,double,"memprof order",ier = 0);
+    if ( ier && !PMMG_reportFilename(parmesh,filename,".memprof.json",&fname) ) {
+      ier = 0;
+    }
+  }
+  if ( parmesh->myrank == parmesh->info.root && ier ) {
+    for ( i=0; i<nu; ++i ) {
+      order[2*i]   = vmax[i*nval];
+      order[2*i+1] = i;
+    }
+    qsort(order,nu,2*sizeof(double),PMMG_memprof_cmpPeak);
+
+    if ( !(fp = fopen(fname,"w")) ) {
+      fprintf(stderr,"\n  ## Error: %s: unable to open %s.\n",__func__,fname);
+      ier = 0;
+    }
+    else {
+      if ( parmesh->info.imprim > PMMG_VERB_VERSION ) {
+        fprintf(stdout,"\n  -- WRITING MEMORY PROFILE %s\n",fname);
+      }
+      fprintf(fp,"{\n  \"nprocs\": %d,\n  \"unit\": \"bytes\",\n",parmesh->nprocs);
+      fprintf(fp,"  \"phases\": [");
+      for ( j=0; j<PMMG_NPHASE; ++j ) {
+        fprintf(fp,"\"%s\"%s",PMMG_phaseName[j],j<PMMG_NPHASE-1 ? ", " : "],\n");
+      }
+
+      /* Total of the tracked arrays then labels by decreasing max peak */
+      fprintf(fp,"  \"labels\": [\n");
+      for ( k=-1; k<nu; ++k ) {
+        if ( k < 0 ) {
+          i = nu;
+          fprintf(fp,"    {\"label\": \"(all)\", ");
+        }
+        else {
+          i   = (int)order[2*k+1];
+          ptr = data;
+          for ( j=0; j<i; ++j ) ptr += strlen(ptr)+1;
+          fprintf(fp,"    {\"label\": \"%s\", ",ptr);
+        }
+        PMMG_memprof_writeStat(fp,"peak",vmin,vmax,vsum,i*nval,parmesh->nprocs,0);
+        PMMG_memprof_writeStat(fp,"atPeak",vmin,vmax,vsum,i*nval+1,parmesh->nprocs,0);
+        PMMG_memprof_writeStat(fp,"end",vmin,vmax,vsum,i*nval+2,parmesh->nprocs,0);
+        fprintf(fp,"\n     \"phases\": {");
+        for ( j=0; j<PMMG_NPHASE; ++j ) {
+          PMMG_memprof_writeStat(fp,PMMG_phaseName[j],vmin,vmax,vsum,i*nval+3+j,
+                                 parmesh->nprocs,j==PMMG_NPHASE-1);
+        }
+        fprintf(fp,"}}%s\n",k<nu-1 ? "," : "");
+      }
+      fprintf(fp,"  ]\n}\n");
+      fclose(fp);
+    }
+  }
+
+end:
+  PMMG_DEL_MEM(parmesh,fname,char,"fname");
+  PMMG_DEL_MEM(parmesh,order,double,"memprof order");
+  PMMG_DEL_MEM(parmesh,vsum,double,"memprof vsum");
+  PMMG_DEL_MEM(parmesh,vmax,double,"memprof vmax");
+  PMMG_DEL_MEM(parmesh,vmin,double,"memprof vmin");
+  PMMG_DEL_MEM(parmesh,lidx,int,"memprof lidx");
+  PMMG_DEL_MEM(parmesh,loc,double,"memprof loc");
+  PMMG_DEL_MEM(parmesh,data,char,"memprof data");
+  PMMG_DEL_MEM(parmesh,names,const char*,"memprof names");
+  PMMG_DEL_MEM(parmesh,gbuf,char,"memprof gbuf");
+  PMMG_DEL_MEM(parmesh,displs,int,"memprof displs");
+  PMMG_DEL_MEM(parmesh,lens,int,"memprof lens");
+  PMMG_DEL_MEM(parmesh,buf,char,"memprof buf");
+
+  PMMG_memprof_destroy();
+
+  MPI_Allreduce( &ier,&ieresult,1,MPI_INT,MPI_MIN,parmesh->comm );
+  return ieresult;
+}
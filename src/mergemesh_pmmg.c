@@ -95,6 +95,12 @@ int PMMG_mergeGrpJinI_interfacePoints_addGrpJ( PMMG_pParMesh parmesh,
       }
       assert( (ip <= meshI->npmax) && "run out of points" );
 
+      if ( !PMMG_fields_resize(meshI,grpI->sol,meshI->npmax) ) return 0;
+      PMMG_fields_copyPoint(meshI,grpI->sol,ip,grpJ->sol,
+                            node2int_node_comm_index1[ k ]);
+      if ( !PMMG_gid_resize(meshI,grpI,meshI->npmax) ) return 0;
+      PMMG_gid_copyPoint(grpI,ip,grpJ,node2int_node_comm_index1[ k ]);
+
       pptJ->tmp = ip;
       intvalues[ poi_id_glo ] = ip;
 
@@ -129,6 +135,7 @@ int PMMG_mergeGrpJinI_interfacePoints_addGrpJ( PMMG_pParMesh parmesh,
     }
   }
   metI->np = meshI->np;
+  PMMG_fields_setNp(meshI,grpI->sol,meshI->np);
 
   return 1;
 }
@@ -223,6 +230,11 @@ int PMMG_mergeGrpJinI_internalPoints( PMMG_pGrp grpI, PMMG_pGrp grpJ ) {
     }
     pptJ->tmp = ip;
 
+    if ( !PMMG_fields_resize(meshI,grpI->sol,meshI->npmax) ) return 0;
+    PMMG_fields_copyPoint(meshI,grpI->sol,ip,grpJ->sol,k);
+    if ( !PMMG_gid_resize(meshI,grpI,meshI->npmax) ) return 0;
+    PMMG_gid_copyPoint(grpI,ip,grpJ,k);
+
     /* Add xpoint if needed */
     ier = 1;
     if ( pptJ->xp ) {
@@ -245,6 +257,7 @@ int PMMG_mergeGrpJinI_internalPoints( PMMG_pGrp grpI, PMMG_pGrp grpJ ) {
     }
   }
   metI->np = meshI->np;
+  PMMG_fields_setNp(meshI,grpI->sol,meshI->np);
   return 1;
 }
 
@@ -940,6 +953,10 @@ fail_ncomm:
  * \param rcv_met buffer to gather metric
  * \param nmet_tot number of metrics in \a rcv_met
  * \param rcv_isMet met->size if we are waiting a metric
+ * \param rcv_fields buffer to gather the solution fields
+ * \param rcv_fieldsSize number of solution values per point (0 if no fields)
+ * \param rcv_nsols number of solution fields
+ * \param rcv_typSol types of the solution fields
  * \param rcv_intvalues Buffer to gather the intvalue array of the internal comm
  * \param nitem_int_node_comm_tot number of items in \a  rcv_intvalues
  * \param rcv_nitem_ext_tab Buffer to gather the number of item in the ext comm
@@ -953,6 +970,8 @@ fail_ncomm:
  * \param tetra_displs Position of the 1st tetra of each mesh in rcv_tetra
  * \param xtetra_displs Position of the 1st xtetra of each mesh in rcv_xtetra
  * \param met_displs Position of the 1st metric of each mesh in rcv_met
+ * \param fields_displs Position of the 1st solution value of each mesh in
+ * rcv_fields
  * \param intval_displs Position of the 1st data of each internal comm in rcv_intvalues
  * \param ext_comm_displs Position of the 1st data of each external comm in arrays
  * related to external comm
@@ -963,6 +982,7 @@ fail_ncomm:
  * \param rcv_ne Buffer to gather the number of tetra
  * \param rcv_xt Buffer to gather the number of xtetra
  * \param rcv_nmet Buffer to gather the number of metrics
+ * \param rcv_nfields Buffer to gather the number of solution values
  * \param rcv_int_comm_index Buffer to gather the internal comm sizes
  * \param nitem_icidx_tot number of items in \a rcv_int_comm_index
  * \param rcv_next_node_comm Buffer to gather the numbers of external comm
@@ -983,6 +1003,8 @@ int PMMG_gather_parmesh( PMMG_pParMesh parmesh,
                          MMG5_pTetra  *rcv_tetra, int *ne_tot,
                          MMG5_pxTetra *rcv_xtetra,int *xt_tot,
                          double      **rcv_met,   int *nmet_tot,int *rcv_isMet,
+                         double      **rcv_fields,int *rcv_fieldsSize,
+                         int *rcv_nsols,int **rcv_typSol,
                          int **rcv_intvalues,int *nitem_int_node_comm_tot,
                          int **rcv_nitem_ext_tab,int *ext_comm_displs_tot,
                          int **rcv_color_in_tab,int **rcv_color_out_tab,
@@ -990,9 +1012,11 @@ int PMMG_gather_parmesh( PMMG_pParMesh parmesh,
                          int **rcv_node2int_node_comm_index2,int **point_displs,
                          int **xpoint_displs,int **tetra_displs,
                          int **xtetra_displs,int **met_displs,
+                         int **fields_displs,
                          int **intval_displs,int **ext_comm_displs,
                          int **int_comm_index_displs,int **rcv_np,int **rcv_xp,
                          int **rcv_ne,int **rcv_xt,int **rcv_nmet,
+                         int **rcv_nfields,
                          int **rcv_int_comm_index,int *nitem_icidx_tot,
                          int** rcv_next_node_comm,
                          int **rcv_nitem_int_node_comm ) {
@@ -1006,8 +1030,10 @@ int PMMG_gather_parmesh( PMMG_pParMesh parmesh,
   int            *color_in_tab,*color_out_tab,*nitem_ext_tab;
   int            *int_comm_index,*nitems_ext_idx,nitem_ext_tot;
   int            nprocs,root,k,i,idx;
-  int            isMet,np,xp,ne,xt,size2send;
+  int            isMet,fieldsSize,nfields_tot,nsols,*typSol;
+  int            np,xp,ne,xt,size2send;
   int            ier,ieresult;
+  double         *fields;
   void           *ptr;
 
   nprocs        = parmesh->nprocs;
@@ -1016,6 +1042,8 @@ int PMMG_gather_parmesh( PMMG_pParMesh parmesh,
   mesh          = grp ? grp->mesh : NULL;
   met           = grp ? grp->met  : NULL;
   isMet         = (met && (met->m) )? met->size : 0;
+  fieldsSize    = mesh ? PMMG_fields_size(mesh,grp->sol) : 0;
+  nsols         = ( mesh && grp->sol ) ? mesh->nsols : 0;
   comm          = parmesh->comm;
   int_node_comm = parmesh->int_node_comm;
   ier           = 1;
@@ -1040,6 +1068,11 @@ int PMMG_gather_parmesh( PMMG_pParMesh parmesh,
   (*met_displs)    = NULL;
   (*rcv_met)       = NULL;
 
+  (*rcv_nfields)   = NULL;
+  (*fields_displs) = NULL;
+  (*rcv_fields)    = NULL;
+  (*rcv_typSol)    = NULL;
+
   (*rcv_intvalues)                 = NULL;
   (*rcv_node2int_node_comm_index1) = NULL;
   (*rcv_node2int_node_comm_index2) = NULL;
@@ -1056,6 +1089,8 @@ int PMMG_gather_parmesh( PMMG_pParMesh parmesh,
   nitem_ext_tab  = NULL;
   nitems_ext_idx = NULL;
   int_comm_index = NULL;
+  typSol         = NULL;
+  fields         = NULL;
 
   /** Memory alloc */
   /* 1: Mesh data */
@@ -1103,9 +1138,31 @@ int PMMG_gather_parmesh( PMMG_pParMesh parmesh,
     PMMG_CALLOC( parmesh, (*met_displs)  ,nprocs,int,"met_displs"   ,ier=3);
   }
 
+  /* Solution fields: all the procs have the same fields (or no mesh) */
+  MPI_CHECK( MPI_Allreduce(&fieldsSize,rcv_fieldsSize,1,MPI_INT,MPI_MAX,comm),
+             ier = 3);
+  MPI_CHECK( MPI_Allreduce(&nsols,rcv_nsols,1,MPI_INT,MPI_MAX,comm),ier = 3);
+
+  if ( *rcv_nsols ) {
+    PMMG_CALLOC( parmesh, typSol     ,*rcv_nsols,int,"typSol"    ,ier=3);
+    PMMG_CALLOC( parmesh, (*rcv_typSol),*rcv_nsols,int,"rcv_typSol",ier=3);
+  }
+
+  if ( (!parmesh->myrank) && *rcv_fieldsSize ) {
+    PMMG_CALLOC( parmesh, (*rcv_nfields)  ,nprocs,int,"rcv_nfields"  ,ier=3);
+    PMMG_CALLOC( parmesh, (*fields_displs),nprocs,int,"fields_displs",ier=3);
+  }
+
   MPI_CHECK( MPI_Allreduce(&ier,&ieresult,1,MPI_INT,MPI_MAX,comm),ieresult=3);
   if ( ieresult>1 ) goto end;
 
+  /* Types of the solution fields */
+  if ( *rcv_nsols ) {
+    for ( k=0; k<nsols; ++k ) typSol[k] = grp->sol[k].type;
+    MPI_CHECK( MPI_Allreduce(typSol,(*rcv_typSol),*rcv_nsols,MPI_INT,MPI_MAX,
+                             comm),ier = 3);
+  }
+
   /** Alloc arrays */
   /* Creation of MPI types for the mesh comm */
   PMMG_create_MPI_Point ( &mpi_point  );
@@ -1166,6 +1223,27 @@ int PMMG_gather_parmesh( PMMG_pParMesh parmesh,
     *nmet_tot   = (*met_displs)[nprocs-1]+(*rcv_nmet)[nprocs-1]+*rcv_isMet;
     PMMG_CALLOC( parmesh,(*rcv_met),*nmet_tot,double,"rcv_met",ier=2);
   }
+  if ( *rcv_fieldsSize && !parmesh->myrank ) {
+    for ( k=0; k<nprocs; ++k ) {
+      (*rcv_nfields)[k] = *rcv_fieldsSize*(*rcv_np)[k];
+    }
+
+    (*fields_displs)[0] = 0;
+    for ( k=1; k<nprocs; ++k ) {
+      (*fields_displs)[k] += (*fields_displs)[k-1] + (*rcv_nfields)[k-1];
+    }
+    nfields_tot = (*fields_displs)[nprocs-1]+(*rcv_nfields)[nprocs-1]+*rcv_fieldsSize;
+    PMMG_CALLOC( parmesh,(*rcv_fields),nfields_tot,double,"rcv_fields",ier=2);
+  }
+  /* Store contiguously the fields values of each point */
+  if ( fieldsSize ) {
+    PMMG_MALLOC( parmesh,fields,fieldsSize*mesh->np,double,"fields",ier=2);
+    if ( fields ) {
+      for ( k=1; k<=mesh->np; ++k ) {
+        PMMG_fields_packPoint(mesh,grp->sol,k,&fields[fieldsSize*(k-1)]);
+      }
+    }
+  }
 
   /* Internal communicator */
   (*intval_displs)[0] = 0;
@@ -1310,6 +1388,14 @@ int PMMG_gather_parmesh( PMMG_pParMesh parmesh,
                            &(*rcv_met)[*rcv_isMet],(*rcv_nmet),(*met_displs),
                            MPI_DOUBLE,root,comm),ier=2);
   }
+  if ( *rcv_fieldsSize ) {
+    size2send = fieldsSize ? mesh->np*fieldsSize : 0;
+
+    MPI_CHECK( MPI_Gatherv(fields,size2send,MPI_DOUBLE,
+                           (*rcv_fields) ? &(*rcv_fields)[*rcv_fieldsSize] : NULL,
+                           (*rcv_nfields),(*fields_displs),
+                           MPI_DOUBLE,root,comm),ier=2);
+  }
 
   /* Internal communicator */
   MPI_CHECK( MPI_Gatherv(int_node_comm->intvalues,int_node_comm->nitem,MPI_INT,
@@ -1364,6 +1450,8 @@ end:
     PMMG_DEL_MEM(parmesh,nitem_ext_tab ,int,"nitem_ext");
     PMMG_DEL_MEM(parmesh,nitems_ext_idx,int,"nitems_ext_idx");
     PMMG_DEL_MEM(parmesh,int_comm_index,int,"int_comm_idx");
+    PMMG_DEL_MEM(parmesh,fields,double,"fields");
+    PMMG_DEL_MEM(parmesh,typSol,int,"typSol");
 
     /* Free useless groups */
     /* 1: mesh */
@@ -1377,6 +1465,10 @@ end:
       }
       if ( isMet )
         PMMG_DEL_MEM(mesh,met->m,double,"met");
+      for ( k=0; k<nsols; ++k ) {
+        PMMG_DEL_MEM(mesh,grp->sol[k].m,double,"sol array");
+        grp->sol[k].np = grp->sol[k].npmax = 0;
+      }
 
       mesh->np = mesh->npmax = 0;
       mesh->ne = mesh->nemax = 0;
@@ -1417,6 +1509,9 @@ end:
  * \param rcv_tetra Buffer that gathers tetra
  * \param rcv_xtetra Buffer that gathers xtetra
  * \param rcv_met buffer that gathers metric
+ * \param rcv_fields buffer that gathers the solution fields
+ * \param rcv_nsols number of solution fields
+ * \param rcv_typSol types of the solution fields
  * \param rcv_intvalues Buffer that gathers the intvalue array of the internal comm
  * \param rcv_nitem_ext_tab Buffer that gathers the number of item in the ext comm
  * \param rcv_color_in_tab Buffer that gathers the color_in field of the ext comm
@@ -1426,6 +1521,8 @@ end:
  * \param tetra_displs Position of the 1st tetra of each mesh in rcv_tetra
  * \param xtetra_displs Position of the 1st xtetra of each mesh in rcv_xtetra
  * \param met_displs Position of the 1st metric of each mesh in rcv_met
+ * \param fields_displs Position of the 1st solution value of each mesh in
+ * rcv_fields
  * \param intval_displs Position of the 1st data of each internal comm in rcv_intvalues
  * \param ext_comm_displs Position of the 1st data of each external comm in arrays
  * related to external comm
@@ -1448,12 +1545,14 @@ static inline
 int PMMG_mergeParmesh_rcvParMeshes(PMMG_pParMesh parmesh,MMG5_pPoint rcv_point,
                                    MMG5_pxPoint rcv_xpoint,MMG5_pTetra rcv_tetra,
                                    MMG5_pxTetra rcv_xtetra,double *rcv_met,
+                                   double *rcv_fields,int rcv_nsols,
+                                   int *rcv_typSol,
                                    int *rcv_intvalues,int *rcv_nitem_ext_tab,
                                    int *rcv_color_in_tab,int *rcv_color_out_tab,
                                    int *point_displs,
                                    int *xpoint_displs,int *tetra_displs,
                                    int *xtetra_displs,int *met_displs,
-                                   int *intval_displs,int *ext_comm_displs,
+                                   int *fields_displs,int *intval_displs,int *ext_comm_displs,
                                    int *int_comm_index_displs,int *rcv_np,
                                    int *rcv_ne,int *rcv_xt,
                                    int *rcv_int_comm_index,int* rcv_next_node_comm) {
@@ -1463,13 +1562,13 @@ int PMMG_mergeParmesh_rcvParMeshes(PMMG_pParMesh parmesh,MMG5_pPoint rcv_point,
   MMG5_pxPoint   xpoint,pxp;
   MMG5_pTetra    tetra,pt;
   MMG5_pxTetra   xtetra,pxt;
-  MMG5_pSol      met;
-  double         *met_1;
+  MMG5_pSol      met,psl;
+  double         *met_1,*fields_1;
   size_t         memAv;
   int            *int_comm_index,*int_comm_index_2;
   int            *intvalues_1,*intvalues_2,nitems_1,nitems_2;
   int            nprocs,k,i,j,idx,idx_2,cursor,color_in,color_out;
-  int            np,ne,ne_tot,xt_tot,nnpar;
+  int            np,ne,ne_tot,xt_tot,nnpar,fieldsSize;
 
   nprocs = parmesh->nprocs;
 
@@ -1637,6 +1736,27 @@ int PMMG_mergeParmesh_rcvParMeshes(PMMG_pParMesh parmesh,MMG5_pPoint rcv_point,
     MMG5_SAFE_CALLOC(met->m,(met->npmax+1)*met->size,double,return 0);
   }
 
+  fieldsSize = 0;
+  if ( rcv_fields ) {
+    if ( !grp->sol ) {
+      /* The root has no group left: rebuild the solution fields */
+      if ( !PMMG_fields_init(mesh,&grp->sol,rcv_nsols) ) return 0;
+      for ( j=0; j<rcv_nsols; ++j ) {
+        psl = &grp->sol[j];
+        if ( !MMG5_Set_inputSolName(mesh,psl,"") )  return 0;
+        if ( !MMG5_Set_outputSolName(mesh,psl,"") ) return 0;
+        if ( !MMG3D_Set_solSize(mesh,psl,MMG5_Vertex,mesh->np,rcv_typSol[j]) )
+          return 0;
+      }
+    }
+    else {
+      assert ( mesh->nsols == rcv_nsols );
+      if ( !PMMG_fields_resize(mesh,grp->sol,mesh->npmax) ) return 0;
+      PMMG_fields_setNp(mesh,grp->sol,mesh->np);
+    }
+    fieldsSize = PMMG_fields_size(mesh,grp->sol);
+  }
+
   for ( i=1; i<=mesh->np; ++i ) mesh->point[i].tag = MG_NUL;
 
   np = 0;
@@ -1644,6 +1764,8 @@ int PMMG_mergeParmesh_rcvParMeshes(PMMG_pParMesh parmesh,MMG5_pPoint rcv_point,
     point_1     = &rcv_point[point_displs[k]];
     if ( rcv_met )
       met_1       = &rcv_met[met_displs[k]];
+    if ( rcv_fields )
+      fields_1    = &rcv_fields[fields_displs[k]];
 
     for ( i=1; i<=rcv_np[k]; ++i ) {
       idx = point_1[i].tmp;
@@ -1663,6 +1785,9 @@ int PMMG_mergeParmesh_rcvParMeshes(PMMG_pParMesh parmesh,MMG5_pPoint rcv_point,
                 &met_1[i*met->size],
                 met->size*sizeof(double) );
 
+      if ( rcv_fields )
+        PMMG_fields_unpackPoint( mesh,grp->sol,idx,&fields_1[i*fieldsSize] );
+
       if ( point_1[i].xp ) ++np;
     }
   }
@@ -1709,12 +1834,13 @@ int PMMG_merge_parmesh( PMMG_pParMesh parmesh ) {
   MMG5_pTetra    rcv_tetra;
   MMG5_pxTetra   rcv_xtetra;
   PMMG_pInt_comm int_node_comm;
-  double         *rcv_met;
+  double         *rcv_met,*rcv_fields;
   size_t         available;
   int            *rcv_np,np_tot,*rcv_ne,ne_tot,*rcv_xp,xp_tot,*rcv_xt,xt_tot;
-  int            *rcv_nmet,nmet_tot;
+  int            *rcv_nmet,nmet_tot,*rcv_nfields,rcv_fieldsSize;
+  int            rcv_nsols,*rcv_typSol;
   int            *point_displs,*xpoint_displs,*tetra_displs,*xtetra_displs;
-  int            *met_displs,*intval_displs,*ext_comm_displs;
+  int            *met_displs,*fields_displs,*intval_displs,*ext_comm_displs;
   int            *int_comm_index_displs;
   int            *rcv_intvalues,nitem_inc_tot;
   int            *rcv_int_comm_index,nitem_icidx_tot,ext_comm_displs_tot;
@@ -1771,16 +1897,19 @@ int PMMG_merge_parmesh( PMMG_pParMesh parmesh ) {
   /** Step 2: Procs send their parmeshes to Proc 0 and Proc 0 recieve the data */
   ier = PMMG_gather_parmesh(parmesh,&rcv_point,&np_tot,&rcv_xpoint,&xp_tot,
                             &rcv_tetra,&ne_tot,&rcv_xtetra,&xt_tot,
-                            &rcv_met,&nmet_tot,&rcv_isMet,&rcv_intvalues,
-                            &nitem_inc_tot,
+                            &rcv_met,&nmet_tot,&rcv_isMet,
+                            &rcv_fields,&rcv_fieldsSize,&rcv_nsols,&rcv_typSol,
+                            &rcv_intvalues,&nitem_inc_tot,
                             &rcv_nitem_ext_tab,&ext_comm_displs_tot,
                             &rcv_color_in_tab,&rcv_color_out_tab,
                             &rcv_node2int_node_comm_index1,
                             &rcv_node2int_node_comm_index2,&point_displs,
                             &xpoint_displs,&tetra_displs,&xtetra_displs,
-                            &met_displs,&intval_displs,&ext_comm_displs,
+                            &met_displs,&fields_displs,&intval_displs,
+                            &ext_comm_displs,
                             &int_comm_index_displs,&rcv_np,&rcv_xp,&rcv_ne,
-                            &rcv_xt,&rcv_nmet,&rcv_int_comm_index,&nitem_icidx_tot,
+                            &rcv_xt,&rcv_nmet,&rcv_nfields,
+                            &rcv_int_comm_index,&nitem_icidx_tot,
                             &rcv_next_node_comm,&rcv_nitem_int_node_comm);
 
   if ( ier ) {
@@ -1806,10 +1935,12 @@ int PMMG_merge_parmesh( PMMG_pParMesh parmesh ) {
      * communicators to recover the numbering of the points shared with a lower
      * proc. The other points are concatenated with the proc 0. */
     ier = PMMG_mergeParmesh_rcvParMeshes(parmesh,rcv_point,rcv_xpoint,rcv_tetra,
-                                         rcv_xtetra,rcv_met,rcv_intvalues,rcv_nitem_ext_tab,
+                                         rcv_xtetra,rcv_met,rcv_fields,rcv_nsols,
+                                         rcv_typSol,rcv_intvalues,rcv_nitem_ext_tab,
                                          rcv_color_in_tab,rcv_color_out_tab,point_displs,
                                          xpoint_displs,tetra_displs,xtetra_displs,
-                                         met_displs,intval_displs,ext_comm_displs,
+                                         met_displs,fields_displs,intval_displs,
+                                         ext_comm_displs,
                                          int_comm_index_displs,rcv_np,rcv_ne,rcv_xt,
                                          rcv_int_comm_index,rcv_next_node_comm);
   }
@@ -1838,6 +1969,9 @@ int PMMG_merge_parmesh( PMMG_pParMesh parmesh ) {
       PMMG_DEL_MEM(parmesh,rcv_met,double,"rcv_met");
       PMMG_DEL_MEM(parmesh,met_displs,int,"met_displs");
     }
+    PMMG_DEL_MEM(parmesh,rcv_nfields,int,"rcv_nfields");
+    PMMG_DEL_MEM(parmesh,rcv_fields,double,"rcv_fields");
+    PMMG_DEL_MEM(parmesh,fields_displs,int,"fields_displs");
 
     parmesh->ngrp = 1;
   }
@@ -1846,6 +1980,8 @@ int PMMG_merge_parmesh( PMMG_pParMesh parmesh ) {
     parmesh->ngrp = 0;
   }
 
+  PMMG_DEL_MEM(parmesh,rcv_typSol,int,"rcv_typSol");
+
   /* 2: communicators data */
   PMMG_DEL_MEM(parmesh,rcv_int_comm_index,int,"rcv_ic_idx");
   PMMG_DEL_MEM(parmesh,rcv_intvalues,int,"rcv_intvalues");
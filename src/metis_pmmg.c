@@ -203,6 +203,93 @@ double PMMG_computeWgt( MMG5_pMesh mesh,MMG5_pSol met,MMG5_pTetra pt,int ifac )
   return res;
 }
 
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met  pointer toward the met structure.
+ * \param pt   pointer toward the tetrahedron structure.
+ *
+ * \return the predicted number of elements
+ *
+ * Predict the number of elements that the remesher creates inside the
+ * tetrahedron \a pt: integral of sqrt(det(M)) over the element (approximated
+ * by the element volume times the mean of the vertex values) divided by the
+ * volume of the unit regular tetrahedron. Return 1 if there is no metric.
+ *
+ */
+double PMMG_computeVwgt( MMG5_pMesh mesh,MMG5_pSol met,MMG5_pTetra pt ) {
+  MMG5_pPoint  p0,p1,p2,p3;
+  double       *m,dens,det,vol,h;
+  double       abx,aby,abz,acx,acy,acz,adx,ady,adz;
+  int          i;
+
+  if ( (!met) || (!met->m) || (!met->np) ) return 1.;
+
+  dens = 0.;
+  for ( i=0; i<4; ++i ) {
+    m = &met->m[met->size*pt->v[i]];
+    if ( met->size == 1 ) {
+      h = m[0];
+      dens += ( h > MMG5_EPSD ) ? 1./(h*h*h) : 0.;
+    }
+    else {
+      det = m[0]*(m[3]*m[5]-m[4]*m[4]) - m[1]*(m[1]*m[5]-m[2]*m[4])
+        + m[2]*(m[1]*m[4]-m[2]*m[3]);
+      dens += ( det > 0. ) ? sqrt(det) : 0.;
+    }
+  }
+
+  p0 = &mesh->point[pt->v[0]];
+  p1 = &mesh->point[pt->v[1]];
+  p2 = &mesh->point[pt->v[2]];
+  p3 = &mesh->point[pt->v[3]];
+
+  abx = p1->c[0]-p0->c[0]; aby = p1->c[1]-p0->c[1]; abz = p1->c[2]-p0->c[2];
+  acx = p2->c[0]-p0->c[0]; acy = p2->c[1]-p0->c[1]; acz = p2->c[2]-p0->c[2];
+  adx = p3->c[0]-p0->c[0]; ady = p3->c[1]-p0->c[1]; adz = p3->c[2]-p0->c[2];
+
+  vol = fabs( abx*(acy*adz-acz*ady) + aby*(acz*adx-acx*adz)
+              + abz*(acx*ady-acy*adx) ) / 6.;
+
+  return 0.25 * dens * vol / PMMG_VOLUNIT;
+}
+
+/**
+ * \param ne number of elements of the graph (global number for parmetis).
+ *
+ * \return the weight of an element of mean cost.
+ *
+ * The weights sum is about the weight of the mean element times \a ne: use
+ * \ref PMMG_VWGT_SCALE, lowered if needed so that the sum stays under the half
+ * of the range of idx_t.
+ *
+ */
+static inline
+double PMMG_scaleVwgt_factor( double ne ) {
+  return MG_MIN((double)PMMG_VWGT_SCALE,(double)IDX_MAX/(2.*MG_MAX(ne,1.)));
+}
+
+/**
+ * \param pred predicted number of elements of an item.
+ * \param mean mean predicted number of elements per element.
+ * \param scale weight of an element of mean cost (see \ref PMMG_scaleVwgt_factor).
+ * \param wmax maximal weight of the item.
+ *
+ * \return the metis node weight of the item.
+ *
+ * Scale the predicted number of elements so that an element of mean cost has
+ * weight \a scale, and bound it by \a wmax (computed in double precision to
+ * not overflow idx_t).
+ *
+ */
+static inline
+idx_t PMMG_scaleVwgt( double pred,double mean,double scale,double wmax ) {
+  double wgt;
+
+  wgt = ( mean > 0. ) ? scale*pred/mean : scale;
+  wgt = MG_MIN(wgt,wmax);
+  return (idx_t)MG_MAX(1.,wgt+0.5);
+}
+
 /**
  * \param parmesh pointer toward the parmesh structure.
  *
@@ -640,8 +727,12 @@ int PMMG_correct_parmeshGrps2parmetis( PMMG_pParMesh parmesh,idx_t *vtxdist,
 /**
  * \param parmesh pointer toward the PMMG parmesh structure
  * \param mesh pointer toward a MMG5 mesh structure
+ * \param met pointer toward the metric structure
  * \param xadj pointer toward the position of the elt adjacents in adjncy
  * \param adjncy pointer toward the list of the adjacent of each elt
+ * \param vwgt pointer toward the metis node weights (allocated only if the
+ * weights are asked, NULL otherwise)
+ * \param adjwgt pointer toward the metis edge weights
  * \param nadjncy number of data in adjncy array
  * \param memAv pointer toward the available memory (to update)
  *
@@ -653,11 +744,12 @@ int PMMG_correct_parmeshGrps2parmetis( PMMG_pParMesh parmesh,idx_t *vtxdist,
  *
  */
 int PMMG_graph_meshElts2metis( PMMG_pParMesh parmesh,MMG5_pMesh mesh,MMG5_pSol met,
-                               idx_t **xadj,idx_t **adjncy,idx_t **adjwgt,
-                               idx_t *nadjncy,size_t *memAv) {
+                               idx_t **xadj,idx_t **adjncy,idx_t **vwgt,
+                               idx_t **adjwgt,idx_t *nadjncy,size_t *memAv) {
   MMG5_pTetra  pt;
   MMG5_pxTetra pxt;
   size_t       memMaxOld;
+  double       *pred,mean,scale;
   int          *adja;
   int          j,k,iadr,jel,count,nbAdj,wgt,ier;
 
@@ -680,8 +772,8 @@ int PMMG_graph_meshElts2metis( PMMG_pParMesh parmesh,MMG5_pMesh mesh,MMG5_pSol m
   memMaxOld        = parmesh->memMax;
   parmesh->memMax += *memAv;
 
-  PMMG_CALLOC(parmesh, (*xadj), mesh->ne+1, idx_t, "allocate xadj",
-              return 0);
+  PMMG_SCRATCH_CALLOC(parmesh, (*xadj), mesh->ne+1, idx_t, "allocate xadj",
+                      return 0);
 
   /** 1) Count the number of adjacent of each elements and fill xadj */
   (*xadj)[0] = 0;
@@ -701,14 +793,14 @@ int PMMG_graph_meshElts2metis( PMMG_pParMesh parmesh,MMG5_pMesh mesh,MMG5_pSol m
   /** 2) List the adjacent of each elts in adjncy */
   ier = 1;
   ++(*nadjncy);
-  PMMG_CALLOC(parmesh, (*adjncy), (*nadjncy), idx_t, "allocate adjncy", ier=0;);
+  PMMG_SCRATCH_CALLOC(parmesh, (*adjncy), (*nadjncy), idx_t, "allocate adjncy", ier=0;);
   if( !ier ) {
     PMMG_DEL_MEM(parmesh, (*xadj), idx_t, "deallocate xadj" );
     parmesh->memMax = parmesh->memCur;
     *memAv -= (parmesh->memMax - memMaxOld);
     return ier;
   }
-  PMMG_CALLOC(parmesh, (*adjwgt), (*nadjncy), idx_t, "allocate adjwgt", ier=0;);
+  PMMG_SCRATCH_CALLOC(parmesh, (*adjwgt), (*nadjncy), idx_t, "allocate adjwgt", ier=0;);
   if( !ier ) {
     PMMG_DEL_MEM(parmesh, (*xadj), idx_t, "deallocate xadj" );
     PMMG_DEL_MEM(parmesh, (*adjncy), idx_t, "deallocate adjncy" );
@@ -747,6 +839,38 @@ int PMMG_graph_meshElts2metis( PMMG_pParMesh parmesh,MMG5_pMesh mesh,MMG5_pSol m
     assert( count == ( (*xadj)[k] ) );
   }
 
+  /** 3) Node weights: predicted number of elements created by the remesher */
+  *vwgt = NULL;
+  if ( parmesh->info.vwgt_mode != PMMG_VWGT_elements && mesh->ne ) {
+    pred = NULL;
+    PMMG_MALLOC(parmesh,pred,mesh->ne,double,"predicted elements",ier=0);
+    if ( ier ) {
+      PMMG_SCRATCH_MALLOC(parmesh,*vwgt,mesh->ne,idx_t,"allocate vwgt",ier=0);
+    }
+    if ( !ier ) {
+      PMMG_DEL_MEM(parmesh,pred,double,"predicted elements");
+      PMMG_DEL_MEM(parmesh,(*adjwgt),idx_t,"deallocate adjwgt");
+      PMMG_DEL_MEM(parmesh,(*adjncy),idx_t,"deallocate adjncy");
+      PMMG_DEL_MEM(parmesh,(*xadj),idx_t,"deallocate xadj");
+      parmesh->memMax = parmesh->memCur;
+      *memAv -= (parmesh->memMax - memMaxOld);
+      return ier;
+    }
+
+    mean = 0.;
+    for ( k=1; k<=mesh->ne; ++k ) {
+      pred[k-1] = PMMG_computeVwgt(mesh,met,&mesh->tetra[k]);
+      mean     += pred[k-1];
+    }
+    mean /= (double)mesh->ne;
+
+    scale = PMMG_scaleVwgt_factor((double)mesh->ne);
+    for ( k=0; k<mesh->ne; ++k ) {
+      (*vwgt)[k] = PMMG_scaleVwgt(pred[k],mean,scale,(double)PMMG_VWGT_MAX);
+    }
+    PMMG_DEL_MEM(parmesh,pred,double,"predicted elements");
+  }
+
   parmesh->memMax = parmesh->memCur;
   *memAv -= (parmesh->memMax - memMaxOld);
 
@@ -788,11 +912,10 @@ int PMMG_graph_parmeshGrps2parmetis( PMMG_pParMesh parmesh,idx_t **vtxdist,
   MMG5_pTetra    pt;
   MMG5_pxTetra   pxt;
   MPI_Comm       comm;
-  MPI_Status     status;
   int            *face2int_face_comm_index1,*face2int_face_comm_index2;
   int            *intvalues,*itosend,*itorecv;
-  double         *doublevalues,*rtosend,*rtorecv;
-  int            found,color;
+  double         *doublevalues,*rtosend,*rtorecv,*grppred,pred[2],mean,scale;
+  int            found,ne;
   int            ngrp,myrank,nitem,k,igrp,igrp_adj,i,idx,ie,ifac,ishift,wgt;
 
   *wgtflag = PMMG_WGTFLAG_DEF; /* Default weight choice for parmetis */
@@ -806,7 +929,7 @@ int PMMG_graph_parmeshGrps2parmetis( PMMG_pParMesh parmesh,idx_t **vtxdist,
 
   /** Step 1: Fill vtxdist array with the range of groups local to each
    * processor */
-  PMMG_CALLOC(parmesh,*vtxdist,nproc+1,idx_t,"parmetis vtxdist", return 0);
+  PMMG_SCRATCH_CALLOC(parmesh,*vtxdist,nproc+1,idx_t,"parmetis vtxdist", return 0);
 
   MPI_CHECK( MPI_Allgather(&ngrp,1,MPI_INT,&(*vtxdist)[1],1,MPI_INT,comm),
              goto fail_1 );
@@ -815,38 +938,83 @@ int PMMG_graph_parmeshGrps2parmetis( PMMG_pParMesh parmesh,idx_t **vtxdist,
     (*vtxdist)[k] += (*vtxdist)[k-1];
 
   /** Step 2: Fill weights array with the number of MG_PARBDY face per group */
-  PMMG_CALLOC(parmesh,*vwgt,ngrp,idx_t,"parmetis vwgt", goto fail_1);
+  PMMG_SCRATCH_CALLOC(parmesh,*vwgt,ngrp,idx_t,"parmetis vwgt", goto fail_1);
 
-  for ( igrp=0; igrp<ngrp; ++igrp ) {
-    mesh = parmesh->listgrp[igrp].mesh;
+  if ( parmesh->info.vwgt_mode != PMMG_VWGT_elements ) {
+    /* Predicted number of elements created by the remesher in each group
+     * (times the measured cost ratio of the proc if asked), scaled by the
+     * global mean prediction per element */
+    *wgtflag = PMMG_WGTFLAG_BOTH;
 
-    if ( !mesh ) {
-      (*vwgt)[igrp] = 1;
-      continue;
+    PMMG_MALLOC(parmesh,grppred,ngrp,double,"predicted elements",goto fail_2);
+
+    pred[0] = pred[1] = 0.;
+    for ( igrp=0; igrp<ngrp; ++igrp ) {
+      grppred[igrp] = 0.;
+      mesh          = parmesh->listgrp[igrp].mesh;
+      met           = parmesh->listgrp[igrp].met;
+      if ( !mesh ) continue;
+
+      for ( k=1; k<=mesh->ne; ++k ) {
+        pt = &mesh->tetra[k];
+        if ( !MG_EOK(pt) ) continue;
+
+        grppred[igrp] += PMMG_computeVwgt(mesh,met,pt);
+        ++pred[1];
+      }
+      if ( parmesh->info.vwgt_mode == PMMG_VWGT_measured &&
+           parmesh->cost_ratio > 0. ) {
+        grppred[igrp] *= parmesh->cost_ratio;
+      }
+      pred[0] += grppred[igrp];
+    }
+    MPI_CHECK( MPI_Allreduce(MPI_IN_PLACE,pred,2,MPI_DOUBLE,MPI_SUM,comm),
+               PMMG_DEL_MEM(parmesh,grppred,double,"predicted elements");
+               goto fail_2 );
+
+    /* pred[1] is the global number of elements */
+    mean  = ( pred[1] > 0. ) ? pred[0]/pred[1] : 0.;
+    scale = PMMG_scaleVwgt_factor(pred[1]);
+    for ( igrp=0; igrp<ngrp; ++igrp ) {
+      mesh = parmesh->listgrp[igrp].mesh;
+      ne   = mesh ? MG_MAX(mesh->ne,1) : 1;
+      (*vwgt)[igrp] = PMMG_scaleVwgt(grppred[igrp],mean,scale,
+                                     (double)PMMG_VWGT_MAX*ne);
     }
+    PMMG_DEL_MEM(parmesh,grppred,double,"predicted elements");
+  }
+  else {
+    for ( igrp=0; igrp<ngrp; ++igrp ) {
+      mesh = parmesh->listgrp[igrp].mesh;
 
-    for ( k=1; k<=mesh->ne; ++k ) {
-      pt = &mesh->tetra[k];
-      if ( !MG_EOK(pt) ) continue;
+      if ( !mesh ) {
+        (*vwgt)[igrp] = 1;
+        continue;
+      }
+
+      for ( k=1; k<=mesh->ne; ++k ) {
+        pt = &mesh->tetra[k];
+        if ( !MG_EOK(pt) ) continue;
 
-      (*vwgt)[igrp] += pt->mark;
+        (*vwgt)[igrp] += pt->mark;
+      }
     }
   }
 
   /* Fill tpwgts */
-  PMMG_CALLOC(parmesh,*tpwgts,(*ncon)*nproc,real_t,"parmetis tpwgts", goto fail_2);
+  PMMG_SCRATCH_CALLOC(parmesh,*tpwgts,(*ncon)*nproc,real_t,"parmetis tpwgts", goto fail_2);
   for ( k=0; k < (*ncon)*nproc ; ++k )
     (*tpwgts)[k] = 1./(double)nproc;
 
   /* Fill ubvec */
-  PMMG_CALLOC(parmesh,*ubvec,(*ncon),real_t,"parmetis ubvec", goto fail_3);
+  PMMG_SCRATCH_CALLOC(parmesh,*ubvec,(*ncon),real_t,"parmetis ubvec", goto fail_3);
   for ( k=0; k < (*ncon); ++k )
     (*ubvec)[k] = PMMG_UBVEC_DEF;
 
   /** Step 3: Fill the internal communicator with the greater index of the 2
    * groups to which the face belong. Use a minus sign to mark old parallel
    * faces.*/
-  PMMG_CALLOC(parmesh,*xadj,ngrp+1,idx_t,"parmetis xadj", goto fail_4);
+  PMMG_SCRATCH_CALLOC(parmesh,*xadj,ngrp+1,idx_t,"parmetis xadj", goto fail_4);
 
   int_face_comm = parmesh->int_face_comm;
 
@@ -898,43 +1066,19 @@ int PMMG_graph_parmeshGrps2parmetis( PMMG_pParMesh parmesh,idx_t **vtxdist,
 
   /** Step 4: Send and receive external communicators filled by the (group id +
    * ishift) of the neighbours (through the faces) */
+  if ( !PMMG_halo_exchange(parmesh,PMMG_HALO_FACE_INT,intvalues,PMMG_HALO_KEEP) )
+    goto fail_6;
+  if ( !PMMG_halo_exchange(parmesh,PMMG_HALO_FACE_DBL,doublevalues,PMMG_HALO_KEEP) )
+    goto fail_6;
+
+  /* Mark the faces of the external communicators as boundary in the
+   * intvalues array */
   for ( k=0; k<parmesh->next_face_comm; ++k ) {
     ext_face_comm = &parmesh->ext_face_comm[k];
-    nitem         = ext_face_comm->nitem;
-    color         = ext_face_comm->color_out;
-
-    PMMG_CALLOC(parmesh,ext_face_comm->itosend,nitem,int,"itosend array",
-                goto fail_6);
-    itosend = ext_face_comm->itosend;
-
-    PMMG_CALLOC(parmesh,ext_face_comm->itorecv,nitem,int,"itorecv array",
-                goto fail_6);
-    itorecv       = ext_face_comm->itorecv;
-
-    PMMG_CALLOC(parmesh,ext_face_comm->rtosend,nitem,double,"rtosend array",
-                goto fail_6);
-    rtosend = ext_face_comm->rtosend;
-
-    PMMG_CALLOC(parmesh,ext_face_comm->rtorecv,nitem,double,"rtorecv array",
-                goto fail_6);
-    rtorecv       = ext_face_comm->rtorecv;
-
-    for ( i=0; i<nitem; ++i ) {
+    for ( i=0; i<ext_face_comm->nitem; ++i ) {
       idx            = ext_face_comm->int_comm_index[i];
-      rtosend[i]     = doublevalues[idx] ;
-      itosend[i]     = intvalues[idx] ;
-      /* Mark the face as boundary in the intvalues array */
       intvalues[idx] = PMMG_UNSET;
     }
-
-    MPI_CHECK(
-      MPI_Sendrecv(itosend,nitem,MPI_INT,color,MPI_PARMESHGRPS2PARMETIS_TAG,
-                   itorecv,nitem,MPI_INT,color,MPI_PARMESHGRPS2PARMETIS_TAG,
-                   comm,&status),goto fail_6 );
-    MPI_CHECK(
-      MPI_Sendrecv(rtosend,nitem,MPI_DOUBLE,color,MPI_PARMESHGRPS2PARMETIS_TAG,
-                   rtorecv,nitem,MPI_DOUBLE,color,MPI_PARMESHGRPS2PARMETIS_TAG,
-                   comm,&status),goto fail_6 );
   }
 
    /** Step 5: Process the external communicators to count for each group the
@@ -947,10 +1091,11 @@ int PMMG_graph_parmeshGrps2parmetis( PMMG_pParMesh parmesh,idx_t **vtxdist,
 
   for (  k=0; k<parmesh->next_face_comm; ++k ) {
     ext_face_comm = &parmesh->ext_face_comm[k];
-    itosend       = ext_face_comm->itosend;
-    itorecv       = ext_face_comm->itorecv;
-    rtosend       = ext_face_comm->rtosend;
-    rtorecv       = ext_face_comm->rtorecv;
+    idx           = parmesh->halo[PMMG_HALO_FACE_INT].displs[k];
+    itosend       = (int*)parmesh->halo[PMMG_HALO_FACE_INT].sbuf + idx;
+    itorecv       = (int*)parmesh->halo[PMMG_HALO_FACE_INT].rbuf + idx;
+    rtosend       = (double*)parmesh->halo[PMMG_HALO_FACE_DBL].sbuf + idx;
+    rtorecv       = (double*)parmesh->halo[PMMG_HALO_FACE_DBL].rbuf + idx;
     nitem         = ext_face_comm->nitem;
 
     /* i2send array contains the group id of the boundary faces and i2recv the
@@ -1064,10 +1209,10 @@ int PMMG_graph_parmeshGrps2parmetis( PMMG_pParMesh parmesh,idx_t **vtxdist,
     (*xadj)[igrp] += (*xadj)[igrp-1];
 
   /** Step 8: Fill adjncy array at metis format */
-  PMMG_CALLOC(parmesh,*adjncy,(*xadj)[ngrp],idx_t,"adjcncy parmetis array",
-              goto fail_7);
-  PMMG_CALLOC(parmesh,*adjwgt,(*xadj)[ngrp],idx_t,"parmetis adjwgt",
-              goto fail_7);
+  PMMG_SCRATCH_CALLOC(parmesh,*adjncy,(*xadj)[ngrp],idx_t,"adjcncy parmetis array",
+                      goto fail_7);
+  PMMG_SCRATCH_CALLOC(parmesh,*adjwgt,(*xadj)[ngrp],idx_t,"parmetis adjwgt",
+                      goto fail_7);
 
   (*nadjncy) = 0;
   for ( igrp=0; igrp<=ngrp; ++igrp ) {
@@ -1122,19 +1267,6 @@ int PMMG_graph_parmeshGrps2parmetis( PMMG_pParMesh parmesh,idx_t **vtxdist,
       break;
   }
 
-  for ( k=0; k<parmesh->next_face_comm; ++k ) {
-    ext_face_comm = &parmesh->ext_face_comm[k];
-    nitem = ext_face_comm->nitem;
-
-    if ( ext_face_comm->itorecv )
-      PMMG_DEL_MEM(parmesh,ext_face_comm->itorecv,int,"itorecv array");
-    if ( ext_face_comm->itosend )
-      PMMG_DEL_MEM(parmesh,ext_face_comm->itosend,int,"itosend array");
-    if ( ext_face_comm->rtorecv )
-      PMMG_DEL_MEM(parmesh,ext_face_comm->rtorecv,double,"rtorecv array");
-    if ( ext_face_comm->rtosend )
-      PMMG_DEL_MEM(parmesh,ext_face_comm->rtosend,double,"rtosend array");
-  }
   PMMG_DEL_MEM(parmesh,hash.item,PMMG_hgrp,"group hash table");
   PMMG_DEL_MEM(parmesh,int_face_comm->intvalues,int,"face communicator");
 
@@ -1144,26 +1276,6 @@ fail_7:
   if ( hash.item )
     PMMG_DEL_MEM(parmesh,hash.item,PMMG_hgrp,"group hash table");
 fail_6:
-  for ( k=0; k<parmesh->next_face_comm; ++k ) {
-    ext_face_comm = &parmesh->ext_face_comm[k];
-    if ( ext_face_comm->itorecv )
-      PMMG_DEL_MEM(parmesh,ext_face_comm->itorecv,int,"itorecv array");
-  }
-  for ( k=0; k<parmesh->next_face_comm; ++k ) {
-    ext_face_comm = &parmesh->ext_face_comm[k];
-    if ( ext_face_comm->itosend )
-      PMMG_DEL_MEM(parmesh,ext_face_comm->itosend,int,"itosend array");
-  }
-  for ( k=0; k<parmesh->next_face_comm; ++k ) {
-    ext_face_comm = &parmesh->ext_face_comm[k];
-    if ( ext_face_comm->rtorecv )
-      PMMG_DEL_MEM(parmesh,ext_face_comm->rtorecv,double,"rtorecv array");
-  }
-  for ( k=0; k<parmesh->next_face_comm; ++k ) {
-    ext_face_comm = &parmesh->ext_face_comm[k];
-    if ( ext_face_comm->rtosend )
-      PMMG_DEL_MEM(parmesh,ext_face_comm->rtosend,double,"rtosend array");
-  }
   if ( int_face_comm->intvalues )
     PMMG_DEL_MEM(parmesh,int_face_comm->intvalues,int,"face communicator");
   if ( int_face_comm->doublevalues )
@@ -1220,7 +1332,8 @@ int PMMG_part_meshElts2metis( PMMG_pParMesh parmesh, idx_t* part, idx_t nproc )
   memAv = parmesh->memGloMax-parmesh->memMax-parmesh->listgrp[0].mesh->memMax;
 
   /** Build the graph */
-  if ( !PMMG_graph_meshElts2metis(parmesh,mesh,met,&xadj,&adjncy,&adjwgt,&adjsize,&memAv) )
+  if ( !PMMG_graph_meshElts2metis(parmesh,mesh,met,&xadj,&adjncy,&vwgt,&adjwgt,
+                                  &adjsize,&memAv) )
     return 0;
 
   /* Give the memory to the parmesh */
@@ -1255,6 +1368,7 @@ int PMMG_part_meshElts2metis( PMMG_pParMesh parmesh, idx_t* part, idx_t nproc )
   /** Correct partitioning to avoid empty partitions */
   if( !PMMG_correct_meshElts2metis( parmesh,part,nelt,nproc ) ) return 0;
 
+  PMMG_DEL_MEM(parmesh, vwgt, idx_t, "deallocate vwgt" );
   PMMG_DEL_MEM(parmesh, adjwgt, idx_t, "deallocate adjwgt" );
   PMMG_DEL_MEM(parmesh, adjncy, idx_t, "deallocate adjncy" );
   PMMG_DEL_MEM(parmesh, xadj, idx_t, "deallocate xadj" );
@@ -1315,7 +1429,7 @@ int PMMG_part_parmeshGrps2metis( PMMG_pParMesh parmesh,idx_t* part,idx_t nproc )
 
   xadj_seq = NULL;
   if(parmesh->myrank == root)
-    PMMG_CALLOC(parmesh,xadj_seq,vtxdist[nproc]+1,idx_t,"xadj_seq", return 0);
+    PMMG_SCRATCH_CALLOC(parmesh,xadj_seq,vtxdist[nproc]+1,idx_t,"xadj_seq", return 0);
 
   MPI_CHECK( MPI_Gatherv(&xadj[1],recvcounts[parmesh->myrank],MPI_INT,
                          &xadj_seq[1],recvcounts,displs,MPI_INT,
@@ -1328,7 +1442,7 @@ int PMMG_part_parmeshGrps2metis( PMMG_pParMesh parmesh,idx_t* part,idx_t nproc )
 
   if(wgtflag == PMMG_WGTFLAG_VTX || wgtflag == PMMG_WGTFLAG_BOTH ) {
     if(parmesh->myrank == root)
-      PMMG_CALLOC(parmesh,vwgt_seq,vtxdist[nproc]+1,idx_t,"vwgt_seq", return 0);
+      PMMG_SCRATCH_CALLOC(parmesh,vwgt_seq,vtxdist[nproc]+1,idx_t,"vwgt_seq", return 0);
 
     MPI_CHECK( MPI_Gatherv(vwgt,recvcounts[parmesh->myrank],MPI_INT,
                            vwgt_seq,recvcounts,displs,MPI_INT,
@@ -1347,7 +1461,7 @@ int PMMG_part_parmeshGrps2metis( PMMG_pParMesh parmesh,idx_t* part,idx_t nproc )
 
   adjncy_seq = NULL;
   if ( parmesh->myrank == root )
-    PMMG_CALLOC(parmesh,adjncy_seq,xadj_seq[vtxdist[nproc]],idx_t,"xadj_seq", return 0);
+    PMMG_SCRATCH_CALLOC(parmesh,adjncy_seq,xadj_seq[vtxdist[nproc]],idx_t,"xadj_seq", return 0);
 
   MPI_CHECK( MPI_Gatherv(adjncy,recvcounts[parmesh->myrank],MPI_INT,
                          adjncy_seq,recvcounts,displs,MPI_INT,
@@ -1355,7 +1469,7 @@ int PMMG_part_parmeshGrps2metis( PMMG_pParMesh parmesh,idx_t* part,idx_t nproc )
 
   if(wgtflag == PMMG_WGTFLAG_ADJ || wgtflag == PMMG_WGTFLAG_BOTH ) {
     if(parmesh->myrank == root)
-      PMMG_CALLOC(parmesh,adjwgt_seq,xadj_seq[vtxdist[nproc]],idx_t,"xadj_seq", return 0);
+      PMMG_SCRATCH_CALLOC(parmesh,adjwgt_seq,xadj_seq[vtxdist[nproc]],idx_t,"xadj_seq", return 0);
 
     MPI_CHECK( MPI_Gatherv(adjwgt,recvcounts[parmesh->myrank],MPI_INT,
                            adjwgt_seq,recvcounts,displs,MPI_INT,
@@ -1483,6 +1597,35 @@ int PMMG_part_parmeshGrps2metis( PMMG_pParMesh parmesh,idx_t* part,idx_t nproc )
 }
 
 #ifdef USE_PARMETIS
+/**
+ * \param grp pointer toward the group.
+ *
+ * \return the migration cost of the group for parmetis.
+ *
+ * Estimate the memory size of the group (in kilobytes) from the size of its
+ * mesh entities and of its metric and fields.
+ *
+ */
+static inline
+idx_t PMMG_vsize_grp( PMMG_pGrp grp ) {
+  MMG5_pMesh mesh;
+  double     size;
+  int        nsize;
+
+  mesh = grp->mesh;
+  if ( !mesh ) return 1;
+
+  nsize  = grp->met ? grp->met->size : 0;
+  nsize += PMMG_fields_size(mesh,grp->sol);
+
+  size = (double)mesh->np * ( sizeof(MMG5_Point) + nsize*sizeof(double) )
+    + (double)mesh->xp * sizeof(MMG5_xPoint)
+    + (double)mesh->ne * sizeof(MMG5_Tetra)
+    + (double)mesh->xt * sizeof(MMG5_xTetra);
+
+  return (idx_t)MG_MAX(1.,size/1024.);
+}
+
 /**
  * \param parmesh pointer toward the parmesh structure
  * \param part pointer of an array containing the partitions (at the end)
@@ -1491,15 +1634,18 @@ int PMMG_part_parmeshGrps2metis( PMMG_pParMesh parmesh,idx_t* part,idx_t nproc )
  * \return  1 if success, 0 if fail
  *
  * Use parmetis to partition the first mesh in the list of meshes into nproc
- * groups
+ * groups. If the adaptive repartitioning is asked, the current distribution of
+ * the groups is the initial partition and parmetis balances the edge cut with
+ * the migration cost of the groups (their memory size), weighted by the \a
+ * repart_itr ratio.
  *
  */
 int PMMG_part_parmeshGrps2parmetis( PMMG_pParMesh parmesh,idx_t* part,idx_t nproc )
 {
-  real_t     *tpwgts,*ubvec;
-  idx_t      *xadj,*adjncy,*vwgt,*adjwgt,*vtxdist,adjsize,edgecut;
-  idx_t      wgtflag,numflag,ncon,options[3];
-  int        ngrp,nprocs,ier;
+  real_t     *tpwgts,*ubvec,itr;
+  idx_t      *xadj,*adjncy,*vwgt,*adjwgt,*vtxdist,*vsize,adjsize,edgecut;
+  idx_t      wgtflag,numflag,ncon,options[4];
+  int        ngrp,nprocs,ier,igrp;
 
   ngrp   = parmesh->ngrp;
   nprocs = parmesh->nprocs;
@@ -1519,9 +1665,38 @@ int PMMG_part_parmeshGrps2parmetis( PMMG_pParMesh parmesh,idx_t* part,idx_t npro
 
   /** Call parmetis and get the partition array */
   if ( 2 < nprocs + ngrp ) {
-    if ( ParMETIS_V3_PartKway( vtxdist,xadj,adjncy,vwgt,adjwgt,&wgtflag,&numflag,
-                               &ncon,&nproc,tpwgts,ubvec,options,&edgecut,part,
-                               &parmesh->comm) != METIS_OK ) {
+    if ( parmesh->info.repart_adaptive ) {
+      /* Migration cost of the groups */
+      vsize = NULL;
+      PMMG_MALLOC(parmesh,vsize,MG_MAX(ngrp,1),idx_t,"parmetis vsize",ier = 0);
+      MPI_CHECK( MPI_Allreduce(MPI_IN_PLACE,&ier,1,MPI_INT,MPI_MIN,parmesh->comm),
+                 ier = 0 );
+      if ( ier ) {
+        for ( igrp=0; igrp<ngrp; ++igrp ) {
+          vsize[igrp] = PMMG_vsize_grp(&parmesh->listgrp[igrp]);
+          part[igrp]  = parmesh->myrank;
+        }
+        itr = parmesh->info.repart_itr;
+
+        /* Coupled mode: the initial partition of a group is its proc */
+        options[0] = 1;
+        options[1] = 0;
+        options[2] = 0;
+        options[3] = PARMETIS_PSR_COUPLED;
+        if ( ParMETIS_V3_AdaptiveRepart( vtxdist,xadj,adjncy,vwgt,vsize,adjwgt,
+                                         &wgtflag,&numflag,&ncon,&nproc,tpwgts,
+                                         ubvec,&itr,options,&edgecut,part,
+                                         &parmesh->comm) != METIS_OK ) {
+          fprintf(stderr,"\n  ## Error: Parmetis adaptive repartitioning"
+                  " fails.\n" );
+          ier = 0;
+        }
+        PMMG_DEL_MEM(parmesh,vsize,idx_t,"parmetis vsize");
+      }
+    }
+    else if ( ParMETIS_V3_PartKway( vtxdist,xadj,adjncy,vwgt,adjwgt,&wgtflag,
+                                    &numflag,&ncon,&nproc,tpwgts,ubvec,options,
+                                    &edgecut,part,&parmesh->comm) != METIS_OK ) {
         fprintf(stderr,"\n  ## Error: Parmetis fails.\n" );
         ier = 0;
     }
@@ -63,6 +63,31 @@
  */
 #define PMMG_WGTVAL_HUGEINT   1000000
 
+/**
+ * \def PMMG_VWGT_SCALE
+ *
+ * Metis node weight of an element of mean predicted remeshing cost (lowered
+ * on huge meshes so that the weights sum fits in idx_t)
+ *
+ */
+#define PMMG_VWGT_SCALE   10
+
+/**
+ * \def PMMG_VWGT_MAX
+ *
+ * Maximal metis node weight of one element
+ *
+ */
+#define PMMG_VWGT_MAX     1000
+
+/**
+ * \def PMMG_VOLUNIT
+ *
+ * Volume of the regular tetrahedron of unit edges
+ *
+ */
+#define PMMG_VOLUNIT      0.11785113019775793
+
 /**
  * \def PMMG_UBVEC_DEF
  *
@@ -113,7 +138,7 @@ typedef struct {
 
 int PMMG_checkAndReset_grps_contiguity( PMMG_pParMesh parmesh );
 int PMMG_check_grps_contiguity( PMMG_pParMesh parmesh );
-int PMMG_graph_meshElts2metis(PMMG_pParMesh,MMG5_pMesh,MMG5_pSol,idx_t**,idx_t**,idx_t**,idx_t*,size_t*);
+int PMMG_graph_meshElts2metis(PMMG_pParMesh,MMG5_pMesh,MMG5_pSol,idx_t**,idx_t**,idx_t**,idx_t**,idx_t*,size_t*);
 int PMMG_part_meshElts2metis( PMMG_pParMesh,idx_t*,idx_t);
 int PMMG_graph_parmeshGrps2parmetis(PMMG_pParMesh,idx_t**,idx_t**,idx_t**,idx_t*,
                                     idx_t**,idx_t**,idx_t*,idx_t*,idx_t*,idx_t,
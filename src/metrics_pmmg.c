@@ -0,0 +1,226 @@
+/* =============================================================================
+**  This file is part of the parmmg software package for parallel tetrahedral
+**  mesh modification.
+**  Copyright (c) Bx INP/Inria/UBordeaux, 2017-
+**
+**  parmmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  parmmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with parmmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the parmmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/**
+ * \file metrics_pmmg.c
+ * \brief Functions to compute the logarithm and the exponential of metrics.
+ * \author Cécile Dobrzynski (Bx INP/Inria)
+ * \author Algiane Froehly (Inria)
+ * \author Luca Cirrottola (Inria)
+ * \version 1
+ * \copyright GNU Lesser General Public License.
+ */
+#include "parmmg.h"
+
+/**
+ * \param a batch of symmetric matrices, overwritten (the eigenvalues are
+ * stored on the diagonal at the end).
+ * \param v batch of eigenvectors (filled, stored by columns).
+ *
+ * Diagonalize \ref PMMG_LOGMET_BATCH symmetric 3x3 matrices at once by the
+ * cyclic Jacobi method. The matrices are stored component by component: the
+ * (i,j) component of the matrix b is a[PMMG_LOGMET_BATCH*(3*i+j)+b]. A fixed
+ * number of sweeps is performed and the rotations are computed without
+ * branches so the loops on the batch can be vectorized.
+ *
+ */
+static
+void PMMG_eigenSym3_batch( double *a,double *v ) {
+  double   *ap,*aq,*vp,*vq,app,aqq,apq,d,t,c,s,akp,akq;
+  int      sweep,p,q,k,b;
+  const int ip[3] = {0,0,1};
+  const int iq[3] = {1,2,2};
+
+  for ( k=0; k<9; ++k ) {
+    for ( b=0; b<PMMG_LOGMET_BATCH; ++b ) {
+      v[PMMG_LOGMET_BATCH*k+b] = ( k%4 ) ? 0. : 1.;
+    }
+  }
+
+  for ( sweep=0; sweep<PMMG_LOGMET_NSWEEP; ++sweep ) {
+    for ( k=0; k<3; ++k ) {
+      p = ip[k];
+      q = iq[k];
+
+      for ( b=0; b<PMMG_LOGMET_BATCH; ++b ) {
+        app = a[PMMG_LOGMET_BATCH*(3*p+p)+b];
+        aqq = a[PMMG_LOGMET_BATCH*(3*q+q)+b];
+        apq = a[PMMG_LOGMET_BATCH*(3*p+q)+b];
+
+        /* Rotation that cancels apq: t = tan(theta) */
+        d = aqq-app;
+        t = fabs(d) + sqrt(d*d+4.*apq*apq);
+        t = ( t > 0. ) ? 2.*apq/t : 0.;
+        t = ( d < 0. ) ? -t : t;
+        c = 1./sqrt(1.+t*t);
+        s = t*c;
+
+        /* a <- a.J */
+        ap = &a[PMMG_LOGMET_BATCH*p+b];
+        aq = &a[PMMG_LOGMET_BATCH*q+b];
+        akp = ap[0];                    akq = aq[0];
+        ap[0] = c*akp - s*akq;          aq[0] = s*akp + c*akq;
+        akp = ap[3*PMMG_LOGMET_BATCH];  akq = aq[3*PMMG_LOGMET_BATCH];
+        ap[3*PMMG_LOGMET_BATCH] = c*akp - s*akq;
+        aq[3*PMMG_LOGMET_BATCH] = s*akp + c*akq;
+        akp = ap[6*PMMG_LOGMET_BATCH];  akq = aq[6*PMMG_LOGMET_BATCH];
+        ap[6*PMMG_LOGMET_BATCH] = c*akp - s*akq;
+        aq[6*PMMG_LOGMET_BATCH] = s*akp + c*akq;
+
+        /* a <- tJ.a */
+        ap = &a[PMMG_LOGMET_BATCH*3*p+b];
+        aq = &a[PMMG_LOGMET_BATCH*3*q+b];
+        akp = ap[0];                    akq = aq[0];
+        ap[0] = c*akp - s*akq;          aq[0] = s*akp + c*akq;
+        akp = ap[PMMG_LOGMET_BATCH];    akq = aq[PMMG_LOGMET_BATCH];
+        ap[PMMG_LOGMET_BATCH] = c*akp - s*akq;
+        aq[PMMG_LOGMET_BATCH] = s*akp + c*akq;
+        akp = ap[2*PMMG_LOGMET_BATCH];  akq = aq[2*PMMG_LOGMET_BATCH];
+        ap[2*PMMG_LOGMET_BATCH] = c*akp - s*akq;
+        aq[2*PMMG_LOGMET_BATCH] = s*akp + c*akq;
+
+        /* v <- v.J */
+        vp = &v[PMMG_LOGMET_BATCH*p+b];
+        vq = &v[PMMG_LOGMET_BATCH*q+b];
+        akp = vp[0];                    akq = vq[0];
+        vp[0] = c*akp - s*akq;          vq[0] = s*akp + c*akq;
+        akp = vp[3*PMMG_LOGMET_BATCH];  akq = vq[3*PMMG_LOGMET_BATCH];
+        vp[3*PMMG_LOGMET_BATCH] = c*akp - s*akq;
+        vq[3*PMMG_LOGMET_BATCH] = s*akp + c*akq;
+        akp = vp[6*PMMG_LOGMET_BATCH];  akq = vq[6*PMMG_LOGMET_BATCH];
+        vp[6*PMMG_LOGMET_BATCH] = c*akp - s*akq;
+        vq[6*PMMG_LOGMET_BATCH] = s*akp + c*akq;
+      }
+    }
+  }
+}
+
+/**
+ * \param nsize size of the metrics (1 if isotropic, 6 if anisotropic).
+ * \param in batch of metrics (or of logarithms of metrics).
+ * \param out batch of computed metrics (filled).
+ * \param nb number of metrics in the batch (at most \ref PMMG_LOGMET_BATCH).
+ * \param takeLog 1 to compute the logarithms of the metrics, 0 to compute the
+ * exponentials.
+ *
+ * Apply the logarithm or the exponential to a batch of metrics. Anisotropic
+ * metrics are diagonalized, the function is applied to their eigenvalues and
+ * the matrices are rebuilt.
+ *
+ */
+static
+void PMMG_funcMetrics_batch( int nsize,const double *in,double *out,int nb,
+                             int takeLog ) {
+  double   a[9*PMMG_LOGMET_BATCH],v[9*PMMG_LOGMET_BATCH];
+  double   lambda[3];
+  int      i,j,k,l,b;
+  const int ii[6] = {0,0,0,1,1,2};
+  const int jj[6] = {0,1,2,1,2,2};
+
+  assert ( nb <= PMMG_LOGMET_BATCH );
+
+  if ( nsize == 1 ) {
+    for ( b=0; b<nb; ++b ) {
+      out[b] = takeLog ? log(MG_MAX(in[b],MMG5_EPSD)) : exp(in[b]);
+    }
+    return;
+  }
+
+  assert ( nsize == 6 );
+
+  /** Load the symmetric matrices (unused slots receive the identity) */
+  for ( b=0; b<PMMG_LOGMET_BATCH; ++b ) {
+    for ( k=0; k<6; ++k ) {
+      i = ii[k];
+      j = jj[k];
+      a[PMMG_LOGMET_BATCH*(3*i+j)+b] = ( b < nb ) ? in[6*b+k] : (double)(i==j);
+      a[PMMG_LOGMET_BATCH*(3*j+i)+b] = a[PMMG_LOGMET_BATCH*(3*i+j)+b];
+    }
+  }
+
+  PMMG_eigenSym3_batch( a,v );
+
+  /** Rebuild the matrices with the transformed eigenvalues */
+  for ( b=0; b<nb; ++b ) {
+    for ( l=0; l<3; ++l ) {
+      lambda[l] = a[PMMG_LOGMET_BATCH*4*l+b];
+      lambda[l] = takeLog ? log(MG_MAX(lambda[l],MMG5_EPSD)) : exp(lambda[l]);
+    }
+    for ( k=0; k<6; ++k ) {
+      i = ii[k];
+      j = jj[k];
+      out[6*b+k] = 0.;
+      for ( l=0; l<3; ++l ) {
+        out[6*b+k] += lambda[l] * v[PMMG_LOGMET_BATCH*(3*i+l)+b]
+          * v[PMMG_LOGMET_BATCH*(3*j+l)+b];
+      }
+    }
+  }
+}
+
+/**
+ * \param nsize size of the metrics (1 if isotropic, 6 if anisotropic).
+ * \param m batch of metrics.
+ * \param logm batch of logarithms of the metrics (filled).
+ * \param nb number of metrics in the batch (at most \ref PMMG_LOGMET_BATCH).
+ *
+ * Compute the logarithms of a batch of metrics. Non positive eigenvalues are
+ * truncated to \ref MMG5_EPSD.
+ *
+ */
+void PMMG_logMetrics_batch( int nsize,const double *m,double *logm,int nb ) {
+  PMMG_funcMetrics_batch( nsize,m,logm,nb,1 );
+}
+
+/**
+ * \param nsize size of the metrics (1 if isotropic, 6 if anisotropic).
+ * \param logm batch of logarithms of metrics.
+ * \param m batch of metrics (filled).
+ * \param nb number of metrics in the batch (at most \ref PMMG_LOGMET_BATCH).
+ *
+ * Compute the exponentials of a batch of logarithms of metrics.
+ *
+ */
+void PMMG_expMetrics_batch( int nsize,const double *logm,double *m,int nb ) {
+  PMMG_funcMetrics_batch( nsize,logm,m,nb,0 );
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metrics structure.
+ * \param logm logarithms of the metrics at the mesh vertices (filled).
+ *
+ * Compute the logarithms of the metrics at all the vertices of a mesh, by
+ * batches of \ref PMMG_LOGMET_BATCH vertices.
+ *
+ */
+void PMMG_logMetrics_mesh( MMG5_pMesh mesh,MMG5_pSol met,double *logm ) {
+  int nsize,ip,nb;
+
+  nsize = met->size;
+
+  for ( ip=1; ip<=mesh->np; ip+=PMMG_LOGMET_BATCH ) {
+    nb = MG_MIN( PMMG_LOGMET_BATCH,mesh->np+1-ip );
+    PMMG_logMetrics_batch( nsize,&met->m[nsize*ip],&logm[nsize*ip],nb );
+  }
+}
@@ -572,16 +572,13 @@ int PMMG_check_reachability( PMMG_pParMesh parmesh,int *counter ) {
   MMG5_pTetra  pt;
   PMMG_pInt_comm int_face_comm;
   PMMG_pExt_comm ext_face_comm;
-  MPI_Comm       comm;
-  MPI_Status     status;
   int          *face2int_face_comm_index1,*face2int_face_comm_index2;
-  int          *intvalues,*itosend,*itorecv,rank_out;
+  int          *intvalues,rank_out;
   int          *list;
   int          next_head,next_len,next_base,next_otetra;
-  int          nitem,color;
+  int          color;
   int          ie,i,idx,k;
 
-  comm   = parmesh->comm;
   assert( parmesh->ngrp == 1 );
   grp  = &parmesh->listgrp[0];
   mesh = grp->mesh;
@@ -608,36 +605,8 @@ int PMMG_check_reachability( PMMG_pParMesh parmesh,int *counter ) {
   }
 
   /* Exchange values on the interfaces among procs */
-  for ( k = 0; k < parmesh->next_face_comm; ++k ) {
-    ext_face_comm = &parmesh->ext_face_comm[k];
-    nitem         = ext_face_comm->nitem;
-    color         = ext_face_comm->color_out;
-
-    PMMG_CALLOC(parmesh,ext_face_comm->itosend,nitem,int,"itosend array",
-                return 0);
-    itosend = ext_face_comm->itosend;
-
-    PMMG_CALLOC(parmesh,ext_face_comm->itorecv,nitem,int,"itorecv array",
-                return 0);
-    itorecv       = ext_face_comm->itorecv;
-
-    for ( i=0; i<nitem; ++i ) {
-      idx            = ext_face_comm->int_comm_index[i];
-      itosend[i]     = intvalues[idx] ;
-    }
-
-//#warning Luca: change this tag
-    MPI_CHECK(
-      MPI_Sendrecv(itosend,nitem,MPI_INT,color,MPI_PARMESHGRPS2PARMETIS_TAG+1,
-                   itorecv,nitem,MPI_INT,color,MPI_PARMESHGRPS2PARMETIS_TAG+1,
-                   comm,&status),return 0 );
-
-    for ( i=0; i<nitem; ++i ) {
-      idx            = ext_face_comm->int_comm_index[i];
-      intvalues[idx] = itorecv[i];
-    }
-
-  }
+  if ( !PMMG_halo_exchange(parmesh,PMMG_HALO_FACE_INT,intvalues,PMMG_HALO_COPY) )
+    return 0;
 
   PMMG_MALLOC(parmesh,list,mesh->ne,int,"tetra list",return 0);
 
@@ -726,11 +695,6 @@ int PMMG_check_reachability( PMMG_pParMesh parmesh,int *counter ) {
 
 
   PMMG_DEL_MEM( parmesh,int_face_comm->intvalues,int,"intvalues" );
-  for ( k = 0; k < parmesh->next_face_comm; ++k ) {
-    ext_face_comm = &parmesh->ext_face_comm[k];
-    PMMG_DEL_MEM(parmesh,ext_face_comm->itosend,int,"itosend array");
-    PMMG_DEL_MEM(parmesh,ext_face_comm->itorecv,int,"itorecv array");
-  }
 
   PMMG_DEL_MEM(parmesh,list,int,"tetra list");
 
@@ -1248,19 +1212,15 @@ int PMMG_part_moveInterfaces( PMMG_pParMesh parmesh,int *displsgrp,int *mapgrp,i
   MMG5_pxTetra pxt;
   MMG5_pPoint  ppt;
   PMMG_pInt_comm int_node_comm;
-  PMMG_pExt_comm ext_node_comm;
-  MPI_Comm       comm;
-  MPI_Status     status;
   int          *node2int_node_comm_index1,*node2int_node_comm_index2;
-  int          *intvalues,*itosend,*itorecv;
+  int          *intvalues;
   int          *negrp,*nemin;
   int          ilayer;
   int          nprocs,ngrp;
-  int          igrp,k,i,idx,ip,ie,ifac,je,ne,nitem,color,color_out;
+  int          igrp,k,i,idx,ip,ie,ifac,je,ne;
   int          list[MMG3D_LMAX+2];
   int          ier=1,ier_glob;
 
-  comm   = parmesh->comm;
   assert( parmesh->ngrp == 1 );
   grp  = &parmesh->listgrp[0];
   mesh = grp->mesh;
@@ -1292,17 +1252,6 @@ int PMMG_part_moveInterfaces( PMMG_pParMesh parmesh,int *displsgrp,int *mapgrp,i
     intvalues[idx] = PMMG_UNSET;
   }
 
-  /* Allocate external buffers */
-  for ( k = 0; k < parmesh->next_node_comm; ++k ) {
-    ext_node_comm = &parmesh->ext_node_comm[k];
-    nitem         = ext_node_comm->nitem;
-
-    PMMG_CALLOC(parmesh,ext_node_comm->itosend,nitem,int,"itosend array",
-                return 0);
-    PMMG_CALLOC(parmesh,ext_node_comm->itorecv,nitem,int,"itorecv array",
-                return 0);
-  }
- 
   /* Move interfaces */
   for( ilayer = 0; ilayer < parmesh->info.ifc_layers; ilayer++ ) {
 
@@ -1316,30 +1265,8 @@ int PMMG_part_moveInterfaces( PMMG_pParMesh parmesh,int *displsgrp,int *mapgrp,i
     }
 
     /* Exchange values on the interfaces among procs */
-    for ( k = 0; k < parmesh->next_node_comm; ++k ) {
-      ext_node_comm = &parmesh->ext_node_comm[k];
-      nitem         = ext_node_comm->nitem;
-      color         = ext_node_comm->color_out;
-
-      itosend = ext_node_comm->itosend;
-      itorecv = ext_node_comm->itorecv;
-
-      for ( i=0; i<nitem; ++i ) {
-        idx            = ext_node_comm->int_comm_index[i];
-        itosend[i]     = intvalues[idx] ;
-      }
-
-//#warning Luca: change this tag
-      MPI_CHECK(
-        MPI_Sendrecv(itosend,nitem,MPI_INT,color,MPI_PARMESHGRPS2PARMETIS_TAG+3,
-                     itorecv,nitem,MPI_INT,color,MPI_PARMESHGRPS2PARMETIS_TAG+3,
-                     comm,&status),return 0 );
-
-      for ( i=0; i<nitem; ++i ) {
-        idx            = ext_node_comm->int_comm_index[i];
-        intvalues[idx] = itorecv[i];
-      }
-    }
+    if ( !PMMG_halo_exchange(parmesh,PMMG_HALO_NODE_INT,intvalues,PMMG_HALO_COPY) )
+      return 0;
 
     /* Update grp index and proc after communication */
     for( i = 0; i < grp->nitem_int_node_comm; i++ ) {
@@ -1395,11 +1322,6 @@ int PMMG_part_moveInterfaces( PMMG_pParMesh parmesh,int *displsgrp,int *mapgrp,i
   PMMG_DEL_MEM( parmesh,negrp,int,"negrp" );
   PMMG_DEL_MEM( parmesh,nemin,int,"nemin" );
   PMMG_DEL_MEM( parmesh,int_node_comm->intvalues,int,"intvalues" );
-  for ( k = 0; k < parmesh->next_node_comm; ++k ) {
-    ext_node_comm = &parmesh->ext_node_comm[k];
-    PMMG_DEL_MEM(parmesh,ext_node_comm->itosend,int,"itosend array");
-    PMMG_DEL_MEM(parmesh,ext_node_comm->itorecv,int,"itorecv array");
-  }
 
   PMMG_DEL_MEM(parmesh,mapgrp,int,"mapgrp");
   PMMG_DEL_MEM(parmesh,displsgrp,int,"displsgrp");
@@ -44,6 +44,9 @@
 #define MPI_SENDEXTFACECOMM_TAG         7000
 #define MPI_TRANSFER_GRP_TAG            8000
 #define MPI_COMMUNICATORS_REF_TAG       9000
+#define MPI_COMMUNICATORS_GLONUM_TAG    10000
+#define MPI_COMMUNICATORS_FACE_TAG      11000
+#define MPI_HALO_TAG                    12000
 
 #define MPI_CHECK(func_call,on_failure) do {                            \
     int mpi_ret_val;                                                    \
@@ -0,0 +1,757 @@
+/* =============================================================================
+**  This file is part of the parmmg software package for parallel tetrahedral
+**  mesh modification.
+**  Copyright (c) Bx INP/Inria/UBordeaux, 2017-
+**
+**  parmmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  parmmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with parmmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the parmmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/**
+ * \file mpicount_pmmg.c
+ * \brief MPI communication counters per phase and per peer (PMPI layer).
+ * \author Cécile Dobrzynski (Bx INP/Inria)
+ * \author Algiane Froehly (Inria)
+ * \author Luca Cirrottola (Inria)
+ * \version 1
+ * \copyright GNU Lesser General Public License.
+ *
+ * Only compiled with USE_MPI_COUNTERS. The MPI functions used by ParMmg are
+ * intercepted through the PMPI profiling interface: for each phase of the
+ * pipeline (set by the phase timers), we count the point-to-point messages
+ * and bytes sent and received, the collective calls and the bytes given to
+ * them, the MPI-IO calls and the bytes written or read, and the time spent in
+ * MPI. The messages and bytes sent are also counted per peer (rank in the
+ * communicator of the call, Alltoall(v) included). The counters are reduced
+ * over the processes and saved with the phases timers (see
+ * \ref PMMG_timers_report).
+ *
+ * As the layer redefines the MPI symbols, the MPI calls of the application
+ * linked with ParMmg are counted too (in the current phase), and it can't be
+ * combined with another PMPI tool. MPI must be called from one thread only.
+ * The persistent requests are identified by the address where they are stored
+ * (the request arrays of the halos, see halo_pmmg.c): a persistent request
+ * copied elsewhere before being started is not counted.
+ *
+ */
+#include "parmmg.h"
+
+#ifdef USE_MPI_COUNTERS
+
+#define PMMG_MPICOUNT_NSEND  0 /*!< nb of messages sent */
+#define PMMG_MPICOUNT_BSEND  1 /*!< bytes sent */
+#define PMMG_MPICOUNT_NRECV  2 /*!< nb of messages received */
+#define PMMG_MPICOUNT_BRECV  3 /*!< bytes received */
+#define PMMG_MPICOUNT_NCOLL  4 /*!< nb of collective calls */
+#define PMMG_MPICOUNT_BCOLL  5 /*!< bytes given to the collectives */
+#define PMMG_MPICOUNT_NIO    6 /*!< nb of MPI-IO calls */
+#define PMMG_MPICOUNT_BIO    7 /*!< bytes written or read with MPI-IO */
+#define PMMG_MPICOUNT_TIME   8 /*!< time in MPI */
+#define PMMG_MPICOUNT_NVAL   9
+
+static const char *PMMG_mpicountName[PMMG_MPICOUNT_NVAL] = {
+  "msgSent","bytesSent","msgRecv","bytesRecv","collectives","bytesColl",
+  "ioCalls","bytesIO","time" };
+
+/**
+ * \struct PMMG_MpiPersistent
+ * \brief persistent request created by MPI_Send_init or MPI_Recv_init.
+ */
+typedef struct {
+  MPI_Request *slot;   /*!< address of the request (sort key) */
+  MPI_Request request; /*!< request */
+  double      bytes;   /*!< bytes of the message */
+  int         peer;    /*!< remote rank */
+  int         send;    /*!< 1 for a send, 0 for a receive */
+} PMMG_MpiPersistent;
+
+/* The counters are not charged on the parmesh memory */
+static double             PMMG_mpicount[PMMG_NPHASE][PMMG_MPICOUNT_NVAL];
+static double             *PMMG_mpipeer   = NULL; /* [peer][phase][msgs,bytes] */
+static int                PMMG_npeer      = 0;
+static PMMG_MpiPersistent *PMMG_mpipers   = NULL;
+static int                PMMG_npers      = 0;
+static int                PMMG_npersMax   = 0;
+static int                PMMG_mpiphase   = PMMG_PHASE_INIT;
+static int                PMMG_mpicountOff= 0;
+
+/**
+ * \param phase index of the phase.
+ *
+ * Set the phase on which the next MPI calls are charged.
+ *
+ */
+void PMMG_mpicount_setPhase( int phase ) {
+  assert ( phase >= 0 && phase < PMMG_NPHASE );
+  PMMG_mpiphase = phase;
+}
+
+/**
+ * \param count nb of items.
+ * \param datatype type of the items.
+ *
+ * \return the size in bytes of the items.
+ *
+ */
+static inline
+double PMMG_mpicount_bytes( int count,MPI_Datatype datatype ) {
+  int size;
+
+  if ( datatype == MPI_DATATYPE_NULL || PMPI_Type_size(datatype,&size) != MPI_SUCCESS )
+    return 0.;
+  return (double)count*size;
+}
+
+/**
+ * \param peer rank of the receiver in the communicator of the call.
+ * \param bytes size of the message.
+ *
+ * Count a message sent to \a peer.
+ *
+ */
+static
+void PMMG_mpicount_peer( int peer,double bytes ) {
+  double *ptr;
+  int    nprocs;
+
+  if ( !PMMG_mpipeer ) {
+    PMPI_Comm_size(MPI_COMM_WORLD,&nprocs);
+    PMMG_mpipeer = (double*)calloc((size_t)nprocs*PMMG_NPHASE*2,sizeof(double));
+    if ( !PMMG_mpipeer ) return;
+    PMMG_npeer = nprocs;
+  }
+  if ( peer < 0 || peer >= PMMG_npeer ) return;
+
+  ptr     = &PMMG_mpipeer[((size_t)peer*PMMG_NPHASE+PMMG_mpiphase)*2];
+  ptr[0] += 1.;
+  ptr[1] += bytes;
+}
+
+/**
+ * \param peer rank of the remote proc.
+ * \param bytes size of the message.
+ * \param send 1 for a sent message, 0 for a received one.
+ *
+ * Count a point-to-point message.
+ *
+ */
+static inline
+void PMMG_mpicount_p2p( int peer,double bytes,int send ) {
+  double *cnt;
+
+  if ( PMMG_mpicountOff ) return;
+
+  cnt = PMMG_mpicount[PMMG_mpiphase];
+  if ( send ) {
+    cnt[PMMG_MPICOUNT_NSEND] += 1.;
+    cnt[PMMG_MPICOUNT_BSEND] += bytes;
+    PMMG_mpicount_peer(peer,bytes);
+  }
+  else {
+    cnt[PMMG_MPICOUNT_NRECV] += 1.;
+    cnt[PMMG_MPICOUNT_BRECV] += bytes;
+  }
+}
+
+/**
+ * \param bytes bytes given to the collective by the process.
+ * \param tstart start time of the call.
+ *
+ * Count a collective call.
+ *
+ */
+static inline
+void PMMG_mpicount_coll( double bytes,double tstart ) {
+  double *cnt;
+
+  if ( PMMG_mpicountOff ) return;
+
+  cnt = PMMG_mpicount[PMMG_mpiphase];
+  cnt[PMMG_MPICOUNT_NCOLL] += 1.;
+  cnt[PMMG_MPICOUNT_BCOLL] += bytes;
+  cnt[PMMG_MPICOUNT_TIME]  += PMPI_Wtime() - tstart;
+}
+
+/**
+ * \param bytes bytes written or read by the process.
+ * \param tstart start time of the call.
+ *
+ * Count an MPI-IO call.
+ *
+ */
+static inline
+void PMMG_mpicount_io( double bytes,double tstart ) {
+  double *cnt;
+
+  if ( PMMG_mpicountOff ) return;
+
+  cnt = PMMG_mpicount[PMMG_mpiphase];
+  cnt[PMMG_MPICOUNT_NIO]  += 1.;
+  cnt[PMMG_MPICOUNT_BIO]  += bytes;
+  cnt[PMMG_MPICOUNT_TIME] += PMPI_Wtime() - tstart;
+}
+
+/**
+ * \param tstart start time of the call.
+ *
+ * Count the time spent in an MPI call.
+ *
+ */
+static inline
+void PMMG_mpicount_time( double tstart ) {
+  if ( PMMG_mpicountOff ) return;
+  PMMG_mpicount[PMMG_mpiphase][PMMG_MPICOUNT_TIME] += PMPI_Wtime() - tstart;
+}
+
+/**
+ * \param slot address of a request.
+ *
+ * \return the index of the first persistent request stored at an address
+ * greater or equal to \a slot (\a PMMG_npers if none).
+ *
+ * The persistent requests are sorted by address: the requests of a halo are
+ * contiguous, so a lookup costs a binary search per MPI_Start or MPI_Startall.
+ *
+ */
+static
+int PMMG_mpicount_lowerPersistent( MPI_Request *slot ) {
+  int lo,hi,mid;
+
+  lo = 0;
+  hi = PMMG_npers;
+  while ( lo < hi ) {
+    mid = (lo+hi)/2;
+    if ( PMMG_mpipers[mid].slot < slot ) lo = mid+1;
+    else hi = mid;
+  }
+  return lo;
+}
+
+/**
+ * \param slot address of the request.
+ * \param peer remote rank.
+ * \param bytes size of the message.
+ * \param send 1 for a send, 0 for a receive.
+ *
+ * Store a persistent request (counted at each MPI_Start).
+ *
+ */
+static
+void PMMG_mpicount_addPersistent( MPI_Request *slot,int peer,double bytes,
+                                  int send ) {
+  PMMG_MpiPersistent *pers;
+  int                k,n;
+
+  k = PMMG_mpicount_lowerPersistent(slot);
+  if ( k == PMMG_npers || PMMG_mpipers[k].slot != slot ) {
+    /* New address: insert it */
+    if ( PMMG_npers == PMMG_npersMax ) {
+      n    = PMMG_npersMax ? 2*PMMG_npersMax : 64;
+      pers = (PMMG_MpiPersistent*)realloc(PMMG_mpipers,n*sizeof(PMMG_MpiPersistent));
+      if ( !pers ) return;
+      PMMG_mpipers  = pers;
+      PMMG_npersMax = n;
+    }
+    memmove(&PMMG_mpipers[k+1],&PMMG_mpipers[k],
+            (PMMG_npers-k)*sizeof(PMMG_MpiPersistent));
+    ++PMMG_npers;
+  }
+  pers          = &PMMG_mpipers[k];
+  pers->slot    = slot;
+  pers->request = *slot;
+  pers->peer    = peer;
+  pers->bytes   = bytes;
+  pers->send    = send;
+}
+
+/**
+ * \param count nb of requests to start.
+ * \param requests requests to start.
+ *
+ * Count the messages of the started persistent requests.
+ *
+ */
+static
+void PMMG_mpicount_start( int count,MPI_Request *requests ) {
+  PMMG_MpiPersistent *pers;
+  int                k;
+
+  k = PMMG_mpicount_lowerPersistent(requests);
+  for ( ; k<PMMG_npers && PMMG_mpipers[k].slot < requests+count; ++k ) {
+    pers = &PMMG_mpipers[k];
+    /* Skip a request freed without MPI_Request_free or stored elsewhere */
+    if ( memcmp(&pers->request,pers->slot,sizeof(MPI_Request)) ) continue;
+    PMMG_mpicount_p2p(pers->peer,pers->bytes,pers->send);
+  }
+}
+
+/* Point-to-point communications */
+int MPI_Send( const void *buf,int count,MPI_Datatype datatype,int dest,int tag,
+              MPI_Comm comm ) {
+  double t = PMPI_Wtime();
+  int    ier = PMPI_Send(buf,count,datatype,dest,tag,comm);
+  PMMG_mpicount_p2p(dest,PMMG_mpicount_bytes(count,datatype),1);
+  PMMG_mpicount_time(t);
+  return ier;
+}
+
+int MPI_Isend( const void *buf,int count,MPI_Datatype datatype,int dest,int tag,
+               MPI_Comm comm,MPI_Request *request ) {
+  double t = PMPI_Wtime();
+  int    ier = PMPI_Isend(buf,count,datatype,dest,tag,comm,request);
+  PMMG_mpicount_p2p(dest,PMMG_mpicount_bytes(count,datatype),1);
+  PMMG_mpicount_time(t);
+  return ier;
+}
+
+int MPI_Recv( void *buf,int count,MPI_Datatype datatype,int source,int tag,
+              MPI_Comm comm,MPI_Status *status ) {
+  MPI_Status st;
+  double     t = PMPI_Wtime();
+  int        ier,n;
+
+  /* Count the received size (not the size of the buffer) */
+  if ( status == MPI_STATUS_IGNORE ) status = &st;
+  ier = PMPI_Recv(buf,count,datatype,source,tag,comm,status);
+  if ( ier == MPI_SUCCESS && PMPI_Get_count(status,datatype,&n) == MPI_SUCCESS &&
+       n != MPI_UNDEFINED ) {
+    count = n;
+  }
+  PMMG_mpicount_p2p(status->MPI_SOURCE,PMMG_mpicount_bytes(count,datatype),0);
+  PMMG_mpicount_time(t);
+  return ier;
+}
+
+int MPI_Irecv( void *buf,int count,MPI_Datatype datatype,int source,int tag,
+               MPI_Comm comm,MPI_Request *request ) {
+  double t = PMPI_Wtime();
+  int    ier = PMPI_Irecv(buf,count,datatype,source,tag,comm,request);
+  /* Size of the buffer: the received size is known at the completion */
+  PMMG_mpicount_p2p(source,PMMG_mpicount_bytes(count,datatype),0);
+  PMMG_mpicount_time(t);
+  return ier;
+}
+
+int MPI_Send_init( const void *buf,int count,MPI_Datatype datatype,int dest,
+                   int tag,MPI_Comm comm,MPI_Request *request ) {
+  int ier = PMPI_Send_init(buf,count,datatype,dest,tag,comm,request);
+  if ( ier == MPI_SUCCESS ) {
+    PMMG_mpicount_addPersistent(request,dest,PMMG_mpicount_bytes(count,datatype),1);
+  }
+  return ier;
+}
+
+int MPI_Recv_init( void *buf,int count,MPI_Datatype datatype,int source,
+                   int tag,MPI_Comm comm,MPI_Request *request ) {
+  int ier = PMPI_Recv_init(buf,count,datatype,source,tag,comm,request);
+  if ( ier == MPI_SUCCESS ) {
+    PMMG_mpicount_addPersistent(request,source,PMMG_mpicount_bytes(count,datatype),0);
+  }
+  return ier;
+}
+
+int MPI_Start( MPI_Request *request ) {
+  double t = PMPI_Wtime();
+  int    ier;
+
+  PMMG_mpicount_start(1,request);
+  ier = PMPI_Start(request);
+  PMMG_mpicount_time(t);
+  return ier;
+}
+
+int MPI_Startall( int count,MPI_Request *requests ) {
+  double t = PMPI_Wtime();
+  int    ier;
+
+  PMMG_mpicount_start(count,requests);
+  ier = PMPI_Startall(count,requests);
+  PMMG_mpicount_time(t);
+  return ier;
+}
+
+int MPI_Request_free( MPI_Request *request ) {
+  int k;
+
+  k = PMMG_mpicount_lowerPersistent(request);
+  if ( k < PMMG_npers && PMMG_mpipers[k].slot == request ) {
+    memmove(&PMMG_mpipers[k],&PMMG_mpipers[k+1],
+            (PMMG_npers-k-1)*sizeof(PMMG_MpiPersistent));
+    --PMMG_npers;
+  }
+  return PMPI_Request_free(request);
+}
+
+int MPI_Wait( MPI_Request *request,MPI_Status *status ) {
+  double t = PMPI_Wtime();
+  int    ier = PMPI_Wait(request,status);
+  PMMG_mpicount_time(t);
+  return ier;
+}
+
+int MPI_Waitall( int count,MPI_Request *requests,MPI_Status *statuses ) {
+  double t = PMPI_Wtime();
+  int    ier = PMPI_Waitall(count,requests,statuses);
+  PMMG_mpicount_time(t);
+  return ier;
+}
+
+int MPI_Probe( int source,int tag,MPI_Comm comm,MPI_Status *status ) {
+  double t = PMPI_Wtime();
+  int    ier = PMPI_Probe(source,tag,comm,status);
+  PMMG_mpicount_time(t);
+  return ier;
+}
+
+/* Collective communications (bytes given by the process) */
+int MPI_Barrier( MPI_Comm comm ) {
+  double t = PMPI_Wtime();
+  int    ier = PMPI_Barrier(comm);
+  PMMG_mpicount_coll(0.,t);
+  return ier;
+}
+
+int MPI_Bcast( void *buf,int count,MPI_Datatype datatype,int root,MPI_Comm comm ) {
+  double t = PMPI_Wtime();
+  int    ier = PMPI_Bcast(buf,count,datatype,root,comm);
+  PMMG_mpicount_coll(PMMG_mpicount_bytes(count,datatype),t);
+  return ier;
+}
+
+int MPI_Allreduce( const void *sendbuf,void *recvbuf,int count,
+                   MPI_Datatype datatype,MPI_Op op,MPI_Comm comm ) {
+  double t = PMPI_Wtime();
+  int    ier = PMPI_Allreduce(sendbuf,recvbuf,count,datatype,op,comm);
+  PMMG_mpicount_coll(PMMG_mpicount_bytes(count,datatype),t);
+  return ier;
+}
+
+int MPI_Reduce( const void *sendbuf,void *recvbuf,int count,
+                MPI_Datatype datatype,MPI_Op op,int root,MPI_Comm comm ) {
+  double t = PMPI_Wtime();
+  int    ier = PMPI_Reduce(sendbuf,recvbuf,count,datatype,op,root,comm);
+  PMMG_mpicount_coll(PMMG_mpicount_bytes(count,datatype),t);
+  return ier;
+}
+
+int MPI_Exscan( const void *sendbuf,void *recvbuf,int count,
+                MPI_Datatype datatype,MPI_Op op,MPI_Comm comm ) {
+  double t = PMPI_Wtime();
+  int    ier = PMPI_Exscan(sendbuf,recvbuf,count,datatype,op,comm);
+  PMMG_mpicount_coll(PMMG_mpicount_bytes(count,datatype),t);
+  return ier;
+}
+
+int MPI_Gather( const void *sendbuf,int sendcount,MPI_Datatype sendtype,
+                void *recvbuf,int recvcount,MPI_Datatype recvtype,int root,
+                MPI_Comm comm ) {
+  double t = PMPI_Wtime();
+  int    ier = PMPI_Gather(sendbuf,sendcount,sendtype,recvbuf,recvcount,
+                           recvtype,root,comm);
+  PMMG_mpicount_coll(PMMG_mpicount_bytes(sendcount,sendtype),t);
+  return ier;
+}
+
+int MPI_Gatherv( const void *sendbuf,int sendcount,MPI_Datatype sendtype,
+                 void *recvbuf,const int recvcounts[],const int displs[],
+                 MPI_Datatype recvtype,int root,MPI_Comm comm ) {
+  double t = PMPI_Wtime();
+  int    ier = PMPI_Gatherv(sendbuf,sendcount,sendtype,recvbuf,recvcounts,
+                            displs,recvtype,root,comm);
+  PMMG_mpicount_coll(PMMG_mpicount_bytes(sendcount,sendtype),t);
+  return ier;
+}
+
+int MPI_Allgather( const void *sendbuf,int sendcount,MPI_Datatype sendtype,
+                   void *recvbuf,int recvcount,MPI_Datatype recvtype,
+                   MPI_Comm comm ) {
+  double t = PMPI_Wtime();
+  int    ier = PMPI_Allgather(sendbuf,sendcount,sendtype,recvbuf,recvcount,
+                              recvtype,comm);
+  PMMG_mpicount_coll(PMMG_mpicount_bytes(sendcount,sendtype),t);
+  return ier;
+}
+
+int MPI_Allgatherv( const void *sendbuf,int sendcount,MPI_Datatype sendtype,
+                    void *recvbuf,const int recvcounts[],const int displs[],
+                    MPI_Datatype recvtype,MPI_Comm comm ) {
+  double t = PMPI_Wtime();
+  int    ier = PMPI_Allgatherv(sendbuf,sendcount,sendtype,recvbuf,recvcounts,
+                               displs,recvtype,comm);
+  PMMG_mpicount_coll(PMMG_mpicount_bytes(sendcount,sendtype),t);
+  return ier;
+}
+
+int MPI_Scatterv( const void *sendbuf,const int sendcounts[],const int displs[],
+                  MPI_Datatype sendtype,void *recvbuf,int recvcount,
+                  MPI_Datatype recvtype,int root,MPI_Comm comm ) {
+  double t = PMPI_Wtime();
+  int    ier = PMPI_Scatterv(sendbuf,sendcounts,displs,sendtype,recvbuf,
+                             recvcount,recvtype,root,comm);
+  PMMG_mpicount_coll(PMMG_mpicount_bytes(recvcount,recvtype),t);
+  return ier;
+}
+
+int MPI_Alltoall( const void *sendbuf,int sendcount,MPI_Datatype sendtype,
+                  void *recvbuf,int recvcount,MPI_Datatype recvtype,
+                  MPI_Comm comm ) {
+  double t = PMPI_Wtime(),bytes;
+  int    ier,nprocs,myrank,k;
+
+  ier = PMPI_Alltoall(sendbuf,sendcount,sendtype,recvbuf,recvcount,recvtype,comm);
+  PMPI_Comm_size(comm,&nprocs);
+  PMPI_Comm_rank(comm,&myrank);
+  bytes = PMMG_mpicount_bytes(sendcount,sendtype);
+  if ( !PMMG_mpicountOff ) {
+    for ( k=0; k<nprocs; ++k ) {
+      if ( k != myrank && bytes > 0. ) PMMG_mpicount_peer(k,bytes);
+    }
+  }
+  PMMG_mpicount_coll(bytes*nprocs,t);
+  return ier;
+}
+
+int MPI_Alltoallv( const void *sendbuf,const int sendcounts[],const int sdispls[],
+                   MPI_Datatype sendtype,void *recvbuf,const int recvcounts[],
+                   const int rdispls[],MPI_Datatype recvtype,MPI_Comm comm ) {
+  double t = PMPI_Wtime(),bytes,tot;
+  int    ier,nprocs,myrank,k;
+
+  ier = PMPI_Alltoallv(sendbuf,sendcounts,sdispls,sendtype,recvbuf,recvcounts,
+                       rdispls,recvtype,comm);
+  PMPI_Comm_size(comm,&nprocs);
+  PMPI_Comm_rank(comm,&myrank);
+  tot = 0.;
+  for ( k=0; k<nprocs; ++k ) {
+    bytes = PMMG_mpicount_bytes(sendcounts[k],sendtype);
+    tot  += bytes;
+    if ( !PMMG_mpicountOff && k != myrank && bytes > 0. ) PMMG_mpicount_peer(k,bytes);
+  }
+  PMMG_mpicount_coll(tot,t);
+  return ier;
+}
+
+int MPI_Comm_split_type( MPI_Comm comm,int split_type,int key,MPI_Info info,
+                         MPI_Comm *newcomm ) {
+  double t = PMPI_Wtime();
+  int    ier = PMPI_Comm_split_type(comm,split_type,key,info,newcomm);
+  PMMG_mpicount_coll(0.,t);
+  return ier;
+}
+
+/* MPI-IO (bytes written or read by the process) */
+int MPI_File_open( MPI_Comm comm,const char *filename,int amode,MPI_Info info,
+                   MPI_File *fh ) {
+  double t = PMPI_Wtime();
+  int    ier = PMPI_File_open(comm,filename,amode,info,fh);
+  PMMG_mpicount_io(0.,t);
+  return ier;
+}
+
+int MPI_File_close( MPI_File *fh ) {
+  double t = PMPI_Wtime();
+  int    ier = PMPI_File_close(fh);
+  PMMG_mpicount_io(0.,t);
+  return ier;
+}
+
+int MPI_File_set_size( MPI_File fh,MPI_Offset size ) {
+  double t = PMPI_Wtime();
+  int    ier = PMPI_File_set_size(fh,size);
+  PMMG_mpicount_io(0.,t);
+  return ier;
+}
+
+int MPI_File_write_at( MPI_File fh,MPI_Offset offset,const void *buf,int count,
+                       MPI_Datatype datatype,MPI_Status *status ) {
+  double t = PMPI_Wtime();
+  int    ier = PMPI_File_write_at(fh,offset,buf,count,datatype,status);
+  PMMG_mpicount_io(PMMG_mpicount_bytes(count,datatype),t);
+  return ier;
+}
+
+int MPI_File_write_at_all( MPI_File fh,MPI_Offset offset,const void *buf,
+                           int count,MPI_Datatype datatype,MPI_Status *status ) {
+  double t = PMPI_Wtime();
+  int    ier = PMPI_File_write_at_all(fh,offset,buf,count,datatype,status);
+  PMMG_mpicount_io(PMMG_mpicount_bytes(count,datatype),t);
+  return ier;
+}
+
+int MPI_File_read_at_all( MPI_File fh,MPI_Offset offset,void *buf,int count,
+                          MPI_Datatype datatype,MPI_Status *status ) {
+  double t = PMPI_Wtime();
+  int    ier = PMPI_File_read_at_all(fh,offset,buf,count,datatype,status);
+  PMMG_mpicount_io(PMMG_mpicount_bytes(count,datatype),t);
+  return ier;
+}
+
+/**
+ * \param fp file of the timers report (NULL if not root or no JSON report).
+ * \param parmesh pointer toward the parmesh structure.
+ *
+ * \return 1 if success, 0 if fail.
+ *
+ * Reduce the MPI counters over the processes. At verbosity > PMMG_VERB_STEPS,
+ * print the max over the processes of the bytes sent and of the time in MPI
+ * per phase; if \a fp is given, write the min/max/mean of each counter per
+ * phase and the nonzero per-peer counters in the "mpi" entry of the JSON
+ * report. Collective.
+ *
+ */
+int PMMG_mpicount_report( PMMG_pParMesh parmesh,FILE *fp ) {
+  double *vmin,*vmax,*vsum,*loc,*peers,*gpeers,mean;
+  char   stim[32];
+  int    *counts,*displs,nloc,ntot,nval,id,k,j,ier,ieresult,root;
+
+  /* The report communications are not counted */
+  PMMG_mpicountOff = 1;
+
+  ier    = 1;
+  ntot   = 0;
+  root   = ( parmesh->myrank == parmesh->info.root );
+  nval   = PMMG_NPHASE*PMMG_MPICOUNT_NVAL;
+  vmin   = vmax = vsum = peers = gpeers = NULL;
+  counts = displs = NULL;
+  loc    = &PMMG_mpicount[0][0];
+
+  if ( root ) {
+    PMMG_MALLOC(parmesh,vmin,nval,double,"mpicount vmin",ier = 0);
+    PMMG_MALLOC(parmesh,vmax,nval,double,"mpicount vmax",ier = 0);
+    PMMG_MALLOC(parmesh,vsum,nval,double,"mpicount vsum",ier = 0);
+    PMMG_MALLOC(parmesh,counts,parmesh->nprocs,int,"mpicount counts",ier = 0);
+    PMMG_MALLOC(parmesh,displs,parmesh->nprocs,int,"mpicount displs",ier = 0);
+  }
+
+  /* Nonzero per-peer counters: (from,to,phase,msgs,bytes) */
+  nloc = 0;
+  for ( k=0; k<PMMG_npeer*PMMG_NPHASE; ++k ) {
+    if ( PMMG_mpipeer[2*k] > 0. ) ++nloc;
+  }
+  PMMG_MALLOC(parmesh,peers,5*nloc+1,double,"mpicount peers",ier = 0);
+  if ( ier ) {
+    j = 0;
+    for ( k=0; k<PMMG_npeer*PMMG_NPHASE; ++k ) {
+      if ( PMMG_mpipeer[2*k] <= 0. ) continue;
+      peers[j++] = parmesh->myrank;
+      peers[j++] = k/PMMG_NPHASE;
+      peers[j++] = k%PMMG_NPHASE;
+      peers[j++] = PMMG_mpipeer[2*k];
+      peers[j++] = PMMG_mpipeer[2*k+1];
+    }
+  }
+  MPI_Allreduce( &ier,&ieresult,1,MPI_INT,MPI_MIN,parmesh->comm );
+  if ( !ieresult ) goto end;
+
+  MPI_CHECK( MPI_Reduce(loc,vmin,nval,MPI_DOUBLE,MPI_MIN,parmesh->info.root,
+                        parmesh->comm),ier = 0 );
+  MPI_CHECK( MPI_Reduce(loc,vmax,nval,MPI_DOUBLE,MPI_MAX,parmesh->info.root,
+                        parmesh->comm),ier = 0 );
+  MPI_CHECK( MPI_Reduce(loc,vsum,nval,MPI_DOUBLE,MPI_SUM,parmesh->info.root,
+                        parmesh->comm),ier = 0 );
+
+  /* The per-peer counters are only needed in the JSON report */
+  k = ( fp != NULL );
+  MPI_CHECK( MPI_Bcast(&k,1,MPI_INT,parmesh->info.root,parmesh->comm),ier = 0 );
+  if ( k ) {
+    nloc *= 5;
+    MPI_CHECK( MPI_Gather(&nloc,1,MPI_INT,counts,1,MPI_INT,parmesh->info.root,
+                          parmesh->comm),ier = 0 );
+    if ( root ) {
+      for ( k=0; k<parmesh->nprocs; ++k ) {
+        displs[k] = ntot;
+        ntot     += counts[k];
+      }
+      PMMG_MALLOC(parmesh,gpeers,ntot+1,double,"mpicount gpeers",ier = 0);
+    }
+    MPI_Allreduce( &ier,&ieresult,1,MPI_INT,MPI_MIN,parmesh->comm );
+    if ( !ieresult ) goto end;
+
+    MPI_CHECK( MPI_Gatherv(peers,nloc,MPI_DOUBLE,gpeers,counts,displs,MPI_DOUBLE,
+                           parmesh->info.root,parmesh->comm),ier = 0 );
+  }
+
+  if ( !root || !ier ) goto end;
+
+  /** Human output */
+  if ( parmesh->info.imprim > PMMG_VERB_STEPS ) {
+    fprintf(stdout,"\n   -- MPI (slowest proc: MB sent, collectives MB, I/O MB, time in MPI)\n");
+    for ( id=0; id<PMMG_NPHASE; ++id ) {
+      k = id*PMMG_MPICOUNT_NVAL;
+      if ( vmax[k+PMMG_MPICOUNT_TIME] <= 0. ) continue;
+      printim(vmax[k+PMMG_MPICOUNT_TIME],stim);
+      fprintf(stdout,"       %-30s  %9.3f  %9.3f  %9.3f  %s\n",PMMG_Get_phaseName(id),
+              vmax[k+PMMG_MPICOUNT_BSEND]/MMG5_MILLION,
+              vmax[k+PMMG_MPICOUNT_BCOLL]/MMG5_MILLION,
+              vmax[k+PMMG_MPICOUNT_BIO]/MMG5_MILLION,stim);
+    }
+  }
+
+  /** JSON report */
+  if ( !fp ) goto end;
+
+  fprintf(fp,",\n  \"mpi\": {\n    \"phases\": [\n");
+  for ( id=0; id<PMMG_NPHASE; ++id ) {
+    fprintf(fp,"      {\"phase\": \"%s\"",PMMG_Get_phaseName(id));
+    for ( j=0; j<PMMG_MPICOUNT_NVAL; ++j ) {
+      k    = id*PMMG_MPICOUNT_NVAL+j;
+      mean = vsum[k]/parmesh->nprocs;
+      fprintf(fp,", \"%s\": {\"min\": %.6g, \"max\": %.6g, \"mean\": %.6g}",
+              PMMG_mpicountName[j],vmin[k],vmax[k],mean);
+    }
+    fprintf(fp,"}%s\n",id<PMMG_NPHASE-1 ? "," : "");
+  }
+  fprintf(fp,"    ],\n    \"peers\": [");
+  for ( k=0; k<ntot; k+=5 ) {
+    fprintf(fp,"%s\n      {\"from\": %.0f, \"to\": %.0f, \"phase\": \"%s\","
+            " \"msgSent\": %.0f, \"bytesSent\": %.0f}",k ? "," : "",
+            gpeers[k],gpeers[k+1],PMMG_Get_phaseName((int)gpeers[k+2]),
+            gpeers[k+3],gpeers[k+4]);
+  }
+  fprintf(fp,"\n    ]\n  }");
+
+end:
+  PMMG_DEL_MEM(parmesh,gpeers,double,"mpicount gpeers");
+  PMMG_DEL_MEM(parmesh,peers,double,"mpicount peers");
+  PMMG_DEL_MEM(parmesh,displs,int,"mpicount displs");
+  PMMG_DEL_MEM(parmesh,counts,int,"mpicount counts");
+  PMMG_DEL_MEM(parmesh,vsum,double,"mpicount vsum");
+  PMMG_DEL_MEM(parmesh,vmax,double,"mpicount vmax");
+  PMMG_DEL_MEM(parmesh,vmin,double,"mpicount vmin");
+
+  MPI_Allreduce( &ier,&ieresult,1,MPI_INT,MPI_MIN,parmesh->comm );
+
+  PMMG_mpicountOff = 0;
+
+  return ieresult;
+}
+
+/**
+ * Free the MPI counters.
+ */
+void PMMG_mpicount_free( void ) {
+  free(PMMG_mpipeer);
+  free(PMMG_mpipers);
+  PMMG_mpipeer  = NULL;
+  PMMG_mpipers  = NULL;
+  PMMG_npeer    = 0;
+  PMMG_npers    = 0;
+  PMMG_npersMax = 0;
+  memset(PMMG_mpicount,0,sizeof(PMMG_mpicount));
+}
+
+#endif
@@ -0,0 +1,1907 @@
+/* =============================================================================
+**  This file is part of the parmmg software package for parallel tetrahedral
+**  mesh modification.
+**  Copyright (c) Bx INP/Inria/UBordeaux, 2017-
+**
+**  parmmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  parmmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with parmmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the parmmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/**
+ * \file mpiio_pmmg.c
+ * \brief Collective MPI-IO input/output of the parallel mesh in one shared file.
+ * \author Cécile Dobrzynski (Bx INP/Inria)
+ * \author Algiane Froehly (Inria)
+ * \author Luca Cirrottola (Inria)
+ * \version 1
+ * \copyright GNU Lesser General Public License.
+ *
+ * The mesh is written at the Medit binary format without being gathered: the
+ * size of each section is known from the global numbers of entities, so each
+ * process computes where its entities lie in the file and writes them with a
+ * collective call. Only the vertices, triangles and tetrahedra are saved.
+ *
+ * The same files can be read without loading the whole mesh on one process:
+ * each process reads a slab of the tetrahedra, the tetrahedra are partitioned
+ * and migrated to their owners, then the vertices and triangles are read by
+ * slabs too and sent to the processes that use them.
+ *
+ */
+#include "parmmg.h"
+#include "metis_pmmg.h"
+
+/** Size of a vertex (3 coordinates and a reference) in the file */
+#define PMMG_MPIIO_VERSIZE (3*sizeof(double)+sizeof(int))
+/** Size of a triangle (3 vertices and a reference) in the file */
+#define PMMG_MPIIO_TRIASIZE (4*sizeof(int))
+/** Size of a tetrahedron (4 vertices and a reference) in the file */
+#define PMMG_MPIIO_TETRASIZE (5*sizeof(int))
+/** Number of values of the file headers broadcast by the root process */
+#define PMMG_MPIIO_NHDR 11
+
+/**
+ * \param buf pointer toward the buffer position (updated).
+ * \param val value to store.
+ *
+ * Store an integer in a byte buffer.
+ *
+ */
+static inline
+void PMMG_mpiio_packInt( char **buf,int val ) {
+  memcpy(*buf,&val,sizeof(int));
+  *buf += sizeof(int);
+}
+
+/**
+ * \param buf pointer toward the buffer position (updated).
+ * \param pos file position to store.
+ * \param ver version of the Medit file (positions are stored on 4 bytes
+ * before version 3 and on 8 bytes from version 3).
+ *
+ * Store a file position in a byte buffer.
+ *
+ */
+static inline
+void PMMG_mpiio_packPos( char **buf,MPI_Offset pos,int ver ) {
+  int64_t lpos;
+
+  if ( ver < 3 ) {
+    PMMG_mpiio_packInt(buf,(int)pos);
+  }
+  else {
+    lpos = (int64_t)pos;
+    memcpy(*buf,&lpos,sizeof(int64_t));
+    *buf += sizeof(int64_t);
+  }
+}
+
+/**
+ * \param ver version of the Medit file.
+ *
+ * \return the size of a keyword header without its data (keyword code, and
+ * position of the next keyword).
+ *
+ */
+static inline
+MPI_Offset PMMG_mpiio_kwdSize( int ver ) {
+  return sizeof(int) + ( ver < 3 ? sizeof(int) : sizeof(int64_t) );
+}
+
+/**
+ * \param ver version of the Medit file.
+ * \param np global number of vertices.
+ * \param nt global number of triangles.
+ * \param ne global number of tetrahedra.
+ * \param pos positions of the Vertices keyword, of the vertices, of the
+ * Triangles keyword, of the Tetrahedra keyword and of the End keyword (filled).
+ *
+ * \return the size of the mesh file.
+ *
+ * Compute the position of each section of the mesh file.
+ *
+ */
+static
+MPI_Offset PMMG_mpiio_meshLayout( int ver,int np,int nt,int ne,MPI_Offset *pos ) {
+
+  /* Header and dimension */
+  pos[0] = 2*sizeof(int) + PMMG_mpiio_kwdSize(ver) + sizeof(int);
+  pos[1] = pos[0] + PMMG_mpiio_kwdSize(ver) + sizeof(int);
+  pos[2] = pos[1] + (MPI_Offset)np*PMMG_MPIIO_VERSIZE;
+  pos[3] = pos[2];
+  if ( nt ) {
+    pos[3] += PMMG_mpiio_kwdSize(ver) + sizeof(int)
+      + (MPI_Offset)nt*PMMG_MPIIO_TRIASIZE;
+  }
+  pos[4] = pos[3] + PMMG_mpiio_kwdSize(ver) + sizeof(int)
+    + (MPI_Offset)ne*PMMG_MPIIO_TETRASIZE;
+
+  return pos[4] + sizeof(int);
+}
+
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ * \param filename name of the file.
+ * \param amode access mode (files opened for writing are truncated).
+ * \param fh pointer toward the MPI file handle (filled).
+ *
+ * \return 0 if fail, 1 otherwise
+ *
+ * Collectively open a shared file.
+ *
+ */
+static
+int PMMG_mpiio_open( PMMG_pParMesh parmesh,const char *filename,int amode,
+                     MPI_File *fh ) {
+  int ier;
+
+  ier = MPI_File_open(parmesh->comm,filename,amode,MPI_INFO_NULL,fh);
+  if ( ier != MPI_SUCCESS ) {
+    if ( parmesh->myrank == parmesh->info.root ) {
+      fprintf(stderr,"\n  ## Error: %s: unable to open %s.\n",__func__,filename);
+    }
+    return 0;
+  }
+  if ( amode & MPI_MODE_WRONLY ) {
+    MPI_CHECK( MPI_File_set_size(*fh,0),MPI_File_close(fh);return 0 );
+  }
+
+  if ( parmesh->myrank == parmesh->info.root && parmesh->info.imprim >= 0 ) {
+    fprintf(stdout,"  %%%% %s OPENED\n",filename);
+  }
+
+  return 1;
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param ptt pointer toward the triangle.
+ * \param mask bitmask of the tetra faces whose triangle is saved by another
+ * process.
+ *
+ * \return 1 if the triangle is saved by the process, 0 otherwise.
+ *
+ * Triangles of the parallel interfaces are not saved, except if they are also
+ * a true boundary: in this case, the triangle is saved by the lowest rank that
+ * shares it.
+ *
+ */
+static inline
+int PMMG_mpiio_isSavedTria( MMG5_pMesh mesh,MMG5_pTria ptt,int8_t *mask ) {
+  MMG5_pTetra  pt;
+  MMG5_pxTetra pxt;
+  int          ie,ifac;
+
+  ie   = ptt->cc/4;
+  ifac = ptt->cc%4;
+  pt   = &mesh->tetra[ie];
+  assert ( pt->xt );
+  pxt  = &mesh->xtetra[pt->xt];
+
+  if ( !(pxt->ftag[ifac] & MG_PARBDY) ) return 1;
+
+  return ( (pxt->ftag[ifac] & MG_PARBDYBDY) && !(mask[ie] & (1 << ifac)) );
+}
+
+/**
+ * \param fh MPI file.
+ * \param pos position of the first record of the process in the file.
+ * \param buf buffer of the records.
+ * \param count number of records of the process.
+ * \param rsize size of a record (in bytes).
+ *
+ * \return 0 if fail, 1 otherwise
+ *
+ * Collectively write the records of the process: the records are written as
+ * \a count items of a contiguous datatype, so the number of bytes of the
+ * process may exceed the int range.
+ *
+ */
+static
+int PMMG_mpiio_writeSlab( MPI_File fh,MPI_Offset pos,void *buf,int count,
+                          int rsize ) {
+  MPI_Datatype type;
+  MPI_Status   status;
+  int          ier;
+
+  ier = 1;
+  MPI_Type_contiguous(rsize,MPI_BYTE,&type);
+  MPI_Type_commit(&type);
+  MPI_CHECK( MPI_File_write_at_all(fh,pos,buf,count,type,&status),ier = 0 );
+  MPI_Type_free(&type);
+
+  return ier;
+}
+
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ * \param mask bitmask of the tetra faces whose triangle is saved by another
+ * process (allocated to ne+1 and filled).
+ *
+ * \return the number of boundary triangles saved by the process, -1 if fail.
+ *
+ * Mark the interface faces shared with a lower rank and count the boundary
+ * triangles saved by the process.
+ *
+ */
+static
+int PMMG_mpiio_countTria( PMMG_pParMesh parmesh,int8_t *mask ) {
+  PMMG_pGrp      grp;
+  PMMG_pInt_comm int_face_comm;
+  PMMG_pExt_comm ext_face_comm;
+  MMG5_pMesh     mesh;
+  int            *intvalues,icomm,i,k,ie,ifac,idx,nt;
+
+  grp  = &parmesh->listgrp[0];
+  mesh = grp->mesh;
+
+  /** Mark the faces that are shared with a lower rank */
+  int_face_comm = parmesh->int_face_comm;
+  PMMG_MALLOC(parmesh,int_face_comm->intvalues,int_face_comm->nitem,int,
+              "intvalues",return -1);
+  intvalues = int_face_comm->intvalues;
+
+  for ( icomm=0; icomm<parmesh->next_face_comm; ++icomm ) {
+    ext_face_comm = &parmesh->ext_face_comm[icomm];
+    for ( i=0; i<ext_face_comm->nitem; ++i ) {
+      idx            = ext_face_comm->int_comm_index[i];
+      intvalues[idx] = ext_face_comm->color_out;
+    }
+  }
+
+  for ( k=0; k<grp->nitem_int_face_comm; ++k ) {
+    ie   =  grp->face2int_face_comm_index1[k]/12;
+    ifac = (grp->face2int_face_comm_index1[k]%12)/3;
+    idx  =  grp->face2int_face_comm_index2[k];
+    if ( intvalues[idx] < parmesh->myrank ) mask[ie] |= (1 << ifac);
+  }
+
+  PMMG_DEL_MEM(parmesh,int_face_comm->intvalues,int,"intvalues");
+
+  /** Count the saved triangles */
+  nt = 0;
+  for ( k=1; k<=mesh->nt; ++k ) {
+    if ( PMMG_mpiio_isSavedTria(mesh,&mesh->tria[k],mask) ) ++nt;
+  }
+
+  return nt;
+}
+
+int PMMG_saveMesh_mpiio(PMMG_pParMesh parmesh,const char *filename) {
+  MMG5_pMesh mesh;
+  MMG5_pPoint ppt;
+  MMG5_pTria ptt;
+  MMG5_pTetra pt;
+  MPI_File   fh;
+  MPI_Status status;
+  MPI_Offset pos[5],size;
+  int        *glonum,nowned,offset,nglob,loc[2],glo[2],off[2];
+  int        ver,ier,ieresult,ip,k,i,count;
+  int8_t     *mask;
+  char       *buf,*ptr;
+
+  ier = ( parmesh->ngrp == 1 );
+  MPI_CHECK( MPI_Allreduce(&ier,&ieresult,1,MPI_INT,MPI_MIN,parmesh->comm),
+             return 0 );
+  if ( !ieresult ) {
+    if ( parmesh->myrank == parmesh->info.root ) {
+      fprintf(stderr,"  ## Error: %s: you must have exactly 1 group on each"
+              " process.\n",__func__);
+    }
+    return 0;
+  }
+  mesh = parmesh->listgrp[0].mesh;
+
+  glonum = NULL;
+  mask   = NULL;
+  buf    = NULL;
+
+  /** Global numbering of the vertices, triangles and tetrahedra */
+  PMMG_CALLOC(parmesh,glonum,mesh->np+1,int,"glonum",ier = 0);
+  if ( ier ) {
+    ier = PMMG_compute_verticesGloNum(parmesh,glonum,&nowned,&offset,&nglob);
+  }
+
+  loc[0] = loc[1] = 0;
+  if ( ier ) {
+    PMMG_CALLOC(parmesh,mask,mesh->ne+1,int8_t,"mask",ier = 0);
+  }
+  if ( ier ) {
+    loc[0] = PMMG_mpiio_countTria(parmesh,mask);
+    if ( loc[0] < 0 ) ier = 0;
+
+    for ( k=1; k<=mesh->ne; ++k ) {
+      if ( MG_EOK(&mesh->tetra[k]) ) ++loc[1];
+    }
+  }
+
+  MPI_CHECK( MPI_Allreduce(&ier,&ieresult,1,MPI_INT,MPI_MIN,parmesh->comm),
+             ieresult = 0 );
+  if ( !ieresult ) {
+    PMMG_DEL_MEM(parmesh,mask,int8_t,"mask");
+    PMMG_DEL_MEM(parmesh,glonum,int,"glonum");
+    return 0;
+  }
+
+  off[0] = off[1] = 0;
+  MPI_CHECK( MPI_Exscan(loc,off,2,MPI_INT,MPI_SUM,parmesh->comm),
+             PMMG_DEL_MEM(parmesh,mask,int8_t,"mask");
+             PMMG_DEL_MEM(parmesh,glonum,int,"glonum");
+             return 0 );
+  if ( !parmesh->myrank ) off[0] = off[1] = 0;
+  MPI_CHECK( MPI_Allreduce(loc,glo,2,MPI_INT,MPI_SUM,parmesh->comm),
+             PMMG_DEL_MEM(parmesh,mask,int8_t,"mask");
+             PMMG_DEL_MEM(parmesh,glonum,int,"glonum");
+             return 0 );
+
+  /** Positions of the sections (64 bits positions are needed above 2 GB) */
+  ver  = 2;
+  size = PMMG_mpiio_meshLayout(ver,nglob,glo[0],glo[1],pos);
+  if ( size >= INT_MAX ) {
+    ver  = 3;
+    size = PMMG_mpiio_meshLayout(ver,nglob,glo[0],glo[1],pos);
+  }
+
+  if ( ver > 2 && parmesh->myrank == parmesh->info.root ) {
+    fprintf(stderr,"\n  ## Warning: %s: file larger than 2 GB, saved at"
+            " Medit version %d (64 bits positions, not readable by Mmg).\n",
+            __func__,ver);
+  }
+
+  if ( !PMMG_mpiio_open(parmesh,filename,MPI_MODE_WRONLY|MPI_MODE_CREATE,&fh) ) {
+    PMMG_DEL_MEM(parmesh,mask,int8_t,"mask");
+    PMMG_DEL_MEM(parmesh,glonum,int,"glonum");
+    return 0;
+  }
+
+  /** Headers and end keyword (written by the root process) */
+  if ( parmesh->myrank == parmesh->info.root ) {
+    PMMG_MALLOC(parmesh,buf,2*sizeof(int)+4*(PMMG_mpiio_kwdSize(ver)+sizeof(int)),
+                char,"header buffer",ier = 0);
+    if ( ier ) {
+      ptr = buf;
+      PMMG_mpiio_packInt(&ptr,1);
+      PMMG_mpiio_packInt(&ptr,ver);
+      PMMG_mpiio_packInt(&ptr,3); // Dimension
+      PMMG_mpiio_packPos(&ptr,pos[0],ver);
+      PMMG_mpiio_packInt(&ptr,3);
+      PMMG_mpiio_packInt(&ptr,4); // Vertices
+      PMMG_mpiio_packPos(&ptr,pos[2],ver);
+      PMMG_mpiio_packInt(&ptr,nglob);
+      MPI_CHECK( MPI_File_write_at(fh,0,buf,ptr-buf,MPI_BYTE,&status),ier = 0 );
+
+      if ( glo[0] ) {
+        ptr = buf;
+        PMMG_mpiio_packInt(&ptr,6); // Triangles
+        PMMG_mpiio_packPos(&ptr,pos[3],ver);
+        PMMG_mpiio_packInt(&ptr,glo[0]);
+        MPI_CHECK( MPI_File_write_at(fh,pos[2],buf,ptr-buf,MPI_BYTE,&status),
+                   ier = 0 );
+      }
+
+      ptr = buf;
+      PMMG_mpiio_packInt(&ptr,8); // Tetrahedra
+      PMMG_mpiio_packPos(&ptr,pos[4],ver);
+      PMMG_mpiio_packInt(&ptr,glo[1]);
+      MPI_CHECK( MPI_File_write_at(fh,pos[3],buf,ptr-buf,MPI_BYTE,&status),
+                 ier = 0 );
+
+      ptr = buf;
+      PMMG_mpiio_packInt(&ptr,54); // End
+      MPI_CHECK( MPI_File_write_at(fh,pos[4],buf,ptr-buf,MPI_BYTE,&status),
+                 ier = 0 );
+    }
+    PMMG_DEL_MEM(parmesh,buf,char,"header buffer");
+  }
+
+  /** Vertices owned by the process */
+  count = nowned;
+  PMMG_MALLOC(parmesh,buf,MG_MAX((size_t)count*PMMG_MPIIO_VERSIZE,1),char,
+              "vertices buffer",ier = 0);
+  if ( buf ) {
+    for ( ip=1; ip<=mesh->np; ++ip ) {
+      if ( glonum[ip] <= offset || glonum[ip] > offset+nowned ) continue;
+      ppt = &mesh->point[ip];
+      ptr = buf + (size_t)(glonum[ip]-offset-1)*PMMG_MPIIO_VERSIZE;
+      memcpy(ptr,ppt->c,3*sizeof(double));
+      ptr += 3*sizeof(double);
+      PMMG_mpiio_packInt(&ptr,MG_ABS(ppt->ref));
+    }
+  }
+  else count = 0;
+  if ( !PMMG_mpiio_writeSlab(fh,pos[1]+(MPI_Offset)offset*PMMG_MPIIO_VERSIZE,
+                             buf,count,PMMG_MPIIO_VERSIZE) ) ier = 0;
+  PMMG_DEL_MEM(parmesh,buf,char,"vertices buffer");
+
+  /** Triangles saved by the process */
+  if ( glo[0] ) {
+    count = loc[0];
+    PMMG_MALLOC(parmesh,buf,MG_MAX((size_t)count*PMMG_MPIIO_TRIASIZE,1),char,
+                "triangles buffer",ier = 0);
+    if ( buf ) {
+      ptr = buf;
+      for ( k=1; k<=mesh->nt; ++k ) {
+        ptt = &mesh->tria[k];
+        if ( !PMMG_mpiio_isSavedTria(mesh,ptt,mask) ) continue;
+        for ( i=0; i<3; ++i ) {
+          PMMG_mpiio_packInt(&ptr,glonum[ptt->v[i]]);
+        }
+        PMMG_mpiio_packInt(&ptr,MG_ABS(ptt->ref));
+      }
+    }
+    else count = 0;
+    if ( !PMMG_mpiio_writeSlab(fh,pos[2]+PMMG_mpiio_kwdSize(ver)+sizeof(int)
+                               +(MPI_Offset)off[0]*PMMG_MPIIO_TRIASIZE,
+                               buf,count,PMMG_MPIIO_TRIASIZE) ) ier = 0;
+    PMMG_DEL_MEM(parmesh,buf,char,"triangles buffer");
+  }
+
+  PMMG_DEL_MEM(parmesh,mask,int8_t,"mask");
+
+  /** Tetrahedra of the process */
+  count = loc[1];
+  PMMG_MALLOC(parmesh,buf,MG_MAX((size_t)count*PMMG_MPIIO_TETRASIZE,1),char,
+              "tetrahedra buffer",ier = 0);
+  if ( buf ) {
+    ptr = buf;
+    for ( k=1; k<=mesh->ne; ++k ) {
+      pt = &mesh->tetra[k];
+      if ( !MG_EOK(pt) ) continue;
+      for ( i=0; i<4; ++i ) {
+        PMMG_mpiio_packInt(&ptr,glonum[pt->v[i]]);
+      }
+      PMMG_mpiio_packInt(&ptr,MG_ABS(pt->ref));
+    }
+  }
+  else count = 0;
+  if ( !PMMG_mpiio_writeSlab(fh,pos[3]+PMMG_mpiio_kwdSize(ver)+sizeof(int)
+                             +(MPI_Offset)off[1]*PMMG_MPIIO_TETRASIZE,
+                             buf,count,PMMG_MPIIO_TETRASIZE) ) ier = 0;
+  PMMG_DEL_MEM(parmesh,buf,char,"tetrahedra buffer");
+
+  MPI_CHECK( MPI_File_close(&fh),ier = 0 );
+  PMMG_DEL_MEM(parmesh,glonum,int,"glonum");
+
+  MPI_CHECK( MPI_Allreduce(&ier,&ieresult,1,MPI_INT,MPI_MIN,parmesh->comm),
+             return 0 );
+
+  return ieresult;
+}
+
+/**
+ * \param ver version of the Medit file.
+ * \param np global number of vertices.
+ * \param nsols number of solutions.
+ * \param vsize number of values per vertex.
+ * \param pos positions of the values and of the End keyword (filled).
+ *
+ * \return the size of the solution file.
+ *
+ * Compute the position of each section of the solution file.
+ *
+ */
+static
+MPI_Offset PMMG_mpiio_solLayout( int ver,int np,int nsols,int vsize,
+                                 MPI_Offset *pos ) {
+
+  /* Header, dimension and SolAtVertices keyword with the solution types */
+  pos[0] = 2*sizeof(int) + PMMG_mpiio_kwdSize(ver) + sizeof(int)
+    + PMMG_mpiio_kwdSize(ver) + (2+nsols)*sizeof(int);
+  pos[1] = pos[0] + (MPI_Offset)np*vsize*sizeof(double);
+
+  return pos[1] + sizeof(int);
+}
+
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ * \param filename name of the mesh or solution file.
+ * \param data pointer toward the name of the solution file (allocated and
+ * filled).
+ *
+ * \return 0 if fail, 1 otherwise
+ *
+ * Build the name of the binary solution file by replacing the extension of
+ * \a filename by ".solb".
+ *
+ */
+static
+int PMMG_mpiio_solName( PMMG_pParMesh parmesh,const char *filename,char **data ) {
+  char *ptr;
+
+  PMMG_CALLOC(parmesh,*data,strlen(filename)+6,char,"data",return 0);
+  strcpy(*data,filename);
+  ptr = MMG5_Get_filenameExt(*data);
+  *ptr = '\0';
+  strcat(*data,".solb");
+
+  return 1;
+}
+
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ * \param filename name of the mesh or solution file (the extension is replaced
+ * by ".solb").
+ * \param sol pointer toward an array of solutions at vertices.
+ * \param nsols number of solutions.
+ *
+ * \return 0 if fail, 1 otherwise
+ *
+ * Collectively save solutions at vertices in one shared file at the Medit
+ * binary format. Each process writes the values at the vertices that it owns.
+ *
+ */
+static
+int PMMG_saveSols_mpiio( PMMG_pParMesh parmesh,const char *filename,
+                         MMG5_pSol sol,int nsols ) {
+  MMG5_pMesh mesh;
+  MPI_File   fh;
+  MPI_Status status;
+  MPI_Offset pos[2],size,hdr;
+  double     *dbuf;
+  int        *glonum,nowned,offset,nglob,vsize,ver,ier,ieresult,ip,j,count;
+  char       *data,*buf,*ptr;
+
+  ier = ( parmesh->ngrp == 1 );
+  MPI_CHECK( MPI_Allreduce(&ier,&ieresult,1,MPI_INT,MPI_MIN,parmesh->comm),
+             return 0 );
+  if ( !ieresult ) {
+    if ( parmesh->myrank == parmesh->info.root ) {
+      fprintf(stderr,"  ## Error: %s: you must have exactly 1 group on each"
+              " process.\n",__func__);
+    }
+    return 0;
+  }
+  mesh = parmesh->listgrp[0].mesh;
+
+  /** Global numbering of the vertices */
+  glonum = NULL;
+  PMMG_CALLOC(parmesh,glonum,mesh->np+1,int,"glonum",ier = 0);
+  if ( ier ) {
+    ier = PMMG_compute_verticesGloNum(parmesh,glonum,&nowned,&offset,&nglob);
+  }
+  MPI_CHECK( MPI_Allreduce(&ier,&ieresult,1,MPI_INT,MPI_MIN,parmesh->comm),
+             ieresult = 0 );
+  if ( !ieresult ) {
+    PMMG_DEL_MEM(parmesh,glonum,int,"glonum");
+    return 0;
+  }
+
+  vsize = 0;
+  for ( j=0; j<nsols; ++j ) {
+    vsize += sol[j].size;
+  }
+
+  /** Positions of the values and of the End keyword (64 bits positions are
+   * needed above 2 GB) */
+  ver  = 2;
+  size = PMMG_mpiio_solLayout(ver,nglob,nsols,vsize,pos);
+  if ( size >= INT_MAX ) {
+    ver  = 3;
+    size = PMMG_mpiio_solLayout(ver,nglob,nsols,vsize,pos);
+  }
+  /* SolAtVertices keyword: number of vertices, of solutions and types */
+  hdr = PMMG_mpiio_kwdSize(ver) + (2+nsols)*sizeof(int);
+
+  /** Solution file name */
+  if ( !PMMG_mpiio_solName(parmesh,filename,&data) ) {
+    PMMG_DEL_MEM(parmesh,glonum,int,"glonum");
+    return 0;
+  }
+
+  ier = PMMG_mpiio_open(parmesh,data,MPI_MODE_WRONLY|MPI_MODE_CREATE,&fh);
+  PMMG_DEL_MEM(parmesh,data,char,"data");
+  if ( !ier ) {
+    PMMG_DEL_MEM(parmesh,glonum,int,"glonum");
+    return 0;
+  }
+
+  /** Header and end keyword (written by the root process) */
+  if ( parmesh->myrank == parmesh->info.root ) {
+    PMMG_MALLOC(parmesh,buf,pos[0],char,"header buffer",ier = 0);
+    if ( ier ) {
+      ptr = buf;
+      PMMG_mpiio_packInt(&ptr,1);
+      PMMG_mpiio_packInt(&ptr,ver);
+      PMMG_mpiio_packInt(&ptr,3); // Dimension
+      PMMG_mpiio_packPos(&ptr,pos[0]-hdr,ver);
+      PMMG_mpiio_packInt(&ptr,3);
+      PMMG_mpiio_packInt(&ptr,62); // SolAtVertices
+      PMMG_mpiio_packPos(&ptr,pos[1],ver);
+      PMMG_mpiio_packInt(&ptr,nglob);
+      PMMG_mpiio_packInt(&ptr,nsols);
+      for ( j=0; j<nsols; ++j ) {
+        /* Medit types: 1 scalar, 2 vector, 3 symmetric tensor */
+        PMMG_mpiio_packInt(&ptr,sol[j].size==1 ? 1 : (sol[j].size==6 ? 3 : 2));
+      }
+      MPI_CHECK( MPI_File_write_at(fh,0,buf,ptr-buf,MPI_BYTE,&status),ier = 0 );
+
+      ptr = buf;
+      PMMG_mpiio_packInt(&ptr,54); // End
+      MPI_CHECK( MPI_File_write_at(fh,pos[1],buf,ptr-buf,MPI_BYTE,&status),
+                 ier = 0 );
+    }
+    PMMG_DEL_MEM(parmesh,buf,char,"header buffer");
+  }
+
+  /** Values at the vertices owned by the process */
+  count = nowned;
+  dbuf  = NULL;
+  PMMG_MALLOC(parmesh,dbuf,MG_MAX((size_t)count*vsize,1),double,"values buffer",
+              ier = 0);
+  if ( dbuf ) {
+    for ( ip=1; ip<=mesh->np; ++ip ) {
+      if ( glonum[ip] <= offset || glonum[ip] > offset+nowned ) continue;
+      ptr = (char*)(dbuf + (size_t)(glonum[ip]-offset-1)*vsize);
+      for ( j=0; j<nsols; ++j ) {
+        memcpy(ptr,&sol[j].m[sol[j].size*ip],sol[j].size*sizeof(double));
+        if ( sol[j].size == 6 ) {
+          /* Medit stores the tensors as m11 m12 m22 m13 m23 m33 */
+          ((double*)ptr)[2] = sol[j].m[6*ip+3];
+          ((double*)ptr)[3] = sol[j].m[6*ip+2];
+        }
+        ptr += sol[j].size*sizeof(double);
+      }
+    }
+  }
+  else count = 0;
+  if ( !PMMG_mpiio_writeSlab(fh,pos[0]+(MPI_Offset)offset*vsize*sizeof(double),
+                             dbuf,count,vsize*sizeof(double)) ) ier = 0;
+  PMMG_DEL_MEM(parmesh,dbuf,double,"values buffer");
+
+  MPI_CHECK( MPI_File_close(&fh),ier = 0 );
+  PMMG_DEL_MEM(parmesh,glonum,int,"glonum");
+
+  MPI_CHECK( MPI_Allreduce(&ier,&ieresult,1,MPI_INT,MPI_MIN,parmesh->comm),
+             return 0 );
+
+  return ieresult;
+}
+
+int PMMG_saveMet_mpiio(PMMG_pParMesh parmesh,const char *filename) {
+
+  if ( parmesh->ngrp != 1 ) {
+    return PMMG_saveSols_mpiio(parmesh,filename,NULL,0);
+  }
+
+  return PMMG_saveSols_mpiio(parmesh,filename,parmesh->listgrp[0].met,1);
+}
+
+int PMMG_saveAllSols_mpiio(PMMG_pParMesh parmesh,const char *filename) {
+
+  if ( parmesh->ngrp != 1 ) {
+    return PMMG_saveSols_mpiio(parmesh,filename,NULL,0);
+  }
+
+  return PMMG_saveSols_mpiio(parmesh,filename,parmesh->listgrp[0].sol,
+                             parmesh->listgrp[0].mesh->nsols);
+}
+
+/**
+ * \param n global number of entities.
+ * \param nprocs number of processes.
+ * \param rank rank of the process.
+ *
+ * \return the index (starting from 0) of the first entity of the slab read by
+ * the process \a rank.
+ *
+ * The entities of a section are split in \a nprocs contiguous slabs of almost
+ * the same size.
+ *
+ */
+static inline
+MPI_Offset PMMG_mpiio_slabBeg( MPI_Offset n,int nprocs,int rank ) {
+  return n*rank/nprocs;
+}
+
+/**
+ * \param n global number of entities.
+ * \param nprocs number of processes.
+ * \param i index of the entity (starting from 0).
+ *
+ * \return the rank of the process that reads the entity \a i.
+ *
+ */
+static inline
+int PMMG_mpiio_slabOwner( MPI_Offset n,int nprocs,MPI_Offset i ) {
+  return (int)((nprocs*(i+1)-1)/n);
+}
+
+/**
+ * \param buf pointer toward the values in the file.
+ * \param csize size of the values in the file (4 for simple precision, 8 for
+ * double precision).
+ * \param n number of values.
+ * \param val array of values (filled).
+ *
+ * Convert the real values of a file into double precision values.
+ *
+ */
+static inline
+void PMMG_mpiio_unpackReals( const char *buf,int csize,int n,double *val ) {
+  float fval;
+  int   i;
+
+  for ( i=0; i<n; ++i ) {
+    if ( csize == sizeof(float) ) {
+      memcpy(&fval,buf,sizeof(float));
+      val[i] = fval;
+    }
+    else {
+      memcpy(&val[i],buf,sizeof(double));
+    }
+    buf += csize;
+  }
+}
+
+/**
+ * \param a pointer toward an integer.
+ * \param b pointer toward an integer.
+ *
+ * Compare 2 integers (can be used inside the qsort C function).
+ *
+ */
+static
+int PMMG_mpiio_compareInt( const void *a,const void *b ) {
+  int ia,ib;
+
+  ia = *(int*)a;
+  ib = *(int*)b;
+
+  return ( ia > ib ) - ( ia < ib );
+}
+
+/**
+ * \param a pointer toward a pair of integers.
+ * \param b pointer toward a pair of integers.
+ *
+ * Compare 2 pairs of integers on the second value, then on the first one
+ * (can be used inside the qsort C function).
+ *
+ */
+static
+int PMMG_mpiio_comparePair( const void *a,const void *b ) {
+  const int *pa,*pb;
+
+  pa = (const int*)a;
+  pb = (const int*)b;
+
+  if ( pa[1] != pb[1] ) return ( pa[1] > pb[1] ) - ( pa[1] < pb[1] );
+
+  return ( pa[0] > pb[0] ) - ( pa[0] < pb[0] );
+}
+
+/**
+ * \param a pointer toward a face (3 sorted vertices).
+ * \param b pointer toward a face (3 sorted vertices).
+ *
+ * Compare 2 faces (can be used inside the qsort C function).
+ *
+ */
+static
+int PMMG_mpiio_compareFace( const void *a,const void *b ) {
+  const int *fa,*fb;
+  int       i;
+
+  fa = (const int*)a;
+  fb = (const int*)b;
+
+  for ( i=0; i<3; ++i ) {
+    if ( fa[i] != fb[i] ) return ( fa[i] > fb[i] ) - ( fa[i] < fb[i] );
+  }
+  return 0;
+}
+
+/**
+ * \param v array of 3 vertices (sorted).
+ *
+ * Sort the 3 vertices of a face.
+ *
+ */
+static inline
+void PMMG_mpiio_sortFace( int *v ) {
+  int tmp;
+
+  if ( v[0] > v[1] ) { tmp = v[0]; v[0] = v[1]; v[1] = tmp; }
+  if ( v[1] > v[2] ) { tmp = v[1]; v[1] = v[2]; v[2] = tmp; }
+  if ( v[0] > v[1] ) { tmp = v[0]; v[0] = v[1]; v[1] = tmp; }
+}
+
+/**
+ * \param filename name of the file.
+ * \param kwd array of the keywords to find.
+ * \param nkwd number of keywords to find.
+ * \param ver version of the file (filled).
+ * \param nent number of entities of each keyword (filled, 0 if the keyword is
+ * not found).
+ * \param pos position of the data of each keyword (filled).
+ * \param typ type of the solution for the SolAtVertices keyword (filled).
+ *
+ * \return -1 if the file can't be opened, 0 if fail, 1 otherwise.
+ *
+ * Scan the keywords of a file at Medit binary format and store the positions of
+ * the wanted ones (only one solution is accepted for the SolAtVertices
+ * keyword).
+ *
+ */
+static
+int PMMG_mpiio_scanFile( const char *filename,int *kwd,int nkwd,int *ver,
+                         MPI_Offset *nent,MPI_Offset *pos,int *typ ) {
+  FILE    *inm;
+  int64_t lpos;
+  int     code,kw,ipos,val,n,k,ier;
+
+  inm = fopen(filename,"rb");
+  if ( !inm ) return -1;
+  fprintf(stdout,"  %%%% %s OPENED\n",filename);
+
+  for ( k=0; k<nkwd; ++k ) {
+    nent[k] = pos[k] = 0;
+  }
+
+  ier = 1;
+  if ( fread(&code,sizeof(int),1,inm) != 1 || fread(ver,sizeof(int),1,inm) != 1 ) {
+    fprintf(stderr,"\n  ## Error: %s: unable to read the header of %s.\n",
+            __func__,filename);
+    ier = 0;
+  }
+  else if ( code != 1 ) {
+    fprintf(stderr,"\n  ## Error: %s: %s is not a binary file or has a"
+            " different endianness.\n",__func__,filename);
+    ier = 0;
+  }
+  else if ( *ver < 1 || *ver > 3 ) {
+    fprintf(stderr,"\n  ## Error: %s: version %d of the Medit format not"
+            " supported.\n",__func__,*ver);
+    ier = 0;
+  }
+
+  while ( ier && fread(&kw,sizeof(int),1,inm) == 1 && kw != 54 ) { // End
+    if ( *ver < 3 ) {
+      if ( fread(&ipos,sizeof(int),1,inm) != 1 ) { ier = 0; break; }
+      lpos = ipos;
+    }
+    else if ( fread(&lpos,sizeof(int64_t),1,inm) != 1 ) { ier = 0; break; }
+
+    if ( kw == 3 ) { // Dimension
+      if ( fread(&val,sizeof(int),1,inm) != 1 || val != 3 ) {
+        fprintf(stderr,"\n  ## Error: %s: only 3D files are supported.\n",
+                __func__);
+        ier = 0;
+        break;
+      }
+    }
+
+    for ( k=0; k<nkwd; ++k ) {
+      if ( kw != kwd[k] ) continue;
+
+      if ( fread(&n,sizeof(int),1,inm) != 1 ) { ier = 0; break; }
+      nent[k] = n;
+
+      if ( kw == 62 ) { // SolAtVertices
+        if ( fread(&val,sizeof(int),1,inm) != 1 || val != 1 ||
+             fread(typ,sizeof(int),1,inm) != 1 ) {
+          fprintf(stderr,"\n  ## Error: %s: only one solution is allowed in"
+                  " %s.\n",__func__,filename);
+          ier = 0;
+          break;
+        }
+      }
+      pos[k] = (MPI_Offset)ftell(inm);
+    }
+
+    if ( !lpos ) break;
+    if ( fseek(inm,lpos,SEEK_SET) ) ier = 0;
+  }
+  fclose(inm);
+
+  return ier;
+}
+
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ * \param filename name of the mesh file.
+ * \param metname name of the metric file (its extension is replaced by
+ * ".solb"), NULL if no metric.
+ * \param hdr header of the files (filled): version, number of vertices and
+ * position of the vertices, number of triangles and position of the triangles,
+ * number of tetrahedra and position of the tetrahedra, then version (0 if no
+ * metric), number of values, position of the values and size of the metric.
+ *
+ * \return 0 if fail, 1 otherwise
+ *
+ * Read the headers of the mesh and metric files on the root process and
+ * broadcast them. The metric is facultative: if the file is not found, the mesh
+ * is read without metric.
+ *
+ */
+static
+int PMMG_mpiio_readHeaders( PMMG_pParMesh parmesh,const char *filename,
+                            const char *metname,MPI_Offset *hdr ) {
+  MPI_Offset nent[3],pos[3];
+  int        kwd[3],ver,typ,ier,k;
+  char       *data;
+
+  for ( k=0; k<PMMG_MPIIO_NHDR; ++k ) {
+    hdr[k] = 0;
+  }
+
+  ier = 1;
+  if ( parmesh->myrank == parmesh->info.root ) {
+    kwd[0] = 4; // Vertices
+    kwd[1] = 6; // Triangles
+    kwd[2] = 8; // Tetrahedra
+    ier = PMMG_mpiio_scanFile(filename,kwd,3,&ver,nent,pos,&typ);
+    if ( ier < 0 ) {
+      fprintf(stderr,"  ** %s  NOT FOUND.\n",filename);
+      ier = 0;
+    }
+    else if ( ier ) {
+      hdr[0] = ver;
+      for ( k=0; k<3; ++k ) {
+        hdr[2*k+1] = nent[k];
+        hdr[2*k+2] = pos[k];
+      }
+      if ( !hdr[1] || !hdr[5] ) {
+        fprintf(stderr,"\n  ## Error: %s: no vertices or no tetrahedra in %s.\n",
+                __func__,filename);
+        ier = 0;
+      }
+    }
+
+    if ( ier && metname ) {
+      if ( !PMMG_mpiio_solName(parmesh,metname,&data) ) {
+        ier = 0;
+      }
+      else {
+        kwd[0] = 62; // SolAtVertices
+        k = PMMG_mpiio_scanFile(data,kwd,1,&ver,nent,pos,&typ);
+        if ( k < 0 ) {
+          if ( parmesh->info.imprim > PMMG_VERB_VERSION ) {
+            fprintf(stdout,"  ** %s  NOT FOUND. USE DEFAULT METRIC.\n",data);
+          }
+        }
+        else if ( !k ) {
+          ier = 0;
+        }
+        else if ( nent[0] != hdr[1] || ( typ != 1 && typ != 3 ) ) {
+          fprintf(stderr,"\n  ## Error: %s: %s must contain one scalar or"
+                  " tensor metric at the %" PRId64 " vertices.\n",__func__,data,
+                  (int64_t)hdr[1]);
+          ier = 0;
+        }
+        else {
+          hdr[7]  = ver;
+          hdr[8]  = nent[0];
+          hdr[9]  = pos[0];
+          hdr[10] = ( typ == 1 ) ? 1 : 6;
+        }
+        PMMG_DEL_MEM(parmesh,data,char,"data");
+      }
+    }
+  }
+
+  MPI_CHECK( MPI_Bcast(&ier,1,MPI_INT,parmesh->info.root,parmesh->comm),
+             return 0 );
+  if ( !ier ) return 0;
+
+  MPI_CHECK( MPI_Bcast(hdr,PMMG_MPIIO_NHDR,MPI_OFFSET,parmesh->info.root,
+                       parmesh->comm),return 0 );
+
+  return 1;
+}
+
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ * \param fh MPI file handle.
+ * \param pos position of the first entity of the section.
+ * \param n global number of entities of the section.
+ * \param rsize size of an entity in the file.
+ * \param buf pointer toward the slab (allocated and filled).
+ * \param nloc number of entities of the slab (filled).
+ *
+ * \return 0 if fail, 1 otherwise
+ *
+ * Collectively read the slab of a section that is assigned to the process.
+ * The returned status is the same on all the processes.
+ *
+ */
+static
+int PMMG_mpiio_readSlab( PMMG_pParMesh parmesh,MPI_File fh,MPI_Offset pos,
+                         MPI_Offset n,int rsize,char **buf,int *nloc ) {
+  MPI_Datatype type;
+  MPI_Status   status;
+  MPI_Offset   beg;
+  int          ier,ieresult;
+
+  beg   = PMMG_mpiio_slabBeg(n,parmesh->nprocs,parmesh->myrank);
+  *nloc = (int)(PMMG_mpiio_slabBeg(n,parmesh->nprocs,parmesh->myrank+1) - beg);
+
+  ier  = 1;
+  *buf = NULL;
+  PMMG_MALLOC(parmesh,*buf,(size_t)(*nloc)*rsize,char,"slab",ier = 0);
+  MPI_CHECK( MPI_Allreduce(&ier,&ieresult,1,MPI_INT,MPI_MIN,parmesh->comm),
+             ieresult = 0 );
+  if ( !ieresult ) {
+    PMMG_DEL_MEM(parmesh,*buf,char,"slab");
+    return 0;
+  }
+
+  MPI_Type_contiguous(rsize,MPI_BYTE,&type);
+  MPI_Type_commit(&type);
+  MPI_CHECK( MPI_File_read_at_all(fh,pos+beg*rsize,*buf,*nloc,type,&status),
+             ier = 0 );
+  MPI_Type_free(&type);
+
+  MPI_CHECK( MPI_Allreduce(&ier,&ieresult,1,MPI_INT,MPI_MIN,parmesh->comm),
+             ieresult = 0 );
+  if ( !ieresult ) {
+    PMMG_DEL_MEM(parmesh,*buf,char,"slab");
+  }
+
+  return ieresult;
+}
+
+/**
+ * \param nprocs number of processes.
+ * \param count number of items for each process.
+ * \param displ displacement of the items of each process (filled).
+ *
+ * \return the total number of items.
+ *
+ */
+static inline
+int PMMG_mpiio_displs( int nprocs,const int *count,int *displ ) {
+  int k;
+
+  displ[0] = 0;
+  for ( k=1; k<nprocs; ++k ) {
+    displ[k] = displ[k-1] + count[k-1];
+  }
+  return displ[nprocs-1] + count[nprocs-1];
+}
+
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ * \param sbuf items to send, sorted by destination.
+ * \param scount number of items to send to each process.
+ * \param rsize size of an item.
+ * \param rbuf pointer toward the received items (allocated and filled).
+ * \param rcount number of items received from each process (filled).
+ * \param nrecv total number of received items (filled).
+ *
+ * \return 0 if fail, 1 otherwise
+ *
+ * Send items of fixed size to any process (all to all exchange).
+ *
+ */
+static
+int PMMG_mpiio_exchange( PMMG_pParMesh parmesh,void *sbuf,int *scount,
+                         int rsize,void **rbuf,int *rcount,int *nrecv ) {
+  MPI_Datatype type;
+  int          *sdispl,*rdispl,ier,ieresult;
+  char         *buf;
+
+  sdispl = rdispl = NULL;
+  buf    = NULL;
+  *nrecv = 0;
+
+  ier = 1;
+  PMMG_MALLOC(parmesh,sdispl,parmesh->nprocs,int,"sdispl",ier = 0);
+  PMMG_MALLOC(parmesh,rdispl,parmesh->nprocs,int,"rdispl",ier = 0);
+
+  MPI_CHECK( MPI_Alltoall(scount,1,MPI_INT,rcount,1,MPI_INT,parmesh->comm),
+             ier = 0 );
+
+  if ( ier ) {
+    PMMG_mpiio_displs(parmesh->nprocs,scount,sdispl);
+    *nrecv = PMMG_mpiio_displs(parmesh->nprocs,rcount,rdispl);
+    PMMG_MALLOC(parmesh,buf,(size_t)(*nrecv)*rsize,char,"receive buffer",ier = 0);
+  }
+
+  MPI_CHECK( MPI_Allreduce(&ier,&ieresult,1,MPI_INT,MPI_MIN,parmesh->comm),
+             ieresult = 0 );
+
+  if ( ieresult ) {
+    MPI_Type_contiguous(rsize,MPI_BYTE,&type);
+    MPI_Type_commit(&type);
+    MPI_CHECK( MPI_Alltoallv(sbuf,scount,sdispl,type,buf,rcount,rdispl,type,
+                             parmesh->comm),ieresult = 0 );
+    MPI_Type_free(&type);
+  }
+
+  PMMG_DEL_MEM(parmesh,rdispl,int,"rdispl");
+  PMMG_DEL_MEM(parmesh,sdispl,int,"sdispl");
+
+  if ( !ieresult ) {
+    PMMG_DEL_MEM(parmesh,buf,char,"receive buffer");
+  }
+  *rbuf = buf;
+
+  return ieresult;
+}
+
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ * \param ne global number of tetrahedra.
+ * \param tetra pointer toward the tetrahedra of the process (4 global vertices
+ * and a reference per tetra, updated).
+ * \param nel number of tetrahedra of the process (updated).
+ *
+ * \return 0 if fail, 1 otherwise
+ *
+ * Partition the tetrahedra read by slabs and send them to their owner. The
+ * partition is computed by ParMetis if available, otherwise each process keeps
+ * its slab (the load balancing of the remeshing loop improves it later).
+ *
+ */
+static
+int PMMG_mpiio_migrateTetra( PMMG_pParMesh parmesh,MPI_Offset ne,int **tetra,
+                             int *nel ) {
+#ifdef USE_PARMETIS
+  real_t *tpwgts,ubvec;
+  idx_t  *elmdist,*eptr,*eind,*ipart,wgtflag,numflag,ncon,ncommonnodes;
+  idx_t  nparts,edgecut,options[3];
+#endif
+  int    *part,*scount,*rcount,*cur,*sbuf,nrecv,k,ier,ieresult;
+  void   *rbuf;
+
+  part = scount = rcount = cur = sbuf = NULL;
+
+  ier = 1;
+  PMMG_MALLOC(parmesh,part,*nel,int,"part",ier = 0);
+
+#ifdef USE_PARMETIS
+  /** Partition of the dual graph of the mesh (elements sharing a face) */
+  elmdist = eptr = eind = ipart = NULL;
+  tpwgts  = NULL;
+  PMMG_MALLOC(parmesh,elmdist,parmesh->nprocs+1,idx_t,"elmdist",ier = 0);
+  PMMG_MALLOC(parmesh,eptr,*nel+1,idx_t,"eptr",ier = 0);
+  PMMG_MALLOC(parmesh,eind,4*(*nel),idx_t,"eind",ier = 0);
+  PMMG_MALLOC(parmesh,ipart,MG_MAX(*nel,1),idx_t,"ipart",ier = 0);
+  PMMG_MALLOC(parmesh,tpwgts,parmesh->nprocs,real_t,"tpwgts",ier = 0);
+
+  if ( ier ) {
+    for ( k=0; k<=parmesh->nprocs; ++k ) {
+      elmdist[k] = PMMG_mpiio_slabBeg(ne,parmesh->nprocs,k);
+    }
+    for ( k=0; k<*nel; ++k ) {
+      eptr[k]      = 4*k;
+      eind[4*k]    = (*tetra)[5*k]-1;
+      eind[4*k+1]  = (*tetra)[5*k+1]-1;
+      eind[4*k+2]  = (*tetra)[5*k+2]-1;
+      eind[4*k+3]  = (*tetra)[5*k+3]-1;
+    }
+    eptr[*nel] = 4*(*nel);
+    for ( k=0; k<parmesh->nprocs; ++k ) {
+      tpwgts[k] = 1./(real_t)parmesh->nprocs;
+    }
+  }
+
+  MPI_CHECK( MPI_Allreduce(&ier,&ieresult,1,MPI_INT,MPI_MIN,parmesh->comm),
+             ieresult = 0 );
+
+  if ( ieresult && parmesh->nprocs > 1 ) {
+    wgtflag      = PMMG_WGTFLAG_NONE;
+    numflag      = 0;
+    ncon         = 1;
+    ncommonnodes = 3;
+    nparts       = parmesh->nprocs;
+    ubvec        = PMMG_UBVEC_DEF;
+    options[0]   = 0;
+    if ( ParMETIS_V3_PartMeshKway(elmdist,eptr,eind,NULL,&wgtflag,&numflag,
+                                  &ncon,&ncommonnodes,&nparts,tpwgts,&ubvec,
+                                  options,&edgecut,ipart,&parmesh->comm)
+         != METIS_OK ) {
+      fprintf(stderr,"\n  ## Error: Parmetis fails.\n" );
+      ier = 0;
+    }
+    for ( k=0; k<*nel; ++k ) {
+      part[k] = ier ? (int)ipart[k] : parmesh->myrank;
+    }
+  }
+  else if ( ier ) {
+    for ( k=0; k<*nel; ++k ) {
+      part[k] = parmesh->myrank;
+    }
+  }
+
+  PMMG_DEL_MEM(parmesh,tpwgts,real_t,"tpwgts");
+  PMMG_DEL_MEM(parmesh,ipart,idx_t,"ipart");
+  PMMG_DEL_MEM(parmesh,eind,idx_t,"eind");
+  PMMG_DEL_MEM(parmesh,eptr,idx_t,"eptr");
+  PMMG_DEL_MEM(parmesh,elmdist,idx_t,"elmdist");
+#else
+  if ( ier ) {
+    for ( k=0; k<*nel; ++k ) {
+      part[k] = parmesh->myrank;
+    }
+  }
+#endif
+
+  /** Send the tetrahedra to their owner */
+  PMMG_CALLOC(parmesh,scount,parmesh->nprocs,int,"scount",ier = 0);
+  PMMG_CALLOC(parmesh,rcount,parmesh->nprocs,int,"rcount",ier = 0);
+  PMMG_MALLOC(parmesh,cur,parmesh->nprocs,int,"cur",ier = 0);
+  PMMG_MALLOC(parmesh,sbuf,5*(*nel),int,"sbuf",ier = 0);
+
+  MPI_CHECK( MPI_Allreduce(&ier,&ieresult,1,MPI_INT,MPI_MIN,parmesh->comm),
+             ieresult = 0 );
+
+  if ( ieresult ) {
+    for ( k=0; k<*nel; ++k ) {
+      ++scount[part[k]];
+    }
+    PMMG_mpiio_displs(parmesh->nprocs,scount,cur);
+    for ( k=0; k<*nel; ++k ) {
+      memcpy(&sbuf[5*cur[part[k]]++],&(*tetra)[5*k],5*sizeof(int));
+    }
+    ieresult = PMMG_mpiio_exchange(parmesh,sbuf,scount,5*sizeof(int),&rbuf,
+                                   rcount,&nrecv);
+  }
+
+  PMMG_DEL_MEM(parmesh,sbuf,int,"sbuf");
+  PMMG_DEL_MEM(parmesh,cur,int,"cur");
+  PMMG_DEL_MEM(parmesh,rcount,int,"rcount");
+  PMMG_DEL_MEM(parmesh,scount,int,"scount");
+  PMMG_DEL_MEM(parmesh,part,int,"part");
+
+  if ( !ieresult ) return 0;
+
+  PMMG_DEL_MEM(parmesh,*tetra,int,"tetra");
+  *tetra = (int*)rbuf;
+  *nel   = nrecv;
+
+  return 1;
+}
+
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ * \param fh MPI file handle of the mesh file.
+ * \param fhm MPI file handle of the metric file.
+ * \param hdr header of the files.
+ * \param gids sorted global indices of the vertices of the process.
+ * \param np number of vertices of the process.
+ * \param vals pointer toward the coordinates, reference and metric of the
+ * vertices of the process (allocated and filled).
+ * \param uidx pointer toward the position of the first user of each vertex of
+ * the slab read by the process (allocated and filled).
+ * \param users pointer toward the ranks that use the vertices of the slab
+ * (allocated and filled).
+ * \param pairs pointer toward the pairs (global vertex, rank of another
+ * process using the vertex) of the shared vertices of the process (allocated
+ * and filled).
+ * \param npairs number of pairs (filled).
+ *
+ * \return 0 if fail, 1 otherwise
+ *
+ * Each process requests its vertices to the processes that read them. The
+ * vertices (and metrics) are read by slabs and sent back, with the list of
+ * the other processes using them.
+ *
+ */
+static
+int PMMG_mpiio_fetchVertices( PMMG_pParMesh parmesh,MPI_File fh,MPI_File fhm,
+                              MPI_Offset *hdr,int *gids,int np,double **vals,
+                              int **uidx,int **users,int **pairs,int *npairs ) {
+  MPI_Offset beg;
+  double     *sval,*dptr,swp;
+  int        *scount,*rcount,*cur,*req,*spairs,nreq,nv,nrecv,msize,csize,mcsize;
+  int        vsize,nval,ref,s,i,j,k,l,m,n,ier,ieresult,ret;
+  char       *vbuf,*mbuf,*ptr;
+  void       *rbuf;
+
+  scount = rcount = cur = req = spairs = NULL;
+  sval   = NULL;
+  vbuf   = mbuf = NULL;
+  *vals  = NULL;
+  *uidx  = *users = *pairs = NULL;
+  ret    = 0;
+
+  csize  = ( hdr[0] == 1 ) ? sizeof(float) : sizeof(double);
+  vsize  = 3*csize + sizeof(int);
+  msize  = hdr[7] ? (int)hdr[10] : 0;
+  mcsize = ( hdr[7] == 1 ) ? sizeof(float) : sizeof(double);
+  nval   = 4 + msize;
+
+  /** Send the requests to the processes that read the vertices (the global
+   * indices are sorted so the requests are sorted by destination) */
+  ier = 1;
+  PMMG_CALLOC(parmesh,scount,parmesh->nprocs,int,"scount",ier = 0);
+  PMMG_CALLOC(parmesh,rcount,parmesh->nprocs,int,"rcount",ier = 0);
+  MPI_CHECK( MPI_Allreduce(&ier,&ieresult,1,MPI_INT,MPI_MIN,parmesh->comm),
+             ieresult = 0 );
+  if ( !ieresult ) goto end;
+
+  for ( k=0; k<np; ++k ) {
+    ++scount[PMMG_mpiio_slabOwner(hdr[1],parmesh->nprocs,gids[k]-1)];
+  }
+  if ( !PMMG_mpiio_exchange(parmesh,gids,scount,sizeof(int),&rbuf,rcount,&nreq) )
+    goto end;
+  req = (int*)rbuf;
+
+  /** Read the slabs of vertices and metrics */
+  beg = PMMG_mpiio_slabBeg(hdr[1],parmesh->nprocs,parmesh->myrank);
+  if ( !PMMG_mpiio_readSlab(parmesh,fh,hdr[2],hdr[1],vsize,&vbuf,&nv) )
+    goto end;
+  if ( msize &&
+       !PMMG_mpiio_readSlab(parmesh,fhm,hdr[9],hdr[8],msize*mcsize,&mbuf,&nv) )
+    goto end;
+
+  /** Store the users of each vertex of the slab and answer the requests */
+  PMMG_CALLOC(parmesh,*uidx,nv+1,int,"uidx",ier = 0);
+  PMMG_MALLOC(parmesh,*users,nreq,int,"users",ier = 0);
+  PMMG_MALLOC(parmesh,cur,MG_MAX(nv,parmesh->nprocs),int,"cur",ier = 0);
+  PMMG_MALLOC(parmesh,sval,(size_t)nreq*nval,double,"sval",ier = 0);
+  MPI_CHECK( MPI_Allreduce(&ier,&ieresult,1,MPI_INT,MPI_MIN,parmesh->comm),
+             ieresult = 0 );
+  if ( !ieresult ) goto end;
+
+  for ( k=0; k<nreq; ++k ) {
+    ++(*uidx)[req[k]-beg];
+  }
+  for ( i=0; i<nv; ++i ) {
+    (*uidx)[i+1] += (*uidx)[i];
+    cur[i] = (*uidx)[i];
+  }
+
+  k = 0;
+  for ( s=0; s<parmesh->nprocs; ++s ) {
+    for ( j=0; j<rcount[s]; ++j,++k ) {
+      i = req[k]-1-beg;
+      (*users)[cur[i]++] = s;
+
+      dptr = &sval[(size_t)k*nval];
+      ptr  = vbuf + (size_t)i*vsize;
+      PMMG_mpiio_unpackReals(ptr,csize,3,dptr);
+      memcpy(&ref,ptr+3*csize,sizeof(int));
+      dptr[3] = ref;
+
+      if ( msize ) {
+        PMMG_mpiio_unpackReals(mbuf+(size_t)i*msize*mcsize,mcsize,msize,dptr+4);
+        if ( msize == 6 ) {
+          /* Medit stores the tensors as m11 m12 m22 m13 m23 m33 */
+          swp     = dptr[6];
+          dptr[6] = dptr[7];
+          dptr[7] = swp;
+        }
+      }
+    }
+  }
+
+  /** Send the vertices back to the processes that requested them (they are
+   * received in the order of the requests) */
+  if ( !PMMG_mpiio_exchange(parmesh,sval,rcount,nval*sizeof(double),&rbuf,
+                            scount,&nrecv) )
+    goto end;
+  *vals = (double*)rbuf;
+  ier   = ( nrecv == np );
+  if ( !ier ) {
+    fprintf(stderr,"\n  ## Error: %s: %d vertices received instead of %d.\n",
+            __func__,nrecv,np);
+  }
+  MPI_CHECK( MPI_Allreduce(&ier,&ieresult,1,MPI_INT,MPI_MIN,parmesh->comm),
+             ieresult = 0 );
+  if ( !ieresult ) goto end;
+
+  /** Send to each user of a shared vertex the other processes that use it */
+  memset(scount,0,parmesh->nprocs*sizeof(int));
+  for ( i=0; i<nv; ++i ) {
+    n = (*uidx)[i+1]-(*uidx)[i];
+    if ( n < 2 ) continue;
+    for ( l=(*uidx)[i]; l<(*uidx)[i+1]; ++l ) {
+      scount[(*users)[l]] += n-1;
+    }
+  }
+  n = PMMG_mpiio_displs(parmesh->nprocs,scount,cur);
+
+  PMMG_MALLOC(parmesh,spairs,2*n,int,"spairs",ier = 0);
+  MPI_CHECK( MPI_Allreduce(&ier,&ieresult,1,MPI_INT,MPI_MIN,parmesh->comm),
+             ieresult = 0 );
+  if ( !ieresult ) goto end;
+
+  for ( i=0; i<nv; ++i ) {
+    if ( (*uidx)[i+1]-(*uidx)[i] < 2 ) continue;
+    for ( l=(*uidx)[i]; l<(*uidx)[i+1]; ++l ) {
+      for ( m=(*uidx)[i]; m<(*uidx)[i+1]; ++m ) {
+        if ( m == l ) continue;
+        k = cur[(*users)[l]]++;
+        spairs[2*k]   = beg+i+1;
+        spairs[2*k+1] = (*users)[m];
+      }
+    }
+  }
+  if ( !PMMG_mpiio_exchange(parmesh,spairs,scount,2*sizeof(int),&rbuf,rcount,
+                            npairs) )
+    goto end;
+  *pairs = (int*)rbuf;
+
+  ret = 1;
+
+end:
+  PMMG_DEL_MEM(parmesh,spairs,int,"spairs");
+  PMMG_DEL_MEM(parmesh,sval,double,"sval");
+  PMMG_DEL_MEM(parmesh,cur,int,"cur");
+  PMMG_DEL_MEM(parmesh,mbuf,char,"slab");
+  PMMG_DEL_MEM(parmesh,vbuf,char,"slab");
+  PMMG_DEL_MEM(parmesh,req,int,"req");
+  PMMG_DEL_MEM(parmesh,rcount,int,"rcount");
+  PMMG_DEL_MEM(parmesh,scount,int,"scount");
+
+  if ( !ret ) {
+    PMMG_DEL_MEM(parmesh,*pairs,int,"pairs");
+    PMMG_DEL_MEM(parmesh,*users,int,"users");
+    PMMG_DEL_MEM(parmesh,*uidx,int,"uidx");
+    PMMG_DEL_MEM(parmesh,*vals,double,"vals");
+  }
+
+  return ret;
+}
+
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ * \param npg global number of vertices.
+ * \param tetra tetrahedra of the process.
+ * \param nel number of tetrahedra of the process.
+ * \param gids pointer toward the sorted global indices of the vertices of the
+ * process (allocated and filled).
+ * \param np number of vertices of the process (filled).
+ *
+ * \return 0 if fail, 1 otherwise
+ *
+ * List the global indices of the vertices used by the tetrahedra of the
+ * process.
+ *
+ */
+static
+int PMMG_mpiio_localVertices( PMMG_pParMesh parmesh,MPI_Offset npg,int *tetra,
+                              int nel,int **gids,int *np ) {
+  int k,i;
+
+  PMMG_MALLOC(parmesh,*gids,4*nel,int,"gids",return 0);
+
+  for ( k=0; k<nel; ++k ) {
+    for ( i=0; i<4; ++i ) {
+      if ( tetra[5*k+i] < 1 || tetra[5*k+i] > npg ) {
+        fprintf(stderr,"\n  ## Error: %s: wrong vertex index %d in tetra.\n",
+                __func__,tetra[5*k+i]);
+        PMMG_DEL_MEM(parmesh,*gids,int,"gids");
+        return 0;
+      }
+      (*gids)[4*k+i] = tetra[5*k+i];
+    }
+  }
+
+  qsort(*gids,4*nel,sizeof(int),PMMG_mpiio_compareInt);
+
+  *np = 0;
+  for ( k=0; k<4*nel; ++k ) {
+    if ( *np && (*gids)[*np-1] == (*gids)[k] ) continue;
+    (*gids)[(*np)++] = (*gids)[k];
+  }
+  PMMG_REALLOC(parmesh,*gids,*np,4*nel,int,"gids",return 0);
+
+  return 1;
+}
+
+/**
+ * \param gids sorted global indices of the vertices of the process.
+ * \param np number of vertices of the process.
+ * \param g global index of a vertex of the process.
+ *
+ * \return the local index of the vertex.
+ *
+ */
+static inline
+int PMMG_mpiio_localIdx( int *gids,int np,int g ) {
+  int *pg;
+
+  pg = (int*)bsearch(&g,gids,np,sizeof(int),PMMG_mpiio_compareInt);
+  assert ( pg );
+
+  return (int)(pg-gids) + 1;
+}
+
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ * \param fh MPI file handle of the mesh file.
+ * \param hdr header of the mesh file.
+ * \param uidx position of the first user of each vertex of the slab read by
+ * the process.
+ * \param users ranks that use the vertices of the slab.
+ * \param tria pointer toward the candidate triangles of the process (3 global
+ * vertices and a reference per triangle, allocated and filled).
+ * \param nt number of candidate triangles (filled).
+ *
+ * \return 0 if fail, 1 otherwise
+ *
+ * Read the triangles by slabs and send them to the processes that use their
+ * first vertex, through the process that reads this vertex.
+ *
+ */
+static
+int PMMG_mpiio_fetchTria( PMMG_pParMesh parmesh,MPI_File fh,MPI_Offset *hdr,
+                          int *uidx,int *users,int **tria,int *nt ) {
+  MPI_Offset beg;
+  int        *slab,*scount,*rcount,*cur,*sbuf,*rtria,nloc,nrt,n,i,k,l;
+  int        ier,ieresult,ret;
+  char       *buf;
+  void       *rbuf;
+
+  scount = rcount = cur = sbuf = rtria = NULL;
+  *tria  = NULL;
+  *nt    = 0;
+  ret    = 0;
+
+  if ( !PMMG_mpiio_readSlab(parmesh,fh,hdr[4],hdr[3],PMMG_MPIIO_TRIASIZE,
+                            &buf,&nloc) )
+    return 0;
+  slab = (int*)buf;
+
+  ier = 1;
+  PMMG_CALLOC(parmesh,scount,parmesh->nprocs,int,"scount",ier = 0);
+  PMMG_CALLOC(parmesh,rcount,parmesh->nprocs,int,"rcount",ier = 0);
+  PMMG_MALLOC(parmesh,cur,parmesh->nprocs,int,"cur",ier = 0);
+  PMMG_MALLOC(parmesh,sbuf,4*nloc,int,"sbuf",ier = 0);
+
+  for ( k=0; k<nloc; ++k ) {
+    for ( i=0; i<3; ++i ) {
+      if ( slab[4*k+i] < 1 || slab[4*k+i] > hdr[1] ) {
+        fprintf(stderr,"\n  ## Error: %s: wrong vertex index %d in triangle.\n",
+                __func__,slab[4*k+i]);
+        ier = 0;
+        break;
+      }
+    }
+    if ( !ier ) break;
+  }
+
+  MPI_CHECK( MPI_Allreduce(&ier,&ieresult,1,MPI_INT,MPI_MIN,parmesh->comm),
+             ieresult = 0 );
+  if ( !ieresult ) goto end;
+
+  /** Send each triangle to the process that reads its first vertex */
+  for ( k=0; k<nloc; ++k ) {
+    ++scount[PMMG_mpiio_slabOwner(hdr[1],parmesh->nprocs,slab[4*k]-1)];
+  }
+  PMMG_mpiio_displs(parmesh->nprocs,scount,cur);
+  for ( k=0; k<nloc; ++k ) {
+    i = PMMG_mpiio_slabOwner(hdr[1],parmesh->nprocs,slab[4*k]-1);
+    memcpy(&sbuf[4*cur[i]++],&slab[4*k],4*sizeof(int));
+  }
+  if ( !PMMG_mpiio_exchange(parmesh,sbuf,scount,4*sizeof(int),&rbuf,rcount,&nrt) )
+    goto end;
+  rtria = (int*)rbuf;
+  PMMG_DEL_MEM(parmesh,sbuf,int,"sbuf");
+
+  /** Forward each triangle to the users of its first vertex */
+  beg = PMMG_mpiio_slabBeg(hdr[1],parmesh->nprocs,parmesh->myrank);
+
+  memset(scount,0,parmesh->nprocs*sizeof(int));
+  for ( k=0; k<nrt; ++k ) {
+    i = rtria[4*k]-1-beg;
+    for ( l=uidx[i]; l<uidx[i+1]; ++l ) {
+      ++scount[users[l]];
+    }
+  }
+  n = PMMG_mpiio_displs(parmesh->nprocs,scount,cur);
+
+  ier = 1;
+  PMMG_MALLOC(parmesh,sbuf,4*n,int,"sbuf",ier = 0);
+  MPI_CHECK( MPI_Allreduce(&ier,&ieresult,1,MPI_INT,MPI_MIN,parmesh->comm),
+             ieresult = 0 );
+  if ( !ieresult ) goto end;
+
+  for ( k=0; k<nrt; ++k ) {
+    i = rtria[4*k]-1-beg;
+    for ( l=uidx[i]; l<uidx[i+1]; ++l ) {
+      memcpy(&sbuf[4*cur[users[l]]++],&rtria[4*k],4*sizeof(int));
+    }
+  }
+  if ( !PMMG_mpiio_exchange(parmesh,sbuf,scount,4*sizeof(int),&rbuf,rcount,nt) )
+    goto end;
+  *tria = (int*)rbuf;
+
+  ret = 1;
+
+end:
+  PMMG_DEL_MEM(parmesh,rtria,int,"rtria");
+  PMMG_DEL_MEM(parmesh,sbuf,int,"sbuf");
+  PMMG_DEL_MEM(parmesh,cur,int,"cur");
+  PMMG_DEL_MEM(parmesh,rcount,int,"rcount");
+  PMMG_DEL_MEM(parmesh,scount,int,"scount");
+  PMMG_DEL_MEM(parmesh,slab,int,"slab");
+
+  return ret;
+}
+
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ * \param tetra tetrahedra of the process.
+ * \param nel number of tetrahedra of the process.
+ * \param tria candidate triangles of the process (updated).
+ * \param nt number of candidate triangles (updated).
+ *
+ * \return 0 if fail, 1 otherwise
+ *
+ * Keep only the triangles that are a face of a tetrahedron of the process.
+ *
+ */
+static
+int PMMG_mpiio_filterTria( PMMG_pParMesh parmesh,int *tetra,int nel,int *tria,
+                           int *nt ) {
+  int *faces,v[3],i,j,k,l,n;
+
+  PMMG_MALLOC(parmesh,faces,12*nel,int,"faces",return 0);
+
+  for ( k=0; k<nel; ++k ) {
+    for ( i=0; i<4; ++i ) {
+      /* Face opposite to the vertex i */
+      l = 0;
+      for ( j=0; j<4; ++j ) {
+        if ( j != i ) faces[12*k+3*i+l++] = tetra[5*k+j];
+      }
+      PMMG_mpiio_sortFace(&faces[12*k+3*i]);
+    }
+  }
+  qsort(faces,4*nel,3*sizeof(int),PMMG_mpiio_compareFace);
+
+  n = 0;
+  for ( k=0; k<*nt; ++k ) {
+    memcpy(v,&tria[4*k],3*sizeof(int));
+    PMMG_mpiio_sortFace(v);
+    if ( !bsearch(v,faces,4*nel,3*sizeof(int),PMMG_mpiio_compareFace) ) continue;
+    memmove(&tria[4*n++],&tria[4*k],4*sizeof(int));
+  }
+  *nt = n;
+
+  PMMG_DEL_MEM(parmesh,faces,int,"faces");
+
+  return 1;
+}
+
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ * \param gids sorted global indices of the vertices of the process.
+ * \param np number of vertices of the process.
+ * \param pairs pairs (global vertex, rank of another process using the
+ * vertex) of the shared vertices of the process (sorted).
+ * \param npairs number of pairs.
+ *
+ * \return 0 if fail, 1 otherwise
+ *
+ * Set the node communicators of the process: the pairs are sorted by rank and
+ * by global index, so the nodes of each communicator are ordered in the same
+ * way on the two processes.
+ *
+ */
+static
+int PMMG_mpiio_setNodeComms( PMMG_pParMesh parmesh,int *gids,int np,int *pairs,
+                             int npairs ) {
+  int *local,*global,ncomm,icomm,nitem,k,i,ier;
+
+  ncomm = 0;
+  for ( k=0; k<npairs; ++k ) {
+    if ( !k || pairs[2*k+1] != pairs[2*k-1] ) ++ncomm;
+  }
+
+  if ( !PMMG_Set_numberOfNodeCommunicators(parmesh,ncomm) ) return 0;
+
+  ier   = 1;
+  icomm = 0;
+  for ( k=0; k<npairs; k+=nitem,++icomm ) {
+    for ( nitem=1; k+nitem<npairs; ++nitem ) {
+      if ( pairs[2*(k+nitem)+1] != pairs[2*k+1] ) break;
+    }
+
+    if ( !PMMG_Set_ithNodeCommunicatorSize(parmesh,icomm,pairs[2*k+1],nitem) )
+      return 0;
+
+    local = global = NULL;
+    PMMG_MALLOC(parmesh,local,nitem,int,"local",return 0);
+    PMMG_MALLOC(parmesh,global,nitem,int,"global",ier = 0);
+    if ( ier ) {
+      for ( i=0; i<nitem; ++i ) {
+        global[i] = pairs[2*(k+i)];
+        local[i]  = PMMG_mpiio_localIdx(gids,np,global[i]);
+      }
+      ier = PMMG_Set_ithNodeCommunicator_nodes(parmesh,icomm,local,global,0);
+    }
+    PMMG_DEL_MEM(parmesh,global,int,"global");
+    PMMG_DEL_MEM(parmesh,local,int,"local");
+    if ( !ier ) return 0;
+  }
+
+  return PMMG_Set_iparameter(parmesh,PMMG_IPARAM_APImode,PMMG_APIDISTRIB_nodes);
+}
+
+int PMMG_loadMesh_mpiio(PMMG_pParMesh parmesh,const char *filename,
+                        const char *metname) {
+  MPI_File   fh,fhm;
+  MPI_Offset hdr[PMMG_MPIIO_NHDR];
+  double     *vals,*dptr;
+  int        *tetra,*gids,*tria,*uidx,*users,*pairs,v[4];
+  int        nel,np,nt,npairs,nval,ier,ieresult,k,i;
+  char       *data,*buf;
+
+  ier = ( parmesh->ngrp == 1 );
+  MPI_CHECK( MPI_Allreduce(&ier,&ieresult,1,MPI_INT,MPI_MIN,parmesh->comm),
+             return 0 );
+  if ( !ieresult ) {
+    if ( parmesh->myrank == parmesh->info.root ) {
+      fprintf(stderr,"  ## Error: %s: you must have exactly 1 group on each"
+              " process.\n",__func__);
+    }
+    return 0;
+  }
+
+  if ( !PMMG_mpiio_readHeaders(parmesh,filename,metname,hdr) ) return 0;
+
+  if ( hdr[5] < parmesh->nprocs ) {
+    if ( parmesh->myrank == parmesh->info.root ) {
+      fprintf(stderr,"  ## Error: %s: less tetrahedra than processes.\n",
+              __func__);
+    }
+    return 0;
+  }
+
+  /** Open the files */
+  if ( !PMMG_mpiio_open(parmesh,filename,MPI_MODE_RDONLY,&fh) ) return 0;
+
+  fhm = MPI_FILE_NULL;
+  if ( hdr[7] ) {
+    ier = PMMG_mpiio_solName(parmesh,metname,&data);
+    if ( ier ) {
+      ier = PMMG_mpiio_open(parmesh,data,MPI_MODE_RDONLY,&fhm);
+    }
+    PMMG_DEL_MEM(parmesh,data,char,"data");
+    if ( !ier ) {
+      MPI_File_close(&fh);
+      return 0;
+    }
+  }
+
+  tetra = gids = tria = uidx = users = pairs = NULL;
+  vals  = NULL;
+  np    = nt = npairs = 0;
+
+  /** Tetrahedra: read by slabs, then partitioned and sent to their owner */
+  ier = PMMG_mpiio_readSlab(parmesh,fh,hdr[6],hdr[5],PMMG_MPIIO_TETRASIZE,
+                            &buf,&nel);
+  tetra = (int*)buf;
+  if ( ier ) {
+    ier = PMMG_mpiio_migrateTetra(parmesh,hdr[5],&tetra,&nel);
+    MPI_CHECK( MPI_Allreduce(&ier,&ieresult,1,MPI_INT,MPI_MIN,parmesh->comm),
+               ieresult = 0 );
+    ier = ieresult;
+  }
+
+  /** Vertices of the process */
+  if ( ier ) {
+    if ( !nel ) {
+      fprintf(stderr,"\n  ## Error: %s: empty partition on process %d.\n",
+              __func__,parmesh->myrank);
+      ier = 0;
+    }
+    else {
+      ier = PMMG_mpiio_localVertices(parmesh,hdr[1],tetra,nel,&gids,&np);
+    }
+    MPI_CHECK( MPI_Allreduce(&ier,&ieresult,1,MPI_INT,MPI_MIN,parmesh->comm),
+               ieresult = 0 );
+    ier = ieresult;
+  }
+  if ( ier ) {
+    ier = PMMG_mpiio_fetchVertices(parmesh,fh,fhm,hdr,gids,np,&vals,&uidx,
+                                   &users,&pairs,&npairs);
+  }
+
+  /** Boundary triangles of the process */
+  if ( ier && hdr[3] ) {
+    ier = PMMG_mpiio_fetchTria(parmesh,fh,hdr,uidx,users,&tria,&nt);
+    if ( ier ) {
+      ier = PMMG_mpiio_filterTria(parmesh,tetra,nel,tria,&nt);
+    }
+    MPI_CHECK( MPI_Allreduce(&ier,&ieresult,1,MPI_INT,MPI_MIN,parmesh->comm),
+               ieresult = 0 );
+    ier = ieresult;
+  }
+  PMMG_DEL_MEM(parmesh,users,int,"users");
+  PMMG_DEL_MEM(parmesh,uidx,int,"uidx");
+
+  if ( fhm != MPI_FILE_NULL ) {
+    MPI_CHECK( MPI_File_close(&fhm),ier = 0 );
+  }
+  MPI_CHECK( MPI_File_close(&fh),ier = 0 );
+
+  /** Build the mesh of the process */
+  if ( ier ) {
+    ier = PMMG_Set_meshSize(parmesh,np,nel,0,nt,0,0);
+  }
+
+  if ( ier ) {
+    nval = 4 + ( hdr[7] ? (int)hdr[10] : 0 );
+    for ( k=0; k<np; ++k ) {
+      dptr = &vals[(size_t)k*nval];
+      if ( !PMMG_Set_vertex(parmesh,dptr[0],dptr[1],dptr[2],(int)dptr[3],k+1) ) {
+        ier = 0;
+        break;
+      }
+    }
+  }
+
+  if ( ier ) {
+    for ( k=0; k<nel; ++k ) {
+      for ( i=0; i<4; ++i ) {
+        v[i] = PMMG_mpiio_localIdx(gids,np,tetra[5*k+i]);
+      }
+      if ( !PMMG_Set_tetrahedron(parmesh,v[0],v[1],v[2],v[3],tetra[5*k+4],k+1) ) {
+        ier = 0;
+        break;
+      }
+    }
+  }
+
+  if ( ier ) {
+    for ( k=0; k<nt; ++k ) {
+      for ( i=0; i<3; ++i ) {
+        v[i] = PMMG_mpiio_localIdx(gids,np,tria[4*k+i]);
+      }
+      if ( !PMMG_Set_triangle(parmesh,v[0],v[1],v[2],tria[4*k+3],k+1) ) {
+        ier = 0;
+        break;
+      }
+    }
+  }
+
+  /** Metric at the vertices */
+  if ( ier && hdr[7] ) {
+    ier = PMMG_Set_metSize(parmesh,MMG5_Vertex,np,
+                           hdr[10] == 1 ? MMG5_Scalar : MMG5_Tensor);
+    for ( k=0; ier && k<np; ++k ) {
+      dptr = &vals[(size_t)k*nval+4];
+      if ( hdr[10] == 1 ) {
+        ier = PMMG_Set_scalarMet(parmesh,dptr[0],k+1);
+      }
+      else {
+        ier = PMMG_Set_tensorMet(parmesh,dptr[0],dptr[1],dptr[2],dptr[3],
+                                 dptr[4],dptr[5],k+1);
+      }
+    }
+  }
+
+  /** Node communicators */
+  if ( ier ) {
+    qsort(pairs,npairs,2*sizeof(int),PMMG_mpiio_comparePair);
+    ier = PMMG_mpiio_setNodeComms(parmesh,gids,np,pairs,npairs);
+  }
+
+  PMMG_DEL_MEM(parmesh,pairs,int,"pairs");
+  PMMG_DEL_MEM(parmesh,tria,int,"tria");
+  PMMG_DEL_MEM(parmesh,vals,double,"vals");
+  PMMG_DEL_MEM(parmesh,gids,int,"gids");
+  PMMG_DEL_MEM(parmesh,tetra,int,"tetra");
+
+  MPI_CHECK( MPI_Allreduce(&ier,&ieresult,1,MPI_INT,MPI_MIN,parmesh->comm),
+             return 0 );
+
+  if ( ieresult && parmesh->myrank == parmesh->info.root &&
+       parmesh->info.imprim > PMMG_VERB_VERSION ) {
+    fprintf(stdout,"     NUMBER OF VERTICES   %" PRId64 "\n",(int64_t)hdr[1]);
+    fprintf(stdout,"     NUMBER OF TRIANGLES  %" PRId64 "\n",(int64_t)hdr[3]);
+    fprintf(stdout,"     NUMBER OF TETRAHEDRA %" PRId64 "\n",(int64_t)hdr[5]);
+  }
+
+  return ieresult;
+}
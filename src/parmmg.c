@@ -34,6 +34,12 @@
 
 mytime         PMMG_ctim[TIMEMAX];
 
+/* Free the saved output name, then the parmesh and leave */
+#define PMMG_RETURN_AND_FREE_NAME(parmesh,nameout,val) do {    \
+    PMMG_DEL_MEM(parmesh,nameout,char,"nameout");              \
+    PMMG_RETURN_AND_FREE(parmesh,val);                         \
+  } while(0)
+
 /**
  *
  * Print elapsed time at end of process.
@@ -65,8 +71,11 @@ int main( int argc, char *argv[] )
   MMG5_pSol     sol;
   int           rank;
   int           ier,iresult,ierSave,fmtin;
+#ifdef USE_OPENMP
+  int           provided;
+#endif
   int8_t        tim;
-  char          stim[32],*ptr;
+  char          stim[32],*ptr,*nameout;
 
   // Shared memory communicator: processes that are on the same node, sharing
   //    local memory and can potentially communicate without using the network
@@ -74,9 +83,27 @@ int main( int argc, char *argv[] )
   int      rank_shm = 0;
 
   /** Initializations: MPI, mesh, and memory */
+#ifdef USE_OPENMP
+  /* Only the main thread performs MPI calls */
+  MPI_Init_thread( &argc, &argv, MPI_THREAD_FUNNELED, &provided );
+#else
   MPI_Init( &argc, &argv );
+#endif
   MPI_Comm_rank( MPI_COMM_WORLD, &rank );
 
+#ifdef USE_OPENMP
+  if ( provided < MPI_THREAD_FUNNELED ) {
+    /* The MPI library doesn't support the threads: remesh the groups
+     * sequentially */
+    if ( !rank ) {
+      fprintf(stderr,"\n  ## Warning: %s: MPI_THREAD_FUNNELED is not supported"
+              " by the MPI library. The groups are remeshed by only one"
+              " thread.\n",__func__);
+    }
+    omp_set_num_threads(1);
+  }
+#endif
+
   if ( !rank ) {
     fprintf(stdout,"  -- PARMMG, Release %s (%s) \n",PMMG_VER,PMMG_REL);
     fprintf(stdout,"     %s\n",PMMG_CPY);
@@ -136,8 +163,13 @@ int main( int argc, char *argv[] )
   tim = 1;
   chrono(ON,&PMMG_ctim[tim]);
   if ( rank==parmesh->info.root && parmesh->info.imprim > PMMG_VERB_NO ) {
-    fprintf(stdout,"\n  -- INPUT DATA: LOADING MESH ON RANK %d\n",
-            parmesh->info.root);
+    if ( parmesh->info.shared_input ) {
+      fprintf(stdout,"\n  -- INPUT DATA: LOADING MESH ON ALL RANKS\n");
+    }
+    else {
+      fprintf(stdout,"\n  -- INPUT DATA: LOADING MESH ON RANK %d\n",
+              parmesh->info.root);
+    }
   }
 
   grp = &parmesh->listgrp[0];
@@ -150,7 +182,37 @@ int main( int argc, char *argv[] )
   ptr                  = MMG5_Get_filenameExt(grp->mesh->nameout);
   parmesh->info.fmtout = MMG5_Get_format(ptr,fmtin);
 
-  switch ( fmtin ) {
+  if ( parmesh->info.shared_input ) {
+    /* Shared input: the binary mesh file is read by slabs on all the processes */
+    if ( fmtin != MMG5_FMT_MeditBinary ) {
+      if ( rank == parmesh->info.root ) {
+        fprintf(stderr,"  ## Error: shared input only available at"
+                " .meshb format.\n");
+      }
+      ier = 0;
+      goto check_mesh_loading;
+    }
+    if ( grp->mesh->info.lag >= 0 || grp->mesh->info.iso ) {
+      if ( rank == parmesh->info.root ) {
+        fprintf(stderr,"  ## Error: shared input not available in"
+                " lagrangian or level-set mode.\n");
+      }
+      ier = 0;
+      goto check_mesh_loading;
+    }
+    if ( 1 != PMMG_loadMesh_mpiio(parmesh,grp->mesh->namein,grp->met->namein) ) {
+      ier = 0;
+      goto check_mesh_loading;
+    }
+
+    /* The output mesh is not merged */
+    if ( parmesh->info.distributed_output == PMMG_OUTPUT_merged ) {
+      parmesh->info.distributed_output =
+        ( parmesh->info.fmtout == MMG5_FMT_MeditBinary ) ?
+        PMMG_OUTPUT_sharedFile : PMMG_OUTPUT_perProcess;
+    }
+  }
+  else switch ( fmtin ) {
   case ( MMG5_FMT_MeditASCII ): case ( MMG5_FMT_MeditBinary ):
 
     if ( 1 != PMMG_loadMesh_centralized(parmesh,grp->mesh->namein) ) {
@@ -230,25 +292,39 @@ check_mesh_loading:
   if ( iresult != 1 )
     PMMG_RETURN_AND_FREE( parmesh, PMMG_LOWFAILURE );
 
+  /* The merge of the mesh frees the groups of the non-root procs: save the
+   * output name for the reports */
+  nameout = NULL;
+  PMMG_MALLOC(parmesh,nameout,strlen(grp->mesh->nameout)+1,char,"nameout",
+              PMMG_RETURN_AND_FREE( parmesh, PMMG_STRONGFAILURE ));
+  strcpy(nameout,grp->mesh->nameout);
+
   /** Main call */
   if ( parmesh->listgrp[0].mesh->mark ) {
     /* Save a local parameters file containing the default parameters */
     printf("  ## Error: default parameter file saving not yet implemented.\n");
     ier = 2;//PMMG_defaultOption(grp->mesh,grp->met);
-    PMMG_RETURN_AND_FREE(parmesh,ier);
+    PMMG_RETURN_AND_FREE_NAME(parmesh,nameout,ier);
   }
   else {
     /* Parallel remeshing */
-    ier = PMMG_parmmglib_centralized(parmesh);
+    if ( parmesh->info.shared_input ) {
+      ier = PMMG_parmmglib_distributed(parmesh);
+    }
+    else {
+      ier = PMMG_parmmglib_centralized(parmesh);
+    }
   }
 
   /** Check result and save output files */
   MPI_Allreduce( &ier, &iresult, 1, MPI_INT, MPI_MAX, parmesh->comm );
-  if ( iresult == PMMG_STRONGFAILURE ) { PMMG_RETURN_AND_FREE( parmesh, ier ); }
+  if ( iresult == PMMG_STRONGFAILURE ) { PMMG_RETURN_AND_FREE_NAME( parmesh,nameout,ier ); }
 
   tim = 2;
   chrono(ON,&PMMG_ctim[tim]);
 
+  PMMG_timer_start( parmesh,PMMG_PHASE_OUTPUT );
+
   grp = &parmesh->listgrp[0];
   if ( parmesh->info.imprim > PMMG_VERB_VERSION ) {
     fprintf(stdout,"\n  -- WRITING DATA FILE %s\n",grp->mesh->nameout);
@@ -257,7 +333,43 @@ check_mesh_loading:
   if ( parmesh->listgrp && parmesh->listgrp[0].mesh ) {
     grp = &parmesh->listgrp[0];
 
-    switch ( parmesh->info.fmtout ) {
+    if ( parmesh->info.distributed_output == PMMG_OUTPUT_sharedFile ) {
+      /* Shared output: one binary mesh file written by all the processes */
+      if ( parmesh->info.fmtout != MMG5_FMT_MeditBinary ) {
+        if ( rank == parmesh->info.root ) {
+          fprintf(stderr,"  ## Error: shared output only available at"
+                  " .meshb format.\n");
+        }
+        PMMG_RETURN_AND_FREE_NAME(parmesh,nameout,PMMG_STRONGFAILURE);
+      }
+      ierSave = PMMG_saveMesh_mpiio(parmesh,grp->mesh->nameout);
+      if ( ierSave && grp->met->m ) {
+        ierSave = PMMG_saveMet_mpiio(parmesh,grp->mesh->nameout);
+      }
+      if ( ierSave && grp->sol ) {
+        ierSave = PMMG_saveAllSols_mpiio(parmesh,grp->sol->nameout);
+      }
+      if ( !ierSave ) {
+        PMMG_RETURN_AND_FREE_NAME(parmesh,nameout,PMMG_STRONGFAILURE);
+      }
+    }
+    else if ( parmesh->info.distributed_output == PMMG_OUTPUT_perProcess &&
+              ( parmesh->info.fmtout == MMG5_FMT_MeditASCII ||
+                parmesh->info.fmtout == MMG5_FMT_MeditBinary ) ) {
+      /* Distributed output: one mesh file per process */
+      ierSave = PMMG_saveMesh_distributed(parmesh,grp->mesh->nameout);
+      if ( ierSave ) {
+        ierSave = PMMG_saveMet_distributed(parmesh,grp->mesh->nameout);
+      }
+      if ( ierSave && grp->sol ) {
+        ierSave = PMMG_saveAllSols_distributed(parmesh,grp->sol->nameout);
+      }
+      MPI_Allreduce( &ierSave, &ier, 1, MPI_INT, MPI_MIN, parmesh->comm );
+      if ( !ier ) {
+        PMMG_RETURN_AND_FREE_NAME(parmesh,nameout,PMMG_STRONGFAILURE);
+      }
+    }
+    else switch ( parmesh->info.fmtout ) {
     case ( MMG5_FMT_VtkPvtu ):
       PMMG_savePvtuMesh(parmesh,grp->mesh->nameout);
       break;
@@ -265,19 +377,19 @@ check_mesh_loading:
     case ( MMG5_FMT_VtkVtu ):
     case ( MMG5_FMT_VtkVtk ):
       printf("  ## Error: Output format not yet implemented.\n");
-      PMMG_RETURN_AND_FREE(parmesh,PMMG_STRONGFAILURE);
+      PMMG_RETURN_AND_FREE_NAME(parmesh,nameout,PMMG_STRONGFAILURE);
       break;
     default:
       ierSave = PMMG_saveMesh_centralized(parmesh,grp->mesh->nameout);
       if ( !ierSave ) {
-        PMMG_RETURN_AND_FREE(parmesh,PMMG_STRONGFAILURE);
+        PMMG_RETURN_AND_FREE_NAME(parmesh,nameout,PMMG_STRONGFAILURE);
       }
       if ( !PMMG_saveMet_centralized(parmesh,grp->mesh->nameout) ) {
-        PMMG_RETURN_AND_FREE(parmesh,PMMG_STRONGFAILURE);
+        PMMG_RETURN_AND_FREE_NAME(parmesh,nameout,PMMG_STRONGFAILURE);
       }
 
       if ( grp->sol && !PMMG_saveAllSols_centralized(parmesh,grp->sol->nameout) ) {
-        PMMG_RETURN_AND_FREE(parmesh,PMMG_STRONGFAILURE);
+        PMMG_RETURN_AND_FREE_NAME(parmesh,nameout,PMMG_STRONGFAILURE);
       }
 
       break;
@@ -285,8 +397,26 @@ check_mesh_loading:
   }
 
   chrono(OFF,&PMMG_ctim[tim]);
+  PMMG_timer_stop( parmesh,PMMG_PHASE_OUTPUT );
   if ( parmesh->info.imprim > PMMG_VERB_VERSION )
     fprintf(stdout,"  -- WRITING COMPLETED\n");
 
-  PMMG_RETURN_AND_FREE( parmesh, iresult );
+  /* Phases timers reduced over the procs */
+  if ( !PMMG_timers_report(parmesh,nameout) ) {
+    PMMG_RETURN_AND_FREE_NAME(parmesh,nameout,PMMG_LOWFAILURE);
+  }
+
+#ifdef USE_TRACE
+  /* Timeline of the events of each proc */
+  if ( !PMMG_trace_write(parmesh,nameout) ) {
+    PMMG_RETURN_AND_FREE_NAME(parmesh,nameout,PMMG_LOWFAILURE);
+  }
+#endif
+
+  /* Memory profile per allocation label */
+  if ( !PMMG_memprof_report(parmesh,nameout) ) {
+    PMMG_RETURN_AND_FREE_NAME(parmesh,nameout,PMMG_LOWFAILURE);
+  }
+
+  PMMG_RETURN_AND_FREE_NAME( parmesh,nameout,iresult );
 }
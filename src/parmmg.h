@@ -48,6 +48,10 @@
 #include "libparmmg.h"
 #include "mmg3d.h"
 
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -175,6 +179,76 @@ extern "C" {
  */
 #define PMMG_GRPSPL_MMG_TARGET 2
 
+/**
+ *
+ * Maximal ratio between the measured remeshing cost of a proc and the mean one
+ *
+ */
+#define PMMG_COSTRATIO_MAX 10.
+
+
+/**
+ *
+ * Number of metrics treated together by the log-Euclidean interpolation
+ *
+ */
+#define PMMG_LOGMET_BATCH 8
+
+/**
+ *
+ * Number of Jacobi sweeps for the diagonalization of the metrics
+ *
+ */
+#define PMMG_LOGMET_NSWEEP 6
+
+/**
+ *
+ * Halos (persistent exchanges of the internal communicator values): node or
+ * face communicator, int or double values
+ *
+ */
+#define PMMG_HALO_NODE_INT 0
+#define PMMG_HALO_NODE_DBL 1
+#define PMMG_HALO_FACE_INT 2
+#define PMMG_HALO_FACE_DBL 3
+#define PMMG_NHALO         4
+
+/**
+ *
+ * Storage of the received halo values: keep them in the halo buffer only,
+ * overwrite the internal communicator values, or keep the maximum (int only)
+ *
+ */
+#define PMMG_HALO_KEEP 0
+#define PMMG_HALO_COPY 1
+#define PMMG_HALO_MAX  2
+
+/**
+ *
+ * Phases of the pipeline for the profiling reports
+ *
+ */
+#define PMMG_PHASE_INIT     0
+#define PMMG_PHASE_GRPSPLIT 1
+#define PMMG_PHASE_MMG      2
+#define PMMG_PHASE_INTERP   3
+#define PMMG_PHASE_QUALITY  4
+#define PMMG_PHASE_LOADBAL  5
+#define PMMG_PHASE_PACKING  6
+#define PMMG_PHASE_MERGING  7
+#define PMMG_PHASE_OUTPUT   8
+#define PMMG_NPHASE         9
+
+/**
+ *
+ * Timers of the load balancing steps (after the phases timers)
+ *
+ */
+#define PMMG_TIMER_LB_IFC      9
+#define PMMG_TIMER_LB_SPLITMET 10
+#define PMMG_TIMER_LB_DISTRIB  11
+#define PMMG_TIMER_LB_SPLITMMG 12
+#define PMMG_NTIMER            13
 
 /**< Subgroups target size for a fast remeshing step */
 static const int PMMG_REMESHER_TARGET_MESH_SIZE = -30000000;
@@ -194,6 +268,9 @@ static const int PMMG_REDISTR_NELEM_MIN = 6;
 /**< Allowed imbalance ratio between current and demanded groups size */
 static const double PMMG_GRPS_RATIO = 2.0;
 
+/**< Ratio between edge cut and migration cost for adaptive repartitioning */
+static const double PMMG_REPART_ITR = 1000.0;
+
 /**< Number of elements layers for interface displacement */
 static const int PMMG_MVIFCS_NLAYERS = 2;
 
@@ -252,6 +329,37 @@ static const int PMMG_MVIFCS_NLAYERS = 2;
   }while(0)
 
 
+/* Allocations of the memory macros (see arena_pmmg.c) */
+void*  PMMG_scratch_malloc( void *owner,size_t size );
+void*  PMMG_scratch_calloc( void *owner,size_t nmemb,size_t size );
+void*  PMMG_myrealloc( void *owner,void *ptr,size_t size,size_t oldsize );
+size_t PMMG_myfree( void *ptr );
+
+/* Timeline of the events of the process (see trace_pmmg.c) */
+#ifdef USE_TRACE
+void PMMG_trace_event( const char *name,char ph,const char *key1,int val1,
+                       const char *key2,int val2 );
+void PMMG_trace_free( void );
+
+#define PMMG_TRACE_BEGIN(name)                                  \
+  PMMG_trace_event( (name),'B',NULL,0,NULL,0 )
+#define PMMG_TRACE_BEGIN_ARGS(name,key1,val1,key2,val2)         \
+  PMMG_trace_event( (name),'B',(key1),(val1),(key2),(val2) )
+#define PMMG_TRACE_END(name)                                    \
+  PMMG_trace_event( (name),'E',NULL,0,NULL,0 )
+#else
+#define PMMG_TRACE_BEGIN(name)                          do {} while(0)
+#define PMMG_TRACE_BEGIN_ARGS(name,key1,val1,key2,val2) do {} while(0)
+#define PMMG_TRACE_END(name)                            do {} while(0)
+#endif
+
+/* Memory profiler hooks of the memory macros (see memprof_pmmg.c) */
+extern int PMMG_memprof_on;
+void PMMG_memprof_alloc( void *ptr,size_t size,const char *msg );
+void PMMG_memprof_release( void *ptr );
+void PMMG_memprof_realloc( void *ptr,void *newptr,size_t size,const char *msg );
+void PMMG_memprof_releaseMesh( MMG5_pMesh mesh,MMG5_pSol met,MMG5_pSol sol );
+
 #define ERROR_AT(msg1,msg2)                                          \
   fprintf( stderr, msg1 msg2 " function: %s, file: %s, line: %d \n", \
            __func__, __FILE__, __LINE__ )
@@ -272,7 +380,8 @@ static const int PMMG_MVIFCS_NLAYERS = 2;
     size_t size_to_free;                                    \
                                                             \
     if ( ptr ) {                                            \
-      size_to_free = myfree( ptr );                         \
+      if ( PMMG_memprof_on ) PMMG_memprof_release( ptr );   \
+      size_to_free = PMMG_myfree( ptr );                    \
       assert ( (mesh)->memCur >= size_to_free );            \
       (mesh)->memCur -= size_to_free;                       \
       (ptr) = NULL;                                         \
@@ -293,6 +402,8 @@ static const int PMMG_MVIFCS_NLAYERS = 2;
         ERROR_AT( msg, " malloc failed: " );                \
         on_failure;                                         \
       } else {                                              \
+        if ( PMMG_memprof_on )                              \
+          PMMG_memprof_alloc( (ptr),size_to_allocate,msg ); \
         (mesh)->memCur += size_to_allocate;                 \
         stat = PMMG_SUCCESS;                                \
       }                                                     \
@@ -315,6 +426,8 @@ static const int PMMG_MVIFCS_NLAYERS = 2;
         ERROR_AT(msg," calloc failed: ");                   \
         on_failure;                                         \
       } else {                                              \
+        if ( PMMG_memprof_on )                              \
+          PMMG_memprof_alloc( (ptr),size_to_allocate,msg ); \
         (mesh)->memCur += size_to_allocate;                 \
       }                                                     \
     } else {                                                \
@@ -322,6 +435,57 @@ static const int PMMG_MVIFCS_NLAYERS = 2;
     }                                                       \
   } } while(0)
 
+/* Scratch arrays: served by the arena during a phase (see arena_pmmg.c).
+ * Only for arrays of the parmesh that are never freed or reallocated by Mmg
+ * (freed by PMMG_DEL_MEM and resized by PMMG_REALLOC) */
+#define PMMG_SCRATCH_MALLOC(mesh,ptr,size,type,msg,on_failure) do { \
+  int    stat = PMMG_SUCCESS;                                       \
+  size_t size_to_allocate;                                          \
+                                                                    \
+  (ptr) = NULL;                                                     \
+  if ( (size) != 0 ) {                                              \
+    size_to_allocate = (size)*sizeof(type);                         \
+    MEM_CHK_AVAIL(mesh,size_to_allocate,msg );                      \
+    if ( stat == PMMG_SUCCESS ) {                                   \
+      (ptr) = (type*)PMMG_scratch_malloc( (void*)(mesh),            \
+                                          size_to_allocate );       \
+      if ( (ptr) == NULL ) {                                        \
+        ERROR_AT( msg, " malloc failed: " );                        \
+        on_failure;                                                 \
+      } else {                                                      \
+        if ( PMMG_memprof_on )                                      \
+          PMMG_memprof_alloc( (ptr),size_to_allocate,msg );         \
+        (mesh)->memCur += size_to_allocate;                         \
+      }                                                             \
+    } else {                                                        \
+      on_failure;                                                   \
+    }                                                               \
+  } } while(0)
+
+#define PMMG_SCRATCH_CALLOC(mesh,ptr,size,type,msg,on_failure) do { \
+  int    stat = PMMG_SUCCESS;                                       \
+  size_t size_to_allocate;                                          \
+                                                                    \
+  (ptr) = NULL;                                                     \
+  if ( (size) != 0 ) {                                              \
+    size_to_allocate = (size)*sizeof(type);                         \
+    MEM_CHK_AVAIL(mesh,size_to_allocate,msg);                       \
+    if ( stat == PMMG_SUCCESS ) {                                   \
+      (ptr) = (type*)PMMG_scratch_calloc( (void*)(mesh),            \
+                                          (size), sizeof(type) );   \
+      if ( (ptr) == NULL ) {                                        \
+        ERROR_AT(msg," calloc failed: ");                           \
+        on_failure;                                                 \
+      } else {                                                      \
+        if ( PMMG_memprof_on )                                      \
+          PMMG_memprof_alloc( (ptr),size_to_allocate,msg );         \
+        (mesh)->memCur += size_to_allocate;                         \
+      }                                                             \
+    } else {                                                        \
+      on_failure;                                                   \
+    }                                                               \
+  } } while(0)
+
 #define PMMG_REALLOC(mesh,ptr,newsize,oldsize,type,msg,on_failure) do { \
   int    stat = PMMG_SUCCESS;                                           \
   size_t size_to_allocate,size_to_add,size_to_increase;                 \
@@ -334,13 +498,15 @@ static const int PMMG_MVIFCS_NLAYERS = 2;
     PMMG_DEL_MEM(mesh,ptr,type,msg);                                    \
   } else if ((newsize) < (oldsize)) {                                   \
     size_to_allocate = (newsize)*sizeof(type);                          \
-    tmp = (type *)myrealloc((ptr),size_to_allocate,                     \
+    tmp = (type *)PMMG_myrealloc((void*)(mesh),(ptr),size_to_allocate, \
                             (oldsize)*sizeof(type));                    \
     if ( tmp == NULL ) {                                                \
       ERROR_AT(msg," Realloc failed: ");                                \
       PMMG_DEL_MEM(mesh,ptr,type,msg);                                  \
       on_failure;                                                       \
     } else {                                                            \
+      if ( PMMG_memprof_on )                                            \
+        PMMG_memprof_realloc( (ptr),tmp,size_to_allocate,msg );         \
       (ptr) = tmp;                                                      \
       (mesh)->memCur -= (((oldsize)*sizeof(type))-size_to_allocate);    \
     }                                                                   \
@@ -351,12 +517,15 @@ static const int PMMG_MVIFCS_NLAYERS = 2;
                                                                         \
     MEM_CHK_AVAIL(mesh,size_to_add,msg);                                \
     if ( stat == PMMG_SUCCESS ) {                                       \
-      tmp = (type *)myrealloc((ptr),size_to_allocate,size_to_increase); \
+      tmp = (type *)PMMG_myrealloc((void*)(mesh),(ptr),                 \
+                                   size_to_allocate,size_to_increase); \
       if ( tmp == NULL ) {                                              \
         ERROR_AT(msg, " Realloc failed: " );                            \
         PMMG_DEL_MEM(mesh,ptr,type,msg);                                \
         on_failure;                                                     \
       } else {                                                          \
+        if ( PMMG_memprof_on )                                          \
+          PMMG_memprof_realloc( (ptr),tmp,size_to_allocate,msg );       \
         (ptr) = tmp;                                                    \
         (mesh)->memCur += ( size_to_add );                              \
       }                                                                 \
@@ -493,6 +662,28 @@ static const int PMMG_MVIFCS_NLAYERS = 2;
                                                                         \
   } while(0)
 
+/**
+ * \param flag pointer toward a warning flag (usually a static variable)
+ *
+ * \return 1 if the flag was not raised yet, 0 otherwise.
+ *
+ * Raise the warning flag and return its previous state. The test and the
+ * update are atomic so only one thread prints the warning when groups are
+ * treated concurrently.
+ *
+ */
+static inline
+int PMMG_raise_warnFlag( int *flag ) {
+  int old;
+
+#ifdef USE_OPENMP
+#pragma omp atomic capture
+#endif
+  { old = *flag; *flag = 1; }
+
+  return !old;
+}
+
 /* Input */
 int PMMG_check_inputData ( PMMG_pParMesh parmesh );
 int PMMG_preprocessMesh( PMMG_pParMesh parmesh );
@@ -504,8 +695,6 @@ int PMMG_parmmglib1 ( PMMG_pParMesh parmesh );
 
 /* Mesh distrib */
 int PMMG_bdryUpdate( MMG5_pMesh mesh );
-int PMMG_bcast_mesh ( PMMG_pParMesh parmesh );
-int PMMG_partBcast_mesh( PMMG_pParMesh parmesh );
 int PMMG_grpSplit_setMeshSize( MMG5_pMesh,int,int,int,int,int );
 int PMMG_splitPart_grps( PMMG_pParMesh,int,int,int );
 int PMMG_split_grps( PMMG_pParMesh parmesh,int grpIdOld,int ngrp,idx_t *part,int fitMesh );
@@ -514,16 +703,45 @@ int PMMG_split_grps( PMMG_pParMesh parmesh,int grpIdOld,int ngrp,idx_t *part,int
 int PMMG_transfer_all_grps(PMMG_pParMesh parmesh,idx_t *part);
 int PMMG_distribute_grps( PMMG_pParMesh parmesh );
 int PMMG_loadBalancing( PMMG_pParMesh parmesh );
+int PMMG_fit_costModel( PMMG_pParMesh parmesh );
 int PMMG_split_n2mGrps( PMMG_pParMesh,int,int );
 double PMMG_computeWgt( MMG5_pMesh mesh,MMG5_pSol met,MMG5_pTetra pt,int ifac );
+double PMMG_computeVwgt( MMG5_pMesh mesh,MMG5_pSol met,MMG5_pTetra pt );
 void PMMG_computeWgt_mesh( MMG5_pMesh mesh,MMG5_pSol met,int tag );
 
 /* Mesh interpolation */
 int PMMG_oldGrps_newGroup( PMMG_pParMesh parmesh,int igrp );
 int PMMG_oldGrps_fillGroup( PMMG_pParMesh parmesh,int igrp );
 int PMMG_update_oldGrps( PMMG_pParMesh parmesh );
-int PMMG_interpMetrics_grps( PMMG_pParMesh parmesh,int* );
-int PMMG_copyMetrics_point( PMMG_pGrp grp,PMMG_pGrp oldGrp, int* permNodGlob);
+int PMMG_interpMetricsAndFields_grps( PMMG_pParMesh parmesh );
+int PMMG_copyMetricsAndFields_point( PMMG_pGrp grp,PMMG_pGrp oldGrp, int* permNodGlob);
+void PMMG_logMetrics_batch( int nsize,const double *m,double *logm,int nb );
+void PMMG_expMetrics_batch( int nsize,const double *logm,double *m,int nb );
+void PMMG_logMetrics_mesh( MMG5_pMesh mesh,MMG5_pSol met,double *logm );
+
+/* Solution fields */
+int  PMMG_fields_size( MMG5_pMesh mesh,MMG5_pSol field );
+int  PMMG_fields_init( MMG5_pMesh mesh,MMG5_pSol *field,int nsols );
+int  PMMG_fields_copyStructure( MMG5_pMesh mesh,MMG5_pSol *field,
+                                MMG5_pMesh meshRef,MMG5_pSol fieldRef,int np );
+int  PMMG_fields_resize( MMG5_pMesh mesh,MMG5_pSol field,int npmax );
+void PMMG_fields_setNp( MMG5_pMesh mesh,MMG5_pSol field,int np );
+void PMMG_fields_copyPoint( MMG5_pMesh mesh,MMG5_pSol field,int ip,
+                            MMG5_pSol fieldRef,int ipRef );
+void PMMG_fields_packPoint( MMG5_pMesh mesh,MMG5_pSol field,int ip,double *buf );
+void PMMG_fields_unpackPoint( MMG5_pMesh mesh,MMG5_pSol field,int ip,
+                              const double *buf );
+
+/* Global indices of the vertices */
+int  PMMG_gid_copyStructure( MMG5_pMesh mesh,PMMG_pGrp grp,PMMG_pGrp grpRef );
+int  PMMG_gid_resize( MMG5_pMesh mesh,PMMG_pGrp grp,int npmax );
+void PMMG_gid_free( MMG5_pMesh mesh,PMMG_pGrp grp );
+void PMMG_gid_copyPoint( PMMG_pGrp grp,int ip,PMMG_pGrp grpRef,int ipRef );
+int  PMMG_gid_permute( MMG5_pMesh mesh,PMMG_pGrp grp,int *permNodGlob,int np );
+void PMMG_gid_pack( MMG5_pMesh mesh,PMMG_pGrp grp );
+int  PMMG_gid_init( PMMG_pParMesh parmesh );
+int  PMMG_gid_update( PMMG_pParMesh parmesh );
+int  PMMG_gid_isTracked( PMMG_pParMesh parmesh );
 
 /* Communicators building and unallocation */
 void PMMG_parmesh_int_comm_free( PMMG_pParMesh,PMMG_pInt_comm);
@@ -541,10 +759,43 @@ int PMMG_build_simpleExtNodeComm( PMMG_pParMesh parmesh );
 int PMMG_build_intNodeComm( PMMG_pParMesh parmesh );
 int PMMG_build_completeExtNodeComm( PMMG_pParMesh parmesh );
 int PMMG_parbdySet( PMMG_pParMesh parmesh );
+int PMMG_compute_verticesGloNum( PMMG_pParMesh parmesh,int *glonum,int *nowned,
+                                 int *offset,int *nglob );
 
 int PMMG_pack_faceCommunicators(PMMG_pParMesh parmesh);
 int PMMG_pack_nodeCommunicators(PMMG_pParMesh parmesh);
 
+/* Persistent exchanges through the communicators */
+int  PMMG_halo_exchange( PMMG_pParMesh parmesh,int ihalo,void *values,int mode );
+void PMMG_halo_free( PMMG_pParMesh parmesh );
+
+/* Scratch memory arena */
+void PMMG_arena_begin( PMMG_pParMesh parmesh,const char *phase );
+void PMMG_arena_end( PMMG_pParMesh parmesh );
+void PMMG_arena_free( PMMG_pParMesh parmesh );
+int  PMMG_arena_printStats( PMMG_pParMesh parmesh );
+
+/* Profiling reports */
+const char* PMMG_Get_phaseName( int phase );
+int  PMMG_reportFilename( PMMG_pParMesh parmesh,const char *filename,
+                          const char *ext,char **data );
+void PMMG_memprof_setPhase( int phase );
+void PMMG_memprof_destroy( void );
+int  PMMG_memprof_report( PMMG_pParMesh parmesh,const char *filename );
+void PMMG_timer_setIteration( PMMG_pParMesh parmesh,int it );
+void PMMG_timer_start( PMMG_pParMesh parmesh,int id );
+void PMMG_timer_stop( PMMG_pParMesh parmesh,int id );
+void PMMG_timers_free( PMMG_pParMesh parmesh );
+int  PMMG_timers_report( PMMG_pParMesh parmesh,const char *filename );
+#ifdef USE_TRACE
+int  PMMG_trace_write( PMMG_pParMesh parmesh,const char *filename );
+#endif
+#ifdef USE_MPI_COUNTERS
+void PMMG_mpicount_setPhase( int phase );
+int  PMMG_mpicount_report( PMMG_pParMesh parmesh,FILE *fp );
+void PMMG_mpicount_free( void );
+#endif
+
 /* Communicators checks */
 int PMMG_check_intFaceComm( PMMG_pParMesh parmesh );
 int PMMG_check_extFaceComm( PMMG_pParMesh parmesh );
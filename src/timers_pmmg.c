@@ -0,0 +1,331 @@
+/* =============================================================================
+**  This file is part of the parmmg software package for parallel tetrahedral
+**  mesh modification.
+**  Copyright (c) Bx INP/Inria/UBordeaux, 2017-
+**
+**  parmmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  parmmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with parmmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the parmmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/**
+ * \file timers_pmmg.c
+ * \brief Wall time of the pipeline phases, reduced over the processes.
+ * \author Cécile Dobrzynski (Bx INP/Inria)
+ * \author Algiane Froehly (Inria)
+ * \author Luca Cirrottola (Inria)
+ * \version 1
+ * \copyright GNU Lesser General Public License.
+ *
+ * Each process cumulates the wall time of the phases of the pipeline (and of
+ * the load balancing steps) per adaptation iteration. At the end, the timers
+ * are reduced over the processes (min, max, mean and imbalance max/mean) and
+ * saved in a JSON file (-timing-report). Starting a phase timer also sets the
+ * phase of the memory profiler and of the MPI counters (USE_MPI_COUNTERS) and
+ * adds the phase to the trace (USE_TRACE).
+ *
+ */
+#include "parmmg.h"
+
+static const char *PMMG_timerName[PMMG_NTIMER-PMMG_NPHASE] = {
+  "lb: count interfaces","lb: group split for metis","lb: group distribution",
+  "lb: group split for mmg" };
+
+/**
+ * \param id index of the timer.
+ *
+ * \return the name of the timer.
+ *
+ */
+static
+const char* PMMG_Get_timerName( int id ) {
+  assert ( id >= 0 && id < PMMG_NTIMER );
+  return ( id < PMMG_NPHASE ) ? PMMG_Get_phaseName(id) : PMMG_timerName[id-PMMG_NPHASE];
+}
+
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ * \param niter nb of iterations to store.
+ *
+ * \return 1 if success, 0 if fail.
+ *
+ * Allocate the timers or enlarge them to store \a niter iterations (the row
+ * out of the adaptation loop is always allocated, even if \a niter is 0).
+ *
+ */
+static
+int PMMG_timers_alloc( PMMG_pParMesh parmesh,int niter ) {
+  PMMG_pTimers timers;
+
+  if ( !parmesh->timers ) {
+    PMMG_CALLOC(parmesh,parmesh->timers,1,PMMG_Timers,"timers",return 0);
+    timers = parmesh->timers;
+    timers->ntimer = PMMG_NTIMER;
+    timers->it     = -1;
+    PMMG_CALLOC(parmesh,timers->tstart,PMMG_NTIMER,double,"tstart",
+                PMMG_timers_free(parmesh);return 0);
+    timers->niter  = MG_MAX(niter,0);
+    PMMG_CALLOC(parmesh,timers->time,(timers->niter+1)*PMMG_NTIMER,double,
+                "timers",PMMG_timers_free(parmesh);return 0);
+  }
+  timers = parmesh->timers;
+
+  if ( niter > timers->niter ) {
+    PMMG_RECALLOC(parmesh,timers->time,(niter+1)*PMMG_NTIMER,
+                  (timers->niter+1)*PMMG_NTIMER,double,"timers",
+                  PMMG_timers_free(parmesh);return 0);
+    timers->niter = niter;
+  }
+  return 1;
+}
+
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ *
+ * Free the timers.
+ *
+ */
+void PMMG_timers_free( PMMG_pParMesh parmesh ) {
+
+  if ( !parmesh->timers ) return;
+
+  PMMG_DEL_MEM(parmesh,parmesh->timers->time,double,"timers");
+  PMMG_DEL_MEM(parmesh,parmesh->timers->tstart,double,"tstart");
+  PMMG_DEL_MEM(parmesh,parmesh->timers,PMMG_Timers,"timers");
+}
+
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ * \param it adaptation iteration (-1 out of the adaptation loop).
+ *
+ * Set the iteration on which the next times are charged.
+ *
+ */
+void PMMG_timer_setIteration( PMMG_pParMesh parmesh,int it ) {
+
+  if ( !PMMG_timers_alloc(parmesh,MG_MAX(it+1,parmesh->niter)) ) return;
+
+  parmesh->timers->it = it;
+}
+
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ * \param id index of the timer.
+ *
+ * Start a timer (and set the phase of the memory profiler and of the MPI
+ * counters if \a id is a phase).
+ *
+ */
+void PMMG_timer_start( PMMG_pParMesh parmesh,int id ) {
+
+  assert ( id >= 0 && id < PMMG_NTIMER );
+
+  PMMG_TRACE_BEGIN( PMMG_Get_timerName(id) );
+
+  if ( id < PMMG_NPHASE ) {
+    PMMG_memprof_setPhase(id);
+#ifdef USE_MPI_COUNTERS
+    PMMG_mpicount_setPhase(id);
+#endif
+  }
+
+  if ( !PMMG_timers_alloc(parmesh,parmesh->niter) ) return;
+
+  parmesh->timers->tstart[id] = MPI_Wtime();
+}
+
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ * \param id index of the timer.
+ *
+ * Stop a timer and charge the elapsed time on the current iteration.
+ *
+ */
+void PMMG_timer_stop( PMMG_pParMesh parmesh,int id ) {
+  PMMG_pTimers timers;
+
+  assert ( id >= 0 && id < PMMG_NTIMER );
+
+  PMMG_TRACE_END( PMMG_Get_timerName(id) );
+
+  timers = parmesh->timers;
+  if ( !timers || !timers->time || timers->tstart[id] <= 0. ) return;
+
+  timers->time[(timers->it+1)*PMMG_NTIMER+id] += MPI_Wtime() - timers->tstart[id];
+  timers->tstart[id] = 0.;
+}
+
+/**
+ * \param fp file.
+ * \param id index of the timer.
+ * \param it iteration (0 out of the adaptation loop, -1 for the total).
+ * \param vmin min of the times over the processes.
+ * \param vmax max of the times over the processes.
+ * \param vsum sum of the times over the processes.
+ * \param nprocs number of processes.
+ * \param first 1 if first entry of the list.
+ *
+ * Write the entry of a timer in the JSON report.
+ *
+ */
+static
+void PMMG_timers_writeEntry( FILE *fp,int id,int it,double vmin,double vmax,
+                             double vsum,int nprocs,int first ) {
+  double mean;
+
+  mean = vsum/nprocs;
+  fprintf(fp,"%s    {\"timer\": \"%s\", \"iteration\": ",first ? "" : ",\n",
+          PMMG_Get_timerName(id));
+  if ( it < 0 ) {
+    fprintf(fp,"\"total\"");
+  }
+  else if ( !it ) {
+    fprintf(fp,"\"none\"");
+  }
+  else {
+    fprintf(fp,"%d",it);
+  }
+  fprintf(fp,", \"min\": %.6e, \"max\": %.6e, \"mean\": %.6e, \"imbalance\": %.4f}",
+          vmin,vmax,mean,mean > 0. ? vmax/mean : 1.);
+}
+
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ * \param filename name of the output mesh (the report is saved in
+ * "name.timers.json").
+ *
+ * \return 1 if success, 0 if fail.
+ *
+ * Reduce the timers over the processes. At verbosity > PMMG_VERB_STEPS, print
+ * the max and the imbalance (max/mean) of the total time of each timer; if
+ * the timing report is asked, save the min, max, mean and imbalance of each
+ * timer and iteration in a JSON file. With USE_MPI_COUNTERS, the MPI counters
+ * are reported too (in the "mpi" entry of the JSON file). Collective.
+ *
+ */
+int PMMG_timers_report( PMMG_pParMesh parmesh,const char *filename ) {
+  PMMG_pTimers timers;
+  FILE         *fp = NULL;
+  double       *loc,*vmin,*vmax,*vsum,mean;
+  char         *fname,stim[32];
+  int          niter,nval,first,id,it,ier,ieresult;
+
+  if ( !parmesh->info.timing_report &&
+       parmesh->info.imprim0 <= PMMG_VERB_STEPS ) return 1;
+
+  /* The number of iterations may differ if a proc has failed */
+  niter = parmesh->timers ? parmesh->timers->niter : 0;
+  MPI_CHECK( MPI_Allreduce(MPI_IN_PLACE,&niter,1,MPI_INT,MPI_MAX,parmesh->comm),
+             return 0 );
+
+  ier = PMMG_timers_alloc(parmesh,niter);
+  MPI_Allreduce( &ier,&ieresult,1,MPI_INT,MPI_MIN,parmesh->comm );
+  if ( !ieresult ) return 0;
+
+  timers = parmesh->timers;
+  nval   = (niter+2)*PMMG_NTIMER;
+  loc    = vmin = vmax = vsum = NULL;
+  fname  = NULL;
+
+  /* Last row: total over the iterations */
+  PMMG_CALLOC(parmesh,loc,nval,double,"timers loc",ier = 0);
+  if ( parmesh->myrank == parmesh->info.root ) {
+    PMMG_MALLOC(parmesh,vmin,nval,double,"timers vmin",ier = 0);
+    PMMG_MALLOC(parmesh,vmax,nval,double,"timers vmax",ier = 0);
+    PMMG_MALLOC(parmesh,vsum,nval,double,"timers vsum",ier = 0);
+  }
+  MPI_Allreduce( &ier,&ieresult,1,MPI_INT,MPI_MIN,parmesh->comm );
+  if ( !ieresult ) goto end;
+
+  for ( it=0; it<=niter; ++it ) {
+    for ( id=0; id<PMMG_NTIMER; ++id ) {
+      loc[it*PMMG_NTIMER+id]              = timers->time[it*PMMG_NTIMER+id];
+      loc[(niter+1)*PMMG_NTIMER+id] += timers->time[it*PMMG_NTIMER+id];
+    }
+  }
+
+  MPI_CHECK( MPI_Reduce(loc,vmin,nval,MPI_DOUBLE,MPI_MIN,parmesh->info.root,
+                        parmesh->comm),ier = 0 );
+  MPI_CHECK( MPI_Reduce(loc,vmax,nval,MPI_DOUBLE,MPI_MAX,parmesh->info.root,
+                        parmesh->comm),ier = 0 );
+  MPI_CHECK( MPI_Reduce(loc,vsum,nval,MPI_DOUBLE,MPI_SUM,parmesh->info.root,
+                        parmesh->comm),ier = 0 );
+
+  if ( parmesh->myrank != parmesh->info.root || !ier ) goto end;
+
+  /** Human output: total time of the slowest proc and imbalance */
+  if ( parmesh->info.imprim > PMMG_VERB_STEPS ) {
+    fprintf(stdout,"\n   -- TIMERS (slowest proc / imbalance max/mean)\n");
+    for ( id=0; id<PMMG_NTIMER; ++id ) {
+      it = (niter+1)*PMMG_NTIMER+id;
+      if ( vmax[it] <= 0. ) continue;
+      mean = vsum[it]/parmesh->nprocs;
+      printim(vmax[it],stim);
+      fprintf(stdout,"       %-30s  %s  %.3f\n",PMMG_Get_timerName(id),stim,
+              mean > 0. ? vmax[it]/mean : 1.);
+    }
+  }
+
+  /** JSON report */
+  if ( !parmesh->info.timing_report ) goto end;
+
+  if ( !PMMG_reportFilename(parmesh,filename,".timers.json",&fname) ) {
+    ier = 0;
+    goto end;
+  }
+  if ( !(fp = fopen(fname,"w")) ) {
+    fprintf(stderr,"\n  ## Error: %s: unable to open %s.\n",__func__,fname);
+    ier = 0;
+    goto end;
+  }
+  if ( parmesh->info.imprim > PMMG_VERB_VERSION ) {
+    fprintf(stdout,"\n  -- WRITING TIMING REPORT %s\n",fname);
+  }
+
+  fprintf(fp,"{\n  \"nprocs\": %d,\n  \"niter\": %d,\n  \"unit\": \"s\",\n",
+          parmesh->nprocs,niter);
+  fprintf(fp,"  \"timers\": [\n");
+  first = 1;
+  for ( it=0; it<=niter+1; ++it ) {
+    for ( id=0; id<PMMG_NTIMER; ++id ) {
+      nval = it*PMMG_NTIMER+id;
+      if ( vmax[nval] <= 0. ) continue;
+      PMMG_timers_writeEntry(fp,id,it<=niter ? it : -1,vmin[nval],vmax[nval],
+                             vsum[nval],parmesh->nprocs,first);
+      first = 0;
+    }
+  }
+  fprintf(fp,"\n  ]");
+
+end:
+#ifdef USE_MPI_COUNTERS
+  /* The MPI counters go in the same report */
+  if ( !PMMG_mpicount_report(parmesh,fp) ) ier = 0;
+#endif
+  if ( fp ) {
+    fprintf(fp,"\n}\n");
+    fclose(fp);
+  }
+
+  PMMG_DEL_MEM(parmesh,fname,char,"fname");
+  PMMG_DEL_MEM(parmesh,vsum,double,"timers vsum");
+  PMMG_DEL_MEM(parmesh,vmax,double,"timers vmax");
+  PMMG_DEL_MEM(parmesh,vmin,double,"timers vmin");
+  PMMG_DEL_MEM(parmesh,loc,double,"timers loc");
+
+  MPI_Allreduce( &ier,&ieresult,1,MPI_INT,MPI_MIN,parmesh->comm );
+  return ieresult;
+}
@@ -0,0 +1,207 @@
+/* =============================================================================
+**  This file is part of the parmmg software package for parallel tetrahedral
+**  mesh modification.
+**  Copyright (c) Bx INP/Inria/UBordeaux, 2017-
+**
+**  parmmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  parmmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with parmmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the parmmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/**
+ * \file trace_pmmg.c
+ * \brief Timeline of the events of each process (Chrome trace-event format).
+ * \author Cécile Dobrzynski (Bx INP/Inria)
+ * \author Algiane Froehly (Inria)
+ * \author Luca Cirrottola (Inria)
+ * \version 1
+ * \copyright GNU Lesser General Public License.
+ *
+ * Only compiled with USE_TRACE: otherwise the PMMG_TRACE_* macros are empty.
+ * The begin/end events (phases, Mmg call of each group, groups transfers,
+ * communicators building, error checks) are stored in memory and each process
+ * saves them in "name.trace.<rank>.json" at the end of the run. The pid of the
+ * events is the rank and their time origin is common to all the processes
+ * (if MPI_Wtime is not global, the clocks are aligned on the exit of a
+ * barrier), so the files can be merged offline by concatenating their event
+ * lists.
+ *
+ */
+#include "parmmg.h"
+
+#ifdef USE_TRACE
+
+/**
+ * \struct PMMG_TraceEvent
+ * \brief begin or end event of the timeline.
+ */
+typedef struct {
+  const char *name;  /*!< name of the event (static string) */
+  const char *key[2];/*!< names of the arguments (NULL if unused) */
+  double     ts;     /*!< time of the event (s) */
+  int        val[2]; /*!< values of the arguments */
+  int        tid;    /*!< OpenMP thread */
+  char       ph;     /*!< 'B' for begin, 'E' for end */
+} PMMG_TraceEvent;
+
+/* The trace buffer is not charged on the parmesh memory: it must not change
+ * the memory available for the remeshing */
+static PMMG_TraceEvent *PMMG_trace    = NULL;
+static size_t          PMMG_ntrace    = 0;
+static size_t          PMMG_ntraceMax = 0;
+
+/**
+ * \param name name of the event (static string).
+ * \param ph 'B' to begin the event, 'E' to end it.
+ * \param key1 name of the first argument (NULL if unused).
+ * \param val1 value of the first argument.
+ * \param key2 name of the second argument (NULL if unused).
+ * \param val2 value of the second argument.
+ *
+ * Store an event of the timeline (see the PMMG_TRACE_* macros). The event is
+ * lost if the buffer can't be enlarged.
+ *
+ */
+void PMMG_trace_event( const char *name,char ph,const char *key1,int val1,
+                       const char *key2,int val2 ) {
+  PMMG_TraceEvent *ev;
+  double          ts;
+  size_t          n;
+
+  ts = MPI_Wtime();
+
+#ifdef USE_OPENMP
+#pragma omp critical (PMMG_trace)
+#endif
+  {
+    if ( PMMG_ntrace == PMMG_ntraceMax ) {
+      n  = PMMG_ntraceMax ? 2*PMMG_ntraceMax : 4096;
+      ev = (PMMG_TraceEvent*)realloc(PMMG_trace,n*sizeof(PMMG_TraceEvent));
+      if ( ev ) {
+        PMMG_trace     = ev;
+        PMMG_ntraceMax = n;
+      }
+    }
+    if ( PMMG_ntrace < PMMG_ntraceMax ) {
+      ev         = &PMMG_trace[PMMG_ntrace++];
+      ev->name   = name;
+      ev->ph     = ph;
+      ev->ts     = ts;
+      ev->key[0] = key1;
+      ev->val[0] = val1;
+      ev->key[1] = key2;
+      ev->val[1] = val2;
+#ifdef USE_OPENMP
+      ev->tid    = omp_get_thread_num();
+#else
+      ev->tid    = 0;
+#endif
+    }
+  }
+}
+
+/**
+ * Free the trace buffer.
+ */
+void PMMG_trace_free( void ) {
+  free(PMMG_trace);
+  PMMG_trace     = NULL;
+  PMMG_ntrace    = 0;
+  PMMG_ntraceMax = 0;
+}
+
+/**
+ * \param parmesh pointer toward the parmesh structure.
+ * \param filename name of the output mesh (the trace is saved in
+ * "name.trace.<rank>.json").
+ *
+ * \return 1 if success, 0 if fail.
+ *
+ * Save the events of the process in the Chrome trace-event format (times in
+ * microseconds from the first event of all the processes) and free the trace
+ * buffer. If the MPI clocks are not synchronized (MPI_WTIME_IS_GLOBAL), each
+ * process shifts its times by its clock at the exit of a common barrier.
+ * Collective.
+ *
+ */
+int PMMG_trace_write( PMMG_pParMesh parmesh,const char *filename ) {
+  PMMG_TraceEvent *ev;
+  FILE            *fp;
+  double          t0,offset;
+  size_t          k;
+  char            ext[32],*fname;
+  int             *isGlobal,flag,global,j,ier,ieresult;
+
+  /* Clock offset of the proc: null if the clocks are synchronized, otherwise
+   * the clocks are aligned on the exit of a barrier */
+  MPI_CHECK( MPI_Comm_get_attr(MPI_COMM_WORLD,MPI_WTIME_IS_GLOBAL,&isGlobal,&flag),
+             return 0 );
+  global = ( flag && *isGlobal );
+  MPI_CHECK( MPI_Allreduce(MPI_IN_PLACE,&global,1,MPI_INT,MPI_MIN,parmesh->comm),
+             return 0 );
+  offset = 0.;
+  if ( !global ) {
+    MPI_CHECK( MPI_Barrier(parmesh->comm),return 0 );
+    offset = MPI_Wtime();
+  }
+
+  /* Common time origin */
+  t0 = ( PMMG_ntrace ? PMMG_trace[0].ts : MPI_Wtime() ) - offset;
+  MPI_CHECK( MPI_Allreduce(MPI_IN_PLACE,&t0,1,MPI_DOUBLE,MPI_MIN,parmesh->comm),
+             return 0 );
+  t0 += offset;
+
+  ier   = 1;
+  fname = NULL;
+  sprintf(ext,".trace.%d.json",parmesh->myrank);
+  if ( !PMMG_reportFilename(parmesh,filename,ext,&fname) ) {
+    ier = 0;
+  }
+  else if ( !(fp = fopen(fname,"w")) ) {
+    fprintf(stderr,"\n  ## Error: %s: unable to open %s.\n",__func__,fname);
+    ier = 0;
+  }
+  else {
+    if ( parmesh->info.imprim > PMMG_VERB_VERSION ) {
+      fprintf(stdout,"\n  -- WRITING TRACE %s\n",fname);
+    }
+    fprintf(fp,"{\"traceEvents\": [\n");
+    for ( k=0; k<PMMG_ntrace; ++k ) {
+      ev = &PMMG_trace[k];
+      fprintf(fp,"{\"name\": \"%s\", \"ph\": \"%c\", \"ts\": %.3f, \"pid\": %d,"
+              " \"tid\": %d",ev->name,ev->ph,(ev->ts-t0)*1.e6,parmesh->myrank,
+              ev->tid);
+      if ( ev->key[0] ) {
+        fprintf(fp,", \"args\": {");
+        for ( j=0; j<2 && ev->key[j]; ++j ) {
+          fprintf(fp,"%s\"%s\": %d",j ? ", " : "",ev->key[j],ev->val[j]);
+        }
+        fprintf(fp,"}");
+      }
+      fprintf(fp,"}%s\n",k+1<PMMG_ntrace ? "," : "");
+    }
+    fprintf(fp,"],\n\"displayTimeUnit\": \"ms\"}\n");
+    fclose(fp);
+  }
+  PMMG_DEL_MEM(parmesh,fname,char,"fname");
+
+  PMMG_trace_free();
+
+  MPI_Allreduce( &ier,&ieresult,1,MPI_INT,MPI_MIN,parmesh->comm );
+  return ieresult;
+}
+
+#endif
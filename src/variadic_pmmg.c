@@ -267,6 +267,20 @@ int PMMG_Free_all_var(va_list argptr)
 
   PMMG_parmesh_Free_Listgrp( *parmesh );
 
+  PMMG_arena_free( *parmesh );
+
+  PMMG_memprof_destroy();
+
+  PMMG_timers_free( *parmesh );
+
+#ifdef USE_TRACE
+  PMMG_trace_free();
+#endif
+
+#ifdef USE_MPI_COUNTERS
+  PMMG_mpicount_free();
+#endif
+
   (*parmesh)->memCur -= sizeof(PMMG_ParMesh);
 
   if ( (*parmesh)->info.imprim>5 || (*parmesh)->ddebug ) {
@@ -436,6 +436,11 @@ int PMMG_parmesh_updateMemMax( PMMG_pParMesh parmesh, int percent, int fitMesh )
       PMMG_REALLOC(mesh,met->m,met->size*(met->npmax+1),met->size*(npmax_old+1),
                    double,"metric array",return 0);
 
+    if ( !PMMG_fields_resize(mesh,parmesh->listgrp[i].sol,mesh->npmax) )
+      return 0;
+    if ( !PMMG_gid_resize(mesh,&parmesh->listgrp[i],mesh->npmax) )
+      return 0;
+
     /* Count the remaining available memory */
     if ( available < delta ) {
       fprintf(stderr,"\n  ## Error: %s: not enough memory %d-%d\n",__func__,parmesh->myrank,i);